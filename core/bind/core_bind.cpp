@@ -1512,18 +1512,12 @@ bool _File::file_exists(const String &p_name) const {
 void _File::store_var(const Variant &p_var, bool p_full_objects) {
 	ERR_FAIL_COND_MSG(!f, "File must be opened before use.");
 	int len;
-	Error err = encode_variant(p_var, nullptr, len, p_full_objects);
-	ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant.");
-
 	Vector<uint8_t> buff;
-	buff.resize(len);
-
-	uint8_t *w = buff.ptrw();
-	err = encode_variant(p_var, &w[0], len, p_full_objects);
+	Error err = encode_variant(p_var, buff, len, p_full_objects);
 	ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant.");
 
 	store_32(len);
-	store_buffer(buff);
+	f->store_buffer(buff.ptr(), len);
 }
 
 Variant _File::get_var(bool p_allow_objects) const {
@@ -1808,17 +1802,11 @@ _Marshalls *_Marshalls::get_singleton() {
 
 String _Marshalls::variant_to_base64(const Variant &p_var, bool p_full_objects) {
 	int len;
-	Error err = encode_variant(p_var, nullptr, len, p_full_objects);
-	ERR_FAIL_COND_V_MSG(err != OK, "", "Error when trying to encode Variant.");
-
 	Vector<uint8_t> buff;
-	buff.resize(len);
-	uint8_t *w = buff.ptrw();
-
-	err = encode_variant(p_var, &w[0], len, p_full_objects);
+	Error err = encode_variant(p_var, buff, len, p_full_objects);
 	ERR_FAIL_COND_V_MSG(err != OK, "", "Error when trying to encode Variant.");
 
-	String ret = CryptoCore::b64_encode_str(&w[0], len);
+	String ret = CryptoCore::b64_encode_str(buff.ptr(), len);
 	ERR_FAIL_COND_V(ret == "", ret);
 
 	return ret;
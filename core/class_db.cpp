@@ -361,10 +361,8 @@ uint64_t ClassDB::get_api_hash(APIType p_api) {
 
 			List<StringName> snames;
 
-			k = nullptr;
-
-			while ((k = t->method_map.next(k))) {
-				String name = k->operator String();
+			for (OAHashMap<StringName, MethodBind *>::Iterator it = t->method_map.iter(); it.valid; it = t->method_map.next_iter(it)) {
+				String name = it.key->operator String();
 
 				ERR_CONTINUE(name.empty());
 
@@ -372,13 +370,13 @@ uint64_t ClassDB::get_api_hash(APIType p_api) {
 					continue; // Ignore non-virtual methods that start with an underscore
 				}
 
-				snames.push_back(*k);
+				snames.push_back(*it.key);
 			}
 
 			snames.sort_custom<StringName::AlphCompare>();
 
 			for (List<StringName>::Element *F = snames.front(); F; F = F->next()) {
-				MethodBind *mb = t->method_map[F->get()];
+				MethodBind *mb = *t->method_map.lookup_ptr(F->get());
 				hash = hash_djb2_one_64(mb->get_name().hash(), hash);
 				hash = hash_djb2_one_64(mb->get_argument_count(), hash);
 				hash = hash_djb2_one_64(mb->get_argument_type(-1), hash); //return
@@ -446,16 +444,14 @@ uint64_t ClassDB::get_api_hash(APIType p_api) {
 
 			List<StringName> snames;
 
-			k = nullptr;
-
-			while ((k = t->property_setget.next(k))) {
-				snames.push_back(*k);
+			for (OAHashMap<StringName, PropertySetGet>::Iterator it = t->property_setget.iter(); it.valid; it = t->property_setget.next_iter(it)) {
+				snames.push_back(*it.key);
 			}
 
 			snames.sort_custom<StringName::AlphCompare>();
 
 			for (List<StringName>::Element *F = snames.front(); F; F = F->next()) {
-				PropertySetGet *psg = t->property_setget.getptr(F->get());
+				PropertySetGet *psg = t->property_setget.lookup_ptr(F->get());
 				ERR_FAIL_COND_V(!psg, 0);
 
 				hash = hash_djb2_one_64(F->get().hash(), hash);
@@ -570,7 +566,7 @@ void ClassDB::get_method_list(StringName p_class, List<MethodInfo> *p_methods, b
 		}
 
 		for (List<StringName>::Element *E = type->method_order.front(); E; E = E->next()) {
-			MethodBind *method = type->method_map.get(E->get());
+			MethodBind *method = *type->method_map.lookup_ptr(E->get());
 			MethodInfo minfo;
 			minfo.name = E->get();
 			minfo.id = method->get_method_id();
@@ -599,10 +595,8 @@ void ClassDB::get_method_list(StringName p_class, List<MethodInfo> *p_methods, b
 
 #else
 
-		const StringName *K = nullptr;
-
-		while ((K = type->method_map.next(K))) {
-			MethodBind *m = type->method_map[*K];
+		for (OAHashMap<StringName, MethodBind *>::Iterator it = type->method_map.iter(); it.valid; it = type->method_map.next_iter(it)) {
+			MethodBind *m = *it.value;
 			MethodInfo mi;
 			mi.name = m->get_name();
 			p_methods->push_back(mi);
@@ -624,7 +618,7 @@ MethodBind *ClassDB::get_method(StringName p_class, StringName p_name) {
 	ClassInfo *type = classes.getptr(p_class);
 
 	while (type) {
-		MethodBind **method = type->method_map.getptr(p_name);
+		MethodBind **method = type->method_map.lookup_ptr(p_name);
 		if (method && *method) {
 			return *method;
 		}
@@ -926,7 +920,7 @@ void ClassDB::add_property(StringName p_class, const PropertyInfo &p_pinfo, cons
 	psg.index = p_index;
 	psg.type = p_pinfo.type;
 
-	type->property_setget[p_pinfo.name] = psg;
+	type->property_setget.set(p_pinfo.name, psg);
 }
 
 void ClassDB::set_property_default_value(StringName p_class, const StringName &p_name, const Variant &p_default) {
@@ -963,7 +957,7 @@ bool ClassDB::set_property(Object *p_object, const StringName &p_property, const
 	ClassInfo *type = classes.getptr(p_object->get_class_name());
 	ClassInfo *check = type;
 	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		const PropertySetGet *psg = check->property_setget.lookup_ptr(p_property);
 		if (psg) {
 			if (!psg->setter) {
 				if (r_valid) {
@@ -1010,7 +1004,7 @@ bool ClassDB::get_property(Object *p_object, const StringName &p_property, Varia
 	ClassInfo *type = classes.getptr(p_object->get_class_name());
 	ClassInfo *check = type;
 	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		const PropertySetGet *psg = check->property_setget.lookup_ptr(p_property);
 		if (psg) {
 			if (!psg->getter) {
 				return true; //return true but do nothing
@@ -1059,7 +1053,7 @@ int ClassDB::get_property_index(const StringName &p_class, const StringName &p_p
 	ClassInfo *type = classes.getptr(p_class);
 	ClassInfo *check = type;
 	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		const PropertySetGet *psg = check->property_setget.lookup_ptr(p_property);
 		if (psg) {
 			if (r_is_valid) {
 				*r_is_valid = true;
@@ -1081,7 +1075,7 @@ Variant::Type ClassDB::get_property_type(const StringName &p_class, const String
 	ClassInfo *type = classes.getptr(p_class);
 	ClassInfo *check = type;
 	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		const PropertySetGet *psg = check->property_setget.lookup_ptr(p_property);
 		if (psg) {
 			if (r_is_valid) {
 				*r_is_valid = true;
@@ -1103,7 +1097,7 @@ StringName ClassDB::get_property_setter(StringName p_class, const StringName &p_
 	ClassInfo *type = classes.getptr(p_class);
 	ClassInfo *check = type;
 	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		const PropertySetGet *psg = check->property_setget.lookup_ptr(p_property);
 		if (psg) {
 			return psg->setter;
 		}
@@ -1118,7 +1112,7 @@ StringName ClassDB::get_property_getter(StringName p_class, const StringName &p_
 	ClassInfo *type = classes.getptr(p_class);
 	ClassInfo *check = type;
 	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		const PropertySetGet *psg = check->property_setget.lookup_ptr(p_property);
 		if (psg) {
 			return psg->getter;
 		}
@@ -1151,8 +1145,9 @@ void ClassDB::set_method_flags(StringName p_class, StringName p_method, int p_fl
 	ClassInfo *type = classes.getptr(p_class);
 	ClassInfo *check = type;
 	ERR_FAIL_COND(!check);
-	ERR_FAIL_COND(!check->method_map.has(p_method));
-	check->method_map[p_method]->set_hint_flags(p_flags);
+	MethodBind **method = check->method_map.lookup_ptr(p_method);
+	ERR_FAIL_COND(!method);
+	(*method)->set_hint_flags(p_flags);
 }
 
 bool ClassDB::has_method(StringName p_class, StringName p_method, bool p_no_inheritance) {
@@ -1214,7 +1209,8 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, const c
 	type->method_order.push_back(mdname);
 #endif
 
-	type->method_map[mdname] = p_bind;
+	type->method_map.insert(mdname, p_bind);
+	VariantCallCache::invalidate_all();
 
 	Vector<Variant> defvals;
 
@@ -1408,12 +1404,12 @@ void ClassDB::cleanup() {
 	while ((k = classes.next(k))) {
 		ClassInfo &ti = classes[*k];
 
-		const StringName *m = nullptr;
-		while ((m = ti.method_map.next(m))) {
-			memdelete(ti.method_map[*m]);
+		for (OAHashMap<StringName, MethodBind *>::Iterator it = ti.method_map.iter(); it.valid; it = ti.method_map.next_iter(it)) {
+			memdelete(*it.value);
 		}
 	}
 	classes.clear();
+	VariantCallCache::invalidate_all();
 	resource_base_extensions.clear();
 	compat_classes.clear();
 
@@ -32,6 +32,7 @@
 #define CLASS_DB_H
 
 #include "core/method_bind.h"
+#include "core/oa_hash_map.h"
 #include "core/object.h"
 #include "core/print_string.h"
 
@@ -115,7 +116,7 @@ public:
 		ClassInfo *inherits_ptr = nullptr;
 		void *class_ptr = nullptr;
 
-		HashMap<StringName, MethodBind *> method_map;
+		OAHashMap<StringName, MethodBind *> method_map;
 		HashMap<StringName, int> constant_map;
 		HashMap<StringName, List<StringName>> enum_map;
 		HashMap<StringName, MethodInfo> signal_map;
@@ -127,7 +128,7 @@ public:
 		List<MethodInfo> virtual_methods;
 		StringName category;
 #endif
-		HashMap<StringName, PropertySetGet> property_setget;
+		OAHashMap<StringName, PropertySetGet> property_setget;
 
 		StringName inherits;
 		StringName name;
@@ -135,7 +136,9 @@ public:
 		bool exposed = false;
 		Object *(*creation_func)() = nullptr;
 
-		ClassInfo() {}
+		ClassInfo() :
+				method_map(16),
+				property_setget(8) {}
 		~ClassInfo() {}
 	};
 
@@ -317,7 +320,8 @@ public:
 			// overloading not supported
 			ERR_FAIL_V_MSG(nullptr, "Method already bound: " + instance_type + "::" + p_name + ".");
 		}
-		type->method_map[p_name] = bind;
+		type->method_map.insert(p_name, bind);
+		VariantCallCache::invalidate_all();
 #ifdef DEBUG_METHODS_ENABLED
 		// FIXME: <reduz> set_return_type is no longer in MethodBind, so I guess it should be moved to vararg method bind
 		//bind->set_return_type("Variant");
@@ -46,27 +46,15 @@ void CommandQueueMT::wait_for_flush() {
 }
 
 CommandQueueMT::SyncSemaphore *CommandQueueMT::_alloc_sync_sem() {
-	int idx = -1;
-
 	while (true) {
-		lock();
 		for (int i = 0; i < SYNC_SEMAPHORES; i++) {
-			if (!sync_sems[i].in_use) {
-				sync_sems[i].in_use = true;
-				idx = i;
-				break;
+			if (!sync_sems[i].in_use.load(std::memory_order_relaxed) && !sync_sems[i].in_use.exchange(true, std::memory_order_acquire)) {
+				return &sync_sems[i];
 			}
 		}
-		unlock();
 
-		if (idx == -1) {
-			wait_for_flush();
-		} else {
-			break;
-		}
+		wait_for_flush();
 	}
-
-	return &sync_sems[idx];
 }
 
 bool CommandQueueMT::dealloc_one() {
@@ -76,7 +64,7 @@ tryagain:
 		return false;
 	}
 
-	uint32_t size = *(uint32_t *)&command_mem[dealloc_ptr];
+	uint32_t size = _get_header(dealloc_ptr)->load(std::memory_order_acquire);
 
 	if (size == 0) {
 		// End of command buffer wrap down
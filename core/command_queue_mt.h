@@ -37,6 +37,8 @@
 #include "core/simple_type.h"
 #include "core/typedefs.h"
 
+#include <atomic>
+
 #define COMMA(N) _COMMA_##N
 #define _COMMA_0
 #define _COMMA_1 ,
@@ -252,9 +254,7 @@
 		cmd->instance = p_instance;                                          \
 		cmd->method = p_method;                                              \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                 \
-		unlock();                                                            \
-		if (sync)                                                            \
-			sync->post();                                                    \
+		publish_and_unlock();                                                \
 	}
 
 #define CMD_RET_TYPE(N) CommandRet##N<T, M, COMMA_SEP_LIST(TYPE_ARG, N) COMMA(N) R>
@@ -269,11 +269,9 @@
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                                   \
 		cmd->ret = r_ret;                                                                      \
 		cmd->sync_sem = ss;                                                                    \
-		unlock();                                                                              \
-		if (sync)                                                                              \
-			sync->post();                                                                      \
+		publish_and_unlock();                                                                  \
 		ss->sem.wait();                                                                        \
-		ss->in_use = false;                                                                    \
+		ss->in_use.store(false, std::memory_order_release);                                    \
 	}
 
 #define CMD_SYNC_TYPE(N) CommandSync##N<T, M COMMA(N) COMMA_SEP_LIST(TYPE_ARG, N)>
@@ -287,11 +285,9 @@
 		cmd->method = p_method;                                                       \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                          \
 		cmd->sync_sem = ss;                                                           \
-		unlock();                                                                     \
-		if (sync)                                                                     \
-			sync->post();                                                             \
+		publish_and_unlock();                                                         \
 		ss->sem.wait();                                                               \
-		ss->in_use = false;                                                           \
+		ss->in_use.store(false, std::memory_order_release);                           \
 	}
 
 #define MAX_CMD_PARAMS 15
@@ -299,7 +295,7 @@
 class CommandQueueMT {
 	struct SyncSemaphore {
 		Semaphore sem;
-		bool in_use = false;
+		std::atomic<bool> in_use = { false };
 	};
 
 	struct CommandBase {
@@ -335,14 +331,38 @@ class CommandQueueMT {
 		SYNC_SEMAPHORES = 8
 	};
 
+	// The ring has a single consumer (the server thread, or the main thread
+	// when the server is not threaded) which never takes the mutex. Producers
+	// serialize on the mutex, which is uncontended in the common case of the
+	// main thread being the only one pushing, and make their commands visible
+	// by advancing published_ptr.
+
 	uint8_t *command_mem = (uint8_t *)memalloc(COMMAND_MEM_SIZE);
+
+	// Consumer side.
 	uint32_t read_ptr = 0;
+	uint32_t flushed_count = 0;
+
+	// Producer side, protected by the mutex.
 	uint32_t write_ptr = 0;
 	uint32_t dealloc_ptr = 0;
+
+	std::atomic<uint32_t> published_ptr = { 0 };
+	std::atomic<uint32_t> pushed_count = { 0 };
+	std::atomic<bool> consumer_sleeping = { false };
+
 	SyncSemaphore sync_sems[SYNC_SEMAPHORES];
 	Mutex mutex;
 	Semaphore *sync = nullptr;
 
+	// Every command is preceded by an 8 bytes header, its first word holds
+	// the size of the command shifted left by one, plus a bit telling whether
+	// the command is still in use. The consumer clears that bit once done,
+	// while the producer may be reading it concurrently in dealloc_one().
+	_FORCE_INLINE_ std::atomic<uint32_t> *_get_header(uint32_t p_pos) {
+		return reinterpret_cast<std::atomic<uint32_t> *>(&command_mem[p_pos]);
+	}
+
 	template <class T>
 	T *allocate() {
 		// alloc size is size+T+safeguard
@@ -377,9 +397,7 @@ class CommandQueueMT {
 				// if this happens, it's a bug
 				ERR_FAIL_COND_V((COMMAND_MEM_SIZE - write_ptr) < 8, nullptr);
 				// zero means, wrap to beginning
-
-				uint32_t *p = (uint32_t *)&command_mem[write_ptr];
-				*p = 0;
+				_get_header(write_ptr)->store(0, std::memory_order_relaxed);
 				write_ptr = 0;
 				goto tryagain;
 			}
@@ -388,8 +406,7 @@ class CommandQueueMT {
 		// First bit used to mark if command is still in use (1)
 		// or if it has been destroyed and can be deallocated (0).
 		uint32_t size = (sizeof(T) + 8 - 1) & ~(8 - 1);
-		uint32_t *p = (uint32_t *)&command_mem[write_ptr];
-		*p = (size << 1) | 1;
+		_get_header(write_ptr)->store((size << 1) | 1, std::memory_order_relaxed);
 		write_ptr += 8;
 		// allocate the command
 		T *cmd = memnew_placement(&command_mem[write_ptr], T);
@@ -412,22 +429,30 @@ class CommandQueueMT {
 		return ret;
 	}
 
-	bool flush_one(bool p_lock = true) {
-		if (p_lock) {
-			lock();
+	void publish_and_unlock() {
+		pushed_count.fetch_add(1, std::memory_order_relaxed);
+		// Sequentially consistent, so that either the consumer sees the new
+		// command before going to sleep, or we see it sleeping and wake it up.
+		published_ptr.store(write_ptr);
+		unlock();
+
+		// Only wake the consumer when it's actually waiting, commands pushed
+		// while it's busy get picked up by the batch it's flushing.
+		if (sync && consumer_sleeping.load() && consumer_sleeping.exchange(false)) {
+			sync->post();
 		}
+	}
+
+	bool flush_one() {
 	tryagain:
 
 		// tried to read an empty queue
-		if (read_ptr == write_ptr) {
-			if (p_lock) {
-				unlock();
-			}
+		if (read_ptr == published_ptr.load(std::memory_order_acquire)) {
 			return false;
 		}
 
 		uint32_t size_ptr = read_ptr;
-		uint32_t size = *(uint32_t *)&command_mem[read_ptr] >> 1;
+		uint32_t size = _get_header(read_ptr)->load(std::memory_order_relaxed) >> 1;
 
 		if (size == 0) {
 			//end of ringbuffer, wrap
@@ -440,22 +465,15 @@ class CommandQueueMT {
 		CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[read_ptr]);
 
 		read_ptr += size;
+		flushed_count++;
 
-		if (p_lock) {
-			unlock();
-		}
 		cmd->call();
-		if (p_lock) {
-			lock();
-		}
-
 		cmd->post();
 		cmd->~CommandBase();
-		*(uint32_t *)&command_mem[size_ptr] &= ~1;
 
-		if (p_lock) {
-			unlock();
-		}
+		// Hand the memory back to the producers.
+		_get_header(size_ptr)->store(size << 1, std::memory_order_release);
+
 		return true;
 	}
 
@@ -478,20 +496,34 @@ public:
 	DECL_PUSH_AND_SYNC(0)
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 15)
 
-	void wait_and_flush_one() {
+	// Waits until there is something in the queue, then flushes everything
+	// that has been pushed so far in one go.
+	void wait_and_flush() {
 		ERR_FAIL_COND(!sync);
-		sync->wait();
-		flush_one();
+
+		if (!flush_one()) {
+			consumer_sleeping.store(true);
+			if (read_ptr == published_ptr.load()) {
+				sync->wait();
+			}
+			consumer_sleeping.store(false);
+		}
+
+		while (flush_one()) {
+		}
 	}
 
 	void flush_all() {
-		//ERR_FAIL_COND(sync);
-		lock();
-		while (flush_one(false)) {
+		while (flush_one()) {
 		}
-		unlock();
 	}
 
+	// Amount of commands pushed so far, and amount of them the consumer
+	// has started executing. When they match, the consumer has seen
+	// everything and state cached by the last command is up to date.
+	uint32_t get_pushed_count() const { return pushed_count.load(std::memory_order_acquire); }
+	uint32_t get_flushed_count() const { return flushed_count; }
+
 	CommandQueueMT(bool p_sync);
 	~CommandQueueMT();
 };
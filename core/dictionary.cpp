@@ -30,82 +30,398 @@
 
 #include "dictionary.h"
 
-#include "core/ordered_hash_map.h"
+#include "core/hashfuncs.h"
+#include "core/local_vector.h"
 #include "core/safe_refcount.h"
 #include "core/variant.h"
 
+// Entries are stored inside blocks that never move once allocated, and no
+// entry is ever moved to another slot, so references returned by operator[]
+// and getptr() stay valid until their key is erased. Block 0 and block 1 hold
+// 4 entries each, and every following block doubles in size.
+//
+// Small dictionaries (the common case when used as lightweight structs) are
+// looked up with a linear scan that compares the cached hash before the key.
+// Past LINEAR_MAX entries, an open-addressing index (linear probing, kept at
+// most half full) maps hashes to entry indices.
+//
+// Insertion order is kept as a list linking the entries. Erased entries are
+// unlinked and their slots reused by later inserts, so a dictionary used as a
+// queue stays the size of its contents. An erased key keeps its link to the
+// entry that followed it, so it can still be passed to next() until the next
+// insert.
+
 struct DictionaryPrivate {
+	enum {
+		FIRST_BLOCK_SHIFT = 2,
+		FIRST_BLOCK_SIZE = 1 << FIRST_BLOCK_SHIFT,
+		LINEAR_MAX = 8,
+		MIN_INDEX_CAPACITY = 16,
+	};
+
+	static const uint32_t NONE = 0xFFFFFFFF;
+
+	struct Entry {
+		Variant key;
+		Variant value;
+		uint32_t hash;
+		uint32_t prev; // Previous in insertion order, or next free slot once erased.
+		uint32_t next; // Next in insertion order.
+		bool alive;
+	};
+
+	struct IndexSlot {
+		uint32_t hash;
+		uint32_t entry; // Entry index + 1, 0 when the slot is free.
+	};
+
 	SafeRefCount refcount;
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> variant_map;
-};
+	uint32_t used = 0; // Constructed entries, including erased ones.
+	uint32_t count = 0; // Live entries.
+	uint32_t head = NONE;
+	uint32_t tail = NONE;
+	uint32_t free_head = NONE; // Erased entries, chained through prev.
+	bool in_order = true; // No slot was reused, entries are stored in insertion order.
+	uint32_t index_mask = 0;
+	Entry *first_block = nullptr;
+	LocalVector<Entry *> blocks; // Blocks past the first one.
+	IndexSlot *index = nullptr;
+
+	static _FORCE_INLINE_ uint32_t _log2(uint32_t p_value) {
+#if defined(__GNUC__)
+		return 31 - __builtin_clz(p_value);
+#else
+		return nearest_shift(p_value) - 1;
+#endif
+	}
 
-void Dictionary::get_key_list(List<Variant> *p_keys) const {
-	if (_p->variant_map.empty()) {
-		return;
+	static _FORCE_INLINE_ uint32_t _block_size(uint32_t p_block) {
+		return p_block == 0 ? FIRST_BLOCK_SIZE : (FIRST_BLOCK_SIZE << (p_block - 1));
 	}
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		p_keys->push_back(E.key());
+	_FORCE_INLINE_ Entry &get_entry(uint32_t p_index) const {
+		if (p_index < FIRST_BLOCK_SIZE) {
+			return first_block[p_index];
+		}
+		uint32_t shift = _log2(p_index);
+		return blocks[shift - FIRST_BLOCK_SHIFT][p_index - (1 << shift)];
 	}
-}
 
-Variant Dictionary::get_key_at_index(int p_index) const {
-	int index = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		if (index == p_index) {
-			return E.key();
+	_FORCE_INLINE_ uint32_t capacity() const {
+		return first_block ? (FIRST_BLOCK_SIZE << blocks.size()) : 0;
+	}
+
+	int find(const Variant &p_key, uint32_t p_hash) const {
+		if (!index) {
+			for (uint32_t i = 0; i < used; i++) {
+				const Entry &e = get_entry(i);
+				if (e.hash == p_hash && e.alive && VariantComparator::compare(e.key, p_key)) {
+					return i;
+				}
+			}
+			return -1;
+		}
+
+		uint32_t pos = p_hash & index_mask;
+		while (true) {
+			const IndexSlot &slot = index[pos];
+			if (slot.entry == 0) {
+				return -1;
+			}
+			if (slot.hash == p_hash) {
+				const Entry &e = get_entry(slot.entry - 1);
+				if (e.alive && VariantComparator::compare(e.key, p_key)) {
+					return slot.entry - 1;
+				}
+			}
+			pos = (pos + 1) & index_mask;
 		}
-		index++;
 	}
 
-	return Variant();
-}
+	_FORCE_INLINE_ int find(const Variant &p_key) const {
+		return find(p_key, VariantHasher::hash(p_key));
+	}
 
-Variant Dictionary::get_value_at_index(int p_index) const {
-	int index = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		if (index == p_index) {
-			return E.value();
+	void _index_insert(uint32_t p_hash, uint32_t p_entry) {
+		uint32_t pos = p_hash & index_mask;
+		while (index[pos].entry != 0) {
+			pos = (pos + 1) & index_mask;
+		}
+		index[pos].hash = p_hash;
+		index[pos].entry = p_entry + 1;
+	}
+
+	// Removes the slot and shifts back the ones probed past it, so the index
+	// never holds stale slots.
+	void _index_erase(uint32_t p_hash, uint32_t p_entry) {
+		uint32_t hole = p_hash & index_mask;
+		while (index[hole].entry != p_entry + 1) {
+			hole = (hole + 1) & index_mask;
+		}
+		for (uint32_t pos = (hole + 1) & index_mask; index[pos].entry != 0; pos = (pos + 1) & index_mask) {
+			uint32_t home = index[pos].hash & index_mask;
+			if (((pos - home) & index_mask) >= ((pos - hole) & index_mask)) {
+				index[hole] = index[pos];
+				hole = pos;
+			}
+		}
+		index[hole].hash = 0;
+		index[hole].entry = 0;
+	}
+
+	void rebuild_index() {
+		if (index) {
+			memfree(index);
+			index = nullptr;
+			index_mask = 0;
 		}
-		index++;
+		if (used <= LINEAR_MAX) {
+			return;
+		}
+
+		uint32_t index_capacity = MAX((uint32_t)MIN_INDEX_CAPACITY, next_power_of_2(used * 2));
+		index = (IndexSlot *)memalloc(sizeof(IndexSlot) * index_capacity);
+		memset(index, 0, sizeof(IndexSlot) * index_capacity);
+		index_mask = index_capacity - 1;
+
+		for (uint32_t i = 0; i < used; i++) {
+			const Entry &e = get_entry(i);
+			if (e.alive) {
+				_index_insert(e.hash, i);
+			}
+		}
+	}
+
+	uint32_t insert(const Variant &p_key, uint32_t p_hash) {
+		uint32_t pos;
+		Entry *e;
+		bool reused = free_head != NONE;
+		if (reused) {
+			pos = free_head;
+			e = &get_entry(pos);
+			free_head = e->prev;
+			in_order = false;
+		} else {
+			if (used == capacity()) {
+				if (!first_block) {
+					first_block = (Entry *)memalloc(sizeof(Entry) * FIRST_BLOCK_SIZE);
+				} else {
+					CRASH_COND_MSG(blocks.size() >= 29, "Dictionary is too large.");
+					blocks.push_back((Entry *)memalloc(sizeof(Entry) * _block_size(blocks.size() + 1)));
+				}
+			}
+			pos = used;
+			e = memnew_placement(&get_entry(pos), Entry);
+			used++;
+		}
+
+		e->key = p_key;
+		e->hash = p_hash;
+		e->alive = true;
+		e->prev = tail;
+		e->next = NONE;
+		if (tail != NONE) {
+			get_entry(tail).next = pos;
+		} else {
+			head = pos;
+		}
+		tail = pos;
+		count++;
+
+		if (index && (reused || used * 2 <= index_mask + 1)) {
+			_index_insert(p_hash, pos);
+		} else if (used > LINEAR_MAX) {
+			rebuild_index();
+		}
+		return pos;
 	}
 
-	return Variant();
+	bool erase(const Variant &p_key) {
+		int pos = find(p_key);
+		if (pos < 0) {
+			return false;
+		}
+
+		if (count == 1) {
+			reset();
+			return true;
+		}
+
+		Entry &e = get_entry(pos);
+		if (index) {
+			_index_erase(e.hash, pos);
+		}
+		if (e.prev != NONE) {
+			get_entry(e.prev).next = e.next;
+		} else {
+			head = e.next;
+		}
+		if (e.next != NONE) {
+			get_entry(e.next).prev = e.prev;
+		} else {
+			tail = e.prev;
+		}
+
+		// The next link is kept, so the erased key still works as a cursor.
+		e.alive = false;
+		e.key = Variant();
+		e.value = Variant();
+		e.prev = free_head;
+		free_head = pos;
+		count--;
+		return true;
+	}
+
+	static _FORCE_INLINE_ int _block_offset(const Entry *p_block, uint32_t p_size, const Variant *p_key) {
+		const uint8_t *from = (const uint8_t *)&p_block[0].key;
+		const uint8_t *ptr = (const uint8_t *)p_key;
+		if (ptr < from || ptr >= from + sizeof(Entry) * p_size) {
+			return -1;
+		}
+		uint32_t bytes = ptr - from;
+		return bytes % sizeof(Entry) == 0 ? int(bytes / sizeof(Entry)) : -1;
+	}
+
+	// Maps a key pointer back to its position without hashing.
+	int entry_index(const Variant *p_key) const {
+		if (!first_block) {
+			return -1;
+		}
+		int offset = _block_offset(first_block, FIRST_BLOCK_SIZE, p_key);
+		if (offset >= 0) {
+			return offset;
+		}
+		for (uint32_t i = 0; i < blocks.size(); i++) {
+			uint32_t block_size = _block_size(i + 1);
+			offset = _block_offset(blocks[i], block_size, p_key);
+			if (offset >= 0) {
+				return block_size + offset;
+			}
+		}
+		return -1;
+	}
+
+	// The live entry following p_pos in insertion order. p_pos may have been
+	// erased, then its successor at the time (or the one after) is used.
+	uint32_t next_alive(uint32_t p_pos) const {
+		uint32_t pos = get_entry(p_pos).next;
+		while (pos != NONE && !get_entry(pos).alive) {
+			pos = get_entry(pos).next;
+		}
+		return pos;
+	}
+
+	// Finds the entry holding the p_index-th live element.
+	int nth_alive(int p_index) const {
+		if (p_index < 0 || uint32_t(p_index) >= count) {
+			return -1;
+		}
+		if (in_order && used == count) {
+			return p_index;
+		}
+		uint32_t pos = head;
+		for (int i = 0; i < p_index; i++) {
+			pos = get_entry(pos).next;
+		}
+		return pos;
+	}
+
+	// Drops all entries but keeps the blocks around for reuse.
+	void reset() {
+		for (uint32_t i = 0; i < used; i++) {
+			get_entry(i).~Entry();
+		}
+		if (index) {
+			memfree(index);
+			index = nullptr;
+		}
+		index_mask = 0;
+		used = 0;
+		count = 0;
+		head = NONE;
+		tail = NONE;
+		free_head = NONE;
+		in_order = true;
+	}
+
+	void clear() {
+		reset();
+		if (first_block) {
+			memfree(first_block);
+			first_block = nullptr;
+		}
+		for (uint32_t i = 0; i < blocks.size(); i++) {
+			memfree(blocks[i]);
+		}
+		blocks.reset();
+	}
+
+	~DictionaryPrivate() {
+		clear();
+	}
+};
+
+void Dictionary::get_key_list(List<Variant> *p_keys) const {
+	for (uint32_t i = _p->head; i != DictionaryPrivate::NONE; i = _p->get_entry(i).next) {
+		const DictionaryPrivate::Entry &e = _p->get_entry(i);
+		p_keys->push_back(e.key);
+	}
+}
+
+Variant Dictionary::get_key_at_index(int p_index) const {
+	int pos = _p->nth_alive(p_index);
+	if (pos < 0) {
+		return Variant();
+	}
+	return _p->get_entry(pos).key;
+}
+
+Variant Dictionary::get_value_at_index(int p_index) const {
+	int pos = _p->nth_alive(p_index);
+	if (pos < 0) {
+		return Variant();
+	}
+	return _p->get_entry(pos).value;
 }
 
 Variant &Dictionary::operator[](const Variant &p_key) {
-	return _p->variant_map[p_key];
+	uint32_t hash = VariantHasher::hash(p_key);
+	int pos = _p->find(p_key, hash);
+	if (pos < 0) {
+		// consistent with Map behaviour
+		pos = _p->insert(p_key, hash);
+	}
+	return _p->get_entry(pos).value;
 }
 
 const Variant &Dictionary::operator[](const Variant &p_key) const {
-	return _p->variant_map[p_key];
+	int pos = _p->find(p_key);
+	CRASH_COND(pos < 0);
+	return _p->get_entry(pos).value;
 }
 
 const Variant *Dictionary::getptr(const Variant &p_key) const {
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::ConstElement E = ((const OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> *)&_p->variant_map)->find(p_key);
-
-	if (!E) {
+	int pos = _p->find(p_key);
+	if (pos < 0) {
 		return nullptr;
 	}
-	return &E.get();
+	return &_p->get_entry(pos).value;
 }
 
 Variant *Dictionary::getptr(const Variant &p_key) {
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.find(p_key);
-
-	if (!E) {
+	int pos = _p->find(p_key);
+	if (pos < 0) {
 		return nullptr;
 	}
-	return &E.get();
+	return &_p->get_entry(pos).value;
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::ConstElement E = ((const OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> *)&_p->variant_map)->find(p_key);
-
-	if (!E) {
+	int pos = _p->find(p_key);
+	if (pos < 0) {
 		return Variant();
 	}
-	return E.get();
+	return _p->get_entry(pos).value;
 }
 
 Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
@@ -118,15 +434,15 @@ Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
 }
 
 int Dictionary::size() const {
-	return _p->variant_map.size();
+	return _p->count;
 }
 
 bool Dictionary::empty() const {
-	return !_p->variant_map.size();
+	return !_p->count;
 }
 
 bool Dictionary::has(const Variant &p_key) const {
-	return _p->variant_map.has(p_key);
+	return _p->find(p_key) >= 0;
 }
 
 bool Dictionary::has_all(const Array &p_keys) const {
@@ -139,7 +455,7 @@ bool Dictionary::has_all(const Array &p_keys) const {
 }
 
 bool Dictionary::erase(const Variant &p_key) {
-	return _p->variant_map.erase(p_key);
+	return _p->erase(p_key);
 }
 
 bool Dictionary::operator==(const Dictionary &p_dictionary) const {
@@ -168,7 +484,7 @@ void Dictionary::_ref(const Dictionary &p_from) const {
 }
 
 void Dictionary::clear() {
-	_p->variant_map.clear();
+	_p->clear();
 }
 
 void Dictionary::_unref() const {
@@ -182,9 +498,10 @@ void Dictionary::_unref() const {
 uint32_t Dictionary::hash() const {
 	uint32_t h = hash_djb2_one_32(Variant::DICTIONARY);
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		h = hash_djb2_one_32(E.key().hash(), h);
-		h = hash_djb2_one_32(E.value().hash(), h);
+	for (uint32_t i = _p->head; i != DictionaryPrivate::NONE; i = _p->get_entry(i).next) {
+		const DictionaryPrivate::Entry &e = _p->get_entry(i);
+		h = hash_djb2_one_32(e.key.hash(), h);
+		h = hash_djb2_one_32(e.value.hash(), h);
 	}
 
 	return h;
@@ -192,16 +509,16 @@ uint32_t Dictionary::hash() const {
 
 Array Dictionary::keys() const {
 	Array varr;
-	if (_p->variant_map.empty()) {
+	if (!_p->count) {
 		return varr;
 	}
 
 	varr.resize(size());
 
-	int i = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		varr[i] = E.key();
-		i++;
+	int idx = 0;
+	for (uint32_t i = _p->head; i != DictionaryPrivate::NONE; i = _p->get_entry(i).next) {
+		const DictionaryPrivate::Entry &e = _p->get_entry(i);
+		varr[idx++] = e.key;
 	}
 
 	return varr;
@@ -209,42 +526,51 @@ Array Dictionary::keys() const {
 
 Array Dictionary::values() const {
 	Array varr;
-	if (_p->variant_map.empty()) {
+	if (!_p->count) {
 		return varr;
 	}
 
 	varr.resize(size());
 
-	int i = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		varr[i] = E.get();
-		i++;
+	int idx = 0;
+	for (uint32_t i = _p->head; i != DictionaryPrivate::NONE; i = _p->get_entry(i).next) {
+		const DictionaryPrivate::Entry &e = _p->get_entry(i);
+		varr[idx++] = e.value;
 	}
 
 	return varr;
 }
 
 const Variant *Dictionary::next(const Variant *p_key) const {
+	uint32_t pos;
 	if (p_key == nullptr) {
 		// caller wants to get the first element
-		if (_p->variant_map.front()) {
-			return &_p->variant_map.front().key();
+		pos = _p->head;
+	} else {
+		// Keys handed out by a previous call point into the entries, so their
+		// position can be recovered without a lookup.
+		int from = _p->entry_index(p_key);
+		if (from < 0 || uint32_t(from) >= _p->used) {
+			from = _p->find(*p_key);
 		}
-		return nullptr;
+		if (from < 0) {
+			return nullptr;
+		}
+		pos = _p->next_alive(from);
 	}
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.find(*p_key);
 
-	if (E && E.next()) {
-		return &E.next().key();
+	if (pos == DictionaryPrivate::NONE) {
+		return nullptr;
 	}
-	return nullptr;
+	return &_p->get_entry(pos).key;
 }
 
 Dictionary Dictionary::duplicate(bool p_deep) const {
 	Dictionary n;
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		n[E.key()] = p_deep ? E.value().duplicate(true) : E.value();
+	for (uint32_t i = _p->head; i != DictionaryPrivate::NONE; i = _p->get_entry(i).next) {
+		const DictionaryPrivate::Entry &e = _p->get_entry(i);
+		n._p->get_entry(n._p->insert(e.key, e.hash)).value = p_deep ? e.value.duplicate(true) : e.value;
 	}
 
 	return n;
@@ -255,7 +581,7 @@ void Dictionary::operator=(const Dictionary &p_dictionary) {
 }
 
 const void *Dictionary::id() const {
-	return _p->variant_map.id();
+	return _p;
 }
 
 Dictionary::Dictionary(const Dictionary &p_from) {
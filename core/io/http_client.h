@@ -146,6 +146,8 @@ public:
 	};
 
 private:
+	friend class HTTPServer;
+
 	static const char *_methods[METHOD_MAX];
 	static const int HOST_MIN_LEN = 4;
 
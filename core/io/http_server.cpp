@@ -0,0 +1,614 @@
+/*************************************************************************/
+/*  http_server.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "http_server.h"
+
+#include "core/os/os.h"
+
+String HTTPServerRequest::get_status_text(int p_code) {
+	switch (p_code) {
+		case 100:
+			return "Continue";
+		case 101:
+			return "Switching Protocols";
+		case 200:
+			return "OK";
+		case 201:
+			return "Created";
+		case 202:
+			return "Accepted";
+		case 204:
+			return "No Content";
+		case 206:
+			return "Partial Content";
+		case 301:
+			return "Moved Permanently";
+		case 302:
+			return "Found";
+		case 303:
+			return "See Other";
+		case 304:
+			return "Not Modified";
+		case 307:
+			return "Temporary Redirect";
+		case 308:
+			return "Permanent Redirect";
+		case 400:
+			return "Bad Request";
+		case 401:
+			return "Unauthorized";
+		case 403:
+			return "Forbidden";
+		case 404:
+			return "Not Found";
+		case 405:
+			return "Method Not Allowed";
+		case 408:
+			return "Request Timeout";
+		case 409:
+			return "Conflict";
+		case 411:
+			return "Length Required";
+		case 413:
+			return "Payload Too Large";
+		case 415:
+			return "Unsupported Media Type";
+		case 429:
+			return "Too Many Requests";
+		case 431:
+			return "Request Header Fields Too Large";
+		case 500:
+			return "Internal Server Error";
+		case 501:
+			return "Not Implemented";
+		case 502:
+			return "Bad Gateway";
+		case 503:
+			return "Service Unavailable";
+		case 505:
+			return "HTTP Version Not Supported";
+	}
+	return "Unknown";
+}
+
+bool HTTPServerRequest::has_header(const String &p_name) const {
+	return headers.has(p_name.to_lower());
+}
+
+String HTTPServerRequest::get_header(const String &p_name) const {
+	const Variant *v = headers.getptr(p_name.to_lower());
+	return v ? String(*v) : String();
+}
+
+void HTTPServerRequest::_append(const uint8_t *p_data, int p_size) {
+	if (p_size <= 0) {
+		return;
+	}
+	int ofs = output.size();
+	output.resize(ofs + p_size);
+	copymem(output.ptrw() + ofs, p_data, p_size);
+}
+
+void HTTPServerRequest::_append(const String &p_string) {
+	CharString cs = p_string.utf8();
+	_append((const uint8_t *)cs.get_data(), cs.length());
+}
+
+void HTTPServerRequest::_write_head(int p_code, const PackedStringArray &p_headers, int p_content_length) {
+	String head = (http_1_0 ? "HTTP/1.0 " : "HTTP/1.1 ") + itos(p_code) + " " + get_status_text(p_code) + "\r\n";
+	for (int i = 0; i < p_headers.size(); i++) {
+		head += p_headers[i] + "\r\n";
+	}
+	if (p_content_length >= 0) {
+		head += "Content-Length: " + itos(p_content_length) + "\r\n";
+	} else if (chunked) {
+		head += "Transfer-Encoding: chunked\r\n";
+	}
+	if (keep_alive) {
+		if (http_1_0) {
+			head += "Connection: keep-alive\r\n";
+		}
+	} else {
+		head += "Connection: close\r\n";
+	}
+	head += "\r\n";
+	_append(head);
+	responding = true;
+}
+
+Error HTTPServerRequest::respond(int p_code, const PackedByteArray &p_body, const PackedStringArray &p_headers) {
+	ERR_FAIL_COND_V_MSG(responding, ERR_ALREADY_IN_USE, "A response was already sent for this request.");
+	ERR_FAIL_COND_V(p_code < 100 || p_code > 999, ERR_INVALID_PARAMETER);
+
+	_write_head(p_code, p_headers, p_body.size());
+	if (method != HTTPClient::METHOD_HEAD) {
+		_append(p_body.ptr(), p_body.size());
+	}
+	finished = true;
+	return OK;
+}
+
+Error HTTPServerRequest::begin_chunked_response(int p_code, const PackedStringArray &p_headers) {
+	ERR_FAIL_COND_V_MSG(responding, ERR_ALREADY_IN_USE, "A response was already sent for this request.");
+	ERR_FAIL_COND_V(p_code < 100 || p_code > 999, ERR_INVALID_PARAMETER);
+
+	if (http_1_0) {
+		keep_alive = false; // No chunked encoding, the body ends with the connection.
+	} else {
+		chunked = true;
+	}
+	_write_head(p_code, p_headers, -1);
+	if (method == HTTPClient::METHOD_HEAD) {
+		finished = true;
+	}
+	return OK;
+}
+
+Error HTTPServerRequest::send_chunk(const PackedByteArray &p_data) {
+	ERR_FAIL_COND_V_MSG(!responding || finished, ERR_UNCONFIGURED, "No chunked response in progress.");
+
+	if (p_data.empty()) {
+		return OK; // An empty chunk would end the body.
+	}
+	if (chunked) {
+		_append(String::num_int64(p_data.size(), 16) + "\r\n");
+		_append(p_data.ptr(), p_data.size());
+		_append((const uint8_t *)"\r\n", 2);
+	} else {
+		_append(p_data.ptr(), p_data.size());
+	}
+	return OK;
+}
+
+Error HTTPServerRequest::finish_chunked_response() {
+	ERR_FAIL_COND_V_MSG(!responding || finished, ERR_UNCONFIGURED, "No chunked response in progress.");
+
+	if (chunked) {
+		_append((const uint8_t *)"0\r\n\r\n", 5);
+	}
+	finished = true;
+	return OK;
+}
+
+void HTTPServerRequest::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_method"), &HTTPServerRequest::get_method);
+	ClassDB::bind_method(D_METHOD("get_path"), &HTTPServerRequest::get_path);
+	ClassDB::bind_method(D_METHOD("get_query_string"), &HTTPServerRequest::get_query_string);
+	ClassDB::bind_method(D_METHOD("get_headers"), &HTTPServerRequest::get_headers);
+	ClassDB::bind_method(D_METHOD("has_header", "name"), &HTTPServerRequest::has_header);
+	ClassDB::bind_method(D_METHOD("get_header", "name"), &HTTPServerRequest::get_header);
+	ClassDB::bind_method(D_METHOD("get_body"), &HTTPServerRequest::get_body);
+	ClassDB::bind_method(D_METHOD("get_remote_address"), &HTTPServerRequest::get_remote_address);
+	ClassDB::bind_method(D_METHOD("get_remote_port"), &HTTPServerRequest::get_remote_port);
+
+	ClassDB::bind_method(D_METHOD("respond", "code", "body", "headers"), &HTTPServerRequest::respond, DEFVAL(PackedByteArray()), DEFVAL(PackedStringArray()));
+	ClassDB::bind_method(D_METHOD("begin_chunked_response", "code", "headers"), &HTTPServerRequest::begin_chunked_response, DEFVAL(PackedStringArray()));
+	ClassDB::bind_method(D_METHOD("send_chunk", "data"), &HTTPServerRequest::send_chunk);
+	ClassDB::bind_method(D_METHOD("finish_chunked_response"), &HTTPServerRequest::finish_chunked_response);
+	ClassDB::bind_method(D_METHOD("is_finished"), &HTTPServerRequest::is_finished);
+}
+
+Error HTTPServer::listen(int p_port, const IP_Address &p_bind_address) {
+	ERR_FAIL_COND_V(is_listening(), ERR_ALREADY_IN_USE);
+
+	Error err = server->listen(p_port, p_bind_address);
+	if (err != OK) {
+		return err;
+	}
+
+	if (poller.is_valid() && poller->add_socket(LISTEN_ID, server->get_socket(), NetSocket::POLL_TYPE_IN) != OK) {
+		poller.unref(); // Fall back to checking every socket on poll.
+	}
+	last_timeout_check = OS::get_singleton()->get_ticks_msec();
+	return OK;
+}
+
+bool HTTPServer::is_listening() const {
+	return server->is_listening();
+}
+
+void HTTPServer::stop() {
+	while (connections.size()) {
+		_close(connections.front()->key());
+	}
+	if (poller.is_valid()) {
+		poller->clear();
+	}
+	server->stop();
+}
+
+void HTTPServer::_accept() {
+	while (server->is_connection_available()) {
+		Ref<StreamPeerTCP> tcp = server->take_connection();
+		if (tcp.is_null()) {
+			break;
+		}
+
+		int id = ++last_connection_id;
+		if (id <= LISTEN_ID) {
+			last_connection_id = LISTEN_ID + 1; // Wrapped around.
+			id = last_connection_id;
+		}
+
+		Connection &c = connections[id];
+		c.tcp = tcp;
+		c.last_activity = OS::get_singleton()->get_ticks_msec();
+
+		if (poller.is_null() || poller->add_socket(id, tcp->get_socket(), NetSocket::POLL_TYPE_IN) != OK) {
+			poll_always.insert(id);
+		}
+	}
+}
+
+void HTTPServer::_read(int p_id) {
+	Map<int, Connection>::Element *E = connections.find(p_id);
+	ERR_FAIL_COND(!E);
+	Connection &c = E->get();
+
+	uint8_t buf[READ_CHUNK_SIZE];
+	while (true) {
+		int received = 0;
+		Error err = c.tcp->get_partial_data(buf, READ_CHUNK_SIZE, received);
+		if (err != OK) {
+			_close(p_id); // Closed by the client, or socket error.
+			return;
+		}
+		if (received == 0) {
+			break;
+		}
+		c.last_activity = OS::get_singleton()->get_ticks_msec();
+		if (!c.closing) {
+			int ofs = c.input.size();
+			c.input.resize(ofs + received);
+			copymem(c.input.ptrw() + ofs, buf, received);
+		}
+		if (received < READ_CHUNK_SIZE) {
+			break;
+		}
+	}
+
+	_parse(p_id);
+}
+
+void HTTPServer::_parse(int p_id) {
+	Map<int, Connection>::Element *E = connections.find(p_id);
+
+	// Several requests may be pipelined in the same read.
+	while (E && !E->get().closing) {
+		Connection &c = E->get();
+
+		if (c.pending.is_null()) {
+			const uint8_t *r = c.input.ptr();
+			const int size = c.input.size();
+			int header_size = -1;
+			for (int i = 0; i + 3 < size && i + 3 < MAX_HEADER_SIZE; i++) {
+				if (r[i] == '\r' && r[i + 1] == '\n' && r[i + 2] == '\r' && r[i + 3] == '\n') {
+					header_size = i + 4;
+					break;
+				}
+			}
+			if (header_size < 0) {
+				if (size >= MAX_HEADER_SIZE) {
+					_fail(p_id, 431);
+				}
+				return; // Wait for the rest of the headers.
+			}
+
+			String head;
+			head.parse_utf8((const char *)r, header_size - 4);
+			Vector<String> lines = head.split("\r\n");
+
+			Vector<String> request_line = lines[0].split(" ");
+			if (request_line.size() != 3) {
+				_fail(p_id, 400);
+				return;
+			}
+
+			Ref<HTTPServerRequest> req;
+			req.instance();
+
+			int method = 0;
+			while (method < HTTPClient::METHOD_MAX && request_line[0] != HTTPClient::_methods[method]) {
+				method++;
+			}
+			if (method == HTTPClient::METHOD_MAX) {
+				_fail(p_id, 501);
+				return;
+			}
+			req->method = (HTTPClient::Method)method;
+
+			if (request_line[2] == "HTTP/1.0") {
+				req->http_1_0 = true;
+			} else if (request_line[2] != "HTTP/1.1") {
+				_fail(p_id, 505);
+				return;
+			}
+
+			const String &target = request_line[1];
+			int query = target.find("?");
+			req->path = query < 0 ? target : target.substr(0, query);
+			req->query_string = query < 0 ? String() : target.substr(query + 1, target.length());
+
+			for (int i = 1; i < lines.size(); i++) {
+				int sep = lines[i].find(":");
+				if (sep <= 0) {
+					_fail(p_id, 400);
+					return;
+				}
+				String name = lines[i].substr(0, sep).strip_edges().to_lower();
+				String value = lines[i].substr(sep + 1, lines[i].length()).strip_edges();
+				if (req->headers.has(name)) {
+					value = String(req->headers[name]) + ", " + value; // Repeated headers are a list.
+				}
+				req->headers[name] = value;
+			}
+
+			String connection = req->get_header("connection").to_lower();
+			req->keep_alive = req->http_1_0 ? connection == "keep-alive" : connection != "close";
+
+			if (req->has_header("transfer-encoding")) {
+				_fail(p_id, 501); // Chunked request bodies are not supported.
+				return;
+			}
+
+			int body_size = 0;
+			if (req->has_header("content-length")) {
+				String length = req->get_header("content-length");
+				if (!length.is_valid_integer() || length.to_int() < 0) {
+					_fail(p_id, 400);
+					return;
+				}
+				body_size = length.to_int();
+				if (body_size > max_request_size) {
+					_fail(p_id, 413);
+					return;
+				}
+			}
+
+			req->body.resize(body_size);
+			req->remote_address = c.tcp->get_connected_host();
+			req->remote_port = c.tcp->get_connected_port();
+			c.pending = req;
+			c.pending_header_size = header_size;
+		}
+
+		const int body_size = c.pending->body.size();
+		const int consumed = c.pending_header_size + body_size;
+		if (c.input.size() < consumed) {
+			return; // Wait for the rest of the body.
+		}
+
+		Ref<HTTPServerRequest> req = c.pending;
+		if (body_size) {
+			copymem(req->body.ptrw(), c.input.ptr() + c.pending_header_size, body_size);
+		}
+		c.pending.unref();
+
+		// Keep the next pipelined requests, if any.
+		const int left = c.input.size() - consumed;
+		if (left) {
+			memmove(c.input.ptrw(), c.input.ptr() + consumed, left);
+		}
+		c.input.resize(left);
+
+		c.requests.push_back(req);
+		writing.insert(p_id);
+		if (!req->keep_alive) {
+			c.closing = true;
+		}
+
+		emit_signal("request_received", req);
+
+		E = connections.find(p_id); // The handler may have stopped the server.
+	}
+}
+
+void HTTPServer::_write(int p_id) {
+	Map<int, Connection>::Element *E = connections.find(p_id);
+	ERR_FAIL_COND(!E);
+	Connection &c = E->get();
+
+	while (c.requests.size()) {
+		Ref<HTTPServerRequest> req = c.requests.front()->get();
+
+		const int left = req->output.size() - c.write_ofs;
+		if (left > 0) {
+			int sent = 0;
+			Error err = c.tcp->put_partial_data(req->output.ptr() + c.write_ofs, left, sent);
+			if (err != OK) {
+				_close(p_id);
+				return;
+			}
+			c.write_ofs += sent;
+			c.last_activity = OS::get_singleton()->get_ticks_msec();
+			if (sent < left) {
+				return; // Socket buffer is full, continue on the next poll.
+			}
+		}
+
+		if (!req->finished) {
+			// Not responded yet, or still streaming chunks: later requests wait.
+			req->output.clear();
+			c.write_ofs = 0;
+			return;
+		}
+
+		c.requests.pop_front();
+		c.write_ofs = 0;
+		if (!req->keep_alive) {
+			_close(p_id);
+			return;
+		}
+	}
+
+	writing.erase(p_id);
+}
+
+void HTTPServer::_fail(int p_id, int p_code) {
+	Map<int, Connection>::Element *E = connections.find(p_id);
+	ERR_FAIL_COND(!E);
+	Connection &c = E->get();
+
+	Ref<HTTPServerRequest> req;
+	req.instance();
+	req->keep_alive = false;
+	CharString text = HTTPServerRequest::get_status_text(p_code).utf8();
+	PackedByteArray body;
+	body.resize(text.length());
+	copymem(body.ptrw(), text.get_data(), text.length());
+	req->respond(p_code, body, PackedStringArray());
+
+	c.pending.unref();
+	c.input.clear();
+	c.closing = true;
+	c.requests.push_back(req);
+	writing.insert(p_id);
+}
+
+void HTTPServer::_close(int p_id) {
+	Map<int, Connection>::Element *E = connections.find(p_id);
+	ERR_FAIL_COND(!E);
+
+	if (poller.is_valid() && !poll_always.has(p_id)) {
+		poller->remove_socket(p_id);
+	}
+	E->get().tcp->disconnect_from_host();
+	connections.erase(E);
+	writing.erase(p_id);
+	poll_always.erase(p_id);
+}
+
+void HTTPServer::poll() {
+	if (!is_listening()) {
+		return;
+	}
+
+	// Request handlers may stop the server, so work on snapshots of the ids and
+	// bail out once it stopped.
+	if (poller.is_valid()) {
+		poller->wait(poll_events, 0);
+		for (uint32_t i = 0; i < poll_events.size() && is_listening(); i++) {
+			const int id = poll_events[i].id;
+			if (id == LISTEN_ID) {
+				_accept();
+			} else if (connections.has(id)) {
+				_read(id);
+			}
+		}
+	} else {
+		_accept();
+	}
+
+	LocalVector<int> ids;
+	for (Set<int>::Element *E = poll_always.front(); E; E = E->next()) {
+		ids.push_back(E->get());
+	}
+	for (uint32_t i = 0; i < ids.size() && is_listening(); i++) {
+		if (connections.has(ids[i])) {
+			_read(ids[i]);
+		}
+	}
+
+	// Send what was responded since the last poll, in request order.
+	ids.clear();
+	for (Set<int>::Element *E = writing.front(); E; E = E->next()) {
+		ids.push_back(E->get());
+	}
+	for (uint32_t i = 0; i < ids.size() && is_listening(); i++) {
+		if (writing.has(ids[i])) {
+			_write(ids[i]);
+		}
+	}
+
+	if (!is_listening()) {
+		return;
+	}
+
+	// Close idle connections, checked once per second.
+	uint64_t now = OS::get_singleton()->get_ticks_msec();
+	if (keep_alive_timeout > 0 && now - last_timeout_check > 1000) {
+		last_timeout_check = now;
+		Map<int, Connection>::Element *C = connections.front();
+		while (C) {
+			Map<int, Connection>::Element *N = C->next();
+			if (C->get().requests.empty() && now - C->get().last_activity > (uint64_t)keep_alive_timeout * 1000) {
+				_close(C->key());
+			}
+			C = N;
+		}
+	}
+}
+
+int HTTPServer::get_connection_count() const {
+	return connections.size();
+}
+
+void HTTPServer::set_keep_alive_timeout(int p_seconds) {
+	keep_alive_timeout = p_seconds;
+}
+
+int HTTPServer::get_keep_alive_timeout() const {
+	return keep_alive_timeout;
+}
+
+void HTTPServer::set_max_request_size(int p_bytes) {
+	ERR_FAIL_COND(p_bytes < 0);
+	max_request_size = p_bytes;
+}
+
+int HTTPServer::get_max_request_size() const {
+	return max_request_size;
+}
+
+void HTTPServer::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("listen", "port", "bind_address"), &HTTPServer::listen, DEFVAL("*"));
+	ClassDB::bind_method(D_METHOD("is_listening"), &HTTPServer::is_listening);
+	ClassDB::bind_method(D_METHOD("stop"), &HTTPServer::stop);
+	ClassDB::bind_method(D_METHOD("poll"), &HTTPServer::poll);
+	ClassDB::bind_method(D_METHOD("get_connection_count"), &HTTPServer::get_connection_count);
+	ClassDB::bind_method(D_METHOD("set_keep_alive_timeout", "seconds"), &HTTPServer::set_keep_alive_timeout);
+	ClassDB::bind_method(D_METHOD("get_keep_alive_timeout"), &HTTPServer::get_keep_alive_timeout);
+	ClassDB::bind_method(D_METHOD("set_max_request_size", "bytes"), &HTTPServer::set_max_request_size);
+	ClassDB::bind_method(D_METHOD("get_max_request_size"), &HTTPServer::get_max_request_size);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "keep_alive_timeout"), "set_keep_alive_timeout", "get_keep_alive_timeout");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_request_size"), "set_max_request_size", "get_max_request_size");
+
+	ADD_SIGNAL(MethodInfo("request_received", PropertyInfo(Variant::OBJECT, "request", PROPERTY_HINT_RESOURCE_TYPE, "HTTPServerRequest")));
+}
+
+HTTPServer::HTTPServer() {
+	server.instance();
+	poller = Ref<NetSocketPoller>(NetSocketPoller::create());
+}
+
+HTTPServer::~HTTPServer() {
+	stop();
+}
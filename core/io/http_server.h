@@ -0,0 +1,153 @@
+/*************************************************************************/
+/*  http_server.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef HTTP_SERVER_H
+#define HTTP_SERVER_H
+
+#include "core/io/http_client.h"
+#include "core/io/net_socket.h"
+#include "core/io/tcp_server.h"
+#include "core/list.h"
+#include "core/local_vector.h"
+#include "core/reference.h"
+
+class HTTPServerRequest : public Reference {
+	GDCLASS(HTTPServerRequest, Reference);
+
+	friend class HTTPServer;
+
+	HTTPClient::Method method = HTTPClient::METHOD_GET;
+	String path;
+	String query_string;
+	Dictionary headers; // Lowercase names.
+	Vector<uint8_t> body;
+	IP_Address remote_address;
+	int remote_port = 0;
+	bool http_1_0 = false;
+	bool keep_alive = true;
+
+	// Response, written by the server in request order.
+	Vector<uint8_t> output;
+	bool responding = false;
+	bool chunked = false;
+	bool finished = false;
+
+	void _append(const uint8_t *p_data, int p_size);
+	void _append(const String &p_string);
+	void _write_head(int p_code, const PackedStringArray &p_headers, int p_content_length);
+
+protected:
+	static void _bind_methods();
+
+public:
+	HTTPClient::Method get_method() const { return method; }
+	String get_path() const { return path; }
+	String get_query_string() const { return query_string; }
+	Dictionary get_headers() const { return headers; }
+	bool has_header(const String &p_name) const;
+	String get_header(const String &p_name) const;
+	PackedByteArray get_body() const { return body; }
+	String get_remote_address() const { return remote_address; }
+	int get_remote_port() const { return remote_port; }
+
+	Error respond(int p_code, const PackedByteArray &p_body = PackedByteArray(), const PackedStringArray &p_headers = PackedStringArray());
+	Error begin_chunked_response(int p_code, const PackedStringArray &p_headers = PackedStringArray());
+	Error send_chunk(const PackedByteArray &p_data);
+	Error finish_chunked_response();
+	bool is_finished() const { return finished; }
+
+	static String get_status_text(int p_code);
+
+	HTTPServerRequest() {}
+};
+
+// Non-blocking HTTP/1.1 server. Connections are only serviced when their
+// socket is ready (see NetSocketPoller), requests can be pipelined, and the
+// responses are always sent in request order.
+class HTTPServer : public Reference {
+	GDCLASS(HTTPServer, Reference);
+
+	enum {
+		LISTEN_ID = 0,
+		MAX_HEADER_SIZE = 8192,
+		READ_CHUNK_SIZE = 4096,
+	};
+
+	struct Connection {
+		Ref<StreamPeerTCP> tcp;
+		Vector<uint8_t> input;
+		Ref<HTTPServerRequest> pending; // Parsed, waiting for its body.
+		int pending_header_size = 0;
+		List<Ref<HTTPServerRequest>> requests; // In flight, oldest first.
+		int write_ofs = 0; // In the output of the oldest request.
+		uint64_t last_activity = 0;
+		bool closing = false; // No more requests are accepted.
+	};
+
+	Ref<TCP_Server> server;
+	Ref<NetSocketPoller> poller;
+	LocalVector<NetSocketPoller::Event> poll_events;
+	Map<int, Connection> connections;
+	Set<int> writing; // Connections with requests in flight.
+	Set<int> poll_always; // Connections the poller could not take.
+	int last_connection_id = 0;
+	uint64_t last_timeout_check = 0;
+
+	int keep_alive_timeout = 15;
+	int max_request_size = 1 << 20;
+
+	void _accept();
+	void _read(int p_id);
+	void _parse(int p_id);
+	void _write(int p_id);
+	void _close(int p_id);
+	void _fail(int p_id, int p_code);
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error listen(int p_port, const IP_Address &p_bind_address = IP_Address("*"));
+	bool is_listening() const;
+	void stop();
+	void poll();
+
+	int get_connection_count() const;
+
+	void set_keep_alive_timeout(int p_seconds);
+	int get_keep_alive_timeout() const;
+	void set_max_request_size(int p_bytes);
+	int get_max_request_size() const;
+
+	HTTPServer();
+	~HTTPServer();
+};
+
+#endif // HTTP_SERVER_H
@@ -30,6 +30,7 @@
 
 #include "json.h"
 
+#include "core/os/file_access.h"
 #include "core/print_string.h"
 
 const char *JSON::tk_name[TK_MAX] = {
@@ -453,3 +454,740 @@ Error JSON::parse(const String &p_json, Variant &r_ret, String &r_err_str, int &
 
 	return err;
 }
+
+Error JSON::parse_utf8(const uint8_t *p_data, int p_size, Variant &r_ret, String &r_err_str, int &r_err_line) {
+	JSONVariantBuilder builder;
+	JSONReader reader(&builder);
+
+	Error err = reader.feed(p_data, p_size);
+	if (err == OK) {
+		err = reader.finish();
+	}
+	if (err != OK) {
+		r_err_str = reader.get_error_message();
+		r_err_line = reader.get_error_line();
+		return err;
+	}
+
+	r_ret = builder.get_result();
+	return OK;
+}
+
+Error JSON::parse_file(FileAccess *p_file, Variant &r_ret, String &r_err_str, int &r_err_line) {
+	JSONVariantBuilder builder;
+	JSONReader reader(&builder);
+
+	Error err = reader.parse_file(p_file);
+	if (err != OK) {
+		r_err_str = reader.get_error_message();
+		r_err_line = reader.get_error_line();
+		return err;
+	}
+
+	r_ret = builder.get_result();
+	return OK;
+}
+
+Error JSON::print_to_file(const Variant &p_var, FileAccess *p_file, const String &p_indent, bool p_sort_keys) {
+	ERR_FAIL_NULL_V(p_file, ERR_INVALID_PARAMETER);
+
+	JSONWriter writer(p_file, p_indent, p_sort_keys);
+	writer.write_variant(p_var);
+	return writer.flush();
+}
+
+/* JSONReader */
+
+Error JSONReader::_fail(const String &p_error) {
+	error = p_error;
+	return ERR_PARSE_ERROR;
+}
+
+void JSONReader::_append(const uint8_t *p_data, int p_size) {
+	if (p_size <= 0) {
+		return;
+	}
+	_flush_surrogate();
+	uint32_t ofs = token.size();
+	token.resize(ofs + p_size);
+	copymem(&token[ofs], p_data, p_size);
+}
+
+void JSONReader::_flush_surrogate() {
+	if (surrogate) {
+		surrogate = 0;
+		_append_codepoint(0xFFFD); // Unpaired surrogate.
+	}
+}
+
+void JSONReader::_append_codepoint(uint32_t p_codepoint) {
+	if (p_codepoint >= 0xD800 && p_codepoint <= 0xDBFF) {
+		_flush_surrogate();
+		surrogate = p_codepoint;
+		return;
+	}
+	if (p_codepoint >= 0xDC00 && p_codepoint <= 0xDFFF) {
+		if (!surrogate) {
+			p_codepoint = 0xFFFD;
+		} else {
+			p_codepoint = 0x10000 + ((surrogate - 0xD800) << 10) + (p_codepoint - 0xDC00);
+			surrogate = 0;
+		}
+	} else {
+		_flush_surrogate();
+	}
+
+	if (p_codepoint < 0x80) {
+		token.push_back(p_codepoint);
+	} else if (p_codepoint < 0x800) {
+		token.push_back(0xC0 | (p_codepoint >> 6));
+		token.push_back(0x80 | (p_codepoint & 0x3F));
+	} else if (p_codepoint < 0x10000) {
+		token.push_back(0xE0 | (p_codepoint >> 12));
+		token.push_back(0x80 | ((p_codepoint >> 6) & 0x3F));
+		token.push_back(0x80 | (p_codepoint & 0x3F));
+	} else {
+		token.push_back(0xF0 | (p_codepoint >> 18));
+		token.push_back(0x80 | ((p_codepoint >> 12) & 0x3F));
+		token.push_back(0x80 | ((p_codepoint >> 6) & 0x3F));
+		token.push_back(0x80 | (p_codepoint & 0x3F));
+	}
+}
+
+void JSONReader::_end_value() {
+	state = containers.empty() ? STATE_DONE : STATE_COMMA_OR_END;
+}
+
+Error JSONReader::_end_string(const char *p_utf8, int p_len) {
+	lexing = LEX_NONE;
+
+	Error err;
+	if (state == STATE_KEY || state == STATE_KEY_OR_END) {
+		err = handler->key(p_utf8, p_len);
+		state = STATE_COLON;
+	} else {
+		err = handler->string_value(p_utf8, p_len);
+		_end_value();
+	}
+	token.clear();
+	return err;
+}
+
+Error JSONReader::_end_number() {
+	lexing = LEX_NONE;
+	token.push_back(0);
+	double number = String::to_double(&token[0]);
+	token.clear();
+	_end_value();
+	return handler->number_value(number);
+}
+
+Error JSONReader::_end_literal() {
+	lexing = LEX_NONE;
+	String id;
+	id.parse_utf8(&token[0], token.size());
+	token.clear();
+	_end_value();
+
+	if (id == "true") {
+		return handler->bool_value(true);
+	} else if (id == "false") {
+		return handler->bool_value(false);
+	} else if (id == "null") {
+		return handler->null_value();
+	}
+	return _fail("Expected 'true','false' or 'null', got '" + id + "'.");
+}
+
+Error JSONReader::feed(const uint8_t *p_data, int p_size) {
+	ERR_FAIL_COND_V_MSG(!error.empty(), ERR_PARSE_ERROR, "Parsing already failed, call reset() first.");
+
+	Error err = OK;
+	int i = 0;
+	while (i < p_size && err == OK) {
+		switch (lexing) {
+			case LEX_STRING: {
+				// Copy runs of plain characters at once, strings without escapes
+				// that fit in the current input aren't copied at all.
+				const int start = i;
+				while (i < p_size && p_data[i] != '"' && p_data[i] != '\\') {
+					if (p_data[i] == '\n') {
+						line++;
+					}
+					i++;
+				}
+				if (i == p_size) {
+					_append(p_data + start, i - start);
+				} else if (p_data[i] == '"') {
+					if (token.empty() && !surrogate) {
+						err = _end_string((const char *)p_data + start, i - start);
+					} else {
+						_append(p_data + start, i - start);
+						_flush_surrogate();
+						err = _end_string(&token[0], token.size());
+					}
+					i++;
+				} else {
+					_append(p_data + start, i - start);
+					lexing = LEX_ESCAPE;
+					i++;
+				}
+			} break;
+			case LEX_ESCAPE: {
+				const uint8_t next = p_data[i++];
+				lexing = LEX_STRING;
+				switch (next) {
+					case 'b':
+						_append_codepoint(8);
+						break;
+					case 't':
+						_append_codepoint(9);
+						break;
+					case 'n':
+						_append_codepoint(10);
+						break;
+					case 'f':
+						_append_codepoint(12);
+						break;
+					case 'r':
+						_append_codepoint(13);
+						break;
+					case 'u':
+						lexing = LEX_UNICODE;
+						escape = 0;
+						escape_digits = 0;
+						break;
+					default:
+						_append_codepoint(next);
+				}
+			} break;
+			case LEX_UNICODE: {
+				const uint8_t c = p_data[i++];
+				uint32_t v;
+				if (c >= '0' && c <= '9') {
+					v = c - '0';
+				} else if (c >= 'a' && c <= 'f') {
+					v = c - 'a' + 10;
+				} else if (c >= 'A' && c <= 'F') {
+					v = c - 'A' + 10;
+				} else {
+					err = _fail("Malformed hex constant in string");
+					break;
+				}
+				escape = (escape << 4) | v;
+				if (++escape_digits == 4) {
+					_append_codepoint(escape);
+					lexing = LEX_STRING;
+				}
+			} break;
+			case LEX_NUMBER: {
+				const int start = i;
+				while (i < p_size && ((p_data[i] >= '0' && p_data[i] <= '9') || p_data[i] == '-' || p_data[i] == '+' || p_data[i] == '.' || p_data[i] == 'e' || p_data[i] == 'E')) {
+					i++;
+				}
+				_append(p_data + start, i - start);
+				if (i < p_size) {
+					err = _end_number();
+				}
+			} break;
+			case LEX_LITERAL: {
+				const int start = i;
+				while (i < p_size && ((p_data[i] >= 'A' && p_data[i] <= 'Z') || (p_data[i] >= 'a' && p_data[i] <= 'z'))) {
+					i++;
+				}
+				_append(p_data + start, i - start);
+				if (i < p_size) {
+					err = _end_literal();
+				}
+			} break;
+			case LEX_NONE: {
+				const uint8_t c = p_data[i];
+				if (c <= 32) {
+					if (c == '\n') {
+						line++;
+					}
+					i++;
+					break;
+				}
+
+				const bool value_allowed = state == STATE_VALUE || state == STATE_VALUE_OR_END;
+				const bool in_object = !containers.empty() && containers[containers.size() - 1] == '{';
+
+				if (state == STATE_DONE) {
+					err = _fail("Expected EOF.");
+				} else if (c == '{' || c == '[') {
+					if (!value_allowed) {
+						err = _fail("Expected value.");
+						break;
+					}
+					containers.push_back(c);
+					state = c == '{' ? STATE_KEY_OR_END : STATE_VALUE_OR_END;
+					err = c == '{' ? handler->begin_object() : handler->begin_array();
+					i++;
+				} else if (c == '}' || c == ']') {
+					const bool matches = (c == '}') == in_object && !containers.empty();
+					if (!matches || !(state == STATE_COMMA_OR_END || state == (c == '}' ? STATE_KEY_OR_END : STATE_VALUE_OR_END))) {
+						err = _fail(c == '}' ? "Expected '}' or ','" : "Expected ']' or ','");
+						break;
+					}
+					containers.resize(containers.size() - 1);
+					_end_value();
+					err = c == '}' ? handler->end_object() : handler->end_array();
+					i++;
+				} else if (c == ':') {
+					if (state != STATE_COLON) {
+						err = _fail("Unexpected ':'");
+						break;
+					}
+					state = STATE_VALUE;
+					i++;
+				} else if (c == ',') {
+					if (state != STATE_COMMA_OR_END) {
+						err = _fail("Unexpected ','");
+						break;
+					}
+					state = in_object ? STATE_KEY : STATE_VALUE;
+					i++;
+				} else if (c == '"') {
+					if (!value_allowed && state != STATE_KEY && state != STATE_KEY_OR_END) {
+						err = _fail(state == STATE_COLON ? "Expected ':'" : "Expected ','");
+						break;
+					}
+					lexing = LEX_STRING;
+					token.clear();
+					i++;
+				} else if (state == STATE_KEY || state == STATE_KEY_OR_END) {
+					err = _fail("Expected key");
+				} else if (!value_allowed) {
+					err = _fail(state == STATE_COLON ? "Expected ':'" : "Expected ','");
+				} else if (c == '-' || (c >= '0' && c <= '9')) {
+					lexing = LEX_NUMBER;
+					token.clear();
+				} else if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) {
+					lexing = LEX_LITERAL;
+					token.clear();
+				} else {
+					err = _fail("Unexpected character.");
+				}
+			} break;
+		}
+	}
+
+	if (err != OK && error.empty()) {
+		error = "Parsing stopped by the handler.";
+	}
+	return err;
+}
+
+Error JSONReader::finish() {
+	ERR_FAIL_COND_V_MSG(!error.empty(), ERR_PARSE_ERROR, "Parsing already failed, call reset() first.");
+
+	Error err = OK;
+	if (lexing == LEX_NUMBER) {
+		err = _end_number();
+	} else if (lexing == LEX_LITERAL) {
+		err = _end_literal();
+	} else if (lexing != LEX_NONE) {
+		return _fail("Unterminated String");
+	}
+
+	if (err != OK) {
+		if (error.empty()) {
+			error = "Parsing stopped by the handler.";
+		}
+		return err;
+	}
+	if (state != STATE_DONE) {
+		return _fail("Unexpected EOF.");
+	}
+	return OK;
+}
+
+Error JSONReader::parse_file(FileAccess *p_file) {
+	ERR_FAIL_NULL_V(p_file, ERR_INVALID_PARAMETER);
+
+	LocalVector<uint8_t> chunk;
+	chunk.resize(FILE_CHUNK_SIZE);
+	while (true) {
+		int read = p_file->get_buffer(&chunk[0], FILE_CHUNK_SIZE);
+		if (read <= 0) {
+			break;
+		}
+		Error err = feed(&chunk[0], read);
+		if (err != OK) {
+			return err;
+		}
+		if (read < FILE_CHUNK_SIZE) {
+			break;
+		}
+	}
+	return finish();
+}
+
+void JSONReader::reset() {
+	containers.clear();
+	token.clear();
+	state = STATE_VALUE;
+	lexing = LEX_NONE;
+	surrogate = 0;
+	line = 1;
+	error = String();
+}
+
+JSONReader::JSONReader(JSONHandler *p_handler) {
+	handler = p_handler;
+}
+
+/* JSONVariantBuilder */
+
+void JSONVariantBuilder::_add(const Variant &p_value) {
+	if (stack.empty()) {
+		result = p_value;
+		return;
+	}
+	Frame &frame = stack[stack.size() - 1];
+	if (frame.is_object) {
+		frame.object[frame.key] = p_value;
+	} else {
+		frame.array.push_back(p_value);
+	}
+}
+
+Error JSONVariantBuilder::begin_object() {
+	// Containers are shared, so they can be added to the parent right away.
+	Frame frame;
+	frame.is_object = true;
+	_add(frame.object);
+	stack.push_back(frame);
+	return OK;
+}
+
+Error JSONVariantBuilder::end_object() {
+	stack.resize(stack.size() - 1);
+	return OK;
+}
+
+Error JSONVariantBuilder::begin_array() {
+	Frame frame;
+	_add(frame.array);
+	stack.push_back(frame);
+	return OK;
+}
+
+Error JSONVariantBuilder::end_array() {
+	stack.resize(stack.size() - 1);
+	return OK;
+}
+
+Error JSONVariantBuilder::key(const char *p_utf8, int p_len) {
+	String &key = stack[stack.size() - 1].key;
+
+	bool ascii = p_len <= MAX_CACHED_KEY_SIZE;
+	for (int i = 0; ascii && i < p_len; i++) {
+		ascii = (uint8_t)p_utf8[i] < 0x80;
+	}
+	if (!ascii) {
+		key.parse_utf8(p_utf8, p_len);
+		return OK;
+	}
+
+	const uint32_t hash = hash_djb2_buffer((const uint8_t *)p_utf8, p_len);
+	String *cached = key_cache.getptr(hash);
+	if (cached && cached->length() == p_len) {
+		const CharType *c = cached->ptr();
+		int i = 0;
+		while (i < p_len && c[i] == (CharType)p_utf8[i]) {
+			i++;
+		}
+		if (i == p_len) {
+			key = *cached;
+			return OK;
+		}
+	}
+
+	key.parse_utf8(p_utf8, p_len);
+	if (!cached) {
+		key_cache[hash] = key;
+	}
+	return OK;
+}
+
+Error JSONVariantBuilder::string_value(const char *p_utf8, int p_len) {
+	String s;
+	s.parse_utf8(p_utf8, p_len);
+	_add(s);
+	return OK;
+}
+
+Error JSONVariantBuilder::number_value(double p_value) {
+	_add(p_value);
+	return OK;
+}
+
+Error JSONVariantBuilder::bool_value(bool p_value) {
+	_add(p_value);
+	return OK;
+}
+
+Error JSONVariantBuilder::null_value() {
+	_add(Variant());
+	return OK;
+}
+
+void JSONVariantBuilder::clear() {
+	stack.clear();
+	key_cache.clear();
+	result = Variant();
+}
+
+/* JSONWriter */
+
+void JSONWriter::_write(const char *p_data, int p_size) {
+	uint32_t ofs = buffer.size();
+	buffer.resize(ofs + p_size);
+	copymem(&buffer[ofs], p_data, p_size);
+
+	if (file && buffer.size() >= FLUSH_SIZE) {
+		flush();
+	}
+}
+
+void JSONWriter::_write(const String &p_string) {
+	CharString cs = p_string.utf8();
+	_write(cs.get_data(), cs.length());
+}
+
+void JSONWriter::_write_quoted(const String &p_string) {
+	CharString cs = p_string.utf8();
+	const char *str = cs.get_data();
+	const int len = cs.length();
+
+	_write("\"", 1);
+	int start = 0;
+	for (int i = 0; i < len; i++) {
+		const uint8_t c = str[i];
+		if (c >= 0x20 && c != '"' && c != '\\') {
+			continue;
+		}
+		_write(str + start, i - start);
+		start = i + 1;
+		switch (c) {
+			case '"':
+				_write("\\\"", 2);
+				break;
+			case '\\':
+				_write("\\\\", 2);
+				break;
+			case '\b':
+				_write("\\b", 2);
+				break;
+			case '\f':
+				_write("\\f", 2);
+				break;
+			case '\n':
+				_write("\\n", 2);
+				break;
+			case '\r':
+				_write("\\r", 2);
+				break;
+			case '\t':
+				_write("\\t", 2);
+				break;
+			default: {
+				static const char *hex = "0123456789abcdef";
+				char esc[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+				_write(esc, 6);
+			}
+		}
+	}
+	_write(str + start, len - start);
+	_write("\"", 1);
+}
+
+void JSONWriter::_newline() {
+	if (indent.length() == 0) {
+		return;
+	}
+	_write("\n", 1);
+	for (uint32_t i = 0; i < containers.size(); i++) {
+		_write(indent.get_data(), indent.length());
+	}
+}
+
+void JSONWriter::_begin_value() {
+	if (after_key) {
+		after_key = false;
+		return;
+	}
+	ERR_FAIL_COND_MSG(!containers.empty() && containers[containers.size() - 1], "Expected a key before the value.");
+	if (!containers.empty()) {
+		if (!first) {
+			_write(",", 1);
+		}
+		_newline();
+	}
+	first = false;
+}
+
+void JSONWriter::begin_object() {
+	_begin_value();
+	_write("{", 1);
+	containers.push_back(true);
+	first = true;
+}
+
+void JSONWriter::end_object() {
+	ERR_FAIL_COND(containers.empty() || !containers[containers.size() - 1] || after_key);
+	containers.resize(containers.size() - 1);
+	if (!first) {
+		_newline();
+	}
+	_write("}", 1);
+	first = false;
+}
+
+void JSONWriter::begin_array() {
+	_begin_value();
+	_write("[", 1);
+	containers.push_back(false);
+	first = true;
+}
+
+void JSONWriter::end_array() {
+	ERR_FAIL_COND(containers.empty() || containers[containers.size() - 1]);
+	containers.resize(containers.size() - 1);
+	if (!first) {
+		_newline();
+	}
+	_write("]", 1);
+	first = false;
+}
+
+void JSONWriter::write_key(const String &p_key) {
+	ERR_FAIL_COND(containers.empty() || !containers[containers.size() - 1] || after_key);
+	if (!first) {
+		_write(",", 1);
+	}
+	_newline();
+	_write_quoted(p_key);
+	if (indent.length()) {
+		_write(": ", 2);
+	} else {
+		_write(":", 1);
+	}
+	first = false;
+	after_key = true;
+}
+
+void JSONWriter::write_string(const String &p_value) {
+	_begin_value();
+	_write_quoted(p_value);
+}
+
+void JSONWriter::write_number(double p_value) {
+	_begin_value();
+	_write(rtos(p_value));
+}
+
+void JSONWriter::write_int(int64_t p_value) {
+	_begin_value();
+
+	char buf[21];
+	int pos = sizeof(buf);
+	uint64_t v = p_value < 0 ? -(uint64_t)p_value : p_value;
+	do {
+		buf[--pos] = '0' + (v % 10);
+		v /= 10;
+	} while (v);
+	if (p_value < 0) {
+		buf[--pos] = '-';
+	}
+	_write(buf + pos, sizeof(buf) - pos);
+}
+
+void JSONWriter::write_bool(bool p_value) {
+	_begin_value();
+	if (p_value) {
+		_write("true", 4);
+	} else {
+		_write("false", 5);
+	}
+}
+
+void JSONWriter::write_null() {
+	_begin_value();
+	_write("null", 4);
+}
+
+void JSONWriter::write_variant(const Variant &p_var) {
+	switch (p_var.get_type()) {
+		case Variant::NIL:
+			write_null();
+			break;
+		case Variant::BOOL:
+			write_bool(p_var);
+			break;
+		case Variant::INT:
+			write_int(p_var);
+			break;
+		case Variant::FLOAT:
+			write_number(p_var);
+			break;
+		case Variant::PACKED_INT32_ARRAY:
+		case Variant::PACKED_INT64_ARRAY:
+		case Variant::PACKED_FLOAT32_ARRAY:
+		case Variant::PACKED_FLOAT64_ARRAY:
+		case Variant::PACKED_STRING_ARRAY:
+		case Variant::ARRAY: {
+			Array a = p_var;
+			begin_array();
+			for (int i = 0; i < a.size(); i++) {
+				write_variant(a[i]);
+			}
+			end_array();
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary d = p_var;
+			List<Variant> keys;
+			d.get_key_list(&keys);
+
+			if (sort_keys) {
+				keys.sort();
+			}
+
+			begin_object();
+			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+				write_key(E->get());
+				write_variant(d[E->get()]);
+			}
+			end_object();
+		} break;
+		default:
+			write_string(p_var);
+	}
+}
+
+Error JSONWriter::flush() {
+	if (!file) {
+		return OK;
+	}
+	if (buffer.size()) {
+		file->store_buffer(&buffer[0], buffer.size());
+		buffer.clear();
+	}
+	return file->get_error();
+}
+
+String JSONWriter::get_string() const {
+	String s;
+	if (buffer.size()) {
+		s.parse_utf8((const char *)&buffer[0], buffer.size());
+	}
+	return s;
+}
+
+JSONWriter::JSONWriter(FileAccess *p_file, const String &p_indent, bool p_sort_keys) {
+	file = p_file;
+	indent = p_indent.utf8();
+	sort_keys = p_sort_keys;
+}
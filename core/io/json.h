@@ -31,8 +31,12 @@
 #ifndef JSON_H
 #define JSON_H
 
+#include "core/hash_map.h"
+#include "core/local_vector.h"
 #include "core/variant.h"
 
+class FileAccess;
+
 class JSON {
 	enum TokenType {
 		TK_CURLY_BRACKET_OPEN,
@@ -73,6 +77,163 @@ class JSON {
 public:
 	static String print(const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true);
 	static Error parse(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line);
+
+	// Streaming variants, working on UTF-8 without converting the whole input or output.
+	static Error parse_utf8(const uint8_t *p_data, int p_size, Variant &r_ret, String &r_err_str, int &r_err_line);
+	static Error parse_file(FileAccess *p_file, Variant &r_ret, String &r_err_str, int &r_err_line);
+	static Error print_to_file(const Variant &p_var, FileAccess *p_file, const String &p_indent = "", bool p_sort_keys = true);
+};
+
+// Receives the events of a JSONReader, in document order. Strings and keys
+// are UTF-8, not null-terminated, and only valid during the call.
+// Returning an error stops the parsing.
+class JSONHandler {
+public:
+	virtual Error begin_object() = 0;
+	virtual Error end_object() = 0;
+	virtual Error begin_array() = 0;
+	virtual Error end_array() = 0;
+	virtual Error key(const char *p_utf8, int p_len) = 0;
+	virtual Error string_value(const char *p_utf8, int p_len) = 0;
+	virtual Error number_value(double p_value) = 0;
+	virtual Error bool_value(bool p_value) = 0;
+	virtual Error null_value() = 0;
+
+	virtual ~JSONHandler() {}
+};
+
+// Incremental JSON tokenizer. Input is fed in pieces of any size, so files
+// can be parsed with a fixed amount of memory. Nesting is tracked with an
+// explicit stack, deep documents can't overflow the call stack.
+class JSONReader {
+	enum State {
+		STATE_VALUE,
+		STATE_VALUE_OR_END, // After '['.
+		STATE_KEY,
+		STATE_KEY_OR_END, // After '{'.
+		STATE_COLON,
+		STATE_COMMA_OR_END,
+		STATE_DONE,
+	};
+
+	enum Lexing {
+		LEX_NONE,
+		LEX_STRING,
+		LEX_ESCAPE,
+		LEX_UNICODE,
+		LEX_NUMBER,
+		LEX_LITERAL,
+	};
+
+	enum {
+		FILE_CHUNK_SIZE = 65536,
+	};
+
+	JSONHandler *handler;
+	LocalVector<uint8_t> containers; // '{' or '['.
+	State state = STATE_VALUE;
+	Lexing lexing = LEX_NONE;
+	LocalVector<char> token; // Part of the current token that was copied.
+	uint32_t escape = 0;
+	int escape_digits = 0;
+	uint32_t surrogate = 0;
+	int line = 1;
+	String error;
+
+	Error _fail(const String &p_error);
+	void _append(const uint8_t *p_data, int p_size);
+	void _append_codepoint(uint32_t p_codepoint);
+	void _flush_surrogate();
+	void _end_value();
+	Error _end_string(const char *p_utf8, int p_len);
+	Error _end_number();
+	Error _end_literal();
+
+public:
+	Error feed(const uint8_t *p_data, int p_size);
+	Error finish();
+	Error parse_file(FileAccess *p_file);
+	void reset();
+
+	String get_error_message() const { return error; }
+	int get_error_line() const { return line; }
+
+	JSONReader(JSONHandler *p_handler);
+};
+
+// Builds the same Variant as JSON::parse. Repeated short keys share the
+// same String, which saves a lot of memory on large arrays of objects.
+class JSONVariantBuilder : public JSONHandler {
+	enum {
+		MAX_CACHED_KEY_SIZE = 64,
+	};
+
+	struct Frame {
+		Dictionary object;
+		Array array;
+		bool is_object = false;
+		String key;
+	};
+
+	LocalVector<Frame> stack;
+	HashMap<uint32_t, String> key_cache;
+	Variant result;
+
+	void _add(const Variant &p_value);
+
+public:
+	virtual Error begin_object();
+	virtual Error end_object();
+	virtual Error begin_array();
+	virtual Error end_array();
+	virtual Error key(const char *p_utf8, int p_len);
+	virtual Error string_value(const char *p_utf8, int p_len);
+	virtual Error number_value(double p_value);
+	virtual Error bool_value(bool p_value);
+	virtual Error null_value();
+
+	const Variant &get_result() const { return result; }
+	void clear();
+};
+
+// Writes JSON as UTF-8, either to a file in buffered blocks or to memory.
+// Commas and indentation are handled automatically.
+class JSONWriter {
+	enum {
+		FLUSH_SIZE = 65536,
+	};
+
+	FileAccess *file;
+	LocalVector<uint8_t> buffer;
+	CharString indent;
+	bool sort_keys;
+	LocalVector<bool> containers; // true for objects.
+	bool first = true; // No value written yet in the current container.
+	bool after_key = false;
+
+	void _write(const char *p_data, int p_size);
+	void _write(const String &p_string);
+	void _write_quoted(const String &p_string);
+	void _begin_value();
+	void _newline();
+
+public:
+	void begin_object();
+	void end_object();
+	void begin_array();
+	void end_array();
+	void write_key(const String &p_key);
+	void write_string(const String &p_value);
+	void write_number(double p_value);
+	void write_int(int64_t p_value);
+	void write_bool(bool p_value);
+	void write_null();
+	void write_variant(const Variant &p_var);
+
+	Error flush();
+	String get_string() const; // When not writing to a file.
+
+	JSONWriter(FileAccess *p_file = nullptr, const String &p_indent = "", bool p_sort_keys = true);
 };
 
 #endif // JSON_H
@@ -623,9 +623,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const int*rbuf=(const int*)buf;
 				data.resize(count);
 				int32_t *w = data.ptrw();
+#ifndef BIG_ENDIAN_ENABLED
+				copymem(w, buf, count * 4);
+#else
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_uint32(&buf[i * 4]);
 				}
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -635,7 +639,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
 			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
-			int64_t count = decode_uint64(buf);
+			int32_t count = decode_uint32(buf);
 			buf += 4;
 			len -= 4;
 			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
@@ -647,9 +651,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const int*rbuf=(const int*)buf;
 				data.resize(count);
 				int64_t *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
+#ifndef BIG_ENDIAN_ENABLED
+				copymem(w, buf, count * 8);
+#else
+				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_uint64(&buf[i * 8]);
 				}
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -671,9 +679,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const float*rbuf=(const float*)buf;
 				data.resize(count);
 				float *w = data.ptrw();
+#ifndef BIG_ENDIAN_ENABLED
+				copymem(w, buf, count * 4);
+#else
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_float(&buf[i * 4]);
 				}
+#endif
 			}
 			r_variant = data;
 
@@ -684,7 +696,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 		} break;
 		case Variant::PACKED_FLOAT64_ARRAY: {
 			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
-			int64_t count = decode_uint64(buf);
+			int32_t count = decode_uint32(buf);
 			buf += 4;
 			len -= 4;
 			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
@@ -696,9 +708,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const double*rbuf=(const double*)buf;
 				data.resize(count);
 				double *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
+#ifndef BIG_ENDIAN_ENABLED
+				copymem(w, buf, count * 8);
+#else
+				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_double(&buf[i * 8]);
 				}
+#endif
 			}
 			r_variant = data;
 
@@ -751,10 +767,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				varray.resize(count);
 				Vector2 *w = varray.ptrw();
 
+#if !defined(BIG_ENDIAN_ENABLED) && !defined(REAL_T_IS_DOUBLE)
+				copymem(w, buf, count * 4 * 2);
+#else
 				for (int32_t i = 0; i < count; i++) {
 					w[i].x = decode_float(buf + i * 4 * 2 + 4 * 0);
 					w[i].y = decode_float(buf + i * 4 * 2 + 4 * 1);
 				}
+#endif
 
 				int adv = 4 * 2 * count;
 
@@ -785,11 +805,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				varray.resize(count);
 				Vector3 *w = varray.ptrw();
 
+#if !defined(BIG_ENDIAN_ENABLED) && !defined(REAL_T_IS_DOUBLE)
+				copymem(w, buf, count * 4 * 3);
+#else
 				for (int32_t i = 0; i < count; i++) {
 					w[i].x = decode_float(buf + i * 4 * 3 + 4 * 0);
 					w[i].y = decode_float(buf + i * 4 * 3 + 4 * 1);
 					w[i].z = decode_float(buf + i * 4 * 3 + 4 * 2);
 				}
+#endif
 
 				int adv = 4 * 3 * count;
 
@@ -820,12 +844,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				carray.resize(count);
 				Color *w = carray.ptrw();
 
+#ifndef BIG_ENDIAN_ENABLED
+				copymem(w, buf, count * 4 * 4);
+#else
 				for (int32_t i = 0; i < count; i++) {
 					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
 					w[i].g = decode_float(buf + i * 4 * 4 + 4 * 1);
 					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
 					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
 				}
+#endif
 
 				int adv = 4 * 4 * count;
 
@@ -845,30 +873,116 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 	return OK;
 }
 
-static void _encode_string(const String &p_string, uint8_t *&buf, int &r_len) {
-	CharString utf8 = p_string.utf8();
+// Writes the encoded data in a single pass, either to a fixed buffer the
+// caller already sized, to a Vector that grows as needed, or nowhere to only
+// compute the size. A Vector is never grown past max_size: once the data
+// would not fit, the writer stops writing and only counts.
+class _VariantWriter {
+	Vector<uint8_t> *vector = nullptr;
+	int max_size = 0;
+	uint8_t *w = nullptr;
+
+	_FORCE_INLINE_ uint8_t *_reserve(int p_size) {
+		if (vector && unlikely(pos + p_size > vector->size())) {
+			if (unlikely(pos + p_size > max_size)) {
+				vector = nullptr;
+				w = nullptr;
+				overflow = true;
+			} else {
+				vector->resize(MIN(next_power_of_2(MAX(pos + p_size, 64)), (uint32_t)max_size));
+				w = vector->ptrw();
+			}
+		}
+		uint8_t *ptr = w ? w + pos : nullptr;
+		pos += p_size;
+		return ptr;
+	}
 
-	if (buf) {
-		encode_uint32(utf8.length(), buf);
-		buf += 4;
-		copymem(buf, utf8.get_data(), utf8.length());
-		buf += utf8.length();
+public:
+	int pos = 0;
+	bool overflow = false;
+
+	_FORCE_INLINE_ void put_u32(uint32_t p_value) {
+		uint8_t *ptr = _reserve(4);
+		if (ptr) {
+			encode_uint32(p_value, ptr);
+		}
 	}
 
-	r_len += 4 + utf8.length();
-	while (r_len % 4) {
-		r_len++; //pad
-		if (buf) {
-			*(buf++) = 0;
+	_FORCE_INLINE_ void put_u64(uint64_t p_value) {
+		uint8_t *ptr = _reserve(8);
+		if (ptr) {
+			encode_uint64(p_value, ptr);
 		}
 	}
-}
 
-Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects) {
-	uint8_t *buf = r_buffer;
+	_FORCE_INLINE_ void put_float(float p_value) {
+		uint8_t *ptr = _reserve(4);
+		if (ptr) {
+			encode_float(p_value, ptr);
+		}
+	}
+
+	_FORCE_INLINE_ void put_double(double p_value) {
+		uint8_t *ptr = _reserve(8);
+		if (ptr) {
+			encode_double(p_value, ptr);
+		}
+	}
+
+	_FORCE_INLINE_ void put_data(const void *p_data, int p_size) {
+		uint8_t *ptr = _reserve(p_size);
+		if (ptr && p_size) {
+			copymem(ptr, p_data, p_size);
+		}
+	}
+
+	_FORCE_INLINE_ void pad() {
+		int pad = (4 - pos % 4) % 4;
+		uint8_t *ptr = _reserve(pad);
+		if (ptr) {
+			zeromem(ptr, pad);
+		}
+	}
 
-	r_len = 0;
+	_VariantWriter(uint8_t *p_buffer) {
+		w = p_buffer;
+	}
+
+	_VariantWriter(Vector<uint8_t> *p_vector, int p_max_size) {
+		vector = p_vector;
+		max_size = p_max_size;
+		w = vector->ptrw();
+	}
+};
+
+static void _encode_string(const String &p_string, _VariantWriter &w) {
+	CharString utf8 = p_string.utf8();
+	w.put_u32(utf8.length());
+	w.put_data(utf8.get_data(), utf8.length());
+	w.pad();
+}
 
+// Little-endian hosts store packed arrays in the wire format already.
+template <class T>
+static void _encode_packed_array(const Vector<T> &p_data, _VariantWriter &w) {
+	const int count = p_data.size();
+	const T *r = p_data.ptr();
+	w.put_u32(count);
+#ifndef BIG_ENDIAN_ENABLED
+	w.put_data(r, count * sizeof(T));
+#else
+	for (int i = 0; i < count; i++) {
+		if (sizeof(T) == 8) {
+			w.put_u64(*(const uint64_t *)&r[i]);
+		} else {
+			w.put_u32(*(const uint32_t *)&r[i]);
+		}
+	}
+#endif
+}
+
+static Error _encode_variant(const Variant &p_variant, _VariantWriter &w, bool p_full_objects) {
 	uint32_t flags = 0;
 
 	switch (p_variant.get_type()) {
@@ -890,10 +1004,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			Object *obj = p_variant.get_validated_object();
 			if (!obj) {
 				// Object is invalid, send a nullptr  instead.
-				if (buf) {
-					encode_uint32(Variant::NIL, buf);
-				}
-				r_len += 4;
+				w.put_u32(Variant::NIL);
 				return OK;
 			}
 
@@ -905,272 +1016,142 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		} // nothing to do at this stage
 	}
 
-	if (buf) {
-		encode_uint32(p_variant.get_type() | flags, buf);
-		buf += 4;
-	}
-	r_len += 4;
+	w.put_u32(p_variant.get_type() | flags);
 
 	switch (p_variant.get_type()) {
 		case Variant::NIL: {
 			//nothing to do
 		} break;
 		case Variant::BOOL: {
-			if (buf) {
-				encode_uint32(p_variant.operator bool(), buf);
-			}
-
-			r_len += 4;
-
+			w.put_u32(p_variant.operator bool());
 		} break;
 		case Variant::INT: {
 			if (flags & ENCODE_FLAG_64) {
-				//64 bits
-				if (buf) {
-					encode_uint64(p_variant.operator int64_t(), buf);
-				}
-
-				r_len += 8;
+				w.put_u64(p_variant.operator int64_t());
 			} else {
-				if (buf) {
-					encode_uint32(p_variant.operator int32_t(), buf);
-				}
-
-				r_len += 4;
+				w.put_u32(p_variant.operator int32_t());
 			}
 		} break;
 		case Variant::FLOAT: {
 			if (flags & ENCODE_FLAG_64) {
-				if (buf) {
-					encode_double(p_variant.operator double(), buf);
-				}
-
-				r_len += 8;
-
+				w.put_double(p_variant.operator double());
 			} else {
-				if (buf) {
-					encode_float(p_variant.operator float(), buf);
-				}
-
-				r_len += 4;
+				w.put_float(p_variant.operator float());
 			}
-
 		} break;
 		case Variant::NODE_PATH: {
 			NodePath np = p_variant;
-			if (buf) {
-				encode_uint32(uint32_t(np.get_name_count()) | 0x80000000, buf); //for compatibility with the old format
-				encode_uint32(np.get_subname_count(), buf + 4);
-				uint32_t np_flags = 0;
-				if (np.is_absolute()) {
-					np_flags |= 1;
-				}
-
-				encode_uint32(np_flags, buf + 8);
+			w.put_u32(uint32_t(np.get_name_count()) | 0x80000000); //for compatibility with the old format
+			w.put_u32(np.get_subname_count());
+			w.put_u32(np.is_absolute() ? 1 : 0);
 
-				buf += 12;
+			for (int i = 0; i < np.get_name_count(); i++) {
+				_encode_string(np.get_name(i), w);
 			}
-
-			r_len += 12;
-
-			int total = np.get_name_count() + np.get_subname_count();
-
-			for (int i = 0; i < total; i++) {
-				String str;
-
-				if (i < np.get_name_count()) {
-					str = np.get_name(i);
-				} else {
-					str = np.get_subname(i - np.get_name_count());
-				}
-
-				CharString utf8 = str.utf8();
-
-				int pad = 0;
-
-				if (utf8.length() % 4) {
-					pad = 4 - utf8.length() % 4;
-				}
-
-				if (buf) {
-					encode_uint32(utf8.length(), buf);
-					buf += 4;
-					copymem(buf, utf8.get_data(), utf8.length());
-					buf += pad + utf8.length();
-				}
-
-				r_len += 4 + utf8.length() + pad;
+			for (int i = 0; i < np.get_subname_count(); i++) {
+				_encode_string(np.get_subname(i), w);
 			}
-
-		} break;
-		case Variant::STRING: {
-			_encode_string(p_variant, buf, r_len);
-
 		} break;
+		case Variant::STRING:
 		case Variant::STRING_NAME: {
-			_encode_string(p_variant, buf, r_len);
-
+			_encode_string(p_variant, w);
 		} break;
 
 		// math types
 		case Variant::VECTOR2: {
-			if (buf) {
-				Vector2 v2 = p_variant;
-				encode_float(v2.x, &buf[0]);
-				encode_float(v2.y, &buf[4]);
-			}
-
-			r_len += 2 * 4;
-
+			Vector2 v2 = p_variant;
+			w.put_float(v2.x);
+			w.put_float(v2.y);
 		} break;
 		case Variant::VECTOR2I: {
-			if (buf) {
-				Vector2i v2 = p_variant;
-				encode_uint32(v2.x, &buf[0]);
-				encode_uint32(v2.y, &buf[4]);
-			}
-
-			r_len += 2 * 4;
-
+			Vector2i v2 = p_variant;
+			w.put_u32(v2.x);
+			w.put_u32(v2.y);
 		} break;
 		case Variant::RECT2: {
-			if (buf) {
-				Rect2 r2 = p_variant;
-				encode_float(r2.position.x, &buf[0]);
-				encode_float(r2.position.y, &buf[4]);
-				encode_float(r2.size.x, &buf[8]);
-				encode_float(r2.size.y, &buf[12]);
-			}
-			r_len += 4 * 4;
-
+			Rect2 r2 = p_variant;
+			w.put_float(r2.position.x);
+			w.put_float(r2.position.y);
+			w.put_float(r2.size.x);
+			w.put_float(r2.size.y);
 		} break;
 		case Variant::RECT2I: {
-			if (buf) {
-				Rect2i r2 = p_variant;
-				encode_uint32(r2.position.x, &buf[0]);
-				encode_uint32(r2.position.y, &buf[4]);
-				encode_uint32(r2.size.x, &buf[8]);
-				encode_uint32(r2.size.y, &buf[12]);
-			}
-			r_len += 4 * 4;
-
+			Rect2i r2 = p_variant;
+			w.put_u32(r2.position.x);
+			w.put_u32(r2.position.y);
+			w.put_u32(r2.size.x);
+			w.put_u32(r2.size.y);
 		} break;
 		case Variant::VECTOR3: {
-			if (buf) {
-				Vector3 v3 = p_variant;
-				encode_float(v3.x, &buf[0]);
-				encode_float(v3.y, &buf[4]);
-				encode_float(v3.z, &buf[8]);
-			}
-
-			r_len += 3 * 4;
-
+			Vector3 v3 = p_variant;
+			w.put_float(v3.x);
+			w.put_float(v3.y);
+			w.put_float(v3.z);
 		} break;
 		case Variant::VECTOR3I: {
-			if (buf) {
-				Vector3i v3 = p_variant;
-				encode_uint32(v3.x, &buf[0]);
-				encode_uint32(v3.y, &buf[4]);
-				encode_uint32(v3.z, &buf[8]);
-			}
-
-			r_len += 3 * 4;
-
+			Vector3i v3 = p_variant;
+			w.put_u32(v3.x);
+			w.put_u32(v3.y);
+			w.put_u32(v3.z);
 		} break;
 		case Variant::TRANSFORM2D: {
-			if (buf) {
-				Transform2D val = p_variant;
-				for (int i = 0; i < 3; i++) {
-					for (int j = 0; j < 2; j++) {
-						copymem(&buf[(i * 2 + j) * 4], &val.elements[i][j], sizeof(float));
-					}
+			Transform2D val = p_variant;
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 2; j++) {
+					w.put_float(val.elements[i][j]);
 				}
 			}
-
-			r_len += 6 * 4;
-
 		} break;
 		case Variant::PLANE: {
-			if (buf) {
-				Plane p = p_variant;
-				encode_float(p.normal.x, &buf[0]);
-				encode_float(p.normal.y, &buf[4]);
-				encode_float(p.normal.z, &buf[8]);
-				encode_float(p.d, &buf[12]);
-			}
-
-			r_len += 4 * 4;
-
+			Plane p = p_variant;
+			w.put_float(p.normal.x);
+			w.put_float(p.normal.y);
+			w.put_float(p.normal.z);
+			w.put_float(p.d);
 		} break;
 		case Variant::QUAT: {
-			if (buf) {
-				Quat q = p_variant;
-				encode_float(q.x, &buf[0]);
-				encode_float(q.y, &buf[4]);
-				encode_float(q.z, &buf[8]);
-				encode_float(q.w, &buf[12]);
-			}
-
-			r_len += 4 * 4;
-
+			Quat q = p_variant;
+			w.put_float(q.x);
+			w.put_float(q.y);
+			w.put_float(q.z);
+			w.put_float(q.w);
 		} break;
 		case Variant::AABB: {
-			if (buf) {
-				AABB aabb = p_variant;
-				encode_float(aabb.position.x, &buf[0]);
-				encode_float(aabb.position.y, &buf[4]);
-				encode_float(aabb.position.z, &buf[8]);
-				encode_float(aabb.size.x, &buf[12]);
-				encode_float(aabb.size.y, &buf[16]);
-				encode_float(aabb.size.z, &buf[20]);
-			}
-
-			r_len += 6 * 4;
-
+			AABB aabb = p_variant;
+			w.put_float(aabb.position.x);
+			w.put_float(aabb.position.y);
+			w.put_float(aabb.position.z);
+			w.put_float(aabb.size.x);
+			w.put_float(aabb.size.y);
+			w.put_float(aabb.size.z);
 		} break;
 		case Variant::BASIS: {
-			if (buf) {
-				Basis val = p_variant;
-				for (int i = 0; i < 3; i++) {
-					for (int j = 0; j < 3; j++) {
-						copymem(&buf[(i * 3 + j) * 4], &val.elements[i][j], sizeof(float));
-					}
+			Basis val = p_variant;
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					w.put_float(val.elements[i][j]);
 				}
 			}
-
-			r_len += 9 * 4;
-
 		} break;
 		case Variant::TRANSFORM: {
-			if (buf) {
-				Transform val = p_variant;
-				for (int i = 0; i < 3; i++) {
-					for (int j = 0; j < 3; j++) {
-						copymem(&buf[(i * 3 + j) * 4], &val.basis.elements[i][j], sizeof(float));
-					}
+			Transform val = p_variant;
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					w.put_float(val.basis.elements[i][j]);
 				}
-
-				encode_float(val.origin.x, &buf[36]);
-				encode_float(val.origin.y, &buf[40]);
-				encode_float(val.origin.z, &buf[44]);
 			}
-
-			r_len += 12 * 4;
-
+			w.put_float(val.origin.x);
+			w.put_float(val.origin.y);
+			w.put_float(val.origin.z);
 		} break;
 
 		// misc types
 		case Variant::COLOR: {
-			if (buf) {
-				Color c = p_variant;
-				encode_float(c.r, &buf[0]);
-				encode_float(c.g, &buf[4]);
-				encode_float(c.b, &buf[8]);
-				encode_float(c.a, &buf[12]);
-			}
-
-			r_len += 4 * 4;
-
+			Color c = p_variant;
+			w.put_float(c.r);
+			w.put_float(c.g);
+			w.put_float(c.b);
+			w.put_float(c.a);
 		} break;
 		case Variant::_RID: {
 		} break;
@@ -1182,13 +1163,10 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (p_full_objects) {
 				Object *obj = p_variant;
 				if (!obj) {
-					if (buf) {
-						encode_uint32(0, buf);
-					}
-					r_len += 4;
+					w.put_u32(0);
 
 				} else {
-					_encode_string(obj->get_class(), buf, r_len);
+					_encode_string(obj->get_class(), w);
 
 					List<PropertyInfo> props;
 					obj->get_property_list(&props);
@@ -1201,108 +1179,62 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 						pc++;
 					}
 
-					if (buf) {
-						encode_uint32(pc, buf);
-						buf += 4;
-					}
-
-					r_len += 4;
+					w.put_u32(pc);
 
 					for (List<PropertyInfo>::Element *E = props.front(); E; E = E->next()) {
 						if (!(E->get().usage & PROPERTY_USAGE_STORAGE)) {
 							continue;
 						}
 
-						_encode_string(E->get().name, buf, r_len);
+						_encode_string(E->get().name, w);
 
-						int len;
-						Error err = encode_variant(obj->get(E->get().name), buf, len, p_full_objects);
+						Error err = _encode_variant(obj->get(E->get().name), w, p_full_objects);
 						if (err) {
 							return err;
 						}
-						ERR_FAIL_COND_V(len % 4, ERR_BUG);
-						r_len += len;
-						if (buf) {
-							buf += len;
-						}
 					}
 				}
 			} else {
-				if (buf) {
-					Object *obj = p_variant.get_validated_object();
-					ObjectID id;
-					if (obj) {
-						id = obj->get_instance_id();
-					}
-
-					encode_uint64(id, buf);
+				Object *obj = p_variant.get_validated_object();
+				ObjectID id;
+				if (obj) {
+					id = obj->get_instance_id();
 				}
 
-				r_len += 8;
+				w.put_u64(id);
 			}
 
 		} break;
 		case Variant::DICTIONARY: {
 			Dictionary d = p_variant;
 
-			if (buf) {
-				encode_uint32(uint32_t(d.size()), buf);
-				buf += 4;
-			}
-			r_len += 4;
-
-			List<Variant> keys;
-			d.get_key_list(&keys);
-
-			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
-				/*
-				CharString utf8 = E->->utf8();
+			w.put_u32(uint32_t(d.size()));
 
-				if (buf) {
-					encode_uint32(utf8.length()+1,buf);
-					buf+=4;
-					copymem(buf,utf8.get_data(),utf8.length()+1);
-				}
-
-				r_len+=4+utf8.length()+1;
-				while (r_len%4)
-					r_len++; //pad
-				*/
-				int len;
-				encode_variant(E->get(), buf, len, p_full_objects);
-				ERR_FAIL_COND_V(len % 4, ERR_BUG);
-				r_len += len;
-				if (buf) {
-					buf += len;
+			// Walk the entries in place, no key list to build.
+			for (const Variant *K = d.next(); K; K = d.next(K)) {
+				Error err = _encode_variant(*K, w, p_full_objects);
+				if (err) {
+					return err;
 				}
-				Variant *v = d.getptr(E->get());
-				ERR_FAIL_COND_V(!v, ERR_BUG);
-				encode_variant(*v, buf, len, p_full_objects);
-				ERR_FAIL_COND_V(len % 4, ERR_BUG);
-				r_len += len;
-				if (buf) {
-					buf += len;
+				const Variant *V = d.getptr(*K);
+				ERR_FAIL_COND_V(!V, ERR_BUG);
+				err = _encode_variant(*V, w, p_full_objects);
+				if (err) {
+					return err;
 				}
 			}
 
 		} break;
 		case Variant::ARRAY: {
 			Array v = p_variant;
+			const int size = v.size();
 
-			if (buf) {
-				encode_uint32(uint32_t(v.size()), buf);
-				buf += 4;
-			}
-
-			r_len += 4;
+			w.put_u32(uint32_t(size));
 
-			for (int i = 0; i < v.size(); i++) {
-				int len;
-				encode_variant(v.get(i), buf, len, p_full_objects);
-				ERR_FAIL_COND_V(len % 4, ERR_BUG);
-				r_len += len;
-				if (buf) {
-					buf += len;
+			for (int i = 0; i < size; i++) {
+				Error err = _encode_variant(v[i], w, p_full_objects);
+				if (err) {
+					return err;
 				}
 			}
 
@@ -1310,198 +1242,86 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		// arrays
 		case Variant::PACKED_BYTE_ARRAY: {
 			Vector<uint8_t> data = p_variant;
-			int datalen = data.size();
-			int datasize = sizeof(uint8_t);
-
-			if (buf) {
-				encode_uint32(datalen, buf);
-				buf += 4;
-				const uint8_t *r = data.ptr();
-				copymem(buf, &r[0], datalen * datasize);
-				buf += datalen * datasize;
-			}
-
-			r_len += 4 + datalen * datasize;
-			while (r_len % 4) {
-				r_len++;
-				if (buf) {
-					*(buf++) = 0;
-				}
-			}
-
+			w.put_u32(data.size());
+			w.put_data(data.ptr(), data.size());
+			w.pad();
 		} break;
 		case Variant::PACKED_INT32_ARRAY: {
-			Vector<int32_t> data = p_variant;
-			int datalen = data.size();
-			int datasize = sizeof(int32_t);
-
-			if (buf) {
-				encode_uint32(datalen, buf);
-				buf += 4;
-				const int32_t *r = data.ptr();
-				for (int32_t i = 0; i < datalen; i++) {
-					encode_uint32(r[i], &buf[i * datasize]);
-				}
-			}
-
-			r_len += 4 + datalen * datasize;
-
+			_encode_packed_array<int32_t>(p_variant, w);
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
-			Vector<int64_t> data = p_variant;
-			int datalen = data.size();
-			int datasize = sizeof(int64_t);
-
-			if (buf) {
-				encode_uint64(datalen, buf);
-				buf += 4;
-				const int64_t *r = data.ptr();
-				for (int64_t i = 0; i < datalen; i++) {
-					encode_uint64(r[i], &buf[i * datasize]);
-				}
-			}
-
-			r_len += 4 + datalen * datasize;
-
+			_encode_packed_array<int64_t>(p_variant, w);
 		} break;
 		case Variant::PACKED_FLOAT32_ARRAY: {
-			Vector<float> data = p_variant;
-			int datalen = data.size();
-			int datasize = sizeof(float);
-
-			if (buf) {
-				encode_uint32(datalen, buf);
-				buf += 4;
-				const float *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_float(r[i], &buf[i * datasize]);
-				}
-			}
-
-			r_len += 4 + datalen * datasize;
-
+			_encode_packed_array<float>(p_variant, w);
 		} break;
 		case Variant::PACKED_FLOAT64_ARRAY: {
-			Vector<double> data = p_variant;
-			int datalen = data.size();
-			int datasize = sizeof(double);
-
-			if (buf) {
-				encode_uint32(datalen, buf);
-				buf += 4;
-				const double *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_double(r[i], &buf[i * datasize]);
-				}
-			}
-
-			r_len += 4 + datalen * datasize;
-
+			_encode_packed_array<double>(p_variant, w);
 		} break;
 		case Variant::PACKED_STRING_ARRAY: {
 			Vector<String> data = p_variant;
-			int len = data.size();
+			const int len = data.size();
+			const String *r = data.ptr();
 
-			if (buf) {
-				encode_uint32(len, buf);
-				buf += 4;
-			}
-
-			r_len += 4;
+			w.put_u32(len);
 
 			for (int i = 0; i < len; i++) {
-				CharString utf8 = data.get(i).utf8();
-
-				if (buf) {
-					encode_uint32(utf8.length() + 1, buf);
-					buf += 4;
-					copymem(buf, utf8.get_data(), utf8.length() + 1);
-					buf += utf8.length() + 1;
-				}
-
-				r_len += 4 + utf8.length() + 1;
-				while (r_len % 4) {
-					r_len++; //pad
-					if (buf) {
-						*(buf++) = 0;
-					}
-				}
+				CharString utf8 = r[i].utf8();
+				w.put_u32(utf8.length() + 1);
+				w.put_data(utf8.get_data(), utf8.length() + 1);
+				w.pad();
 			}
 
 		} break;
 		case Variant::PACKED_VECTOR2_ARRAY: {
 			Vector<Vector2> data = p_variant;
-			int len = data.size();
-
-			if (buf) {
-				encode_uint32(len, buf);
-				buf += 4;
-			}
-
-			r_len += 4;
-
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector2 v = data.get(i);
+			const int len = data.size();
+			const Vector2 *r = data.ptr();
 
-					encode_float(v.x, &buf[0]);
-					encode_float(v.y, &buf[4]);
-					buf += 4 * 2;
-				}
+			w.put_u32(len);
+#if !defined(BIG_ENDIAN_ENABLED) && !defined(REAL_T_IS_DOUBLE)
+			w.put_data(r, len * sizeof(Vector2));
+#else
+			for (int i = 0; i < len; i++) {
+				w.put_float(r[i].x);
+				w.put_float(r[i].y);
 			}
-
-			r_len += 4 * 2 * len;
+#endif
 
 		} break;
 		case Variant::PACKED_VECTOR3_ARRAY: {
 			Vector<Vector3> data = p_variant;
-			int len = data.size();
-
-			if (buf) {
-				encode_uint32(len, buf);
-				buf += 4;
-			}
-
-			r_len += 4;
+			const int len = data.size();
+			const Vector3 *r = data.ptr();
 
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector3 v = data.get(i);
-
-					encode_float(v.x, &buf[0]);
-					encode_float(v.y, &buf[4]);
-					encode_float(v.z, &buf[8]);
-					buf += 4 * 3;
-				}
+			w.put_u32(len);
+#if !defined(BIG_ENDIAN_ENABLED) && !defined(REAL_T_IS_DOUBLE)
+			w.put_data(r, len * sizeof(Vector3));
+#else
+			for (int i = 0; i < len; i++) {
+				w.put_float(r[i].x);
+				w.put_float(r[i].y);
+				w.put_float(r[i].z);
 			}
-
-			r_len += 4 * 3 * len;
+#endif
 
 		} break;
 		case Variant::PACKED_COLOR_ARRAY: {
 			Vector<Color> data = p_variant;
-			int len = data.size();
-
-			if (buf) {
-				encode_uint32(len, buf);
-				buf += 4;
-			}
+			const int len = data.size();
+			const Color *r = data.ptr();
 
-			r_len += 4;
-
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Color c = data.get(i);
-
-					encode_float(c.r, &buf[0]);
-					encode_float(c.g, &buf[4]);
-					encode_float(c.b, &buf[8]);
-					encode_float(c.a, &buf[12]);
-					buf += 4 * 4;
-				}
+			w.put_u32(len);
+#ifndef BIG_ENDIAN_ENABLED
+			w.put_data(r, len * sizeof(Color));
+#else
+			for (int i = 0; i < len; i++) {
+				w.put_float(r[i].r);
+				w.put_float(r[i].g);
+				w.put_float(r[i].b);
+				w.put_float(r[i].a);
 			}
-
-			r_len += 4 * 4 * len;
+#endif
 
 		} break;
 		default: {
@@ -1511,3 +1331,20 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 	return OK;
 }
+
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects) {
+	_VariantWriter w(r_buffer);
+	Error err = _encode_variant(p_variant, w, p_full_objects);
+	r_len = w.pos;
+	return err;
+}
+
+Error encode_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int &r_len, bool p_full_objects, int p_max_size) {
+	_VariantWriter w(&r_buffer, p_max_size < 0 ? INT_MAX : p_max_size);
+	Error err = _encode_variant(p_variant, w, p_full_objects);
+	r_len = w.pos;
+	if (err == OK && w.overflow) {
+		return ERR_OUT_OF_MEMORY;
+	}
+	return err;
+}
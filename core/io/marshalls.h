@@ -182,5 +182,10 @@ public:
 
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false);
+// Encodes in a single pass at the start of r_buffer, which is grown as needed
+// but never shrunk, so it can be reused. r_len is the size of the encoded data.
+// If it is larger than p_max_size (when not negative), r_buffer is not grown
+// past it and ERR_OUT_OF_MEMORY is returned.
+Error encode_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int &r_len, bool p_full_objects = false, int p_max_size = -1);
 
 #endif // MARSHALLS_H
@@ -32,6 +32,7 @@
 
 #include "core/debugger/engine_debugger.h"
 #include "core/io/marshalls.h"
+#include "core/os/os.h"
 #include "scene/main/node.h"
 
 #include <stdint.h>
@@ -39,10 +40,7 @@
 #define NODE_ID_COMPRESSION_SHIFT 3
 #define NAME_ID_COMPRESSION_SHIFT 5
 #define BYTE_ONLY_OR_NO_ARGS_SHIFT 6
-
-#ifdef DEBUG_ENABLED
-#include "core/os/os.h"
-#endif
+#define TYPED_ARGS_SHIFT 7
 
 _FORCE_INLINE_ bool _should_call_local(MultiplayerAPI::RPCMode mode, bool is_master, bool &r_skip_rpc) {
 	switch (mode) {
@@ -99,10 +97,26 @@ _FORCE_INLINE_ bool _can_call_mode(Node *p_node, MultiplayerAPI::RPCMode mode, i
 }
 
 void MultiplayerAPI::poll() {
+	if (interest.is_valid() && network_peer.is_valid()) {
+		interest->update();
+	}
+
+	if (threaded_io && network_peer.is_valid()) {
+		_flush_batches(); // Queued since the last poll.
+		if (!io_thread) {
+			_io_poll(); // No thread support, poll inline through the same queues.
+		}
+		_dispatch_io_events();
+		_replication_poll();
+		_flush_batches();
+		return;
+	}
+
 	if (!network_peer.is_valid() || network_peer->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED) {
 		return;
 	}
 
+	_flush_batches(); // Queued since the last poll, so they go out with this one.
 	network_peer->poll();
 
 	if (!network_peer.is_valid()) { // It's possible that polling might have resulted in a disconnection, so check here.
@@ -128,6 +142,221 @@ void MultiplayerAPI::poll() {
 			break; // It's also possible that a packet or RPC caused a disconnection, so also check here.
 		}
 	}
+
+	_replication_poll();
+	_flush_batches();
+}
+
+void MultiplayerAPI::_dispatch_io_events() {
+	Ref<NetworkedMultiplayerPeer> peer = network_peer;
+
+	// Connection changes seen by the I/O thread come first, so packets from a
+	// new peer are only processed once it was added.
+	network_peer->flush_queued_signals();
+	if (network_peer != peer) {
+		return; // The peer was changed by a signal, the packets are stale.
+	}
+
+	if (io_dispatching) {
+		return; // Polled from a callback, the front queue is still being read.
+	}
+	io_dispatching = true;
+
+	io_mutex.lock();
+	IOQueue &queue = io_in[io_in_back];
+	io_in_back = 1 - io_in_back;
+	io_mutex.unlock();
+
+	for (uint32_t i = 0; i < queue.messages.size(); i++) {
+		const IOMessage &msg = queue.messages[i];
+		rpc_sender_id = msg.peer;
+		_process_packet(msg.peer, queue.get_data(msg), msg.size);
+		rpc_sender_id = 0;
+
+		if (network_peer != peer) {
+			break; // The peer was changed while dispatching, the rest is stale.
+		}
+	}
+	queue.clear();
+	io_dispatching = false;
+}
+
+void MultiplayerAPI::IOQueue::push(int p_peer, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len) {
+	IOMessage msg;
+	msg.peer = p_peer;
+	msg.mode = p_mode;
+	msg.offset = data.size();
+	msg.size = p_len;
+	data.resize(msg.offset + p_len);
+	if (p_len) {
+		memcpy(&data[msg.offset], p_data, p_len);
+	}
+	messages.push_back(msg);
+}
+
+void MultiplayerAPI::_io_thread_func(void *p_ud) {
+	MultiplayerAPI *api = (MultiplayerAPI *)p_ud;
+	while (api->io_running) {
+		api->_io_poll();
+		api->network_peer->wait_for_packets(IO_THREAD_WAIT_MSEC);
+	}
+}
+
+void MultiplayerAPI::_io_send(const IOQueue &p_queue) {
+	for (uint32_t i = 0; i < p_queue.messages.size(); i++) {
+		const IOMessage &msg = p_queue.messages[i];
+		network_peer->set_target_peer(msg.peer);
+		network_peer->set_transfer_mode(msg.mode);
+		network_peer->put_packet(p_queue.get_data(msg), msg.size);
+	}
+}
+
+void MultiplayerAPI::_io_poll() {
+	io_mutex.lock();
+	IOQueue &out = io_out[io_out_back];
+	io_out_back = 1 - io_out_back;
+	io_mutex.unlock();
+
+	// Keep the peer locked across the calls that depend on each other (target,
+	// mode and packet; packet peer and packet).
+	network_peer->lock();
+
+	_io_send(out);
+	out.clear();
+
+	if (network_peer->get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED) {
+		// On the I/O thread, the peer queues its signals for _dispatch_io_events().
+		network_peer->poll();
+	}
+
+	// Copy packets out, the buffer returned by get_packet() is only valid until the next call.
+	io_mutex.lock();
+	IOQueue &in = io_in[io_in_back];
+	while (network_peer->get_available_packet_count()) {
+		int from = network_peer->get_packet_peer();
+		const uint8_t *packet;
+		int len;
+		Error err = network_peer->get_packet(&packet, len);
+		if (err != OK) {
+			ERR_PRINT("Error getting packet!");
+			break; // Something is wrong!
+		}
+		in.push(from, NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE, packet, len);
+	}
+
+	io_connection_status = network_peer->get_connection_status();
+	io_unique_id = network_peer->get_unique_id();
+	io_is_server = network_peer->is_server();
+	io_mutex.unlock();
+
+	network_peer->unlock();
+}
+
+void MultiplayerAPI::_io_start() {
+	ERR_FAIL_COND(io_thread || network_peer.is_null());
+
+	io_connection_status = network_peer->get_connection_status();
+	io_unique_id = network_peer->get_unique_id();
+	io_is_server = network_peer->is_server();
+#ifndef NO_THREADS
+	if (!network_peer->is_threaded_poll_supported()) {
+		return; // Polled inline from poll().
+	}
+	network_peer->set_signals_queued(true);
+	io_running = true;
+	io_thread = Thread::create(_io_thread_func, this);
+#endif
+}
+
+void MultiplayerAPI::_io_stop() {
+	if (!io_thread) {
+		return;
+	}
+
+	io_running = false;
+	Thread::wait_to_finish(io_thread);
+	memdelete(io_thread);
+	io_thread = nullptr;
+	network_peer->set_signals_queued(false);
+
+	// Send what is left, so switching modes does not drop outgoing packets.
+	IOQueue &out = io_out[io_out_back];
+	_io_send(out);
+	out.clear();
+}
+
+void MultiplayerAPI::_connect_peer_signals() {
+	network_peer->connect("peer_connected", callable_mp(this, &MultiplayerAPI::_add_peer));
+	network_peer->connect("peer_disconnected", callable_mp(this, &MultiplayerAPI::_del_peer));
+	network_peer->connect("connection_succeeded", callable_mp(this, &MultiplayerAPI::_connected_to_server));
+	network_peer->connect("connection_failed", callable_mp(this, &MultiplayerAPI::_connection_failed));
+	network_peer->connect("server_disconnected", callable_mp(this, &MultiplayerAPI::_server_disconnected));
+}
+
+void MultiplayerAPI::_disconnect_peer_signals() {
+	network_peer->disconnect("peer_connected", callable_mp(this, &MultiplayerAPI::_add_peer));
+	network_peer->disconnect("peer_disconnected", callable_mp(this, &MultiplayerAPI::_del_peer));
+	network_peer->disconnect("connection_succeeded", callable_mp(this, &MultiplayerAPI::_connected_to_server));
+	network_peer->disconnect("connection_failed", callable_mp(this, &MultiplayerAPI::_connection_failed));
+	network_peer->disconnect("server_disconnected", callable_mp(this, &MultiplayerAPI::_server_disconnected));
+}
+
+NetworkedMultiplayerPeer::ConnectionStatus MultiplayerAPI::_get_connection_status() const {
+	if (io_thread) {
+		MutexLock lock(io_mutex);
+		return io_connection_status;
+	}
+	return network_peer->get_connection_status();
+}
+
+Error MultiplayerAPI::_put_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len) {
+	// Send the batched messages to the same peers first, so they stay in order.
+	if (p_to > 0) {
+		Map<int, PeerBatch>::Element *E = peer_batches.find(p_to);
+		if (E) {
+			_flush_peer_batches(p_to, E->get());
+		}
+	} else {
+		for (Map<int, PeerBatch>::Element *E = peer_batches.front(); E; E = E->next()) {
+			if (p_to < 0 && E->key() == -p_to) {
+				continue; // Excluded.
+			}
+			_flush_peer_batches(E->key(), E->get());
+		}
+	}
+
+	return _put_packet_direct(p_to, p_mode, p_data, p_len);
+}
+
+Error MultiplayerAPI::_put_packet_direct(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len) {
+	if (io_thread) {
+		MutexLock lock(io_mutex);
+		io_out[io_out_back].push(p_to, p_mode, p_data, p_len);
+		return OK;
+	}
+
+	network_peer->set_target_peer(p_to);
+	network_peer->set_transfer_mode(p_mode);
+	return network_peer->put_packet(p_data, p_len);
+}
+
+void MultiplayerAPI::set_threaded_io(bool p_enable) {
+	if (threaded_io == p_enable) {
+		return;
+	}
+
+	if (network_peer.is_valid()) {
+		_io_stop();
+		_dispatch_io_events(); // Received while the thread was running.
+	}
+	threaded_io = p_enable;
+	if (network_peer.is_valid() && threaded_io) {
+		_io_start();
+	}
+}
+
+bool MultiplayerAPI::is_threaded_io() const {
+	return threaded_io;
 }
 
 void MultiplayerAPI::clear() {
@@ -136,6 +365,8 @@ void MultiplayerAPI::clear() {
 	path_send_cache.clear();
 	packet_cache.clear();
 	last_send_cache_id = 1;
+	peer_batches.clear();
+	_replication_clear();
 }
 
 void MultiplayerAPI::set_root_node(Node *p_node) {
@@ -151,22 +382,21 @@ void MultiplayerAPI::set_network_peer(const Ref<NetworkedMultiplayerPeer> &p_pee
 			"Supplied NetworkedMultiplayerPeer must be connecting or connected.");
 
 	if (network_peer.is_valid()) {
-		network_peer->disconnect("peer_connected", callable_mp(this, &MultiplayerAPI::_add_peer));
-		network_peer->disconnect("peer_disconnected", callable_mp(this, &MultiplayerAPI::_del_peer));
-		network_peer->disconnect("connection_succeeded", callable_mp(this, &MultiplayerAPI::_connected_to_server));
-		network_peer->disconnect("connection_failed", callable_mp(this, &MultiplayerAPI::_connection_failed));
-		network_peer->disconnect("server_disconnected", callable_mp(this, &MultiplayerAPI::_server_disconnected));
+		_io_stop();
+		_disconnect_peer_signals();
+		network_peer->flush_queued_signals(); // Still seen by other listeners.
+		io_in[0].clear();
+		io_in[1].clear();
 		clear();
 	}
 
 	network_peer = p_peer;
 
 	if (network_peer.is_valid()) {
-		network_peer->connect("peer_connected", callable_mp(this, &MultiplayerAPI::_add_peer));
-		network_peer->connect("peer_disconnected", callable_mp(this, &MultiplayerAPI::_del_peer));
-		network_peer->connect("connection_succeeded", callable_mp(this, &MultiplayerAPI::_connected_to_server));
-		network_peer->connect("connection_failed", callable_mp(this, &MultiplayerAPI::_connection_failed));
-		network_peer->connect("server_disconnected", callable_mp(this, &MultiplayerAPI::_server_disconnected));
+		_connect_peer_signals();
+		if (threaded_io) {
+			_io_start();
+		}
 	}
 }
 
@@ -211,13 +441,15 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 	ERR_FAIL_COND_MSG(root_node == nullptr, "Multiplayer root node was not initialized. If you are using custom multiplayer, remember to set the root node via MultiplayerAPI.set_root_node before using it.");
 	ERR_FAIL_COND_MSG(p_packet_len < 1, "Invalid packet received. Size too small.");
 
-#ifdef DEBUG_ENABLED
-	_profile_bandwidth_data("in", p_packet_len);
-#endif
-
 	// Extract the `packet_type` from the LSB three bits:
 	uint8_t packet_type = p_packet[0] & 7;
 
+#ifdef DEBUG_ENABLED
+	if (packet_type != NETWORK_COMMAND_BATCH) { // Batched messages are profiled one by one.
+		_profile_bandwidth_data("in", p_packet_len);
+	}
+#endif
+
 	switch (packet_type) {
 		case NETWORK_COMMAND_SIMPLIFY_PATH: {
 			_process_simplify_path(p_from, p_packet, p_packet_len);
@@ -310,6 +542,15 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 		case NETWORK_COMMAND_RAW: {
 			_process_raw(p_from, p_packet, p_packet_len);
 		} break;
+		case NETWORK_COMMAND_SNAPSHOT: {
+			_process_snapshot(p_from, p_packet, p_packet_len);
+		} break;
+		case NETWORK_COMMAND_SNAPSHOT_ACK: {
+			_process_snapshot_ack(p_from, p_packet, p_packet_len);
+		} break;
+		case NETWORK_COMMAND_BATCH: {
+			_process_batch(p_from, p_packet, p_packet_len);
+		} break;
 	}
 }
 
@@ -354,6 +595,31 @@ Node *MultiplayerAPI::_process_get_node(int p_from, const uint8_t *p_packet, uin
 	return node;
 }
 
+// Returns the most arguments the method takes, or -1 when that is not known.
+static int _get_rpc_max_argument_count(Node *p_node, const StringName &p_method) {
+	ScriptInstance *script_instance = p_node->get_script_instance();
+	if (script_instance) {
+		Ref<Script> script = script_instance->get_script();
+		while (script.is_valid()) {
+			if (script->has_method(p_method)) {
+				MethodInfo mi = script->get_method_info(p_method);
+				// Some scripts don't describe their arguments.
+				if ((mi.flags & METHOD_FLAG_VARARG) || mi.arguments.empty()) {
+					return -1;
+				}
+				return mi.arguments.size();
+			}
+			script = script->get_base_script();
+		}
+	}
+
+	MethodBind *method = ClassDB::get_method(p_node->get_class_name(), p_method);
+	if (!method || method->is_vararg()) {
+		return -1;
+	}
+	return method->get_argument_count();
+}
+
 void MultiplayerAPI::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset) {
 	ERR_FAIL_COND_MSG(p_offset > p_packet_len, "Invalid packet received. Size too small.");
 
@@ -372,8 +638,15 @@ void MultiplayerAPI::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id,
 	int argc = 0;
 	bool byte_only = false;
 
+	const bool typed_args = ((p_packet[0] & 128) >> TYPED_ARGS_SHIFT) == 1;
 	const bool byte_only_or_no_args = ((p_packet[0] & 64) >> BYTE_ONLY_OR_NO_ARGS_SHIFT) == 1;
-	if (byte_only_or_no_args) {
+	Vector<int> arg_formats;
+	if (typed_args) {
+		// Arguments are encoded with the method signature, which gives the count.
+		arg_formats = p_node->get_node_rpc_arg_formats_by_id(p_rpc_method_id);
+		ERR_FAIL_COND_MSG(arg_formats.empty(), "Invalid packet received. RPC '" + String(name) + "' was sent with typed arguments, but has no signature configured locally.");
+		argc = arg_formats.size();
+	} else if (byte_only_or_no_args) {
 		if (p_offset < p_packet_len) {
 			// This packet contains only bytes.
 			argc = 1;
@@ -388,43 +661,71 @@ void MultiplayerAPI::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id,
 		p_offset += 1;
 	}
 
-	Vector<Variant> args;
-	Vector<const Variant *> argp;
-	args.resize(argc);
-	argp.resize(argc);
+	// The argument count comes from the network, so check it against the
+	// method before allocating anything for it.
+	int max_argc = _get_rpc_max_argument_count(p_node, name);
+	ERR_FAIL_COND_MSG(max_argc >= 0 && argc > max_argc, "Invalid packet received. RPC '" + String(name) + "' was sent " + itos(argc) + " arguments, but takes at most " + itos(max_argc) + ".");
+
+	Variant inline_args[RPC_INLINE_ARGS];
+	const Variant *inline_argp[RPC_INLINE_ARGS];
+	Vector<Variant> heap_args;
+	Vector<const Variant *> heap_argp;
+	Variant *args = inline_args;
+	const Variant **argp = inline_argp;
+	if (argc > RPC_INLINE_ARGS) {
+		heap_args.resize(argc);
+		heap_argp.resize(argc);
+		args = heap_args.ptrw();
+		argp = heap_argp.ptrw();
+	}
+	for (int i = 0; i < argc; i++) {
+		argp[i] = &args[i];
+	}
 
 #ifdef DEBUG_ENABLED
 	_profile_node_data("in_rpc", p_node->get_instance_id());
 #endif
 
-	if (byte_only) {
+	Error err = OK;
+	if (typed_args) {
+		err = _decode_typed_args(arg_formats, &p_packet[p_offset], p_packet_len - p_offset, args);
+		if (err != OK) {
+			ERR_PRINT("Invalid packet received. Unable to decode typed RPC arguments.");
+		}
+	} else if (byte_only) {
 		Vector<uint8_t> pure_data;
 		const int len = p_packet_len - p_offset;
 		pure_data.resize(len);
 		memcpy(pure_data.ptrw(), &p_packet[p_offset], len);
-		args.write[0] = pure_data;
-		argp.write[0] = &args[0];
+		args[0] = pure_data;
 		p_offset += len;
 	} else {
 		for (int i = 0; i < argc; i++) {
-			ERR_FAIL_COND_MSG(p_offset >= p_packet_len, "Invalid packet received. Size too small.");
+			if (p_offset >= p_packet_len) {
+				ERR_PRINT("Invalid packet received. Size too small.");
+				err = ERR_INVALID_DATA;
+				break;
+			}
 
 			int vlen;
-			Error err = _decode_and_decompress_variant(args.write[i], &p_packet[p_offset], p_packet_len - p_offset, &vlen);
-			ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode RPC argument.");
-
-			argp.write[i] = &args[i];
+			err = _decode_and_decompress_variant(args[i], &p_packet[p_offset], p_packet_len - p_offset, &vlen);
+			if (err != OK) {
+				ERR_PRINT("Invalid packet received. Unable to decode RPC argument.");
+				break;
+			}
 			p_offset += vlen;
 		}
 	}
 
-	Callable::CallError ce;
+	if (err == OK) {
+		Callable::CallError ce;
 
-	p_node->call(name, (const Variant **)argp.ptr(), argc, ce);
-	if (ce.error != Callable::CallError::CALL_OK) {
-		String error = Variant::get_call_error_text(p_node, name, (const Variant **)argp.ptr(), argc, ce);
-		error = "RPC - " + error;
-		ERR_PRINT(error);
+		p_node->call(name, argp, argc, ce);
+		if (ce.error != Callable::CallError::CALL_OK) {
+			String error = Variant::get_call_error_text(p_node, name, argp, argc, ce);
+			error = "RPC - " + error;
+			ERR_PRINT(error);
+		}
 	}
 }
 
@@ -504,9 +805,7 @@ void MultiplayerAPI::_process_simplify_path(int p_from, const uint8_t *p_packet,
 	packet.write[1] = valid_rpc_checksum;
 	encode_cstring(pname.get_data(), &packet.write[2]);
 
-	network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
-	network_peer->set_target_peer(p_from);
-	network_peer->put_packet(packet.ptr(), packet.size());
+	_put_packet(p_from, NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE, packet.ptr(), packet.size());
 }
 
 void MultiplayerAPI::_process_confirm_path(int p_from, const uint8_t *p_packet, int p_packet_len) {
@@ -582,9 +881,7 @@ bool MultiplayerAPI::_send_confirm_path(Node *p_node, NodePath p_path, PathSentC
 		ofs += encode_cstring(path.get_data(), &packet.write[ofs]);
 
 		for (List<int>::Element *E = peers_to_add.front(); E; E = E->next()) {
-			network_peer->set_target_peer(E->get()); // To all of you.
-			network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
-			network_peer->put_packet(packet.ptr(), packet.size());
+			_put_packet(E->get(), NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE, packet.ptr(), packet.size()); // To all of you.
 
 			psc->confirmed_peers.insert(E->get(), false); // Insert into confirmed, but as false since it was not confirmed.
 		}
@@ -748,17 +1045,217 @@ Error MultiplayerAPI::_decode_and_decompress_variant(Variant &r_variant, const u
 	return OK;
 }
 
+static _FORCE_INLINE_ int _encode_varint(uint64_t p_value, uint8_t *r_buffer) {
+	int len = 0;
+	do {
+		uint8_t b = p_value & 0x7F;
+		p_value >>= 7;
+		if (p_value) {
+			b |= 0x80;
+		}
+		if (r_buffer) {
+			r_buffer[len] = b;
+		}
+		len++;
+	} while (p_value);
+	return len;
+}
+
+static _FORCE_INLINE_ int _decode_varint(const uint8_t *p_buffer, int p_len, uint64_t &r_value) {
+	r_value = 0;
+	for (int i = 0; i < p_len && i < 10; i++) {
+		r_value |= uint64_t(p_buffer[i] & 0x7F) << (7 * i);
+		if (!(p_buffer[i] & 0x80)) {
+			return i + 1;
+		}
+	}
+	return -1; // Truncated or too long.
+}
+
+static _FORCE_INLINE_ int _encode_half(float p_value, uint8_t *r_buffer) {
+	if (r_buffer) {
+		encode_uint16(Math::make_half_float(p_value), r_buffer);
+	}
+	return 2;
+}
+
+static _FORCE_INLINE_ int _encode_float(float p_value, uint8_t *r_buffer) {
+	if (r_buffer) {
+		encode_float(p_value, r_buffer);
+	}
+	return 4;
+}
+
+int MultiplayerAPI::_encode_typed_args(const Vector<int> &p_formats, const Variant **p_arg, int p_argcount, uint8_t *r_buffer) {
+	if (p_argcount != p_formats.size()) {
+		return -1;
+	}
+
+	// Bools go first, packed in as many bytes as needed.
+	int bool_count = 0;
+	for (int i = 0; i < p_argcount; i++) {
+		if (p_formats[i] == RPC_ARG_BOOL) {
+			if (p_arg[i]->get_type() != Variant::BOOL) {
+				return -1;
+			}
+			if (r_buffer) {
+				if ((bool_count & 7) == 0) {
+					r_buffer[bool_count >> 3] = 0;
+				}
+				if (p_arg[i]->operator bool()) {
+					r_buffer[bool_count >> 3] |= 1 << (bool_count & 7);
+				}
+			}
+			bool_count++;
+		}
+	}
+
+	int len = (bool_count + 7) >> 3;
+	for (int i = 0; i < p_argcount; i++) {
+		const Variant &v = *p_arg[i];
+		uint8_t *w = r_buffer ? r_buffer + len : nullptr;
+		switch (p_formats[i]) {
+			case RPC_ARG_BOOL: {
+				// Already packed.
+			} break;
+			case RPC_ARG_INT: {
+				if (v.get_type() != Variant::INT) {
+					return -1;
+				}
+				int64_t val = v;
+				len += _encode_varint((uint64_t(val) << 1) ^ uint64_t(val >> 63), w);
+			} break;
+			case RPC_ARG_FLOAT:
+			case RPC_ARG_FLOAT_HALF: {
+				if (v.get_type() != Variant::FLOAT && v.get_type() != Variant::INT) {
+					return -1;
+				}
+				float val = v;
+				len += p_formats[i] == RPC_ARG_FLOAT ? _encode_float(val, w) : _encode_half(val, w);
+			} break;
+			case RPC_ARG_VECTOR2:
+			case RPC_ARG_VECTOR2_HALF: {
+				if (v.get_type() != Variant::VECTOR2) {
+					return -1;
+				}
+				Vector2 val = v;
+				for (int j = 0; j < 2; j++) {
+					uint8_t *wc = w ? r_buffer + len : nullptr;
+					len += p_formats[i] == RPC_ARG_VECTOR2 ? _encode_float(val[j], wc) : _encode_half(val[j], wc);
+				}
+			} break;
+			case RPC_ARG_VECTOR3:
+			case RPC_ARG_VECTOR3_HALF: {
+				if (v.get_type() != Variant::VECTOR3) {
+					return -1;
+				}
+				Vector3 val = v;
+				for (int j = 0; j < 3; j++) {
+					uint8_t *wc = w ? r_buffer + len : nullptr;
+					len += p_formats[i] == RPC_ARG_VECTOR3 ? _encode_float(val[j], wc) : _encode_half(val[j], wc);
+				}
+			} break;
+			case RPC_ARG_VARIANT: {
+				int vlen = 0;
+				Error err = _encode_and_compress_variant(v, w, vlen);
+				if (err != OK) {
+					return -1;
+				}
+				len += vlen;
+			} break;
+			default: {
+				return -1;
+			}
+		}
+	}
+
+	return len;
+}
+
+Error MultiplayerAPI::_decode_typed_args(const Vector<int> &p_formats, const uint8_t *p_buffer, int p_len, Variant *r_args) {
+	int bool_count = 0;
+	for (int i = 0; i < p_formats.size(); i++) {
+		if (p_formats[i] == RPC_ARG_BOOL) {
+			bool_count++;
+		}
+	}
+
+	int ofs = (bool_count + 7) >> 3;
+	ERR_FAIL_COND_V(ofs > p_len, ERR_INVALID_DATA);
+
+	int bool_idx = 0;
+	for (int i = 0; i < p_formats.size(); i++) {
+		const uint8_t *buf = p_buffer + ofs;
+		int len = p_len - ofs;
+		switch (p_formats[i]) {
+			case RPC_ARG_BOOL: {
+				r_args[i] = (p_buffer[bool_idx >> 3] & (1 << (bool_idx & 7))) != 0;
+				bool_idx++;
+			} break;
+			case RPC_ARG_INT: {
+				uint64_t zz = 0;
+				int vlen = _decode_varint(buf, len, zz);
+				ERR_FAIL_COND_V(vlen < 0, ERR_INVALID_DATA);
+				r_args[i] = int64_t(zz >> 1) ^ -int64_t(zz & 1);
+				ofs += vlen;
+			} break;
+			case RPC_ARG_FLOAT: {
+				ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+				r_args[i] = decode_float(buf);
+				ofs += 4;
+			} break;
+			case RPC_ARG_FLOAT_HALF: {
+				ERR_FAIL_COND_V(len < 2, ERR_INVALID_DATA);
+				r_args[i] = Math::half_to_float(decode_uint16(buf));
+				ofs += 2;
+			} break;
+			case RPC_ARG_VECTOR2: {
+				ERR_FAIL_COND_V(len < 8, ERR_INVALID_DATA);
+				r_args[i] = Vector2(decode_float(buf), decode_float(buf + 4));
+				ofs += 8;
+			} break;
+			case RPC_ARG_VECTOR2_HALF: {
+				ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+				r_args[i] = Vector2(Math::half_to_float(decode_uint16(buf)), Math::half_to_float(decode_uint16(buf + 2)));
+				ofs += 4;
+			} break;
+			case RPC_ARG_VECTOR3: {
+				ERR_FAIL_COND_V(len < 12, ERR_INVALID_DATA);
+				r_args[i] = Vector3(decode_float(buf), decode_float(buf + 4), decode_float(buf + 8));
+				ofs += 12;
+			} break;
+			case RPC_ARG_VECTOR3_HALF: {
+				ERR_FAIL_COND_V(len < 6, ERR_INVALID_DATA);
+				r_args[i] = Vector3(Math::half_to_float(decode_uint16(buf)), Math::half_to_float(decode_uint16(buf + 2)), Math::half_to_float(decode_uint16(buf + 4)));
+				ofs += 6;
+			} break;
+			case RPC_ARG_VARIANT: {
+				ERR_FAIL_COND_V(len < 1, ERR_INVALID_DATA);
+				int vlen = 0;
+				Error err = _decode_and_decompress_variant(r_args[i], buf, len, &vlen);
+				ERR_FAIL_COND_V(err != OK, err);
+				ofs += vlen;
+			} break;
+			default: {
+				ERR_FAIL_V(ERR_INVALID_DATA);
+			}
+		}
+	}
+
+	return OK;
+}
+
 void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p_set, const StringName &p_name, const Variant **p_arg, int p_argcount) {
 	ERR_FAIL_COND_MSG(network_peer.is_null(), "Attempt to remote call/set when networking is not active in SceneTree.");
 
-	ERR_FAIL_COND_MSG(network_peer->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_CONNECTING, "Attempt to remote call/set when networking is not connected yet in SceneTree.");
+	ERR_FAIL_COND_MSG(_get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_CONNECTING, "Attempt to remote call/set when networking is not connected yet in SceneTree.");
 
-	ERR_FAIL_COND_MSG(network_peer->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED, "Attempt to remote call/set when networking is disconnected.");
+	ERR_FAIL_COND_MSG(_get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED, "Attempt to remote call/set when networking is disconnected.");
 
 	ERR_FAIL_COND_MSG(p_argcount > 255, "Too many arguments >255.");
 
 	if (p_to != 0 && !connected_peers.has(ABS(p_to))) {
-		ERR_FAIL_COND_MSG(p_to == network_peer->get_unique_id(), "Attempt to remote call/set yourself! unique ID: " + itos(network_peer->get_unique_id()) + ".");
+		ERR_FAIL_COND_MSG(p_to == get_network_unique_id(), "Attempt to remote call/set yourself! unique ID: " + itos(get_network_unique_id()) + ".");
 
 		ERR_FAIL_MSG("Attempt to remote call unexisting ID: " + itos(p_to) + ".");
 	}
@@ -775,8 +1272,26 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 		psc->id = last_send_cache_id++;
 	}
 
+	// With an interest manager, broadcasts only reach the interested peers.
+	const bool batched = rpc_batching;
+	const bool filtered = interest.is_valid() && p_to <= 0;
+	Vector<int> relevant;
+	if (filtered) {
+		_get_relevant_peers(p_from, p_to, relevant);
+		if (relevant.empty()) {
+			return;
+		}
+	}
+
 	// See if all peers have cached path (if so, call can be fast).
-	const bool has_all_peers = _send_confirm_path(p_from, from_path, psc, p_to);
+	bool has_all_peers = true;
+	if (filtered) {
+		for (int i = 0; i < relevant.size(); i++) {
+			has_all_peers = _send_confirm_path(p_from, from_path, psc, relevant[i]) && has_all_peers;
+		}
+	} else {
+		has_all_peers = _send_confirm_path(p_from, from_path, psc, p_to);
+	}
 
 	// Create base packet, lots of hardcode because it must be tight.
 
@@ -792,11 +1307,12 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 	// - `NetworkNodeIdCompression` in the next 2 bits.
 	// - `NetworkNameIdCompression` in the next 1 bit.
 	// - `byte_only_or_no_args` in the next 1 bit.
-	// - So we still have the last bit free!
+	// - `typed_args` in the last bit.
 	uint8_t command_type = p_set ? NETWORK_COMMAND_REMOTE_SET : NETWORK_COMMAND_REMOTE_CALL;
 	uint8_t node_id_compression = UINT8_MAX;
 	uint8_t name_id_compression = UINT8_MAX;
 	bool byte_only_or_no_args = false;
+	bool typed_args = false;
 
 	MAKE_ROOM(1);
 	// The meta is composed along the way, so just set 0 for now.
@@ -886,7 +1402,16 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 			ofs += 2;
 		}
 
-		if (p_argcount == 0) {
+		// Use the method signature if any, and if the arguments match it.
+		Vector<int> arg_formats = p_from->get_node_rpc_arg_formats_by_id(method_id);
+		int typed_len = arg_formats.empty() ? -1 : _encode_typed_args(arg_formats, p_arg, p_argcount, nullptr);
+
+		if (typed_len >= 0) {
+			typed_args = true;
+			MAKE_ROOM(ofs + typed_len);
+			_encode_typed_args(arg_formats, p_arg, p_argcount, &(packet_cache.write[ofs]));
+			ofs += typed_len;
+		} else if (p_argcount == 0) {
 			byte_only_or_no_args = true;
 		} else if (p_argcount == 1 && p_arg[0]->get_type() == Variant::PACKED_BYTE_ARRAY) {
 			byte_only_or_no_args = true;
@@ -916,19 +1441,29 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 	ERR_FAIL_COND(name_id_compression > 1);
 
 	// We can now set the meta
-	packet_cache.write[0] = command_type + (node_id_compression << NODE_ID_COMPRESSION_SHIFT) + (name_id_compression << NAME_ID_COMPRESSION_SHIFT) + ((byte_only_or_no_args ? 1 : 0) << BYTE_ONLY_OR_NO_ARGS_SHIFT);
+	packet_cache.write[0] = command_type + (node_id_compression << NODE_ID_COMPRESSION_SHIFT) + (name_id_compression << NAME_ID_COMPRESSION_SHIFT) + ((byte_only_or_no_args ? 1 : 0) << BYTE_ONLY_OR_NO_ARGS_SHIFT) + ((typed_args ? 1 : 0) << TYPED_ARGS_SHIFT);
 
 #ifdef DEBUG_ENABLED
 	_profile_bandwidth_data("out", ofs);
 #endif
 
-	// Take chance and set transfer mode, since all send methods will use it.
-	network_peer->set_transfer_mode(p_unreliable ? NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
+	NetworkedMultiplayerPeer::TransferMode transfer_mode = p_unreliable ? NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE;
 
 	if (has_all_peers) {
 		// They all have verified paths, so send fast.
-		network_peer->set_target_peer(p_to); // To all of you.
-		network_peer->put_packet(packet_cache.ptr(), ofs); // A message with love.
+		if (filtered) {
+			for (int i = 0; i < relevant.size(); i++) {
+				if (batched) {
+					_put_batched(relevant[i], transfer_mode, packet_cache.ptr(), ofs);
+				} else {
+					_put_packet(relevant[i], transfer_mode, packet_cache.ptr(), ofs);
+				}
+			}
+		} else if (batched) {
+			_put_batched(p_to, transfer_mode, packet_cache.ptr(), ofs);
+		} else {
+			_put_packet(p_to, transfer_mode, packet_cache.ptr(), ofs); // A message with love.
+		}
 	} else {
 		// Unreachable because the node ID is never compressed if the peers doesn't know it.
 		CRASH_COND(node_id_compression != NETWORK_NODE_ID_COMPRESSION_32);
@@ -941,6 +1476,11 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 		MAKE_ROOM(ofs + path_len);
 		encode_cstring(pname.get_data(), &(packet_cache.write[ofs]));
 
+		Set<int> relevant_set;
+		for (int i = 0; i < relevant.size(); i++) {
+			relevant_set.insert(relevant[i]);
+		}
+
 		for (Set<int>::Element *E = connected_peers.front(); E; E = E->next()) {
 			if (p_to < 0 && E->get() == -p_to) {
 				continue; // Continue, excluded.
@@ -950,24 +1490,626 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 				continue; // Continue, not for this peer.
 			}
 
+			if (filtered && !relevant_set.has(E->get())) {
+				continue; // Continue, not interested.
+			}
+
 			Map<int, bool>::Element *F = psc->confirmed_peers.find(E->get());
 			ERR_CONTINUE(!F); // Should never happen.
 
-			network_peer->set_target_peer(E->get()); // To this one specifically.
-
+			int len = ofs;
 			if (F->get()) {
 				// This one confirmed path, so use id.
 				encode_uint32(psc->id, &(packet_cache.write[1]));
-				network_peer->put_packet(packet_cache.ptr(), ofs);
 			} else {
 				// This one did not confirm path yet, so use entire path (sorry!).
 				encode_uint32(0x80000000 | ofs, &(packet_cache.write[1])); // Offset to path and flag.
-				network_peer->put_packet(packet_cache.ptr(), ofs + path_len);
+				len += path_len;
+			}
+
+			if (batched) {
+				_put_batched(E->get(), transfer_mode, packet_cache.ptr(), len);
+			} else {
+				_put_packet(E->get(), transfer_mode, packet_cache.ptr(), len); // To this one specifically.
+			}
+		}
+	}
+}
+
+void MultiplayerAPI::_get_relevant_peers(Node *p_node, int p_to, Vector<int> &r_peers) {
+	Vector<int> peers;
+	for (Set<int>::Element *E = connected_peers.front(); E; E = E->next()) {
+		if (p_to < 0 && E->get() == -p_to) {
+			continue; // Continue, excluded.
+		}
+		peers.push_back(E->get());
+	}
+	interest->get_relevant_peers(p_node, peers, r_peers);
+}
+
+void MultiplayerAPI::_put_batched(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len) {
+	PeerBatch &batch = peer_batches[p_to];
+	Vector<uint8_t> &buffer = batch.buffers[p_mode];
+
+	// Each message is prefixed by its size.
+	int size_len = _encode_varint(p_len, nullptr);
+	if (buffer.size() && buffer.size() + size_len + p_len > BATCH_MAX_SIZE) {
+		_flush_batch(p_to, p_mode, buffer);
+	}
+	if (1 + size_len + p_len > BATCH_MAX_SIZE) {
+		_put_packet(p_to, p_mode, p_data, p_len); // Too big, send on its own.
+		return;
+	}
+
+	if (buffer.empty()) {
+		buffer.push_back(NETWORK_COMMAND_BATCH);
+	}
+	int ofs = buffer.size();
+	buffer.resize(ofs + size_len + p_len);
+	uint8_t *w = buffer.ptrw();
+	_encode_varint(p_len, &w[ofs]);
+	memcpy(&w[ofs + size_len], p_data, p_len);
+}
+
+void MultiplayerAPI::_flush_batch(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, Vector<uint8_t> &r_batch) {
+	if (r_batch.empty()) {
+		return;
+	}
+	if (connected_peers.has(p_to)) {
+		_put_packet_direct(p_to, p_mode, r_batch.ptr(), r_batch.size());
+	}
+	r_batch.clear();
+}
+
+void MultiplayerAPI::_flush_peer_batches(int p_to, PeerBatch &r_batches) {
+	for (int i = 0; i < BATCH_MODE_COUNT; i++) {
+		_flush_batch(p_to, NetworkedMultiplayerPeer::TransferMode(i), r_batches.buffers[i]);
+	}
+}
+
+void MultiplayerAPI::_flush_batches() {
+	for (Map<int, PeerBatch>::Element *E = peer_batches.front(); E; E = E->next()) {
+		_flush_peer_batches(E->key(), E->get());
+	}
+}
+
+void MultiplayerAPI::_process_batch(int p_from, const uint8_t *p_packet, int p_packet_len) {
+	int ofs = 1;
+	while (ofs < p_packet_len) {
+		uint64_t len = 0;
+		int r = _decode_varint(&p_packet[ofs], p_packet_len - ofs, len);
+		ERR_FAIL_COND_MSG(r < 0 || len == 0 || len > uint64_t(p_packet_len - ofs - r), "Invalid packet received. Invalid batched message size.");
+		ofs += r;
+		ERR_FAIL_COND_MSG((p_packet[ofs] & 7) == NETWORK_COMMAND_BATCH, "Invalid packet received. Nested batch.");
+
+		_process_packet(p_from, &p_packet[ofs], len);
+		ofs += len;
+
+		if (!network_peer.is_valid()) {
+			break; // A message caused a disconnection.
+		}
+	}
+}
+
+static void _put_snapshot_varint(Vector<uint8_t> &r_packet, uint64_t p_value) {
+	int ofs = r_packet.size();
+	r_packet.resize(ofs + _encode_varint(p_value, nullptr));
+	_encode_varint(p_value, r_packet.ptrw() + ofs);
+}
+
+static void _put_snapshot_string(Vector<uint8_t> &r_packet, const String &p_string) {
+	CharString cs = p_string.utf8();
+	int ofs = r_packet.size();
+	r_packet.resize(ofs + cs.length() + 1);
+	memcpy(r_packet.ptrw() + ofs, cs.get_data(), cs.length() + 1);
+}
+
+static int _get_snapshot_string(const uint8_t *p_buffer, int p_len, String &r_string) {
+	for (int i = 0; i < p_len; i++) {
+		if (p_buffer[i] == 0) {
+			r_string.parse_utf8((const char *)p_buffer, i);
+			return i + 1;
+		}
+	}
+	return -1; // Not terminated.
+}
+
+bool MultiplayerAPI::_encode_snapshot_node(uint32_t p_id, const ReplicationSnapshot &p_snapshot, const ReplicationSnapshot *p_base, const Set<uint32_t> *p_base_nodes, Vector<uint8_t> &r_buffer) {
+	const Map<uint32_t, Vector<Variant>>::Element *E = p_snapshot.nodes.find(p_id);
+	const Map<uint32_t, ReplicatedNode>::Element *R = replicated_nodes.find(p_id);
+	ERR_FAIL_COND_V(!E || !R, false);
+	const ReplicatedNode &rn = R->get();
+	const Vector<Variant> &values = E->get();
+	const Vector<Variant> *base_values = nullptr;
+	if (p_base && p_base_nodes->has(p_id)) {
+		const Map<uint32_t, Vector<Variant>>::Element *B = p_base->nodes.find(p_id);
+		if (B) {
+			base_values = &B->get();
+		}
+	}
+
+	_put_snapshot_varint(r_buffer, p_id);
+	int ofs = r_buffer.size();
+	r_buffer.resize(ofs + 1);
+	// Nodes the peer has not acknowledged yet are introduced with their path and properties.
+	r_buffer.write[ofs] = (base_values ? 0 : 1) | (rn.interpolate ? 2 : 0);
+	if (!base_values) {
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(rn.instance));
+		ERR_FAIL_COND_V(!node, false);
+		_put_snapshot_string(r_buffer, root_node->get_path_to(node));
+		_put_snapshot_varint(r_buffer, rn.properties.size());
+		for (int i = 0; i < rn.properties.size(); i++) {
+			_put_snapshot_string(r_buffer, rn.properties[i]);
+		}
+	}
+
+	// Changed fields bitmask, followed by the changed values.
+	int mask_ofs = r_buffer.size();
+	r_buffer.resize(mask_ofs + (values.size() + 7) / 8);
+	for (int i = mask_ofs; i < r_buffer.size(); i++) {
+		r_buffer.write[i] = 0;
+	}
+	for (int i = 0; i < values.size(); i++) {
+		if (base_values && (*base_values)[i] == values[i]) {
+			continue;
+		}
+		r_buffer.write[mask_ofs + (i >> 3)] |= 1 << (i & 7);
+		int len = 0;
+		Error err = _encode_and_compress_variant(values[i], nullptr, len);
+		ERR_FAIL_COND_V_MSG(err != OK, false, "Unable to encode replicated property. THIS IS LIKELY A BUG IN THE ENGINE!");
+		int vofs = r_buffer.size();
+		r_buffer.resize(vofs + len);
+		_encode_and_compress_variant(values[i], r_buffer.ptrw() + vofs, len);
+	}
+	return true;
+}
+
+void MultiplayerAPI::_encode_snapshot(const ReplicationSnapshot &p_snapshot, const Vector<uint32_t> &p_nodes, const ReplicationSnapshot *p_base, const Set<uint32_t> *p_base_nodes, Vector<uint8_t> &r_packet, Vector<uint32_t> &r_sent_nodes) {
+	// Each node is encoded on its own, so one that fails is left out instead of corrupting the packet.
+	Vector<uint8_t> body;
+	Vector<uint8_t> node_buffer;
+	r_sent_nodes.clear();
+	for (int n = 0; n < p_nodes.size(); n++) {
+		node_buffer.clear();
+		if (!_encode_snapshot_node(p_nodes[n], p_snapshot, p_base, p_base_nodes, node_buffer)) {
+			continue;
+		}
+		int ofs = body.size();
+		body.resize(ofs + node_buffer.size());
+		memcpy(body.ptrw() + ofs, node_buffer.ptr(), node_buffer.size());
+		r_sent_nodes.push_back(p_nodes[n]);
+	}
+
+	r_packet.resize(13);
+	uint8_t *w = r_packet.ptrw();
+	w[0] = NETWORK_COMMAND_SNAPSHOT;
+	encode_uint32(p_snapshot.seq, &w[1]);
+	encode_uint32(p_base ? p_base->seq : 0, &w[5]);
+	encode_uint32(p_snapshot.time, &w[9]);
+	_put_snapshot_varint(r_packet, r_sent_nodes.size());
+	int ofs = r_packet.size();
+	r_packet.resize(ofs + body.size());
+	if (body.size()) {
+		memcpy(r_packet.ptrw() + ofs, body.ptr(), body.size());
+	}
+}
+
+void MultiplayerAPI::send_snapshot() {
+	ERR_FAIL_COND_MSG(!network_peer.is_valid(), "Trying to send a snapshot while no network peer is active.");
+	ERR_FAIL_COND_MSG(_get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED, "Trying to send a snapshot via a network peer which is not connected.");
+	ERR_FAIL_COND_MSG(!is_network_server(), "Only the server can send snapshots.");
+	ERR_FAIL_COND_MSG(root_node == nullptr, "Multiplayer root node was not initialized. If you are using custom multiplayer, remember to set the root node via MultiplayerAPI.set_root_node before using it.");
+
+	if (connected_peers.empty()) {
+		return;
+	}
+
+	replication_seq++;
+	ReplicationSnapshot &snapshot = replication_history[replication_seq % REPLICATION_HISTORY_SIZE];
+	snapshot.seq = replication_seq;
+	snapshot.time = (uint32_t)OS::get_singleton()->get_ticks_msec();
+	snapshot.nodes.clear();
+
+	Vector<uint32_t> ids;
+	Map<int, Vector<uint32_t>> peer_ids; // Relevant nodes per peer, with an interest manager.
+	Vector<int> peers;
+	for (Set<int>::Element *P = connected_peers.front(); P; P = P->next()) {
+		peers.push_back(P->get());
+	}
+
+	Map<uint32_t, ReplicatedNode>::Element *E = replicated_nodes.front();
+	while (E) {
+		Map<uint32_t, ReplicatedNode>::Element *N = E->next();
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(E->get().instance));
+		if (!node) {
+			replicated_nodes.erase(E); // Freed, stop replicating it.
+		} else if (node->is_inside_tree()) {
+			const Vector<StringName> &properties = E->get().properties;
+			Vector<Variant> &values = snapshot.nodes[E->key()];
+			values.resize(properties.size());
+			for (int i = 0; i < properties.size(); i++) {
+				values.write[i] = node->get(properties[i]);
+			}
+			ids.push_back(E->key());
+
+			if (interest.is_valid()) {
+				Vector<int> relevant;
+				interest->get_relevant_peers(node, peers, relevant);
+				for (int i = 0; i < relevant.size(); i++) {
+					peer_ids[relevant[i]].push_back(E->key());
+				}
 			}
 		}
+		E = N;
+	}
+
+	Vector<uint8_t> packet;
+	Vector<uint32_t> sent_nodes;
+	const Vector<uint32_t> no_ids;
+	for (int i = 0; i < peers.size(); i++) {
+		ReplicationPeer &rp = replication_peers[peers[i]];
+		const Vector<uint32_t> *nodes = &ids;
+		if (interest.is_valid()) {
+			Map<int, Vector<uint32_t>>::Element *I = peer_ids.find(peers[i]);
+			nodes = I ? &I->get() : &no_ids;
+		}
+
+		// Delta against the last snapshot the peer acknowledged, if still in history.
+		const ReplicationSnapshot *base = nullptr;
+		const Set<uint32_t> *base_nodes = nullptr;
+		const int base_index = rp.acked % REPLICATION_HISTORY_SIZE;
+		if (rp.acked && rp.sent_seq[base_index] == rp.acked && replication_history[base_index].seq == rp.acked) {
+			base = &replication_history[base_index];
+			base_nodes = &rp.sent_nodes[base_index];
+		}
+
+		_encode_snapshot(snapshot, *nodes, base, base_nodes, packet, sent_nodes);
+		_put_packet(peers[i], NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE, packet.ptr(), packet.size());
+
+		const int index = snapshot.seq % REPLICATION_HISTORY_SIZE;
+		rp.sent_seq[index] = snapshot.seq;
+		rp.sent_nodes[index].clear();
+		for (int j = 0; j < sent_nodes.size(); j++) {
+			rp.sent_nodes[index].insert(sent_nodes[j]);
+		}
 	}
 }
 
+void MultiplayerAPI::_process_snapshot(int p_from, const uint8_t *p_packet, int p_packet_len) {
+	ERR_FAIL_COND_MSG(p_from != NetworkedMultiplayerPeer::TARGET_PEER_SERVER || is_network_server(), "Snapshots can only be received from the server.");
+	ERR_FAIL_COND_MSG(p_packet_len < 14, "Invalid packet received. Size too small.");
+
+	uint32_t seq = decode_uint32(&p_packet[1]);
+	uint32_t base_seq = decode_uint32(&p_packet[5]);
+	uint32_t time = decode_uint32(&p_packet[9]);
+
+	if (seq <= replication_last_received) {
+		return; // Late or duplicated, a newer snapshot was already applied.
+	}
+
+	const ReplicationSnapshot *base = nullptr;
+	if (base_seq) {
+		base = &replication_received[base_seq % REPLICATION_HISTORY_SIZE];
+		if (base->seq != base_seq) {
+			return; // Base dropped from history, the server will catch up with our next ack.
+		}
+	}
+
+	ReplicationSnapshot snapshot;
+	snapshot.seq = seq;
+	snapshot.time = time;
+
+	int ofs = 13;
+	uint64_t node_count = 0;
+	int r = _decode_varint(&p_packet[ofs], p_packet_len - ofs, node_count);
+	ERR_FAIL_COND_MSG(r < 0, "Invalid packet received. Size too small.");
+	ofs += r;
+
+	for (uint64_t n = 0; n < node_count; n++) {
+		uint64_t id = 0;
+		r = _decode_varint(&p_packet[ofs], p_packet_len - ofs, id);
+		ERR_FAIL_COND_MSG(r < 0 || ofs + r >= p_packet_len, "Invalid packet received. Size too small.");
+		ofs += r;
+		uint8_t flags = p_packet[ofs++];
+
+		Map<uint32_t, RemoteReplicatedNode>::Element *R = replication_remote_nodes.find(id);
+		if (flags & 1) {
+			String path;
+			r = _get_snapshot_string(&p_packet[ofs], p_packet_len - ofs, path);
+			ERR_FAIL_COND_MSG(r < 0, "Invalid packet received. Unterminated node path.");
+			ofs += r;
+			uint64_t prop_count = 0;
+			r = _decode_varint(&p_packet[ofs], p_packet_len - ofs, prop_count);
+			ERR_FAIL_COND_MSG(r < 0 || prop_count == 0 || prop_count > uint64_t(p_packet_len - ofs), "Invalid packet received. Invalid property count.");
+			ofs += r;
+			Vector<StringName> properties;
+			for (uint64_t i = 0; i < prop_count; i++) {
+				String name;
+				r = _get_snapshot_string(&p_packet[ofs], p_packet_len - ofs, name);
+				ERR_FAIL_COND_MSG(r < 0, "Invalid packet received. Unterminated property name.");
+				ofs += r;
+				properties.push_back(name);
+			}
+			if (!R) {
+				R = replication_remote_nodes.insert(id, RemoteReplicatedNode());
+				R->get().path = path;
+				R->get().properties = properties;
+				R->get().interpolate = flags & 2;
+			}
+		}
+		ERR_FAIL_COND_MSG(!R, "Invalid packet received. Unknown replicated node.");
+
+		const Vector<StringName> &properties = R->get().properties;
+		const Vector<Variant> *base_values = nullptr;
+		if (base) {
+			const Map<uint32_t, Vector<Variant>>::Element *B = base->nodes.find(id);
+			if (B && B->get().size() == properties.size()) {
+				base_values = &B->get();
+			}
+		}
+
+		int mask_ofs = ofs;
+		ofs += (properties.size() + 7) / 8;
+		ERR_FAIL_COND_MSG(ofs > p_packet_len, "Invalid packet received. Size too small.");
+
+		Vector<Variant> values;
+		values.resize(properties.size());
+		for (int i = 0; i < properties.size(); i++) {
+			if (p_packet[mask_ofs + (i >> 3)] & (1 << (i & 7))) {
+				int vlen = 0;
+				Error err = _decode_and_decompress_variant(values.write[i], &p_packet[ofs], p_packet_len - ofs, &vlen);
+				ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode replicated property.");
+				ofs += vlen;
+			} else {
+				ERR_FAIL_COND_MSG(!base_values, "Invalid packet received. Unchanged property without base snapshot.");
+				values.write[i] = (*base_values)[i];
+			}
+		}
+		snapshot.nodes[id] = values;
+	}
+
+	int64_t time_offset = int64_t(time) - int64_t(OS::get_singleton()->get_ticks_msec());
+	if (replication_last_received == 0) {
+		replication_time_offset = time_offset;
+	} else {
+		replication_time_offset += (time_offset - replication_time_offset) / 8;
+	}
+
+	// Apply what changed since the previously applied snapshot, interpolated nodes are updated in poll.
+	const ReplicationSnapshot &previous = replication_received[replication_last_received % REPLICATION_HISTORY_SIZE];
+	Map<uint32_t, RemoteReplicatedNode>::Element *R = replication_remote_nodes.front();
+	while (R) {
+		Map<uint32_t, RemoteReplicatedNode>::Element *N = R->next();
+		const Map<uint32_t, Vector<Variant>>::Element *E = snapshot.nodes.find(R->key());
+		if (!E) {
+			replication_remote_nodes.erase(R); // No longer replicated by the server.
+			R = N;
+			continue;
+		}
+
+		RemoteReplicatedNode &remote = R->get();
+		const Vector<Variant> &values = E->get();
+		if (remote.interpolate) {
+			RemoteReplicatedNode::Sample sample;
+			sample.time = time;
+			sample.values = values;
+			remote.samples.push_back(sample);
+			if (remote.samples.size() > REPLICATION_INTERPOLATION_BUFFER_SIZE) {
+				remote.samples.remove(0);
+			}
+			R = N;
+			continue;
+		}
+
+		bool synced = ObjectDB::get_instance(remote.instance) != nullptr; // Apply everything to newly resolved nodes.
+		Node *node = _get_remote_replicated_node(remote);
+		if (node) {
+			const Map<uint32_t, Vector<Variant>>::Element *P = previous.seq == replication_last_received ? previous.nodes.find(R->key()) : nullptr;
+			for (int i = 0; i < values.size(); i++) {
+				if (synced && P && P->get()[i] == values[i]) {
+					continue;
+				}
+				ERR_CONTINUE_MSG(!_can_replicate_property(node, remote.properties[i], p_from), "Replicated property '" + String(remote.properties[i]) + "' is not allowed on node " + node->get_path() + " from: " + itos(p_from) + ". Master is " + itos(node->get_network_master()) + ".");
+				node->set(remote.properties[i], values[i]);
+			}
+		}
+		R = N;
+	}
+
+	replication_received[seq % REPLICATION_HISTORY_SIZE] = snapshot;
+	replication_last_received = seq;
+
+	uint8_t ack[5];
+	ack[0] = NETWORK_COMMAND_SNAPSHOT_ACK;
+	encode_uint32(seq, &ack[1]);
+	_put_packet(p_from, NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE, ack, 5);
+}
+
+void MultiplayerAPI::_process_snapshot_ack(int p_from, const uint8_t *p_packet, int p_packet_len) {
+	ERR_FAIL_COND_MSG(!is_network_server(), "Snapshot acknowledgements can only be received by the server.");
+	ERR_FAIL_COND_MSG(p_packet_len < 5, "Invalid packet received. Size too small.");
+
+	uint32_t seq = decode_uint32(&p_packet[1]);
+	Map<int, ReplicationPeer>::Element *E = replication_peers.find(p_from);
+	ERR_FAIL_COND_MSG(!E || seq == 0 || E->get().sent_seq[seq % REPLICATION_HISTORY_SIZE] != seq, "Invalid packet received. Unknown snapshot acknowledged.");
+	if (seq > E->get().acked) {
+		E->get().acked = seq;
+	}
+}
+
+bool MultiplayerAPI::_can_replicate_property(Node *p_node, const StringName &p_property, int p_from) {
+	// Snapshots are bound by the same rules as rset.
+	RPCMode rset_mode = p_node->get_node_rset_mode(p_property);
+	if (rset_mode == RPC_MODE_DISABLED && p_node->get_script_instance()) {
+		rset_mode = p_node->get_script_instance()->get_rset_mode(p_property);
+	}
+	return _can_call_mode(p_node, rset_mode, p_from);
+}
+
+Node *MultiplayerAPI::_get_remote_replicated_node(RemoteReplicatedNode &p_remote) {
+	Node *node = Object::cast_to<Node>(ObjectDB::get_instance(p_remote.instance));
+	if (!node) {
+		node = root_node->get_node_or_null(p_remote.path);
+		p_remote.instance = node ? node->get_instance_id() : ObjectID();
+	}
+	return node;
+}
+
+void MultiplayerAPI::_replication_interpolate() {
+	if (replication_remote_nodes.empty() || root_node == nullptr) {
+		return;
+	}
+
+	int64_t render_time = int64_t(OS::get_singleton()->get_ticks_msec()) + replication_time_offset - interpolation_delay;
+
+	for (Map<uint32_t, RemoteReplicatedNode>::Element *E = replication_remote_nodes.front(); E; E = E->next()) {
+		RemoteReplicatedNode &remote = E->get();
+		if (!remote.interpolate || remote.samples.empty()) {
+			continue;
+		}
+		Node *node = _get_remote_replicated_node(remote);
+		if (!node) {
+			continue;
+		}
+
+		// Find the samples around the render time, clamping (no extrapolation) at both ends.
+		const Vector<RemoteReplicatedNode::Sample> &samples = remote.samples;
+		int from = 0;
+		while (from < samples.size() - 1 && int64_t(samples[from + 1].time) <= render_time) {
+			from++;
+		}
+		const RemoteReplicatedNode::Sample &a = samples[from];
+		if (from == samples.size() - 1 || render_time <= int64_t(a.time)) {
+			for (int i = 0; i < a.values.size(); i++) {
+				if (_can_replicate_property(node, remote.properties[i], NetworkedMultiplayerPeer::TARGET_PEER_SERVER)) {
+					node->set(remote.properties[i], a.values[i]);
+				}
+			}
+			continue;
+		}
+
+		const RemoteReplicatedNode::Sample &b = samples[from + 1];
+		float weight = float(render_time - int64_t(a.time)) / float(b.time - a.time);
+		for (int i = 0; i < a.values.size(); i++) {
+			if (!_can_replicate_property(node, remote.properties[i], NetworkedMultiplayerPeer::TARGET_PEER_SERVER)) {
+				continue;
+			}
+			Variant value;
+			Variant::interpolate(a.values[i], b.values[i], weight, value);
+			node->set(remote.properties[i], value);
+		}
+	}
+}
+
+void MultiplayerAPI::_replication_poll() {
+	if (!network_peer.is_valid() || _get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED) {
+		return;
+	}
+
+	if (!is_network_server()) {
+		_replication_interpolate();
+		return;
+	}
+
+	if (snapshot_interval <= 0 || replicated_nodes.empty()) {
+		return; // Snapshots are sent manually.
+	}
+
+	uint64_t now = OS::get_singleton()->get_ticks_msec();
+	if (now - replication_last_send < (uint64_t)snapshot_interval) {
+		return;
+	}
+	replication_last_send = now;
+	send_snapshot();
+}
+
+void MultiplayerAPI::_replication_clear() {
+	replication_seq = 0;
+	replication_peers.clear();
+	replication_remote_nodes.clear();
+	replication_last_received = 0;
+	replication_time_offset = 0;
+	for (int i = 0; i < REPLICATION_HISTORY_SIZE; i++) {
+		replication_history[i] = ReplicationSnapshot();
+		replication_received[i] = ReplicationSnapshot();
+	}
+}
+
+void MultiplayerAPI::set_interest(const Ref<MultiplayerInterest> &p_interest) {
+	interest = p_interest;
+}
+
+Ref<MultiplayerInterest> MultiplayerAPI::get_interest() const {
+	return interest;
+}
+
+void MultiplayerAPI::set_rpc_batching(bool p_enable) {
+	if (!p_enable && network_peer.is_valid()) {
+		_flush_batches();
+	}
+	rpc_batching = p_enable;
+}
+
+bool MultiplayerAPI::is_rpc_batching() const {
+	return rpc_batching;
+}
+
+void MultiplayerAPI::add_replicated_node(Node *p_node, const PackedStringArray &p_properties, bool p_interpolate) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(p_properties.empty(), "At least one property must be replicated.");
+
+	// Registering again replaces the property list, under a new id.
+	remove_replicated_node(p_node);
+
+	ReplicatedNode rn;
+	rn.instance = p_node->get_instance_id();
+	for (int i = 0; i < p_properties.size(); i++) {
+		rn.properties.push_back(p_properties[i]);
+	}
+	rn.interpolate = p_interpolate;
+	replicated_nodes.insert(++replication_last_id, rn);
+}
+
+void MultiplayerAPI::remove_replicated_node(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+
+	for (Map<uint32_t, ReplicatedNode>::Element *E = replicated_nodes.front(); E; E = E->next()) {
+		if (E->get().instance == p_node->get_instance_id()) {
+			replicated_nodes.erase(E);
+			return;
+		}
+	}
+}
+
+bool MultiplayerAPI::is_node_replicated(Node *p_node) const {
+	ERR_FAIL_NULL_V(p_node, false);
+
+	for (const Map<uint32_t, ReplicatedNode>::Element *E = replicated_nodes.front(); E; E = E->next()) {
+		if (E->get().instance == p_node->get_instance_id()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void MultiplayerAPI::set_snapshot_interval(int p_msec) {
+	ERR_FAIL_COND(p_msec < 0);
+	snapshot_interval = p_msec;
+}
+
+int MultiplayerAPI::get_snapshot_interval() const {
+	return snapshot_interval;
+}
+
+void MultiplayerAPI::set_interpolation_delay(int p_msec) {
+	ERR_FAIL_COND(p_msec < 0);
+	interpolation_delay = p_msec;
+}
+
+int MultiplayerAPI::get_interpolation_delay() const {
+	return interpolation_delay;
+}
+
 void MultiplayerAPI::_add_peer(int p_id) {
 	connected_peers.insert(p_id);
 	path_get_cache.insert(p_id, PathGetCache());
@@ -976,6 +2118,8 @@ void MultiplayerAPI::_add_peer(int p_id) {
 
 void MultiplayerAPI::_del_peer(int p_id) {
 	connected_peers.erase(p_id);
+	replication_peers.erase(p_id);
+	peer_batches.erase(p_id);
 	// Cleanup get cache.
 	path_get_cache.erase(p_id);
 	// Cleanup sent cache.
@@ -1004,9 +2148,9 @@ void MultiplayerAPI::_server_disconnected() {
 void MultiplayerAPI::rpcp(Node *p_node, int p_peer_id, bool p_unreliable, const StringName &p_method, const Variant **p_arg, int p_argcount) {
 	ERR_FAIL_COND_MSG(!network_peer.is_valid(), "Trying to call an RPC while no network peer is active.");
 	ERR_FAIL_COND_MSG(!p_node->is_inside_tree(), "Trying to call an RPC on a node which is not inside SceneTree.");
-	ERR_FAIL_COND_MSG(network_peer->get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED, "Trying to call an RPC via a network peer which is not connected.");
+	ERR_FAIL_COND_MSG(_get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED, "Trying to call an RPC via a network peer which is not connected.");
 
-	int node_id = network_peer->get_unique_id();
+	int node_id = get_network_unique_id();
 	bool skip_rpc = node_id == p_peer_id;
 	bool call_local_native = false;
 	bool call_local_script = false;
@@ -1070,9 +2214,9 @@ void MultiplayerAPI::rpcp(Node *p_node, int p_peer_id, bool p_unreliable, const
 void MultiplayerAPI::rsetp(Node *p_node, int p_peer_id, bool p_unreliable, const StringName &p_property, const Variant &p_value) {
 	ERR_FAIL_COND_MSG(!network_peer.is_valid(), "Trying to RSET while no network peer is active.");
 	ERR_FAIL_COND_MSG(!p_node->is_inside_tree(), "Trying to RSET on a node which is not inside SceneTree.");
-	ERR_FAIL_COND_MSG(network_peer->get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED, "Trying to send an RSET via a network peer which is not connected.");
+	ERR_FAIL_COND_MSG(_get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED, "Trying to send an RSET via a network peer which is not connected.");
 
-	int node_id = network_peer->get_unique_id();
+	int node_id = get_network_unique_id();
 	bool is_master = p_node->is_network_master();
 	bool skip_rset = node_id == p_peer_id;
 	bool set_local = false;
@@ -1134,17 +2278,14 @@ void MultiplayerAPI::rsetp(Node *p_node, int p_peer_id, bool p_unreliable, const
 Error MultiplayerAPI::send_bytes(Vector<uint8_t> p_data, int p_to, NetworkedMultiplayerPeer::TransferMode p_mode) {
 	ERR_FAIL_COND_V_MSG(p_data.size() < 1, ERR_INVALID_DATA, "Trying to send an empty raw packet.");
 	ERR_FAIL_COND_V_MSG(!network_peer.is_valid(), ERR_UNCONFIGURED, "Trying to send a raw packet while no network peer is active.");
-	ERR_FAIL_COND_V_MSG(network_peer->get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED, ERR_UNCONFIGURED, "Trying to send a raw packet via a network peer which is not connected.");
+	ERR_FAIL_COND_V_MSG(_get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED, ERR_UNCONFIGURED, "Trying to send a raw packet via a network peer which is not connected.");
 
 	MAKE_ROOM(p_data.size() + 1);
 	const uint8_t *r = p_data.ptr();
 	packet_cache.write[0] = NETWORK_COMMAND_RAW;
 	memcpy(&packet_cache.write[1], &r[0], p_data.size());
 
-	network_peer->set_target_peer(p_to);
-	network_peer->set_transfer_mode(p_mode);
-
-	return network_peer->put_packet(packet_cache.ptr(), p_data.size() + 1);
+	return _put_packet(p_to, p_mode, packet_cache.ptr(), p_data.size() + 1);
 }
 
 void MultiplayerAPI::_process_raw(int p_from, const uint8_t *p_packet, int p_packet_len) {
@@ -1162,12 +2303,20 @@ void MultiplayerAPI::_process_raw(int p_from, const uint8_t *p_packet, int p_pac
 
 int MultiplayerAPI::get_network_unique_id() const {
 	ERR_FAIL_COND_V_MSG(!network_peer.is_valid(), 0, "No network peer is assigned. Unable to get unique network ID.");
+	if (io_thread) {
+		MutexLock lock(io_mutex);
+		return io_unique_id;
+	}
 	return network_peer->get_unique_id();
 }
 
 bool MultiplayerAPI::is_network_server() const {
 	// XXX Maybe fail silently? Maybe should actually return true to make development of both local and online multiplayer easier?
 	ERR_FAIL_COND_V_MSG(!network_peer.is_valid(), false, "No network peer is assigned. I can't be a server.");
+	if (io_thread) {
+		MutexLock lock(io_mutex);
+		return io_is_server;
+	}
 	return network_peer->is_server();
 }
 
@@ -1217,8 +2366,27 @@ void MultiplayerAPI::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_refusing_new_network_connections"), &MultiplayerAPI::is_refusing_new_network_connections);
 	ClassDB::bind_method(D_METHOD("set_allow_object_decoding", "enable"), &MultiplayerAPI::set_allow_object_decoding);
 	ClassDB::bind_method(D_METHOD("is_object_decoding_allowed"), &MultiplayerAPI::is_object_decoding_allowed);
+	ClassDB::bind_method(D_METHOD("set_threaded_io", "enable"), &MultiplayerAPI::set_threaded_io);
+	ClassDB::bind_method(D_METHOD("is_threaded_io"), &MultiplayerAPI::is_threaded_io);
+	ClassDB::bind_method(D_METHOD("set_interest", "interest"), &MultiplayerAPI::set_interest);
+	ClassDB::bind_method(D_METHOD("get_interest"), &MultiplayerAPI::get_interest);
+	ClassDB::bind_method(D_METHOD("set_rpc_batching", "enable"), &MultiplayerAPI::set_rpc_batching);
+	ClassDB::bind_method(D_METHOD("is_rpc_batching"), &MultiplayerAPI::is_rpc_batching);
+	ClassDB::bind_method(D_METHOD("add_replicated_node", "node", "properties", "interpolate"), &MultiplayerAPI::add_replicated_node, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("remove_replicated_node", "node"), &MultiplayerAPI::remove_replicated_node);
+	ClassDB::bind_method(D_METHOD("is_node_replicated", "node"), &MultiplayerAPI::is_node_replicated);
+	ClassDB::bind_method(D_METHOD("send_snapshot"), &MultiplayerAPI::send_snapshot);
+	ClassDB::bind_method(D_METHOD("set_snapshot_interval", "msec"), &MultiplayerAPI::set_snapshot_interval);
+	ClassDB::bind_method(D_METHOD("get_snapshot_interval"), &MultiplayerAPI::get_snapshot_interval);
+	ClassDB::bind_method(D_METHOD("set_interpolation_delay", "msec"), &MultiplayerAPI::set_interpolation_delay);
+	ClassDB::bind_method(D_METHOD("get_interpolation_delay"), &MultiplayerAPI::get_interpolation_delay);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "allow_object_decoding"), "set_allow_object_decoding", "is_object_decoding_allowed");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "threaded_io"), "set_threaded_io", "is_threaded_io");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "interest", PROPERTY_HINT_RESOURCE_TYPE, "MultiplayerInterest"), "set_interest", "get_interest");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "rpc_batching"), "set_rpc_batching", "is_rpc_batching");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "snapshot_interval", PROPERTY_HINT_RANGE, "0,1000,1"), "set_snapshot_interval", "get_snapshot_interval");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "interpolation_delay", PROPERTY_HINT_RANGE, "0,1000,1"), "set_interpolation_delay", "get_interpolation_delay");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "refuse_new_network_connections"), "set_refuse_new_network_connections", "is_refusing_new_network_connections");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "network_peer", PROPERTY_HINT_RESOURCE_TYPE, "NetworkedMultiplayerPeer", 0), "set_network_peer", "get_network_peer");
 	ADD_PROPERTY_DEFAULT("refuse_new_network_connections", false);
@@ -1237,12 +2405,26 @@ void MultiplayerAPI::_bind_methods() {
 	BIND_ENUM_CONSTANT(RPC_MODE_REMOTESYNC);
 	BIND_ENUM_CONSTANT(RPC_MODE_MASTERSYNC);
 	BIND_ENUM_CONSTANT(RPC_MODE_PUPPETSYNC);
+
+	BIND_ENUM_CONSTANT(RPC_ARG_VARIANT);
+	BIND_ENUM_CONSTANT(RPC_ARG_BOOL);
+	BIND_ENUM_CONSTANT(RPC_ARG_INT);
+	BIND_ENUM_CONSTANT(RPC_ARG_FLOAT);
+	BIND_ENUM_CONSTANT(RPC_ARG_FLOAT_HALF);
+	BIND_ENUM_CONSTANT(RPC_ARG_VECTOR2);
+	BIND_ENUM_CONSTANT(RPC_ARG_VECTOR2_HALF);
+	BIND_ENUM_CONSTANT(RPC_ARG_VECTOR3);
+	BIND_ENUM_CONSTANT(RPC_ARG_VECTOR3_HALF);
 }
 
 MultiplayerAPI::MultiplayerAPI() {
+	io_running = false;
 	clear();
 }
 
 MultiplayerAPI::~MultiplayerAPI() {
+	if (network_peer.is_valid()) {
+		_io_stop();
+	}
 	clear();
 }
@@ -31,9 +31,15 @@
 #ifndef MULTIPLAYER_API_H
 #define MULTIPLAYER_API_H
 
+#include "core/io/multiplayer_interest.h"
 #include "core/io/networked_multiplayer_peer.h"
+#include "core/local_vector.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/reference.h"
 
+#include <atomic>
+
 class MultiplayerAPI : public Reference {
 	GDCLASS(MultiplayerAPI, Reference);
 
@@ -62,7 +68,157 @@ private:
 	int last_send_cache_id;
 	Vector<uint8_t> packet_cache;
 	Node *root_node = nullptr;
+
+	enum {
+		// Received RPC arguments are decoded into an inline buffer up to this count.
+		RPC_INLINE_ARGS = 8,
+	};
+
 	bool allow_object_decoding = false;
+	Ref<MultiplayerInterest> interest;
+
+	// With RPC batching, outgoing RPCs are batched per peer. A peer's batches are
+	// sent when poll() starts and ends, or before any other packet to that peer.
+	bool rpc_batching = false;
+	enum {
+		BATCH_MAX_SIZE = 1200,
+		BATCH_MODE_COUNT = NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE + 1,
+	};
+
+	struct PeerBatch {
+		Vector<uint8_t> buffers[BATCH_MODE_COUNT]; // One per transfer mode.
+	};
+
+	Map<int, PeerBatch> peer_batches;
+
+	void _get_relevant_peers(Node *p_node, int p_to, Vector<int> &r_peers);
+	void _put_batched(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len);
+	void _flush_batch(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, Vector<uint8_t> &r_batch);
+	void _flush_peer_batches(int p_to, PeerBatch &r_batches);
+	void _flush_batches();
+
+	// Threaded I/O: the network peer is polled on its own thread, which
+	// queues received packets and peer events in order. The main thread only
+	// dispatches them, and its outgoing packets are queued for the thread.
+	struct IOMessage {
+		int peer = 0; // Sender when received, target when sent.
+		NetworkedMultiplayerPeer::TransferMode mode = NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE;
+		int offset = 0; // Packet data, in the queue data.
+		int size = 0;
+	};
+
+	// Messages stored back to back. Each direction has two queues: the
+	// producer appends to the back one under io_mutex, the consumer swaps them
+	// under io_mutex and reads the front one unlocked. Both keep their capacity.
+	struct IOQueue {
+		LocalVector<IOMessage> messages;
+		LocalVector<uint8_t> data;
+
+		void push(int p_peer, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len);
+		const uint8_t *get_data(const IOMessage &p_msg) const {
+			return p_msg.size ? &data[p_msg.offset] : nullptr; // Empty packets may point past the end.
+		}
+		void clear() {
+			messages.clear();
+			data.clear();
+		}
+	};
+
+	enum {
+		// Longest wait for incoming packets, which is also the longest delay
+		// before packets queued by poll() are sent.
+		IO_THREAD_WAIT_MSEC = 4,
+	};
+
+	bool threaded_io = false;
+	Thread *io_thread = nullptr;
+	std::atomic<bool> io_running;
+	mutable Mutex io_mutex; // Guards the queues and cached peer state.
+	IOQueue io_in[2]; // Received packets.
+	int io_in_back = 0;
+	IOQueue io_out[2]; // Packets to send.
+	int io_out_back = 0;
+	bool io_dispatching = false;
+	NetworkedMultiplayerPeer::ConnectionStatus io_connection_status = NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED;
+	int io_unique_id = 0;
+	bool io_is_server = false;
+
+	static void _io_thread_func(void *p_ud);
+	void _io_poll();
+	void _io_send(const IOQueue &p_queue);
+	void _io_start();
+	void _io_stop();
+	void _dispatch_io_events();
+
+	void _connect_peer_signals();
+	void _disconnect_peer_signals();
+	NetworkedMultiplayerPeer::ConnectionStatus _get_connection_status() const;
+	Error _put_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len);
+	Error _put_packet_direct(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len);
+
+	// Snapshot replication: the server samples the registered properties every
+	// network tick and sends each peer a delta against the last snapshot that
+	// peer acknowledged. Clients rebuild full snapshots from their own history.
+	enum {
+		REPLICATION_HISTORY_SIZE = 32,
+		REPLICATION_INTERPOLATION_BUFFER_SIZE = 4,
+	};
+
+	struct ReplicatedNode {
+		ObjectID instance;
+		Vector<StringName> properties;
+		bool interpolate = false;
+	};
+
+	struct RemoteReplicatedNode {
+		struct Sample {
+			uint32_t time = 0;
+			Vector<Variant> values;
+		};
+
+		NodePath path;
+		ObjectID instance;
+		Vector<StringName> properties;
+		bool interpolate = false;
+		Vector<Sample> samples; // Oldest first.
+	};
+
+	struct ReplicationSnapshot {
+		uint32_t seq = 0; // 0 means unused.
+		uint32_t time = 0;
+		Map<uint32_t, Vector<Variant>> nodes;
+	};
+
+	struct ReplicationPeer {
+		uint32_t acked = 0;
+		// Nodes sent to the peer in each snapshot of the history.
+		uint32_t sent_seq[REPLICATION_HISTORY_SIZE] = {};
+		Set<uint32_t> sent_nodes[REPLICATION_HISTORY_SIZE];
+	};
+
+	// Server.
+	Map<uint32_t, ReplicatedNode> replicated_nodes;
+	uint32_t replication_last_id = 0;
+	uint32_t replication_seq = 0;
+	ReplicationSnapshot replication_history[REPLICATION_HISTORY_SIZE];
+	Map<int, ReplicationPeer> replication_peers;
+	int snapshot_interval = 50;
+	uint64_t replication_last_send = 0;
+
+	// Client.
+	Map<uint32_t, RemoteReplicatedNode> replication_remote_nodes;
+	ReplicationSnapshot replication_received[REPLICATION_HISTORY_SIZE];
+	uint32_t replication_last_received = 0;
+	int64_t replication_time_offset = 0;
+	int interpolation_delay = 100;
+
+	void _replication_poll();
+	void _replication_interpolate();
+	void _replication_clear();
+	Node *_get_remote_replicated_node(RemoteReplicatedNode &p_remote);
+	bool _can_replicate_property(Node *p_node, const StringName &p_property, int p_from);
+	bool _encode_snapshot_node(uint32_t p_id, const ReplicationSnapshot &p_snapshot, const ReplicationSnapshot *p_base, const Set<uint32_t> *p_base_nodes, Vector<uint8_t> &r_buffer);
+	void _encode_snapshot(const ReplicationSnapshot &p_snapshot, const Vector<uint32_t> &p_nodes, const ReplicationSnapshot *p_base, const Set<uint32_t> *p_base_nodes, Vector<uint8_t> &r_packet, Vector<uint32_t> &r_sent_nodes);
 
 protected:
 	static void _bind_methods();
@@ -74,12 +230,17 @@ protected:
 	void _process_rpc(Node *p_node, const uint16_t p_rpc_method_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 	void _process_rset(Node *p_node, const uint16_t p_rpc_property_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 	void _process_raw(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_snapshot(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_snapshot_ack(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_batch(int p_from, const uint8_t *p_packet, int p_packet_len);
 
 	void _send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p_set, const StringName &p_name, const Variant **p_arg, int p_argcount);
 	bool _send_confirm_path(Node *p_node, NodePath p_path, PathSentCache *psc, int p_target);
 
 	Error _encode_and_compress_variant(const Variant &p_variant, uint8_t *p_buffer, int &r_len);
 	Error _decode_and_decompress_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len);
+	int _encode_typed_args(const Vector<int> &p_formats, const Variant **p_arg, int p_argcount, uint8_t *r_buffer);
+	Error _decode_typed_args(const Vector<int> &p_formats, const uint8_t *p_buffer, int p_len, Variant *r_args);
 
 public:
 	enum NetworkCommands {
@@ -88,6 +249,9 @@ public:
 		NETWORK_COMMAND_SIMPLIFY_PATH,
 		NETWORK_COMMAND_CONFIRM_PATH,
 		NETWORK_COMMAND_RAW,
+		NETWORK_COMMAND_SNAPSHOT,
+		NETWORK_COMMAND_SNAPSHOT_ACK,
+		NETWORK_COMMAND_BATCH,
 	};
 
 	enum NetworkNodeIdCompression {
@@ -112,6 +276,21 @@ public:
 		RPC_MODE_PUPPETSYNC, // Using rpc() on it will call method / set property in all puppets peers and locally
 	};
 
+	// Per-argument wire formats for RPCs configured with a signature (see Node::rpc_config).
+	// Typed arguments are sent without type headers.
+	enum RPCArgFormat {
+		RPC_ARG_VARIANT, // Regular (compressed) Variant encoding.
+		RPC_ARG_BOOL, // 1 bit, packed with the other bool arguments.
+		RPC_ARG_INT, // Zig-zag varint, 1 to 10 bytes.
+		RPC_ARG_FLOAT, // 32-bit float.
+		RPC_ARG_FLOAT_HALF, // 16-bit half float.
+		RPC_ARG_VECTOR2, // 2 x 32-bit float.
+		RPC_ARG_VECTOR2_HALF, // 2 x 16-bit half float.
+		RPC_ARG_VECTOR3, // 3 x 32-bit float.
+		RPC_ARG_VECTOR3_HALF, // 3 x 16-bit half float.
+		RPC_ARG_MAX,
+	};
+
 	void poll();
 	void clear();
 	void set_root_node(Node *p_node);
@@ -141,10 +320,30 @@ public:
 	void set_allow_object_decoding(bool p_enable);
 	bool is_object_decoding_allowed() const;
 
+	void set_threaded_io(bool p_enable);
+	bool is_threaded_io() const;
+
+	void set_interest(const Ref<MultiplayerInterest> &p_interest);
+	Ref<MultiplayerInterest> get_interest() const;
+
+	void set_rpc_batching(bool p_enable);
+	bool is_rpc_batching() const;
+
+	void add_replicated_node(Node *p_node, const PackedStringArray &p_properties, bool p_interpolate = false);
+	void remove_replicated_node(Node *p_node);
+	bool is_node_replicated(Node *p_node) const;
+	void send_snapshot();
+
+	void set_snapshot_interval(int p_msec);
+	int get_snapshot_interval() const;
+	void set_interpolation_delay(int p_msec);
+	int get_interpolation_delay() const;
+
 	MultiplayerAPI();
 	~MultiplayerAPI();
 };
 
 VARIANT_ENUM_CAST(MultiplayerAPI::RPCMode);
+VARIANT_ENUM_CAST(MultiplayerAPI::RPCArgFormat);
 
 #endif // MULTIPLAYER_API_H
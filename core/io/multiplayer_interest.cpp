@@ -0,0 +1,69 @@
+/*************************************************************************/
+/*  multiplayer_interest.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "multiplayer_interest.h"
+
+#include "scene/main/node.h"
+
+void MultiplayerInterest::update() {
+	if (get_script_instance() && get_script_instance()->has_method("_update")) {
+		get_script_instance()->call("_update");
+	}
+}
+
+void MultiplayerInterest::get_relevant_peers(Node *p_node, const Vector<int> &p_peers, Vector<int> &r_peers) {
+	if (get_script_instance() && get_script_instance()->has_method("_get_relevant_peers")) {
+		PackedInt32Array peers;
+		peers.resize(p_peers.size());
+		for (int i = 0; i < p_peers.size(); i++) {
+			peers.write[i] = p_peers[i];
+		}
+		PackedInt32Array relevant = get_script_instance()->call("_get_relevant_peers", p_node, peers);
+
+		// Only keep the candidates, once each, whatever the script returned.
+		Set<int> candidates;
+		for (int i = 0; i < p_peers.size(); i++) {
+			candidates.insert(p_peers[i]);
+		}
+		for (int i = 0; i < relevant.size(); i++) {
+			if (candidates.erase(relevant[i])) {
+				r_peers.push_back(relevant[i]);
+			}
+		}
+		return;
+	}
+
+	r_peers.append_array(p_peers);
+}
+
+void MultiplayerInterest::_bind_methods() {
+	ClassDB::add_virtual_method(get_class_static(), MethodInfo("_update"));
+	ClassDB::add_virtual_method(get_class_static(), MethodInfo(Variant::PACKED_INT32_ARRAY, "_get_relevant_peers", PropertyInfo(Variant::OBJECT, "node", PROPERTY_HINT_RESOURCE_TYPE, "Node"), PropertyInfo(Variant::PACKED_INT32_ARRAY, "peers")));
+}
@@ -0,0 +1,56 @@
+/*************************************************************************/
+/*  multiplayer_interest.h                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef MULTIPLAYER_INTEREST_H
+#define MULTIPLAYER_INTEREST_H
+
+#include "core/reference.h"
+
+class Node;
+
+// Decides which peers receive the broadcast RPCs, RSETs and snapshots of a node.
+// The default implementation considers every peer relevant, or defers to the
+// "_get_relevant_peers" script method when one is provided.
+class MultiplayerInterest : public Reference {
+	GDCLASS(MultiplayerInterest, Reference);
+
+protected:
+	static void _bind_methods();
+
+public:
+	// Called once per network tick, before any relevancy query.
+	virtual void update();
+	// Appends to r_peers those of p_peers that are interested in p_node.
+	virtual void get_relevant_peers(Node *p_node, const Vector<int> &p_peers, Vector<int> &r_peers);
+
+	MultiplayerInterest() {}
+};
+
+#endif // MULTIPLAYER_INTEREST_H
@@ -32,6 +32,7 @@
 #define NET_SOCKET_H
 
 #include "core/io/ip.h"
+#include "core/local_vector.h"
 #include "core/reference.h"
 
 class NetSocket : public Reference {
@@ -77,4 +78,31 @@ public:
 	virtual Error leave_multicast_group(const IP_Address &p_multi_address, String p_if_name) = 0;
 };
 
+// Waits for readiness on many sockets at once (epoll where available,
+// poll/WSAPoll otherwise). Sockets are identified by a caller-chosen id.
+class NetSocketPoller : public Reference {
+protected:
+	static NetSocketPoller *(*_create)();
+
+public:
+	static NetSocketPoller *create();
+
+	struct Event {
+		int id = 0;
+		bool readable = false;
+		bool writable = false;
+		bool error = false; // Error or hang-up, reading will report it.
+	};
+
+	virtual Error add_socket(int p_id, const Ref<NetSocket> &p_socket, NetSocket::PollType p_type) = 0;
+	virtual Error modify_socket(int p_id, NetSocket::PollType p_type) = 0;
+	virtual void remove_socket(int p_id) = 0;
+	virtual bool has_socket(int p_id) const = 0;
+	virtual int get_socket_count() const = 0;
+	virtual void clear() = 0;
+
+	// Fills r_events with the sockets that are ready. A negative timeout blocks.
+	virtual Error wait(LocalVector<Event> &r_events, int p_timeout) = 0;
+};
+
 #endif // NET_SOCKET_H
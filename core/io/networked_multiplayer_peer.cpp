@@ -30,6 +30,63 @@
 
 #include "networked_multiplayer_peer.h"
 
+#include "core/os/os.h"
+
+void NetworkedMultiplayerPeer::wait_for_packets(int p_timeout_msec) {
+	OS::get_singleton()->delay_usec(p_timeout_msec * 1000);
+}
+
+void NetworkedMultiplayerPeer::_queue_or_emit(const QueuedSignal &p_signal) {
+	signal_queue_mutex.lock();
+	if (signals_queued) {
+		signal_queue.push_back(p_signal);
+		signal_queue_mutex.unlock();
+		return;
+	}
+	signal_queue_mutex.unlock();
+
+	if (p_signal.has_peer) {
+		emit_signal(p_signal.name, p_signal.peer);
+	} else {
+		emit_signal(p_signal.name);
+	}
+}
+
+void NetworkedMultiplayerPeer::_emit_peer_signal(const StringName &p_name) {
+	QueuedSignal s;
+	s.name = p_name;
+	_queue_or_emit(s);
+}
+
+void NetworkedMultiplayerPeer::_emit_peer_signal(const StringName &p_name, int p_peer) {
+	QueuedSignal s;
+	s.name = p_name;
+	s.peer = p_peer;
+	s.has_peer = true;
+	_queue_or_emit(s);
+}
+
+void NetworkedMultiplayerPeer::set_signals_queued(bool p_enable) {
+	MutexLock lock(signal_queue_mutex);
+	signals_queued = p_enable;
+}
+
+void NetworkedMultiplayerPeer::flush_queued_signals() {
+	LocalVector<QueuedSignal> signals;
+	signal_queue_mutex.lock();
+	signals = signal_queue;
+	signal_queue.clear();
+	signal_queue_mutex.unlock();
+
+	for (uint32_t i = 0; i < signals.size(); i++) {
+		if (signals[i].has_peer) {
+			emit_signal(signals[i].name, signals[i].peer);
+		} else {
+			emit_signal(signals[i].name);
+		}
+	}
+}
+
 void NetworkedMultiplayerPeer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_transfer_mode", "mode"), &NetworkedMultiplayerPeer::set_transfer_mode);
 	ClassDB::bind_method(D_METHOD("get_transfer_mode"), &NetworkedMultiplayerPeer::get_transfer_mode);
@@ -32,11 +32,32 @@
 #define NETWORKED_MULTIPLAYER_PEER_H
 
 #include "core/io/packet_peer.h"
+#include "core/local_vector.h"
+#include "core/os/mutex.h"
 
 class NetworkedMultiplayerPeer : public PacketPeer {
 	GDCLASS(NetworkedMultiplayerPeer, PacketPeer);
 
+	struct QueuedSignal {
+		StringName name;
+		int peer = 0;
+		bool has_peer = false;
+	};
+
+	Mutex signal_queue_mutex;
+	bool signals_queued = false;
+	LocalVector<QueuedSignal> signal_queue;
+
+	void _queue_or_emit(const QueuedSignal &p_signal);
+
 protected:
+	// Implementations that support threaded polling lock this in their public
+	// methods, and emit their connection signals through _emit_peer_signal().
+	mutable Mutex peer_mutex;
+
+	void _emit_peer_signal(const StringName &p_name);
+	void _emit_peer_signal(const StringName &p_name, int p_peer);
+
 	static void _bind_methods();
 
 public:
@@ -73,6 +94,20 @@ public:
 
 	virtual ConnectionStatus get_connection_status() const = 0;
 
+	// Threaded polling, used by MultiplayerAPI.threaded_io. A peer that
+	// supports it can be polled from one thread while being used from another.
+	virtual bool is_threaded_poll_supported() const { return false; }
+	// Blocks until packets may be available, or for at most p_timeout_msec.
+	virtual void wait_for_packets(int p_timeout_msec);
+	// Held by the polling thread while it uses the peer over several calls.
+	void lock() const { peer_mutex.lock(); }
+	void unlock() const { peer_mutex.unlock(); }
+
+	// While enabled, the connection signals emitted by poll() are queued, and
+	// emitted from the thread calling flush_queued_signals().
+	void set_signals_queued(bool p_enable);
+	void flush_queued_signals();
+
 	NetworkedMultiplayerPeer() {}
 };
 
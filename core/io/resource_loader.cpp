@@ -327,7 +327,7 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 			}
 
 			//get ptr
-			Resource **rptr = ResourceCache::resources.getptr(local_path);
+			Resource **rptr = ResourceCache::resources.lookup_ptr(local_path);
 
 			if (rptr) {
 				RES res(*rptr);
@@ -538,7 +538,7 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 			ResourceCache::lock->read_lock();
 		}
 
-		Resource **rptr = ResourceCache::resources.getptr(local_path);
+		Resource **rptr = ResourceCache::resources.lookup_ptr(local_path);
 
 		if (rptr) {
 			RES res(*rptr);
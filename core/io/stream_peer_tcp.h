@@ -77,6 +77,9 @@ public:
 
 	void set_no_delay(bool p_enabled);
 
+	// Underlying socket, for registering with a NetSocketPoller.
+	Ref<NetSocket> get_socket() const { return _sock; }
+
 	// Poll functions (wait or check for writable, readable)
 	Error poll(NetSocket::PollType p_type, int timeout = 0);
 
@@ -53,6 +53,9 @@ public:
 	bool is_connection_available() const;
 	Ref<StreamPeerTCP> take_connection();
 
+	// Listening socket, for registering with a NetSocketPoller.
+	Ref<NetSocket> get_socket() const { return _sock; }
+
 	void stop(); // Stop listening
 
 	TCP_Server();
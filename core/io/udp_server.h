@@ -49,6 +49,10 @@ public:
 	bool is_connection_available() const;
 	Ref<PacketPeerUDP> take_connection();
 
+	// Listening socket, for registering with a NetSocketPoller. Note that
+	// take_connection() replaces it with a new socket.
+	Ref<NetSocket> get_socket() const { return _sock; }
+
 	void stop();
 
 	UDPServer();
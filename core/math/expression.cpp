@@ -680,7 +680,7 @@ void Expression::exec_func(BuiltinFunc p_func, const Variant **p_inputs, Variant
 			PackedByteArray barr;
 			bool full_objects = *p_inputs[1];
 			int len;
-			Error err = encode_variant(*p_inputs[0], nullptr, len, full_objects);
+			Error err = encode_variant(*p_inputs[0], barr, len, full_objects);
 			if (err) {
 				r_error.error = Callable::CallError::CALL_ERROR_INVALID_ARGUMENT;
 				r_error.argument = 0;
@@ -690,10 +690,6 @@ void Expression::exec_func(BuiltinFunc p_func, const Variant **p_inputs, Variant
 			}
 
 			barr.resize(len);
-			{
-				uint8_t *w = barr.ptrw();
-				encode_variant(*p_inputs[0], w, len, full_objects);
-			}
 			*r_return = barr;
 		} break;
 		case BYTES_TO_VAR: {
@@ -34,12 +34,55 @@
 #include "core/project_settings.h"
 #include "core/script_language.h"
 
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
 MessageQueue *MessageQueue::singleton = nullptr;
 
+// Hints the CPU that this is a spin-wait loop.
+static _FORCE_INLINE_ void _cpu_pause() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	_mm_pause();
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	__builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+	__asm__ __volatile__("yield");
+#endif
+}
+
 MessageQueue *MessageQueue::get_singleton() {
 	return singleton;
 }
 
+// Returns room for a message of p_room_needed bytes, or nullptr when the
+// buffer is full. The message is constructed but not published yet.
+MessageQueue::Message *MessageQueue::_reserve(uint32_t p_room_needed) {
+	uint32_t pos = buffer_end.load(std::memory_order_relaxed);
+	do {
+		if (pos + p_room_needed >= buffer_size) {
+			return nullptr;
+		}
+		// Acquire pairs with the rewind in flush(), which cleared this room.
+	} while (!buffer_end.compare_exchange_weak(pos, pos + p_room_needed, std::memory_order_acquire, std::memory_order_relaxed));
+
+	return memnew_placement(&buffer[pos], Message);
+}
+
+uint32_t MessageQueue::_get_message_size(const Message *p_message) {
+	uint32_t size = sizeof(Message);
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		size += sizeof(Variant) * p_message->args;
+	}
+	return size;
+}
+
+bool MessageQueue::_is_ready(const uint8_t *p_pos) {
+	return ((const Message *)p_pos)->ready.load(std::memory_order_acquire);
+}
+
 Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
 	return push_callable(Callable(p_id, p_method), p_args, p_argcount, p_show_error);
 }
@@ -60,11 +103,10 @@ Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, VARIANT
 }
 
 Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	_THREAD_SAFE_METHOD_
-
-	uint8_t room_needed = sizeof(Message) + sizeof(Variant);
+	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	if ((buffer_end + room_needed) >= buffer_size) {
+	Message *msg = _reserve(room_needed);
+	if (!msg) {
 		String type;
 		if (ObjectDB::get_instance(p_id)) {
 			type = ObjectDB::get_instance(p_id)->get_class();
@@ -74,41 +116,35 @@ Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Vari
 		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
 	msg->type = TYPE_SET;
 
-	buffer_end += sizeof(Message);
+	memnew_placement(msg + 1, Variant(p_value));
 
-	Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-	buffer_end += sizeof(Variant);
-	*v = p_value;
+	msg->ready.store(1, std::memory_order_release);
 
 	return OK;
 }
 
 Error MessageQueue::push_notification(ObjectID p_id, int p_notification) {
-	_THREAD_SAFE_METHOD_
-
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
 
-	uint8_t room_needed = sizeof(Message);
+	uint32_t room_needed = sizeof(Message);
 
-	if ((buffer_end + room_needed) >= buffer_size) {
+	Message *msg = _reserve(room_needed);
+	if (!msg) {
 		print_line("Failed notification: " + itos(p_notification) + " target ID: " + itos(p_id));
 		statistics();
 		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
-
 	msg->type = TYPE_NOTIFICATION;
 	msg->callable = Callable(p_id, CoreStringNames::get_singleton()->notification); //name is meaningless but callable needs it
 	//msg->target;
 	msg->notification = p_notification;
 
-	buffer_end += sizeof(Message);
+	msg->ready.store(1, std::memory_order_release);
 
 	return OK;
 }
@@ -126,17 +162,15 @@ Error MessageQueue::push_set(Object *p_object, const StringName &p_prop, const V
 }
 
 Error MessageQueue::push_callable(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
-	_THREAD_SAFE_METHOD_
-
-	int room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+	uint32_t room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
 
-	if ((buffer_end + room_needed) >= buffer_size) {
+	Message *msg = _reserve(room_needed);
+	if (!msg) {
 		print_line("Failed method: " + p_callable);
 		statistics();
 		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
 	msg->type = TYPE_CALL;
@@ -144,14 +178,13 @@ Error MessageQueue::push_callable(const Callable &p_callable, const Variant **p_
 		msg->type |= FLAG_SHOW_ERROR;
 	}
 
-	buffer_end += sizeof(Message);
-
+	Variant *args = (Variant *)(msg + 1);
 	for (int i = 0; i < p_argcount; i++) {
-		Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-		buffer_end += sizeof(Variant);
-		*v = *p_args[i];
+		memnew_placement(&args[i], Variant(*p_args[i]));
 	}
 
+	msg->ready.store(1, std::memory_order_release);
+
 	return OK;
 }
 
@@ -171,13 +204,30 @@ Error MessageQueue::push_callable(const Callable &p_callable, VARIANT_ARG_DECLAR
 }
 
 void MessageQueue::statistics() {
+	// Messages can only be inspected while no other thread runs them. Producers
+	// may still be writing, so stop at the first one that isn't published.
+	uint32_t read_pos = 0;
+	int state = FLUSH_IDLE;
+	bool inspecting = flush_state.compare_exchange_strong(state, FLUSH_INSPECTING, std::memory_order_acquire);
+	if (!inspecting) {
+		if (state == FLUSH_RUNNING && flush_thread.load(std::memory_order_relaxed) == Thread::get_caller_id()) {
+			read_pos = flush_read_pos; // Pushed from a message being flushed, what follows wasn't run.
+		} else {
+			print_line("TOTAL BYTES: " + itos(buffer_end.load(std::memory_order_relaxed)));
+			print_line("BUFFER SIZE: " + itos(buffer_size));
+			print_line("MAX USED: " + itos(buffer_max_used.load(std::memory_order_relaxed)));
+			print_line("Messages are being flushed by another thread, not listing them.");
+			return;
+		}
+	}
+
 	Map<StringName, int> set_count;
 	Map<int, int> notify_count;
 	Map<Callable, int> call_count;
 	int null_count = 0;
 
-	uint32_t read_pos = 0;
-	while (read_pos < buffer_end) {
+	uint32_t end = buffer_end.load(std::memory_order_acquire);
+	while (read_pos < end && _is_ready(&buffer[read_pos])) {
 		Message *message = (Message *)&buffer[read_pos];
 
 		Object *target = message->callable.get_object();
@@ -218,13 +268,16 @@ void MessageQueue::statistics() {
 			null_count++;
 		}
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			read_pos += sizeof(Variant) * message->args;
-		}
+		read_pos += _get_message_size(message);
 	}
 
-	print_line("TOTAL BYTES: " + itos(buffer_end));
+	if (inspecting) {
+		flush_state.store(FLUSH_IDLE, std::memory_order_release);
+	}
+
+	print_line("TOTAL BYTES: " + itos(end));
+	print_line("BUFFER SIZE: " + itos(buffer_size));
+	print_line("MAX USED: " + itos(buffer_max_used.load(std::memory_order_relaxed)));
 	print_line("NULL count: " + itos(null_count));
 
 	for (Map<StringName, int>::Element *E = set_count.front(); E; E = E->next()) {
@@ -241,7 +294,7 @@ void MessageQueue::statistics() {
 }
 
 int MessageQueue::get_max_buffer_usage() const {
-	return buffer_max_used;
+	return buffer_max_used.load(std::memory_order_relaxed);
 }
 
 void MessageQueue::_call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error) {
@@ -262,35 +315,52 @@ void MessageQueue::_call_function(const Callable &p_callable, const Variant *p_a
 }
 
 void MessageQueue::flush() {
-	if (buffer_end > buffer_max_used) {
-		buffer_max_used = buffer_end;
+	int state = FLUSH_IDLE;
+	while (!flush_state.compare_exchange_weak(state, FLUSH_RUNNING, std::memory_order_acquire)) {
+		ERR_FAIL_COND_MSG(state == FLUSH_RUNNING, "Already flushing the message queue, you did something odd.");
+		if (state == FLUSH_INSPECTING) {
+			std::this_thread::yield(); // statistics() is listing the messages, it doesn't take long.
+		}
+		state = FLUSH_IDLE;
 	}
+	flush_thread.store(Thread::get_caller_id(), std::memory_order_relaxed);
 
 	uint32_t read_pos = 0;
 
-	//using reverse locking strategy
-	_THREAD_SAFE_LOCK_
-
-	if (flushing) {
-		_THREAD_SAFE_UNLOCK_
-		ERR_FAIL_COND(flushing); //already flushing, you did something odd
-	}
-	flushing = true;
-
-	while (read_pos < buffer_end) {
-		//lock on each iteration, so a call can re-add itself to the message queue
+	while (true) {
+		uint32_t end = buffer_end.load(std::memory_order_acquire);
 
-		Message *message = (Message *)&buffer[read_pos];
+		if (read_pos == end) {
+			// Everything reserved so far was run, rewind unless a message was
+			// pushed in the meantime.
+			if (end > buffer_max_used.load(std::memory_order_relaxed)) {
+				buffer_max_used.store(end, std::memory_order_relaxed);
+			}
+			if (buffer_end.compare_exchange_strong(end, 0, std::memory_order_acq_rel)) {
+				break;
+			}
+			continue;
+		}
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
+		// A call can re-add itself to the message queue, so messages pushed while
+		// flushing are run too.
+		uint8_t *pos = &buffer[read_pos];
+		// Reserved by another thread which is still writing it. That takes
+		// very little time, unless the writer was preempted.
+		for (int spins = 0; !_is_ready(pos); spins++) {
+			if (spins < READY_SPIN_COUNT) {
+				_cpu_pause();
+			} else {
+				std::this_thread::yield();
+			}
 		}
 
-		//pre-advance so this function is reentrant
-		read_pos += advance;
+		Message *message = (Message *)pos;
+		uint32_t size = _get_message_size(message);
 
-		_THREAD_SAFE_UNLOCK_
+		//pre-advance so this function is reentrant
+		read_pos += size;
+		flush_read_pos = read_pos;
 
 		Object *target = message->callable.get_object();
 
@@ -327,16 +397,16 @@ void MessageQueue::flush() {
 
 		message->~Message();
 
-		_THREAD_SAFE_LOCK_
+		// Messages land at different offsets once the buffer rewinds, so clear
+		// all of it for the next ready flag placed here to read as unpublished.
+		memset(pos, 0, size);
 	}
 
-	buffer_end = 0; // reset buffer
-	flushing = false;
-	_THREAD_SAFE_UNLOCK_
+	flush_state.store(FLUSH_IDLE, std::memory_order_release);
 }
 
 bool MessageQueue::is_flushing() const {
-	return flushing;
+	return flush_state.load(std::memory_order_acquire) == FLUSH_RUNNING;
 }
 
 MessageQueue::MessageQueue() {
@@ -347,12 +417,15 @@ MessageQueue::MessageQueue() {
 	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/message_queue/max_size_kb", PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_kb", PROPERTY_HINT_RANGE, "1024,4096,1,or_greater"));
 	buffer_size *= 1024;
 	buffer = memnew_arr(uint8_t, buffer_size);
+	// flush() relies on unused room reading as unpublished.
+	memset(buffer, 0, buffer_size);
 }
 
 MessageQueue::~MessageQueue() {
+	uint32_t end = buffer_end.load(std::memory_order_acquire);
 	uint32_t read_pos = 0;
 
-	while (read_pos < buffer_end) {
+	while (read_pos < end && _is_ready(&buffer[read_pos])) {
 		Message *message = (Message *)&buffer[read_pos];
 		Variant *args = (Variant *)(message + 1);
 		int argc = message->args;
@@ -361,12 +434,10 @@ MessageQueue::~MessageQueue() {
 				args[i].~Variant();
 			}
 		}
+		uint32_t size = _get_message_size(message);
 		message->~Message();
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			read_pos += sizeof(Variant) * message->args;
-		}
+		read_pos += size;
 	}
 
 	singleton = nullptr;
@@ -32,16 +32,32 @@
 #define MESSAGE_QUEUE_H
 
 #include "core/object.h"
-#include "core/os/thread_safe.h"
+#include "core/os/thread.h"
 
-class MessageQueue {
-	_THREAD_SAFE_CLASS_
+#include <atomic>
 
+// Producers never lock: each push reserves its room in the buffer with a
+// compare-and-swap on the write cursor, constructs the message there, and
+// then publishes it by setting its ready flag. Messages are flushed in the
+// order their room was reserved, and flush() waits for a reserved message
+// to be published before running it.
+class MessageQueue {
 	enum {
 
 		DEFAULT_QUEUE_SIZE_KB = 1024
 	};
 
+	enum {
+		READY_SPIN_COUNT = 64, // Before yielding to the writer of a message.
+	};
+
+	// Only one thread at a time may run or inspect the published messages.
+	enum FlushState {
+		FLUSH_IDLE,
+		FLUSH_RUNNING,
+		FLUSH_INSPECTING, // By statistics().
+	};
+
 	enum {
 		TYPE_CALL,
 		TYPE_NOTIFICATION,
@@ -52,6 +68,7 @@ class MessageQueue {
 	};
 
 	struct Message {
+		std::atomic<uint32_t> ready = { 0 };
 		Callable callable;
 		int16_t type;
 		union {
@@ -61,15 +78,23 @@ class MessageQueue {
 	};
 
 	uint8_t *buffer;
-	uint32_t buffer_end = 0;
-	uint32_t buffer_max_used = 0;
+	std::atomic<uint32_t> buffer_end = { 0 };
+	std::atomic<uint32_t> buffer_max_used = { 0 };
 	uint32_t buffer_size;
 
+	Message *_reserve(uint32_t p_room_needed);
+	_FORCE_INLINE_ static uint32_t _get_message_size(const Message *p_message);
+	_FORCE_INLINE_ static bool _is_ready(const uint8_t *p_pos);
+
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
 	static MessageQueue *singleton;
 
-	bool flushing = false;
+	std::atomic<int> flush_state = { FLUSH_IDLE };
+	// Lets statistics(), when called from a message being flushed, walk the
+	// messages that weren't run yet.
+	std::atomic<Thread::ID> flush_thread = { 0 };
+	uint32_t flush_read_pos = 0;
 
 public:
 	static MessageQueue *get_singleton();
@@ -65,6 +65,7 @@ private:
 	uint32_t num_elements = 0;
 
 	static const uint32_t EMPTY_HASH = 0;
+	static const uint32_t MIN_CAPACITY = 8;
 
 	_FORCE_INLINE_ uint32_t _hash(const TKey &p_key) const {
 		uint32_t hash = Hasher::hash(p_key);
@@ -77,8 +78,8 @@ private:
 	}
 
 	_FORCE_INLINE_ uint32_t _get_probe_length(uint32_t p_pos, uint32_t p_hash) const {
-		uint32_t original_pos = p_hash % capacity;
-		return (p_pos - original_pos + capacity) % capacity;
+		uint32_t original_pos = p_hash & (capacity - 1);
+		return (p_pos - original_pos) & (capacity - 1);
 	}
 
 	_FORCE_INLINE_ void _construct(uint32_t p_pos, uint32_t p_hash, const TKey &p_key, const TValue &p_value) {
@@ -89,46 +90,81 @@ private:
 		num_elements++;
 	}
 
-	bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
-		uint32_t hash = _hash(p_key);
-		uint32_t pos = hash % capacity;
+	bool _lookup_pos_with_hash(const TKey &p_key, uint32_t p_hash, uint32_t &r_pos) const {
+		if (num_elements == 0) {
+			return false;
+		}
+
+		uint32_t mask = capacity - 1;
+		uint32_t pos = p_hash & mask;
 		uint32_t distance = 0;
 
 		while (true) {
-			if (hashes[pos] == EMPTY_HASH) {
+			uint32_t existing_hash = hashes[pos];
+			if (existing_hash == EMPTY_HASH) {
 				return false;
 			}
 
-			if (distance > _get_probe_length(pos, hashes[pos])) {
+			if (distance > ((pos - existing_hash) & mask)) {
 				return false;
 			}
 
-			if (hashes[pos] == hash && Comparator::compare(keys[pos], p_key)) {
+			if (existing_hash == p_hash && Comparator::compare(keys[pos], p_key)) {
 				r_pos = pos;
 				return true;
 			}
 
-			pos = (pos + 1) % capacity;
+			pos = (pos + 1) & mask;
 			distance++;
 		}
 	}
 
-	void _insert_with_hash(uint32_t p_hash, const TKey &p_key, const TValue &p_value) {
-		uint32_t hash = p_hash;
+	_FORCE_INLINE_ bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		return _lookup_pos_with_hash(p_key, _hash(p_key), r_pos);
+	}
+
+	// Returns the position the new pair ends up in.
+	uint32_t _insert_with_hash(uint32_t p_hash, const TKey &p_key, const TValue &p_value) {
+		uint32_t mask = capacity - 1;
 		uint32_t distance = 0;
-		uint32_t pos = hash % capacity;
+		uint32_t pos = p_hash & mask;
 
-		TKey key = p_key;
-		TValue value = p_value;
+		// Walk until a free slot or a richer entry is found, so the key and value
+		// are only copied into the table once in the common case.
+		while (true) {
+			if (hashes[pos] == EMPTY_HASH) {
+				_construct(pos, p_hash, p_key, p_value);
+				return pos;
+			}
+
+			if (_get_probe_length(pos, hashes[pos]) < distance) {
+				break;
+			}
+
+			pos = (pos + 1) & mask;
+			distance++;
+		}
+
+		// Displace the richer entry and keep shifting it down the probe sequence.
+		uint32_t hash = hashes[pos];
+		TKey key = keys[pos];
+		TValue value = values[pos];
+		uint32_t result = pos;
+
+		hashes[pos] = p_hash;
+		keys[pos] = p_key;
+		values[pos] = p_value;
+
+		distance = _get_probe_length(pos, hash);
+		pos = (pos + 1) & mask;
+		distance++;
 
 		while (true) {
 			if (hashes[pos] == EMPTY_HASH) {
 				_construct(pos, hash, key, value);
-
-				return;
+				return result;
 			}
 
-			// not an empty slot, let's check the probing length of the existing one
 			uint32_t existing_probe_len = _get_probe_length(pos, hashes[pos]);
 			if (existing_probe_len < distance) {
 				SWAP(hash, hashes[pos]);
@@ -137,7 +173,7 @@ private:
 				distance = existing_probe_len;
 			}
 
-			pos = (pos + 1) % capacity;
+			pos = (pos + 1) & mask;
 			distance++;
 		}
 	}
@@ -145,8 +181,8 @@ private:
 	void _resize_and_rehash(uint32_t p_new_capacity) {
 		uint32_t old_capacity = capacity;
 
-		// Capacity can't be 0.
-		capacity = MAX(1, p_new_capacity);
+		// Capacity must be a non-zero power of two, so probing can mask instead of divide.
+		capacity = next_power_of_2(MAX(MIN_CAPACITY, p_new_capacity));
 
 		TKey *old_keys = keys;
 		TValue *old_values = values;
@@ -186,6 +222,11 @@ private:
 		_resize_and_rehash(capacity * 2);
 	}
 
+	// Grows once the table would be more than 7/8 full.
+	_FORCE_INLINE_ bool _needs_grow() const {
+		return num_elements + 1 > capacity - (capacity >> 3);
+	}
+
 public:
 	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
 	_FORCE_INLINE_ uint32_t get_num_elements() const { return num_elements; }
@@ -209,7 +250,7 @@ public:
 	}
 
 	void insert(const TKey &p_key, const TValue &p_value) {
-		if (num_elements + 1 > 0.9 * capacity) {
+		if (_needs_grow()) {
 			_resize_and_rehash();
 		}
 
@@ -219,13 +260,17 @@ public:
 	}
 
 	void set(const TKey &p_key, const TValue &p_data) {
+		uint32_t hash = _hash(p_key);
 		uint32_t pos = 0;
-		bool exists = _lookup_pos(p_key, pos);
+		bool exists = _lookup_pos_with_hash(p_key, hash, pos);
 
 		if (exists) {
 			values[pos] = p_data;
 		} else {
-			insert(p_key, p_data);
+			if (_needs_grow()) {
+				_resize_and_rehash();
+			}
+			_insert_with_hash(hash, p_key, p_data);
 		}
 	}
 
@@ -276,14 +321,15 @@ public:
 			return;
 		}
 
-		uint32_t next_pos = (pos + 1) % capacity;
+		uint32_t mask = capacity - 1;
+		uint32_t next_pos = (pos + 1) & mask;
 		while (hashes[next_pos] != EMPTY_HASH &&
 				_get_probe_length(next_pos, hashes[next_pos]) != 0) {
 			SWAP(hashes[next_pos], hashes[pos]);
 			SWAP(keys[next_pos], keys[pos]);
 			SWAP(values[next_pos], values[pos]);
 			pos = next_pos;
-			next_pos = (pos + 1) % capacity;
+			next_pos = (pos + 1) & mask;
 		}
 
 		hashes[pos] = EMPTY_HASH;
@@ -296,10 +342,13 @@ public:
 	/**
 	 * reserves space for a number of elements, useful to avoid many resizes and rehashes
 	 *  if adding a known (possibly large) number of elements at once, must be larger than old
-	 *  capacity.
+	 *  capacity. The capacity is rounded up to a power of two.
 	 **/
 	void reserve(uint32_t p_new_capacity) {
 		ERR_FAIL_COND(p_new_capacity < capacity);
+		if (next_power_of_2(p_new_capacity) == capacity) {
+			return;
+		}
 		_resize_and_rehash(p_new_capacity);
 	}
 
@@ -368,8 +417,8 @@ public:
 	}
 
 	OAHashMap(uint32_t p_initial_capacity = 64) {
-		// Capacity can't be 0.
-		capacity = MAX(1, p_initial_capacity);
+		// Capacity must be a non-zero power of two.
+		capacity = next_power_of_2(MAX(MIN_CAPACITY, p_initial_capacity));
 
 		keys = static_cast<TKey *>(Memory::alloc_static(sizeof(TKey) * capacity));
 		values = static_cast<TValue *>(Memory::alloc_static(sizeof(TValue) * capacity));
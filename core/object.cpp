@@ -895,6 +895,43 @@ Variant Object::call(const StringName &p_method, const Variant **p_args, int p_a
 	return ret;
 }
 
+// Same as call(), but the ClassDB lookup is served from r_cache when the
+// object's class matches the one the call site last saw.
+Variant Object::call_cached(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error, VariantCallCache &r_cache) {
+	if (_overrides_call) {
+		return call(p_method, p_args, p_argcount, r_error);
+	}
+
+	const StringName &class_name = get_class_name();
+	const void *key = class_name.data_unique_pointer();
+	MethodBind *method = (MethodBind *)r_cache.lookup(key);
+
+	if (!method) {
+		uint32_t version = VariantCallCache::get_version();
+		method = ClassDB::get_method(class_name, p_method);
+		if (!method) {
+			// Not a bound method (free, or a script only method), take the slow path.
+			return call(p_method, p_args, p_argcount, r_error);
+		}
+		r_cache.store(key, method, version);
+	}
+
+	OBJ_DEBUG_LOCK
+	if (script_instance) {
+		Variant ret = script_instance->call(p_method, p_args, p_argcount, r_error);
+		switch (r_error.error) {
+			case Callable::CallError::CALL_ERROR_INVALID_METHOD:
+			case Callable::CallError::CALL_ERROR_INSTANCE_IS_NULL:
+				break;
+			default:
+				return ret;
+		}
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+	return method->call(this, p_args, p_argcount, r_error);
+}
+
 void Object::notification(int p_notification, bool p_reversed) {
 	_notificationv(p_notification, p_reversed);
 
@@ -1070,9 +1107,20 @@ bool Object::_has_user_signal(const StringName &p_name) const {
 	return signal_map[p_name].user.name.length() > 0;
 }
 
-struct _ObjectSignalDisconnectData {
-	StringName signal;
+// Signals with more connections, or connections with more arguments, than
+// this are snapshotted on the heap instead of the stack.
+#define EMIT_SIGNAL_INLINE_SLOTS 16
+#define EMIT_SIGNAL_INLINE_ARGS 16
+
+struct _ObjectSignalEmitSlot {
 	Callable callable;
+	Vector<Variant> binds; // Shared with the connection, not copied.
+	uint32_t flags;
+
+	_ObjectSignalEmitSlot(const Object::Connection &p_connection) :
+			callable(p_connection.callable),
+			binds(p_connection.binds),
+			flags(p_connection.flags) {}
 };
 
 Variant Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
@@ -1118,23 +1166,35 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 		return ERR_UNAVAILABLE;
 	}
 
-	List<_ObjectSignalDisconnectData> disconnect_data;
+	// Callbacks may connect or disconnect this signal, so call a snapshot of
+	// the connections. It lives on the stack unless there are many of them.
+	const int ssize = s->slot_map.size();
+	alignas(_ObjectSignalEmitSlot) uint8_t inline_slots[sizeof(_ObjectSignalEmitSlot) * EMIT_SIGNAL_INLINE_SLOTS];
+	_ObjectSignalEmitSlot *slots = ssize > EMIT_SIGNAL_INLINE_SLOTS ? (_ObjectSignalEmitSlot *)memalloc(sizeof(_ObjectSignalEmitSlot) * ssize) : (_ObjectSignalEmitSlot *)inline_slots;
 
-	//copy on write will ensure that disconnecting the signal or even deleting the object will not affect the signal calling.
-	//this happens automatically and will not change the performance of calling.
-	//awesome, isn't it?
-	VMap<Callable, SignalData::Slot> slot_map = s->slot_map;
+	int max_binds = 0;
+	for (int i = 0; i < ssize; i++) {
+		const Connection &c = s->slot_map.getv(i).conn;
+		memnew_placement(&slots[i], _ObjectSignalEmitSlot(c));
+		max_binds = MAX(max_binds, c.binds.size());
+	}
 
-	int ssize = slot_map.size();
+	// Argument layout for bound connections: the emitted arguments first, then the binds.
+	const Variant *inline_args[EMIT_SIGNAL_INLINE_ARGS];
+	const Variant **bind_args = nullptr;
+	if (max_binds) {
+		bind_args = p_argcount + max_binds > EMIT_SIGNAL_INLINE_ARGS ? (const Variant **)memalloc(sizeof(const Variant *) * (p_argcount + max_binds)) : inline_args;
+		for (int j = 0; j < p_argcount; j++) {
+			bind_args[j] = p_args[j];
+		}
+	}
 
 	OBJ_DEBUG_LOCK
 
-	Vector<const Variant *> bind_mem;
-
 	Error err = OK;
 
 	for (int i = 0; i < ssize; i++) {
-		const Connection &c = slot_map.getv(i).conn;
+		const _ObjectSignalEmitSlot &c = slots[i];
 
 		Object *target = c.callable.get_object();
 		if (!target) {
@@ -1146,18 +1206,13 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 		int argc = p_argcount;
 
 		if (c.binds.size()) {
-			//handle binds
-			bind_mem.resize(p_argcount + c.binds.size());
-
-			for (int j = 0; j < p_argcount; j++) {
-				bind_mem.write[j] = p_args[j];
-			}
+			const Variant *binds = c.binds.ptr();
 			for (int j = 0; j < c.binds.size(); j++) {
-				bind_mem.write[p_argcount + j] = &c.binds[j];
+				bind_args[p_argcount + j] = &binds[j];
 			}
 
-			args = (const Variant **)bind_mem.ptr();
-			argc = bind_mem.size();
+			args = bind_args;
+			argc = p_argcount + c.binds.size();
 		}
 
 		if (c.flags & CONNECT_DEFERRED) {
@@ -1192,18 +1247,22 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 		}
 #endif
 		if (disconnect) {
-			_ObjectSignalDisconnectData dd;
-			dd.signal = p_name;
-			dd.callable = c.callable;
-			disconnect_data.push_back(dd);
+			// The callback may have disconnected it already.
+			const SignalData *sd = signal_map.getptr(p_name);
+			if (sd && sd->slot_map.has(c.callable)) {
+				_disconnect(p_name, c.callable);
+			}
 		}
 	}
 
-	while (!disconnect_data.empty()) {
-		const _ObjectSignalDisconnectData &dd = disconnect_data.front()->get();
-
-		_disconnect(dd.signal, dd.callable);
-		disconnect_data.pop_front();
+	for (int i = 0; i < ssize; i++) {
+		slots[i].~_ObjectSignalEmitSlot();
+	}
+	if (slots != (_ObjectSignalEmitSlot *)inline_slots) {
+		memfree(slots);
+	}
+	if (bind_args && bind_args != inline_args) {
+		memfree(bind_args);
 	}
 
 	return err;
@@ -1934,8 +1993,8 @@ void postinitialize_handler(Object *p_object) {
 void ObjectDB::debug_objects(DebugFunc p_func) {
 	spin_lock.lock();
 	for (uint32_t i = 0; i < slot_count; i++) {
-		uint32_t slot = object_slots[i].next_free;
-		p_func(object_slots[slot].object);
+		uint32_t slot = _get_slot(i).next_free;
+		p_func(_get_slot(slot).object.load(std::memory_order_relaxed));
 	}
 	spin_lock.unlock();
 }
@@ -1945,8 +2004,8 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 
 SpinLock ObjectDB::spin_lock;
 uint32_t ObjectDB::slot_count = 0;
-uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
+std::atomic<uint32_t> ObjectDB::slot_max(0);
+ObjectDB::ObjectSlot *ObjectDB::object_slot_blocks[OBJECTDB_SLOT_MAX_BLOCKS] = {};
 uint64_t ObjectDB::validator_counter = 0;
 
 int ObjectDB::get_object_count() {
@@ -1955,32 +2014,38 @@ int ObjectDB::get_object_count() {
 
 ObjectID ObjectDB::add_instance(Object *p_object) {
 	spin_lock.lock();
-	if (unlikely(slot_count == slot_max)) {
+	uint32_t current_max = slot_max.load(std::memory_order_relaxed);
+	if (unlikely(slot_count == current_max)) {
 		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_reference = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+		// Existing blocks stay where they are, readers may be using them.
+		const uint32_t block_size = OBJECTDB_SLOT_BLOCK_MASK + 1;
+		ObjectSlot *block = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * block_size);
+		for (uint32_t i = 0; i < block_size; i++) {
+			memnew_placement(&block[i], ObjectSlot);
+			block[i].validator.store(0, std::memory_order_relaxed);
+			block[i].object.store(nullptr, std::memory_order_relaxed);
+			block[i].next_free = current_max + i;
+			block[i].is_reference = false;
 		}
-		slot_max = new_slot_max;
+		object_slot_blocks[current_max >> OBJECTDB_SLOT_BLOCK_BITS] = block;
+		current_max += block_size;
+		slot_max.store(current_max, std::memory_order_release);
 	}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
+	uint32_t slot = _get_slot(slot_count).next_free;
+	ObjectSlot &s = _get_slot(slot);
+	if (s.object.load(std::memory_order_relaxed) != nullptr) {
 		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+		ERR_FAIL_COND_V(s.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_reference = p_object->is_reference();
 	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
 	if (unlikely(validator_counter == 0)) {
 		validator_counter = 1;
 	}
-	object_slots[slot].validator = validator_counter;
+	s.is_reference = p_object->is_reference();
+	s.object.store(p_object, std::memory_order_release);
+	s.validator.store(validator_counter, std::memory_order_release); // Publishes the object.
 
 	uint64_t id = validator_counter;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
@@ -2003,17 +2068,19 @@ void ObjectDB::remove_instance(Object *p_object) {
 
 	spin_lock.lock();
 
+	ObjectSlot &s = _get_slot(slot);
+
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
+	if (s.object.load(std::memory_order_relaxed) != p_object) {
 		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
+		ERR_FAIL_COND(s.object.load(std::memory_order_relaxed) != p_object);
 	}
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
+		if (s.validator.load(std::memory_order_relaxed) != validator) {
 			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
+			ERR_FAIL_COND(s.validator.load(std::memory_order_relaxed) != validator);
 		}
 	}
 
@@ -2021,11 +2088,11 @@ void ObjectDB::remove_instance(Object *p_object) {
 	//decrease slot count
 	slot_count--;
 	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
+	_get_slot(slot_count).next_free = slot;
 	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_reference = false;
-	object_slots[slot].object = nullptr;
+	s.validator.store(0, std::memory_order_release);
+	s.is_reference = false;
+	s.object.store(nullptr, std::memory_order_release);
 
 	spin_lock.unlock();
 }
@@ -2048,8 +2115,8 @@ void ObjectDB::cleanup() {
 			Callable::CallError call_error;
 
 			for (uint32_t i = 0; i < slot_count; i++) {
-				uint32_t slot = object_slots[i].next_free;
-				Object *obj = object_slots[slot].object;
+				uint32_t slot = _get_slot(i).next_free;
+				Object *obj = _get_slot(slot).object.load(std::memory_order_relaxed);
 
 				String extra_info;
 				if (obj->is_class("Node")) {
@@ -2059,7 +2126,7 @@ void ObjectDB::cleanup() {
 					extra_info = " - Resource path: " + String(resource_get_path->call(obj, nullptr, 0, call_error));
 				}
 
-				uint64_t id = uint64_t(slot) | (uint64_t(object_slots[slot].validator) << OBJECTDB_VALIDATOR_BITS) | (object_slots[slot].is_reference ? OBJECTDB_REFERENCE_BIT : 0);
+				uint64_t id = uint64_t(slot) | (uint64_t(_get_slot(slot).validator.load(std::memory_order_relaxed)) << OBJECTDB_VALIDATOR_BITS) | (_get_slot(slot).is_reference ? OBJECTDB_REFERENCE_BIT : 0);
 				print_line("Leaked instance: " + String(obj->get_class()) + ":" + itos(id) + extra_info);
 			}
 			print_line("Hint: Leaked instances typically happen when nodes are removed from the scene tree (with `remove_child()`) but not freed (with `free()` or `queue_free()`).");
@@ -2067,7 +2134,10 @@ void ObjectDB::cleanup() {
 		spin_lock.unlock();
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	const uint32_t block_count = slot_max.load(std::memory_order_relaxed) >> OBJECTDB_SLOT_BLOCK_BITS;
+	for (uint32_t i = 0; i < block_count; i++) {
+		memfree(object_slot_blocks[i]);
+		object_slot_blocks[i] = nullptr;
 	}
+	slot_max.store(0, std::memory_order_relaxed);
 }
@@ -182,7 +182,7 @@ public:
 	virtual MultiplayerAPI::RPCMode get_rset_mode_by_id(const uint16_t p_rpc_method_id) const = 0;
 	virtual MultiplayerAPI::RPCMode get_rset_mode(const StringName &p_variable) const = 0;
 
-	Script() {}
+	Script() { _overrides_call = true; }
 };
 
 class ScriptInstance {
@@ -44,6 +44,9 @@ public:
 			;
 		}
 	}
+	_ALWAYS_INLINE_ bool try_lock() {
+		return !locked.test_and_set(std::memory_order_acquire);
+	}
 	_ALWAYS_INLINE_ void unlock() {
 		locked.clear(std::memory_order_release);
 	}
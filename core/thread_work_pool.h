@@ -102,6 +102,8 @@ public:
 		memdelete(w);
 	}
 
+	uint32_t get_thread_count() const { return thread_count; }
+
 	void init(int p_thread_count = -1);
 	void finish();
 	~ThreadWorkPool();
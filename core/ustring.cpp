@@ -1357,6 +1357,15 @@ CharString String::ascii(bool p_allow_extended) const {
 	return cs;
 }
 
+// UTF-8 conversions handle runs of ASCII, by far the most common input,
+// a whole 64-bit word at a time instead of byte by byte.
+
+static _FORCE_INLINE_ bool _is_ascii_word(const char *p_str) {
+	uint64_t word;
+	memcpy(&word, p_str, sizeof(word));
+	return (word & 0x8080808080808080ULL) == 0;
+}
+
 String String::utf8(const char *p_utf8, int p_len) {
 	String ret;
 	ret.parse_utf8(p_utf8, p_len);
@@ -1388,11 +1397,29 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 		}
 	}
 
+	// Find where the input ends once, so the loops below don't have to
+	// look for the terminator byte by byte.
+	if (p_len < 0) {
+		p_len = strlen(p_utf8);
+	} else {
+		const char *end = (const char *)memchr(p_utf8, 0, p_len);
+		if (end) {
+			p_len = end - p_utf8;
+		}
+	}
+
 	{
 		const char *ptrtmp = p_utf8;
 		const char *ptrtmp_limit = &p_utf8[p_len];
 		int skip = 0;
-		while (ptrtmp != ptrtmp_limit && *ptrtmp) {
+		while (ptrtmp != ptrtmp_limit) {
+			if (skip == 0 && ptrtmp_limit - ptrtmp >= 8 && _is_ascii_word(ptrtmp)) {
+				str_size += 8;
+				cstr_size += 8;
+				ptrtmp += 8;
+				continue;
+			}
+
 			if (skip == 0) {
 				uint8_t c = *ptrtmp >= 0 ? *ptrtmp : uint8_t(256 + *ptrtmp);
 
@@ -1446,6 +1473,16 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 	dst[str_size] = 0;
 
 	while (cstr_size) {
+		if (cstr_size >= 8 && _is_ascii_word(p_utf8)) {
+			for (int i = 0; i < 8; i++) {
+				dst[i] = p_utf8[i];
+			}
+			dst += 8;
+			cstr_size -= 8;
+			p_utf8 += 8;
+			continue;
+		}
+
 		int len = 0;
 
 		/* Determine the number of characters in sequence */
@@ -1550,6 +1587,16 @@ CharString String::utf8() const {
 #define APPEND_CHAR(m_c) *(cdst++) = m_c
 
 	for (int i = 0; i < l; i++) {
+		if (i + 4 <= l && (uint32_t(d[i]) | uint32_t(d[i + 1]) | uint32_t(d[i + 2]) | uint32_t(d[i + 3])) <= 0x7f) {
+			cdst[0] = d[i];
+			cdst[1] = d[i + 1];
+			cdst[2] = d[i + 2];
+			cdst[3] = d[i + 3];
+			cdst += 4;
+			i += 3;
+			continue;
+		}
+
 		uint32_t c = d[i];
 
 		if (c <= 0x7f) { // 7 bits.
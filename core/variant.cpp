@@ -36,10 +36,82 @@
 #include "core/math/math_funcs.h"
 #include "core/print_string.h"
 #include "core/resource.h"
+#include "core/spin_lock.h"
 #include "core/variant_parser.h"
 #include "scene/gui/control.h"
 #include "scene/main/node.h"
 
+// Transform2D, AABB, Basis and Transform don't fit in a Variant and are
+// boxed on the heap. Freed boxes are kept in a free list per type, up to
+// MAX_CACHED of them, so temporaries in scripts don't hit the allocator every
+// time. Boxes past that are returned to the allocator, and so is every box
+// allocated or freed while another thread holds the list: threads never wait
+// on each other here.
+template <class T>
+class VariantBoxPool {
+	enum {
+		MAX_CACHED = 1024
+	};
+
+	union Box {
+		Box *next;
+		uint8_t data[sizeof(T)];
+	};
+
+	Box *free_list = nullptr;
+	int cached = 0;
+	SpinLock spin_lock;
+
+public:
+	_FORCE_INLINE_ T *alloc(const T &p_value) {
+		Box *box = nullptr;
+		if (spin_lock.try_lock()) {
+			box = free_list;
+			if (box) {
+				free_list = box->next;
+				cached--;
+			}
+			spin_lock.unlock();
+		}
+		if (!box) {
+			box = (Box *)memalloc(sizeof(Box));
+		}
+
+		return memnew_placement(box->data, T(p_value));
+	}
+
+	_FORCE_INLINE_ void free(T *p_value) {
+		p_value->~T();
+		Box *box = reinterpret_cast<Box *>(p_value);
+
+		if (spin_lock.try_lock()) {
+			if (cached < MAX_CACHED) {
+				box->next = free_list;
+				free_list = box;
+				cached++;
+				box = nullptr;
+			}
+			spin_lock.unlock();
+		}
+		if (box) {
+			memfree(box);
+		}
+	}
+
+	~VariantBoxPool() {
+		while (free_list) {
+			Box *box = free_list;
+			free_list = box->next;
+			memfree(box);
+		}
+	}
+};
+
+static VariantBoxPool<Transform2D> transform2d_pool;
+static VariantBoxPool<::AABB> aabb_pool;
+static VariantBoxPool<Basis> basis_pool;
+static VariantBoxPool<Transform> transform_pool;
+
 String Variant::get_type_name(Variant::Type p_type) {
 	switch (p_type) {
 		case NIL: {
@@ -1032,14 +1104,8 @@ bool Variant::is_null() const {
 }
 
 void Variant::reference(const Variant &p_variant) {
-	switch (type) {
-		case NIL:
-		case BOOL:
-		case INT:
-		case FLOAT:
-			break;
-		default:
-			clear();
+	if (!_is_trivial(type)) {
+		clear();
 	}
 
 	type = p_variant.type;
@@ -1077,7 +1143,7 @@ void Variant::reference(const Variant &p_variant) {
 			memnew_placement(_data._mem, Rect2i(*reinterpret_cast<const Rect2i *>(p_variant._data._mem)));
 		} break;
 		case TRANSFORM2D: {
-			_data._transform2d = memnew(Transform2D(*p_variant._data._transform2d));
+			_data._transform2d = transform2d_pool.alloc(*p_variant._data._transform2d);
 		} break;
 		case VECTOR3: {
 			memnew_placement(_data._mem, Vector3(*reinterpret_cast<const Vector3 *>(p_variant._data._mem)));
@@ -1090,18 +1156,18 @@ void Variant::reference(const Variant &p_variant) {
 		} break;
 
 		case AABB: {
-			_data._aabb = memnew(::AABB(*p_variant._data._aabb));
+			_data._aabb = aabb_pool.alloc(*p_variant._data._aabb);
 		} break;
 		case QUAT: {
 			memnew_placement(_data._mem, Quat(*reinterpret_cast<const Quat *>(p_variant._data._mem)));
 
 		} break;
 		case BASIS: {
-			_data._basis = memnew(Basis(*p_variant._data._basis));
+			_data._basis = basis_pool.alloc(*p_variant._data._basis);
 
 		} break;
 		case TRANSFORM: {
-			_data._transform = memnew(Transform(*p_variant._data._transform));
+			_data._transform = transform_pool.alloc(*p_variant._data._transform);
 		} break;
 
 		// misc types
@@ -1281,16 +1347,16 @@ void Variant::clear() {
 		RECT2
 		*/
 		case TRANSFORM2D: {
-			memdelete(_data._transform2d);
+			transform2d_pool.free(_data._transform2d);
 		} break;
 		case AABB: {
-			memdelete(_data._aabb);
+			aabb_pool.free(_data._aabb);
 		} break;
 		case BASIS: {
-			memdelete(_data._basis);
+			basis_pool.free(_data._basis);
 		} break;
 		case TRANSFORM: {
-			memdelete(_data._transform);
+			transform_pool.free(_data._transform);
 		} break;
 
 			// misc types
@@ -2487,12 +2553,12 @@ Variant::Variant(const Plane &p_plane) {
 
 Variant::Variant(const ::AABB &p_aabb) {
 	type = AABB;
-	_data._aabb = memnew(::AABB(p_aabb));
+	_data._aabb = aabb_pool.alloc(p_aabb);
 }
 
 Variant::Variant(const Basis &p_matrix) {
 	type = BASIS;
-	_data._basis = memnew(Basis(p_matrix));
+	_data._basis = basis_pool.alloc(p_matrix);
 }
 
 Variant::Variant(const Quat &p_quat) {
@@ -2502,12 +2568,12 @@ Variant::Variant(const Quat &p_quat) {
 
 Variant::Variant(const Transform &p_transform) {
 	type = TRANSFORM;
-	_data._transform = memnew(Transform(p_transform));
+	_data._transform = transform_pool.alloc(p_transform);
 }
 
 Variant::Variant(const Transform2D &p_transform) {
 	type = TRANSFORM2D;
-	_data._transform2d = memnew(Transform2D(p_transform));
+	_data._transform2d = transform2d_pool.alloc(p_transform);
 }
 
 Variant::Variant(const Color &p_color) {
@@ -2681,7 +2747,7 @@ Variant::Variant(const Vector<StringName> &p_array) {
 	*this = v;
 }
 
-void Variant::operator=(const Variant &p_variant) {
+void Variant::_assign(const Variant &p_variant) {
 	if (unlikely(this == &p_variant)) {
 		return;
 	}
@@ -2836,8 +2902,20 @@ Variant::Variant(const IP_Address &p_address) {
 	memnew_placement(_data._mem, String(p_address));
 }
 
-Variant::Variant(const Variant &p_variant) {
-	reference(p_variant);
+void Variant::operator=(Variant &&p_variant) {
+	if (unlikely(this == &p_variant)) {
+		return;
+	}
+
+	// Keep the old value alive until the new one is in place, it may own the
+	// Variant being moved from (e.g. an element of this Array).
+	Variant old;
+	old.type = type;
+	old._data = _data;
+
+	type = p_variant.type;
+	_data = p_variant._data;
+	p_variant.type = NIL;
 }
 
 uint32_t Variant::hash() const {
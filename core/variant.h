@@ -50,6 +50,8 @@
 #include "core/rid.h"
 #include "core/ustring.h"
 
+#include <atomic>
+
 class Object;
 class Node; // helper
 class Control; // helper
@@ -67,6 +69,8 @@ typedef Vector<Vector2> PackedVector2Array;
 typedef Vector<Vector3> PackedVector3Array;
 typedef Vector<Color> PackedColorArray;
 
+struct VariantCallCache;
+
 class Variant {
 public:
 	// If this changes the table in variant_op must be updated
@@ -205,7 +209,21 @@ private:
 		uint8_t _mem[sizeof(ObjData) > (sizeof(real_t) * 4) ? sizeof(ObjData) : (sizeof(real_t) * 4)];
 	} _data alignas(8);
 
+	// Types held inline in _data that need no construction or destruction.
+	// They are copied bitwise and dropped without going through the switches
+	// in reference() and clear().
+	static constexpr uint64_t TRIVIAL_TYPES =
+			(1ULL << NIL) | (1ULL << BOOL) | (1ULL << INT) | (1ULL << FLOAT) |
+			(1ULL << VECTOR2) | (1ULL << VECTOR2I) | (1ULL << RECT2) | (1ULL << RECT2I) |
+			(1ULL << VECTOR3) | (1ULL << VECTOR3I) | (1ULL << PLANE) | (1ULL << QUAT) |
+			(1ULL << COLOR) | (1ULL << _RID);
+
+	_FORCE_INLINE_ static bool _is_trivial(Type p_type) {
+		return (TRIVIAL_TYPES >> p_type) & 1;
+	}
+
 	void reference(const Variant &p_variant);
+	void _assign(const Variant &p_variant);
 	void clear();
 
 public:
@@ -413,7 +431,7 @@ public:
 	static void blend(const Variant &a, const Variant &b, float c, Variant &r_dst);
 	static void interpolate(const Variant &a, const Variant &b, float c, Variant &r_dst);
 
-	void call_ptr(const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, Callable::CallError &r_error);
+	void call_ptr(const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, Callable::CallError &r_error, VariantCallCache *p_cache = nullptr);
 	Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Variant call(const StringName &p_method, const Variant &p_arg1 = Variant(), const Variant &p_arg2 = Variant(), const Variant &p_arg3 = Variant(), const Variant &p_arg4 = Variant(), const Variant &p_arg5 = Variant());
 
@@ -466,12 +484,35 @@ public:
 	String get_construct_string() const;
 	static void construct_from_string(const String &p_string, Variant &r_value, ObjectConstruct p_obj_construct = nullptr, void *p_construct_ud = nullptr);
 
-	void operator=(const Variant &p_variant); // only this is enough for all the other types
-
-	Variant(const Variant &p_variant);
+	_FORCE_INLINE_ void operator=(const Variant &p_variant) { // only this is enough for all the other types
+		if (_is_trivial(type) && _is_trivial(p_variant.type)) {
+			type = p_variant.type;
+			_data = p_variant._data;
+		} else {
+			_assign(p_variant);
+		}
+	}
+	void operator=(Variant &&p_variant);
+
+	_FORCE_INLINE_ Variant(const Variant &p_variant) {
+		if (_is_trivial(p_variant.type)) {
+			type = p_variant.type;
+			_data = p_variant._data;
+		} else {
+			reference(p_variant);
+		}
+	}
+	// Every type stored in a Variant can be relocated bitwise, so moving just
+	// steals the payload and leaves the source as NIL, without touching any
+	// reference count.
+	_FORCE_INLINE_ Variant(Variant &&p_variant) {
+		type = p_variant.type;
+		_data = p_variant._data;
+		p_variant.type = NIL;
+	}
 	_FORCE_INLINE_ Variant() {}
 	_FORCE_INLINE_ ~Variant() {
-		if (type != Variant::NIL) {
+		if (!_is_trivial(type)) {
 			clear();
 		}
 	}
@@ -495,6 +536,58 @@ struct VariantComparator {
 	static _FORCE_INLINE_ bool compare(const Variant &p_lhs, const Variant &p_rhs) { return p_lhs.hash_compare(p_rhs); }
 };
 
+// Inline cache for a single dynamic call site (a script opcode, a visual
+// script node). It remembers what the last call resolved to, keyed by the
+// receiver's class (or builtin type), so repeated calls skip the lookup.
+// A cache must always be used with the same method name.
+//
+// Entries are tagged with a global version that is bumped whenever methods
+// are registered or unregistered. Call sites may be shared between threads:
+// readers validate a sequence counter, and a writer that finds another write
+// in progress simply leaves the entry alone.
+struct VariantCallCache {
+private:
+	static std::atomic<uint32_t> global_version;
+
+	std::atomic<uint32_t> sequence = { 0 };
+	std::atomic<uint32_t> version = { 0 };
+	std::atomic<const void *> key = { nullptr };
+	std::atomic<void *> target = { nullptr };
+
+public:
+	_FORCE_INLINE_ static uint32_t get_version() { return global_version.load(std::memory_order_acquire); }
+	static void invalidate_all() { global_version.fetch_add(1, std::memory_order_acq_rel); }
+
+	_FORCE_INLINE_ void *lookup(const void *p_key) const {
+		uint32_t seq = sequence.load(std::memory_order_acquire);
+		if (seq & 1) {
+			return nullptr;
+		}
+		const void *k = key.load(std::memory_order_relaxed);
+		void *t = target.load(std::memory_order_relaxed);
+		uint32_t v = version.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (sequence.load(std::memory_order_relaxed) != seq || k != p_key || v != get_version()) {
+			return nullptr;
+		}
+		return t;
+	}
+
+	// p_version must be read before resolving p_target, so an invalidation
+	// that happens in between is not lost.
+	void store(const void *p_key, void *p_target, uint32_t p_version) {
+		uint32_t seq = sequence.load(std::memory_order_relaxed);
+		if ((seq & 1) || !sequence.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) {
+			return;
+		}
+		std::atomic_thread_fence(std::memory_order_release);
+		key.store(p_key, std::memory_order_relaxed);
+		target.store(p_target, std::memory_order_relaxed);
+		version.store(p_version, std::memory_order_relaxed);
+		sequence.store(seq + 2, std::memory_order_release);
+	}
+};
+
 Variant::ObjData &Variant::_get_obj() {
 	return *reinterpret_cast<ObjData *>(&_data._mem[0]);
 }
@@ -1200,13 +1200,15 @@ _VariantCall::TypeFunc *_VariantCall::type_funcs = nullptr;
 _VariantCall::ConstructFunc *_VariantCall::construct_funcs = nullptr;
 _VariantCall::ConstantData *_VariantCall::constant_data = nullptr;
 
+std::atomic<uint32_t> VariantCallCache::global_version(1);
+
 Variant Variant::call(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 	Variant ret;
 	call_ptr(p_method, p_args, p_argcount, &ret, r_error);
 	return ret;
 }
 
-void Variant::call_ptr(const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, Callable::CallError &r_error) {
+void Variant::call_ptr(const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, Callable::CallError &r_error, VariantCallCache *p_cache) {
 	Variant ret;
 
 	if (type == Variant::OBJECT) {
@@ -1223,18 +1225,37 @@ void Variant::call_ptr(const StringName &p_method, const Variant **p_args, int p
 		}
 
 #endif
-		ret = _get_obj().obj->call(p_method, p_args, p_argcount, r_error);
+		if (p_cache) {
+			ret = obj->call_cached(p_method, p_args, p_argcount, r_error, *p_cache);
+		} else {
+			ret = obj->call(p_method, p_args, p_argcount, r_error);
+		}
 
 		//else if (type==Variant::METHOD) {
 
 	} else {
 		r_error.error = Callable::CallError::CALL_OK;
 
-		Map<StringName, _VariantCall::FuncData>::Element *E = _VariantCall::type_funcs[type].functions.find(p_method);
+		_VariantCall::TypeFunc *type_func = &_VariantCall::type_funcs[type];
+		_VariantCall::FuncData *funcdata = nullptr;
+
+		if (p_cache) {
+			funcdata = (_VariantCall::FuncData *)p_cache->lookup(type_func);
+		}
+
+		if (!funcdata) {
+			uint32_t version = VariantCallCache::get_version();
+			Map<StringName, _VariantCall::FuncData>::Element *E = type_func->functions.find(p_method);
+			if (E) {
+				funcdata = &E->get();
+				if (p_cache) {
+					p_cache->store(type_func, funcdata, version);
+				}
+			}
+		}
 
-		if (E) {
-			_VariantCall::FuncData &funcdata = E->get();
-			funcdata.call(ret, *this, p_args, p_argcount, r_error);
+		if (funcdata) {
+			funcdata->call(ret, *this, p_args, p_argcount, r_error);
 
 		} else {
 			//handle vararg functions manually
@@ -2368,6 +2389,7 @@ void register_variant_methods() {
 }
 
 void unregister_variant_methods() {
+	VariantCallCache::invalidate_all();
 	memdelete_arr(_VariantCall::type_funcs);
 	memdelete_arr(_VariantCall::construct_funcs);
 	memdelete_arr(_VariantCall::constant_data);
@@ -202,7 +202,10 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 				[[fallthrough]];
 			}
 			case '"': {
-				String str;
+				StringBuffer<> str;
+				// Only strings with bytes outside ASCII need decoding when
+				// reading UTF-8, the rest can be used as is.
+				bool ascii = true;
 				while (true) {
 					CharType ch = p_stream->get_char();
 
@@ -276,26 +279,29 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 							} break;
 						}
 
+						ascii = ascii && res < 0x80;
 						str += res;
 
 					} else {
 						if (ch == '\n') {
 							line++;
 						}
+						ascii = ascii && ch < 0x80;
 						str += ch;
 					}
 				}
 
-				if (p_stream->is_utf8()) {
-					str.parse_utf8(str.ascii(true).get_data());
+				String s = str.as_string();
+				if (!ascii && p_stream->is_utf8()) {
+					s.parse_utf8(s.ascii(true).get_data());
 				}
 				if (string_name) {
 					r_token.type = TK_STRING_NAME;
-					r_token.value = StringName(str);
+					r_token.value = StringName(s);
 					string_name = false; //reset
 				} else {
 					r_token.type = TK_STRING;
-					r_token.value = str;
+					r_token.value = s;
 				}
 				return OK;
 
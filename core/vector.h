@@ -122,6 +122,10 @@ public:
 		_cowdata._ref(p_from._cowdata);
 		return *this;
 	}
+	inline Vector &operator=(Vector &&p_from) {
+		_cowdata = std::move(p_from._cowdata);
+		return *this;
+	}
 
 	Vector<uint8_t> to_byte_array() const {
 		Vector<uint8_t> ret;
@@ -155,6 +159,8 @@ public:
 
 	_FORCE_INLINE_ Vector() {}
 	_FORCE_INLINE_ Vector(const Vector &p_from) { _cowdata._ref(p_from._cowdata); }
+	_FORCE_INLINE_ Vector(Vector &&p_from) :
+			_cowdata(std::move(p_from._cowdata)) {}
 
 	_FORCE_INLINE_ ~Vector() {}
 };
@@ -175,8 +181,9 @@ void Vector<T>::append_array(Vector<T> p_other) {
 	}
 	const int bs = size();
 	resize(bs + ds);
+	T *w = ptrw();
 	for (int i = 0; i < ds; ++i) {
-		ptrw()[bs + i] = p_other[i];
+		w[bs + i] = p_other[i];
 	}
 }
 
@@ -184,7 +191,7 @@ template <class T>
 bool Vector<T>::push_back(T p_elem) {
 	Error err = resize(size() + 1);
 	ERR_FAIL_COND_V(err, true);
-	set(size() - 1, p_elem);
+	ptrw()[size() - 1] = std::move(p_elem);
 
 	return false;
 }
@@ -921,6 +921,8 @@ public:
 
 	void draw_window_margins(int *p_margins, RID *p_margin_textures) {}
 
+	virtual int get_render_info(RS::RenderInfo p_info) { return 0; }
+
 	virtual bool free(RID p_rid) { return true; }
 	virtual void update() {}
 
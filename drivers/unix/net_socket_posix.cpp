@@ -157,9 +157,11 @@ void NetSocketPosix::make_default() {
 	}
 #endif
 	_create = _create_func;
+	NetSocketPollerPosix::make_default();
 }
 
 void NetSocketPosix::cleanup() {
+	NetSocketPollerPosix::cleanup();
 #if defined(WINDOWS_ENABLED)
 	if (_create != nullptr) {
 		WSACleanup();
@@ -446,7 +448,7 @@ Error NetSocketPosix::poll(PollType p_type, int p_timeout) const {
 	FD_ZERO(&wr);
 	FD_ZERO(&ex);
 	FD_SET(_sock, &ex);
-	struct timeval timeout = { p_timeout, 0 };
+	struct timeval timeout = { p_timeout / 1000, (p_timeout % 1000) * 1000 };
 	// For blocking operation, pass nullptr  timeout pointer to select.
 	struct timeval *tp = nullptr;
 	if (p_timeout >= 0) {
@@ -744,4 +746,243 @@ Error NetSocketPosix::join_multicast_group(const IP_Address &p_multi_address, St
 Error NetSocketPosix::leave_multicast_group(const IP_Address &p_multi_address, String p_if_name) {
 	return _change_multicast_group(p_multi_address, p_if_name, false);
 }
+
+NetSocketPoller *NetSocketPollerPosix::_create_func() {
+	return memnew(NetSocketPollerPosix);
+}
+
+void NetSocketPollerPosix::make_default() {
+	_create = _create_func;
+}
+
+void NetSocketPollerPosix::cleanup() {
+	_create = nullptr;
+}
+
+#ifdef NET_SOCKET_USE_EPOLL
+
+static uint32_t _epoll_events_from_type(NetSocket::PollType p_type) {
+	switch (p_type) {
+		case NetSocket::POLL_TYPE_IN:
+			return EPOLLIN;
+		case NetSocket::POLL_TYPE_OUT:
+			return EPOLLOUT;
+		case NetSocket::POLL_TYPE_IN_OUT:
+			return EPOLLIN | EPOLLOUT;
+	}
+	return 0;
+}
+
+Error NetSocketPollerPosix::add_socket(int p_id, const Ref<NetSocket> &p_socket, NetSocket::PollType p_type) {
+	ERR_FAIL_COND_V(_epoll_fd < 0, ERR_UNCONFIGURED);
+	ERR_FAIL_COND_V(p_socket.is_null() || !p_socket->is_open(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(_sockets.has(p_id), ERR_ALREADY_EXISTS, "Socket id already in use: " + itos(p_id) + ".");
+
+	int fd = static_cast<const NetSocketPosix *>(p_socket.ptr())->_sock;
+	struct epoll_event ev;
+	ev.events = _epoll_events_from_type(p_type);
+	ev.data.u64 = 0;
+	ev.data.fd = p_id;
+	if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+		print_verbose("Unable to add socket to epoll set, errno: " + itos(errno));
+		return FAILED;
+	}
+	_sockets.insert(p_id, fd);
+	return OK;
+}
+
+Error NetSocketPollerPosix::modify_socket(int p_id, NetSocket::PollType p_type) {
+	int *fd = _sockets.lookup_ptr(p_id);
+	ERR_FAIL_COND_V(!fd, ERR_DOES_NOT_EXIST);
+
+	struct epoll_event ev;
+	ev.events = _epoll_events_from_type(p_type);
+	ev.data.u64 = 0;
+	ev.data.fd = p_id;
+	if (epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, *fd, &ev) != 0) {
+		return FAILED;
+	}
+	return OK;
+}
+
+void NetSocketPollerPosix::remove_socket(int p_id) {
+	int *fd = _sockets.lookup_ptr(p_id);
+	if (!fd) {
+		return;
+	}
+	// Closed sockets are dropped from the set by the kernel, so errors are expected here.
+	struct epoll_event ev;
+	epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, *fd, &ev);
+	_sockets.remove(p_id);
+}
+
+bool NetSocketPollerPosix::has_socket(int p_id) const {
+	return _sockets.has(p_id);
+}
+
+int NetSocketPollerPosix::get_socket_count() const {
+	return _sockets.get_num_elements();
+}
+
+void NetSocketPollerPosix::clear() {
+	for (OAHashMap<int, int>::Iterator it = _sockets.iter(); it.valid; it = _sockets.next_iter(it)) {
+		struct epoll_event ev;
+		epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, *it.value, &ev);
+	}
+	_sockets.clear();
+}
+
+Error NetSocketPollerPosix::wait(LocalVector<Event> &r_events, int p_timeout) {
+	ERR_FAIL_COND_V(_epoll_fd < 0, ERR_UNCONFIGURED);
+
+	r_events.clear();
+	if (_sockets.empty()) {
+		return OK;
+	}
+
+	_epoll_events.resize(_sockets.get_num_elements());
+	int ret = epoll_wait(_epoll_fd, &_epoll_events[0], _epoll_events.size(), p_timeout);
+	if (ret < 0) {
+		if (errno == EINTR) {
+			return OK;
+		}
+		print_verbose("Error when waiting on epoll set, errno: " + itos(errno));
+		return FAILED;
+	}
+
+	r_events.resize(ret);
+	for (int i = 0; i < ret; i++) {
+		const struct epoll_event &ev = _epoll_events[i];
+		Event &e = r_events[i];
+		e.id = ev.data.fd;
+		e.readable = ev.events & EPOLLIN;
+		e.writable = ev.events & EPOLLOUT;
+		e.error = ev.events & (EPOLLERR | EPOLLHUP);
+	}
+	return OK;
+}
+
+NetSocketPollerPosix::NetSocketPollerPosix() {
+	_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (_epoll_fd < 0) {
+		ERR_PRINT("Unable to create epoll instance, errno: " + itos(errno) + ".");
+	}
+}
+
+NetSocketPollerPosix::~NetSocketPollerPosix() {
+	if (_epoll_fd >= 0) {
+		::close(_epoll_fd);
+	}
+}
+
+#else
+
+#if defined(WINDOWS_ENABLED)
+#define SOCK_POLL WSAPoll
+#else
+#define SOCK_POLL ::poll
+#endif
+
+static short _poll_events_from_type(NetSocket::PollType p_type) {
+	switch (p_type) {
+		case NetSocket::POLL_TYPE_IN:
+			return POLLIN;
+		case NetSocket::POLL_TYPE_OUT:
+			return POLLOUT;
+		case NetSocket::POLL_TYPE_IN_OUT:
+			return POLLIN | POLLOUT;
+	}
+	return 0;
+}
+
+Error NetSocketPollerPosix::add_socket(int p_id, const Ref<NetSocket> &p_socket, NetSocket::PollType p_type) {
+	ERR_FAIL_COND_V(p_socket.is_null() || !p_socket->is_open(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(_indices.has(p_id), ERR_ALREADY_EXISTS, "Socket id already in use: " + itos(p_id) + ".");
+
+	POLL_FD_TYPE pfd;
+	pfd.fd = static_cast<const NetSocketPosix *>(p_socket.ptr())->_sock;
+	pfd.events = _poll_events_from_type(p_type);
+	pfd.revents = 0;
+	_indices.insert(p_id, _fds.size());
+	_fds.push_back(pfd);
+	_ids.push_back(p_id);
+	return OK;
+}
+
+Error NetSocketPollerPosix::modify_socket(int p_id, NetSocket::PollType p_type) {
+	uint32_t *idx = _indices.lookup_ptr(p_id);
+	ERR_FAIL_COND_V(!idx, ERR_DOES_NOT_EXIST);
+
+	_fds[*idx].events = _poll_events_from_type(p_type);
+	return OK;
+}
+
+void NetSocketPollerPosix::remove_socket(int p_id) {
+	uint32_t *idx_ptr = _indices.lookup_ptr(p_id);
+	if (!idx_ptr) {
+		return;
+	}
+
+	// Swap with the last entry to keep the arrays packed.
+	uint32_t idx = *idx_ptr;
+	uint32_t last = _fds.size() - 1;
+	if (idx != last) {
+		_fds[idx] = _fds[last];
+		_ids[idx] = _ids[last];
+		_indices.set(_ids[idx], idx);
+	}
+	_fds.resize(last);
+	_ids.resize(last);
+	_indices.remove(p_id);
+}
+
+bool NetSocketPollerPosix::has_socket(int p_id) const {
+	return _indices.has(p_id);
+}
+
+int NetSocketPollerPosix::get_socket_count() const {
+	return _fds.size();
+}
+
+void NetSocketPollerPosix::clear() {
+	_fds.clear();
+	_ids.clear();
+	_indices.clear();
+}
+
+Error NetSocketPollerPosix::wait(LocalVector<Event> &r_events, int p_timeout) {
+	r_events.clear();
+	if (_fds.size() == 0) {
+		return OK;
+	}
+
+	int ret = SOCK_POLL(&_fds[0], _fds.size(), p_timeout);
+	if (ret < 0) {
+		print_verbose("Error when polling sockets.");
+		return FAILED;
+	}
+
+	for (uint32_t i = 0; i < _fds.size() && ret > 0; i++) {
+		short revents = _fds[i].revents;
+		if (revents == 0) {
+			continue;
+		}
+		ret--;
+		Event e;
+		e.id = _ids[i];
+		e.readable = revents & POLLIN;
+		e.writable = revents & POLLOUT;
+		e.error = revents & (POLLERR | POLLHUP | POLLNVAL);
+		r_events.push_back(e);
+	}
+	return OK;
+}
+
+NetSocketPollerPosix::NetSocketPollerPosix() {
+}
+
+NetSocketPollerPosix::~NetSocketPollerPosix() {
+}
+
+#endif // NET_SOCKET_USE_EPOLL
 #endif
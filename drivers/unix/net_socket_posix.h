@@ -32,19 +32,31 @@
 #define NET_SOCKET_UNIX_H
 
 #include "core/io/net_socket.h"
+#include "core/oa_hash_map.h"
 
 #if defined(WINDOWS_ENABLED)
 #include <winsock2.h>
 #include <ws2tcpip.h>
 #define SOCKET_TYPE SOCKET
+#define POLL_FD_TYPE WSAPOLLFD
 
 #else
 #include <sys/socket.h>
 #define SOCKET_TYPE int
 
+#if defined(__linux__)
+#include <sys/epoll.h>
+#define NET_SOCKET_USE_EPOLL
+#else
+#include <poll.h>
+#define POLL_FD_TYPE struct pollfd
+#endif
+
 #endif
 
 class NetSocketPosix : public NetSocket {
+	friend class NetSocketPollerPosix;
+
 private:
 	SOCKET_TYPE _sock; // NOLINT - the default value is defined in the .cpp
 	IP::Type _ip_type = IP::TYPE_NONE;
@@ -101,4 +113,35 @@ public:
 	~NetSocketPosix();
 };
 
+class NetSocketPollerPosix : public NetSocketPoller {
+private:
+#ifdef NET_SOCKET_USE_EPOLL
+	int _epoll_fd;
+	OAHashMap<int, int> _sockets; // Id -> fd.
+	LocalVector<struct epoll_event> _epoll_events;
+#else
+	LocalVector<POLL_FD_TYPE> _fds;
+	LocalVector<int> _ids;
+	OAHashMap<int, uint32_t> _indices; // Id -> index in _fds and _ids.
+#endif
+
+protected:
+	static NetSocketPoller *_create_func();
+
+public:
+	static void make_default();
+	static void cleanup();
+
+	virtual Error add_socket(int p_id, const Ref<NetSocket> &p_socket, NetSocket::PollType p_type);
+	virtual Error modify_socket(int p_id, NetSocket::PollType p_type);
+	virtual void remove_socket(int p_id);
+	virtual bool has_socket(int p_id) const;
+	virtual int get_socket_count() const;
+	virtual void clear();
+	virtual Error wait(LocalVector<Event> &r_events, int p_timeout);
+
+	NetSocketPollerPosix();
+	~NetSocketPollerPosix();
+};
+
 #endif
@@ -71,6 +71,9 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(RENDER_2D_COMMANDS_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDER_2D_DRAW_CALLS_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDER_2D_BATCHING_RATIO);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -115,6 +118,9 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
 		"audio/output_latency",
+		"raster/2d_commands",
+		"raster/2d_draw_calls",
+		"raster/2d_batching_ratio",
 
 	};
 
@@ -177,6 +183,17 @@ float Performance::get_monitor(Monitor p_monitor) const {
 			return PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY:
 			return AudioServer::get_singleton()->get_output_latency();
+		case RENDER_2D_COMMANDS_IN_FRAME:
+			return RS::get_singleton()->get_render_info(RS::INFO_2D_COMMANDS_IN_FRAME);
+		case RENDER_2D_DRAW_CALLS_IN_FRAME:
+			return RS::get_singleton()->get_render_info(RS::INFO_2D_DRAW_CALLS_IN_FRAME);
+		case RENDER_2D_BATCHING_RATIO: {
+			int draw_calls = RS::get_singleton()->get_render_info(RS::INFO_2D_DRAW_CALLS_IN_FRAME);
+			if (draw_calls == 0) {
+				return 0;
+			}
+			return float(RS::get_singleton()->get_render_info(RS::INFO_2D_COMMANDS_IN_FRAME)) / draw_calls;
+		}
 
 		default: {
 		}
@@ -217,6 +234,9 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
@@ -78,6 +78,9 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		RENDER_2D_COMMANDS_IN_FRAME,
+		RENDER_2D_DRAW_CALLS_IN_FRAME,
+		RENDER_2D_BATCHING_RATIO,
 		MONITOR_MAX
 	};
 
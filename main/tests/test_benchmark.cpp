@@ -0,0 +1,75 @@
+/*************************************************************************/
+/*  test_benchmark.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_benchmark.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+
+namespace TestBenchmark {
+
+uint64_t Timer::lap() {
+	uint64_t now = OS::get_singleton()->get_ticks_usec();
+	uint64_t elapsed = now - from;
+	from = now;
+	return elapsed;
+}
+
+Timer::Timer() {
+	from = OS::get_singleton()->get_ticks_usec();
+}
+
+double ns_per_op(uint64_t p_usec, double p_ops) {
+	return p_ops > 0 ? p_usec * 1000.0 / p_ops : 0.0;
+}
+
+double mb_per_sec(uint64_t p_usec, double p_bytes) {
+	return p_bytes / (1024.0 * 1024.0) / MAX(p_usec, (uint64_t)1) * 1000000.0;
+}
+
+void begin(const char *p_title) {
+	OS::get_singleton()->print("\n\n%s\n\n", p_title);
+	Math::seed(0);
+}
+
+MainLoop *end(bool p_ok, const char *p_passed, const char *p_failed) {
+	OS::get_singleton()->print("\n%s\n", p_ok ? p_passed : p_failed);
+	return nullptr;
+}
+
+bool check_checksums(int64_t p_checksum, int64_t p_baseline) {
+	if (p_checksum != p_baseline) {
+		OS::get_singleton()->print("  Checksum mismatch: %lld != %lld\n", (long long)p_checksum, (long long)p_baseline);
+		return false;
+	}
+	return true;
+}
+
+} // namespace TestBenchmark
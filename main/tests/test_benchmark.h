@@ -0,0 +1,67 @@
+/*************************************************************************/
+/*  test_benchmark.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_BENCHMARK_H
+#define TEST_BENCHMARK_H
+
+#include "core/os/main_loop.h"
+#include "core/typedefs.h"
+
+// Timing and reporting shared by the *_benchmark tests, so they all print
+// their results the same way.
+namespace TestBenchmark {
+
+// Measures consecutive sections of a benchmark, in microseconds.
+class Timer {
+	uint64_t from = 0;
+
+public:
+	// Returns the time since the timer was created or last lapped, and starts
+	// timing the next section.
+	uint64_t lap();
+
+	Timer();
+};
+
+double ns_per_op(uint64_t p_usec, double p_ops);
+double mb_per_sec(uint64_t p_usec, double p_bytes);
+
+// Prints the title, and seeds the random generator so every run uses the
+// same data.
+void begin(const char *p_title);
+// Prints whether every check passed. Returns what test() should return.
+MainLoop *end(bool p_ok, const char *p_passed, const char *p_failed);
+// Compares the checksums of an implementation and its baseline, run on the
+// same data.
+bool check_checksums(int64_t p_checksum, int64_t p_baseline);
+
+} // namespace TestBenchmark
+
+#endif // TEST_BENCHMARK_H
@@ -0,0 +1,331 @@
+/*************************************************************************/
+/*  test_dictionary.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_dictionary.h"
+
+#include "core/dictionary.h"
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/variant.h"
+
+namespace TestDictionary {
+
+static OS *os = nullptr;
+
+// Checks the keys come out of keys(), next() and get_key_at_index() in p_expected order.
+static bool check_order(const Dictionary &p_dict, const Vector<Variant> &p_expected, const char *p_what) {
+	bool ok = p_dict.size() == p_expected.size();
+
+	Array keys = p_dict.keys();
+	Array values = p_dict.values();
+	for (int i = 0; ok && i < p_expected.size(); i++) {
+		ok = keys[i] == p_expected[i] && p_dict.get_key_at_index(i) == p_expected[i];
+		ok = ok && values[i] == p_dict[p_expected[i]] && p_dict.get_value_at_index(i) == values[i];
+	}
+
+	int i = 0;
+	for (const Variant *K = p_dict.next(nullptr); ok && K; K = p_dict.next(K)) {
+		ok = i < p_expected.size() && *K == p_expected[i];
+		i++;
+	}
+	ok = ok && i == p_expected.size();
+
+	if (!ok) {
+		os->print("\t%s: wrong order or contents.\n", p_what);
+	}
+	return ok;
+}
+
+static bool test_ordering() {
+	bool ok = true;
+
+	// Small (linear scan) and large (indexed) dictionaries.
+	const int sizes[] = { 5, 8, 9, 300 };
+	for (int s = 0; s < 4; s++) {
+		Dictionary dict;
+		Vector<Variant> expected;
+		for (int i = 0; i < sizes[s]; i++) {
+			// Mixed key types, inserted out of hash order.
+			Variant key = (i % 3 == 0) ? Variant(i * 7919) : (i % 3 == 1 ? Variant("key_" + itos(i)) : Variant(StringName("name_" + itos(i))));
+			dict[key] = i;
+			expected.push_back(key);
+		}
+		ok = check_order(dict, expected, "Insertion order") && ok;
+
+		// Overwriting keeps the position.
+		dict[expected[0]] = "first";
+		dict[expected[expected.size() - 1]] = "last";
+		ok = check_order(dict, expected, "Overwrite keeps order") && ok;
+
+		// Erasing and re-adding moves the key to the end.
+		Variant moved = expected[1];
+		dict.erase(moved);
+		expected.remove(1);
+		ok = check_order(dict, expected, "Erase keeps order") && ok;
+		dict[moved] = "moved";
+		expected.push_back(moved);
+		ok = check_order(dict, expected, "Re-added key goes last") && ok;
+
+		// Lookups of present and absent keys.
+		for (int i = 0; i < expected.size(); i++) {
+			ok = ok && dict.has(expected[i]) && dict.getptr(expected[i]);
+		}
+		ok = ok && !dict.has("absent") && !dict.getptr(-1) && !dict.erase("absent");
+		if (!ok) {
+			os->print("\tLookups failed with %d keys.\n", sizes[s]);
+		}
+	}
+
+	return ok;
+}
+
+static bool test_erase_during_iteration() {
+	bool ok = true;
+
+	for (int size = 4; size <= 256; size *= 4) {
+		// Erase the current key while iterating from the next one, everything is visited once.
+		Dictionary dict;
+		for (int i = 0; i < size; i++) {
+			dict[i] = i * 2;
+		}
+		int visited = 0;
+		const Variant *K = dict.next(nullptr);
+		while (K) {
+			const Variant *N = dict.next(K);
+			if (int(*K) != visited || int(dict[*K]) != visited * 2) {
+				ok = false;
+			}
+			dict.erase(*K);
+			visited++;
+			K = N;
+		}
+		if (!ok || visited != size || !dict.empty()) {
+			os->print("\tErasing the current key visited %d of %d.\n", visited, size);
+			ok = false;
+		}
+
+		// Erasing the current key and continuing from it.
+		for (int i = 0; i < size; i++) {
+			dict[i] = i;
+		}
+		visited = 0;
+		for (K = dict.next(nullptr); K; K = dict.next(K)) {
+			visited++;
+			if (int(*K) % 2 == 0) {
+				dict.erase(*K); // Its key stays valid as the iteration cursor.
+			}
+		}
+		Vector<Variant> expected;
+		for (int i = 1; i < size; i += 2) {
+			expected.push_back(i);
+		}
+		if (visited != size) {
+			os->print("\tContinuing after erase visited %d of %d.\n", visited, size);
+			ok = false;
+		}
+		ok = check_order(dict, expected, "Erase during iteration") && ok;
+	}
+
+	// Pointers into the dictionary survive erasing any number of other keys.
+	Dictionary dict;
+	for (int i = 0; i < 1000; i++) {
+		dict[i] = i;
+	}
+	Variant *value = dict.getptr(999);
+	const Variant *key = dict.next(nullptr);
+	for (int i = 1; i < 999; i++) {
+		dict.erase(i);
+	}
+	if (value != dict.getptr(999) || int(*value) != 999 || int(*key) != 0 || dict.next(key) == nullptr || int(*dict.next(key)) != 999) {
+		os->print("\tPointers moved after erasing.\n");
+		ok = false;
+	}
+
+	return ok;
+}
+
+static bool test_slot_reuse() {
+	bool ok = true;
+
+	// Erase most of a large dictionary, then insert into the freed slots: the
+	// survivors keep their order, and the new keys come after them.
+	Dictionary dict;
+	Vector<Variant> expected;
+	for (int i = 0; i < 1000; i++) {
+		dict["k" + itos(i)] = i;
+	}
+	for (int i = 0; i < 1000; i++) {
+		if (i % 10 == 0) {
+			expected.push_back("k" + itos(i));
+		} else {
+			dict.erase("k" + itos(i));
+		}
+	}
+	ok = check_order(dict, expected, "After erasing") && ok;
+
+	// Held across inserts, both into freed slots and into new blocks.
+	Variant *held = dict.getptr("k500");
+	for (int i = 0; i < 2000; i++) {
+		dict["n" + itos(i)] = -i;
+		expected.push_back("n" + itos(i));
+	}
+	dict["new"] = -1;
+	expected.push_back("new");
+	ok = check_order(dict, expected, "After reusing slots") && ok;
+	if (held != dict.getptr("k500") || int(*held) != 500) {
+		os->print("\tPointer moved after inserting.\n");
+		ok = false;
+	}
+	for (int i = 0; i < 1000; i += 10) {
+		if (int(dict["k" + itos(i)]) != i) {
+			os->print("\tWrong value for k%d after reusing slots.\n", i);
+			ok = false;
+			break;
+		}
+	}
+
+	// The reference to the existing value is taken before the new key is
+	// inserted, and must still be readable when it is assigned.
+	dict["copied"] = dict["k990"];
+	if (int(dict["copied"]) != 990) {
+		os->print("\tAssigning from an existing key to a new one failed.\n");
+		ok = false;
+	}
+
+	// Random erases and inserts, checked against the expected contents.
+	Dictionary random;
+	Vector<int> present;
+	present.resize(512);
+	for (int i = 0; i < present.size(); i++) {
+		present.write[i] = -1;
+	}
+	Math::seed(7);
+	for (int i = 0; i < 20000; i++) {
+		int key = Math::rand() % present.size();
+		if (present[key] >= 0) {
+			random.erase(key);
+			present.write[key] = -1;
+		} else {
+			random[key] = i;
+			present.write[key] = i;
+		}
+	}
+	int present_count = 0;
+	for (int key = 0; key < present.size(); key++) {
+		const Variant *value = random.getptr(key);
+		if (present[key] >= 0) {
+			present_count++;
+		}
+		if ((present[key] >= 0) != (value != nullptr) || (value && int(*value) != present[key])) {
+			os->print("\tRandom erase and insert lost key %d.\n", key);
+			ok = false;
+			break;
+		}
+	}
+	if (random.size() != present_count) {
+		os->print("\tRandom erase and insert has %d keys instead of %d.\n", random.size(), present_count);
+		ok = false;
+	}
+
+	// Used as a queue: erase the oldest and insert a new one, many times over.
+	Dictionary queue;
+	int first = 0;
+	int next = 0;
+	for (; next < 64; next++) {
+		queue[next] = next;
+	}
+	for (int i = 0; i < 100000; i++) {
+		queue.erase(first++);
+		queue[next] = next;
+		next++;
+	}
+	expected.clear();
+	for (int i = first; i < next; i++) {
+		expected.push_back(i);
+	}
+	ok = check_order(queue, expected, "Queue churn") && ok;
+
+	// Empty again, then reused.
+	queue.clear();
+	queue["a"] = 1;
+	expected.clear();
+	expected.push_back("a");
+	ok = check_order(queue, expected, "Reuse after clear") && ok;
+
+	// Copies are independent.
+	Dictionary copy = dict.duplicate();
+	copy.erase("new");
+	ok = ok && dict.has("new") && copy.size() == dict.size() - 1;
+	if (!ok) {
+		os->print("\tDuplicate shares entries.\n");
+	}
+
+	return ok;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_ordering,
+	test_erase_during_iteration,
+	test_slot_reuse,
+	nullptr
+};
+
+MainLoop *test() {
+	os = OS::get_singleton();
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		os->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	os->print("\n\n\n");
+	os->print("*************\n");
+	os->print("***TOTALS!***\n");
+	os->print("*************\n");
+
+	os->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+
+} // namespace TestDictionary
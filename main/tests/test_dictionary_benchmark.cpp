@@ -0,0 +1,215 @@
+/*************************************************************************/
+/*  test_dictionary_benchmark.cpp                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_dictionary_benchmark.h"
+
+#include "test_benchmark.h"
+
+#include "core/dictionary.h"
+#include "core/math/math_funcs.h"
+#include "core/ordered_hash_map.h"
+#include "core/os/os.h"
+#include "core/variant.h"
+
+namespace TestDictionaryBenchmark {
+
+// OrderedHashMap is what Dictionary used to be built on, so it serves as the
+// baseline. Both are driven through the same operations.
+
+typedef OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> OrderedMap;
+
+static void dict_set(Dictionary &p_dict, const Variant &p_key, const Variant &p_value) {
+	p_dict[p_key] = p_value;
+}
+
+static const Variant *dict_find(const Dictionary &p_dict, const Variant &p_key) {
+	return p_dict.getptr(p_key);
+}
+
+static void dict_erase(Dictionary &p_dict, const Variant &p_key) {
+	p_dict.erase(p_key);
+}
+
+static int64_t dict_iterate(const Dictionary &p_dict) {
+	int64_t sum = 0;
+	for (const Variant *K = p_dict.next(nullptr); K; K = p_dict.next(K)) {
+		sum += int64_t(p_dict[*K]);
+	}
+	return sum;
+}
+
+static void dict_set(OrderedMap &p_map, const Variant &p_key, const Variant &p_value) {
+	p_map.insert(p_key, p_value);
+}
+
+static const Variant *dict_find(const OrderedMap &p_map, const Variant &p_key) {
+	OrderedMap::ConstElement E = p_map.find(p_key);
+	return E ? &E.value() : nullptr;
+}
+
+static void dict_erase(OrderedMap &p_map, const Variant &p_key) {
+	p_map.erase(p_key);
+}
+
+static int64_t dict_iterate(const OrderedMap &p_map) {
+	int64_t sum = 0;
+	for (OrderedMap::ConstElement E = p_map.front(); E; E = E.next()) {
+		sum += int64_t(E.value());
+	}
+	return sum;
+}
+
+struct Result {
+	uint64_t insert = 0;
+	uint64_t hit = 0;
+	uint64_t miss = 0;
+	uint64_t iterate = 0;
+	uint64_t erase = 0;
+	int64_t checksum = 0;
+};
+
+// p_maps containers get the same keys inserted, looked up (all present), looked
+// up with absent keys, iterated and erased. Many small containers model
+// dictionaries used as structs, a single one models a large table.
+template <class M>
+static Result run(int p_maps, const Vector<Variant> &p_keys, const Vector<Variant> &p_missing, int p_rounds) {
+	Result r;
+	Vector<M> maps;
+	maps.resize(p_maps);
+
+	TestBenchmark::Timer timer;
+	for (int m = 0; m < p_maps; m++) {
+		for (int i = 0; i < p_keys.size(); i++) {
+			dict_set(maps.write[m], p_keys[i], i);
+		}
+	}
+	r.insert = timer.lap();
+
+	for (int round = 0; round < p_rounds; round++) {
+		for (int m = 0; m < p_maps; m++) {
+			for (int i = 0; i < p_keys.size(); i++) {
+				const Variant *v = dict_find(maps[m], p_keys[i]);
+				r.checksum += v ? int64_t(*v) : -1;
+			}
+		}
+	}
+	r.hit = timer.lap();
+
+	for (int round = 0; round < p_rounds; round++) {
+		for (int m = 0; m < p_maps; m++) {
+			for (int i = 0; i < p_missing.size(); i++) {
+				r.checksum += dict_find(maps[m], p_missing[i]) ? 1 : 0;
+			}
+		}
+	}
+	r.miss = timer.lap();
+
+	for (int round = 0; round < p_rounds; round++) {
+		for (int m = 0; m < p_maps; m++) {
+			r.checksum += dict_iterate(maps[m]);
+		}
+	}
+	r.iterate = timer.lap();
+
+	for (int m = 0; m < p_maps; m++) {
+		for (int i = 0; i < p_keys.size(); i++) {
+			dict_erase(maps.write[m], p_keys[i]);
+		}
+	}
+	r.erase = timer.lap();
+
+	return r;
+}
+
+static void print_result(const char *p_name, const Result &p_result, int p_ops, int p_rounds) {
+	using TestBenchmark::ns_per_op;
+	double lookups = double(p_ops) * p_rounds;
+	OS::get_singleton()->print("  %-14s insert %7.2f ns  hit %7.2f ns  miss %7.2f ns  iterate %7.2f ns  erase %7.2f ns\n", p_name,
+			ns_per_op(p_result.insert, p_ops), ns_per_op(p_result.hit, lookups), ns_per_op(p_result.miss, lookups),
+			ns_per_op(p_result.iterate, lookups), ns_per_op(p_result.erase, p_ops));
+}
+
+static bool compare(const char *p_name, int p_maps, const Vector<Variant> &p_keys, const Vector<Variant> &p_missing, int p_rounds) {
+	OS::get_singleton()->print("%s, %d x %d keys\n", p_name, p_maps, p_keys.size());
+
+	Result dict = run<Dictionary>(p_maps, p_keys, p_missing, p_rounds);
+	Result ordered = run<OrderedMap>(p_maps, p_keys, p_missing, p_rounds);
+
+	const int ops = p_maps * p_keys.size();
+	print_result("Dictionary", dict, ops, p_rounds);
+	print_result("OrderedHashMap", ordered, ops, p_rounds);
+
+	return TestBenchmark::check_checksums(dict.checksum, ordered.checksum);
+}
+
+static void make_keys(int p_count, int p_type, Vector<Variant> &r_keys, Vector<Variant> &r_missing) {
+	r_keys.resize(p_count);
+	r_missing.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		switch (p_type) {
+			case Variant::INT: {
+				// Even keys are stored, odd keys are never present.
+				int64_t key = int64_t(Math::rand() & 0x3fffffff) << 1;
+				r_keys.write[i] = key;
+				r_missing.write[i] = key | 1;
+			} break;
+			case Variant::STRING_NAME: {
+				r_keys.write[i] = StringName("property_" + itos(i));
+				r_missing.write[i] = StringName("property_" + itos(i) + "_missing");
+			} break;
+			default: {
+				r_keys.write[i] = "res://assets/texture_" + itos(i) + ".png";
+				r_missing.write[i] = "res://assets/texture_" + itos(i) + ".jpg";
+			}
+		}
+	}
+}
+
+MainLoop *test() {
+	TestBenchmark::begin("Dictionary benchmark");
+
+	bool ok = true;
+	Vector<Variant> keys, missing;
+
+	// Struct-like dictionaries, such as the ones returned by get_property_list().
+	make_keys(6, Variant::STRING_NAME, keys, missing);
+	ok = compare("StringName, small", 10000, keys, missing, 20) && ok;
+	make_keys(6, Variant::STRING, keys, missing);
+	ok = compare("String, small", 10000, keys, missing, 20) && ok;
+
+	make_keys(1 << 16, Variant::INT, keys, missing);
+	ok = compare("int, large", 1, keys, missing, 10) && ok;
+	make_keys(1 << 14, Variant::STRING, keys, missing);
+	ok = compare("String, large", 1, keys, missing, 10) && ok;
+
+	return TestBenchmark::end(ok, "All containers agreed.", "Some containers disagreed.");
+}
+
+} // namespace TestDictionaryBenchmark
@@ -0,0 +1,162 @@
+/*************************************************************************/
+/*  test_enet.cpp                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_enet.h"
+
+#include "core/io/marshalls.h"
+#include "core/os/os.h"
+
+#include "modules/modules_enabled.gen.h"
+#ifdef MODULE_ENET_ENABLED
+#include "modules/enet/networked_multiplayer_enet.h"
+#endif
+
+namespace TestENet {
+
+#ifdef MODULE_ENET_ENABLED
+
+enum {
+	TEST_PORT = 47653,
+	TEST_PACKET_COUNT = 1000, // Well past the initial incoming queue size.
+	TEST_TIMEOUT_MSEC = 5000,
+};
+
+static bool _wait_for_connection(Ref<NetworkedMultiplayerENet> p_server, Ref<NetworkedMultiplayerENet> p_client) {
+	uint64_t start = OS::get_singleton()->get_ticks_msec();
+	while (OS::get_singleton()->get_ticks_msec() - start < TEST_TIMEOUT_MSEC) {
+		p_server->poll();
+		p_client->poll();
+		if (p_client->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_CONNECTED) {
+			return true;
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+	return false;
+}
+
+static bool test_incoming_queue_growth() {
+	Ref<NetworkedMultiplayerENet> server;
+	server.instance();
+	Ref<NetworkedMultiplayerENet> client;
+	client.instance();
+
+	if (server->create_server(TEST_PORT) != OK || client->create_client("127.0.0.1", TEST_PORT) != OK) {
+		OS::get_singleton()->print("Unable to create the ENet server or client.\n");
+		return false;
+	}
+
+	bool ok = _wait_for_connection(server, client);
+	if (!ok) {
+		OS::get_singleton()->print("Client did not connect.\n");
+	}
+
+	if (ok) {
+		// Send everything before the server reads anything, so it all piles up in its queue.
+		client->set_target_peer(NetworkedMultiplayerPeer::TARGET_PEER_SERVER);
+		for (int i = 0; i < TEST_PACKET_COUNT; i++) {
+			uint8_t data[4];
+			encode_uint32(i, data);
+			client->put_packet(data, 4);
+		}
+
+		uint64_t start = OS::get_singleton()->get_ticks_msec();
+		while (server->get_available_packet_count() < TEST_PACKET_COUNT && OS::get_singleton()->get_ticks_msec() - start < TEST_TIMEOUT_MSEC) {
+			client->poll();
+			server->poll();
+			OS::get_singleton()->delay_usec(1000);
+		}
+		if (server->get_available_packet_count() != TEST_PACKET_COUNT) {
+			OS::get_singleton()->print("Expected %d queued packets, got %d.\n", TEST_PACKET_COUNT, server->get_available_packet_count());
+			ok = false;
+		}
+
+		for (int i = 0; ok && i < TEST_PACKET_COUNT; i++) {
+			const uint8_t *buffer = nullptr;
+			int size = 0;
+			if (server->get_packet(&buffer, size) != OK || size != 4 || decode_uint32(buffer) != uint32_t(i)) {
+				OS::get_singleton()->print("Packet %d was lost or corrupted.\n", i);
+				ok = false;
+			}
+		}
+		if (ok && server->get_available_packet_count() != 0) {
+			OS::get_singleton()->print("Packets left over in the queue.\n");
+			ok = false;
+		}
+	}
+
+	client->close_connection();
+	server->close_connection();
+	return ok;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_incoming_queue_growth,
+	nullptr
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+
+#else
+
+MainLoop *test() {
+	ERR_PRINT("The ENet module is disabled, nothing to test.");
+	return nullptr;
+}
+
+#endif
+
+} // namespace TestENet
@@ -729,24 +729,25 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 						txt += " call ";
 					}
 
+					// Operands: argc, call cache index, base, name, arguments, return.
 					int argc = code[ip + 1];
 					if (ret) {
-						txt += DADDR(4 + argc) + "=";
+						txt += DADDR(5 + argc) + "=";
 					}
 
-					txt += DADDR(2) + ".";
-					txt += String(func.get_global_name(code[ip + 3]));
+					txt += DADDR(3) + ".";
+					txt += String(func.get_global_name(code[ip + 4]));
 					txt += "(";
 
 					for (int i = 0; i < argc; i++) {
 						if (i > 0) {
 							txt += ", ";
 						}
-						txt += DADDR(4 + i);
+						txt += DADDR(5 + i);
 					}
 					txt += ")";
 
-					incr = 5 + argc;
+					incr = 6 + argc;
 
 				} break;
 				case GDScriptFunction::OPCODE_CALL_BUILT_IN: {
@@ -0,0 +1,194 @@
+/*************************************************************************/
+/*  test_hash_map_benchmark.cpp                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_hash_map_benchmark.h"
+
+#include "test_benchmark.h"
+
+#include "core/hash_map.h"
+#include "core/math/math_funcs.h"
+#include "core/oa_hash_map.h"
+#include "core/os/os.h"
+#include "core/string_name.h"
+
+namespace TestHashMapBenchmark {
+
+// Both maps are driven through the same small set of operations, so the
+// benchmarks below can be written once.
+
+template <class K, class V>
+static void map_set(HashMap<K, V> &p_map, const K &p_key, const V &p_value) {
+	p_map.set(p_key, p_value);
+}
+
+template <class K, class V>
+static V *map_find(HashMap<K, V> &p_map, const K &p_key) {
+	return p_map.getptr(p_key);
+}
+
+template <class K, class V>
+static void map_erase(HashMap<K, V> &p_map, const K &p_key) {
+	p_map.erase(p_key);
+}
+
+template <class K, class V>
+static void map_set(OAHashMap<K, V> &p_map, const K &p_key, const V &p_value) {
+	p_map.set(p_key, p_value);
+}
+
+template <class K, class V>
+static V *map_find(OAHashMap<K, V> &p_map, const K &p_key) {
+	return p_map.lookup_ptr(p_key);
+}
+
+template <class K, class V>
+static void map_erase(OAHashMap<K, V> &p_map, const K &p_key) {
+	p_map.remove(p_key);
+}
+
+struct Result {
+	uint64_t insert = 0;
+	uint64_t hit = 0;
+	uint64_t miss = 0;
+	uint64_t erase = 0;
+	int64_t checksum = 0;
+};
+
+// Keys are inserted, looked up (all present), looked up again with keys that
+// are all absent, then erased. The checksum makes sure both maps agree and
+// keeps the lookups from being optimized out.
+template <class M, class K>
+static Result run(const Vector<K> &p_keys, const Vector<K> &p_missing, int p_lookup_rounds) {
+	Result r;
+	M map;
+
+	TestBenchmark::Timer timer;
+	for (int i = 0; i < p_keys.size(); i++) {
+		map_set(map, p_keys[i], i);
+	}
+	r.insert = timer.lap();
+
+	for (int round = 0; round < p_lookup_rounds; round++) {
+		for (int i = 0; i < p_keys.size(); i++) {
+			int *v = map_find(map, p_keys[i]);
+			r.checksum += v ? *v : -1;
+		}
+	}
+	r.hit = timer.lap();
+
+	for (int round = 0; round < p_lookup_rounds; round++) {
+		for (int i = 0; i < p_missing.size(); i++) {
+			r.checksum += map_find(map, p_missing[i]) ? 1 : 0;
+		}
+	}
+	r.miss = timer.lap();
+
+	for (int i = 0; i < p_keys.size(); i++) {
+		map_erase(map, p_keys[i]);
+	}
+	r.erase = timer.lap();
+
+	return r;
+}
+
+static void print_result(const char *p_map, const Result &p_result, int p_count, int p_rounds) {
+	using TestBenchmark::ns_per_op;
+	double lookups = double(p_count) * p_rounds;
+	OS::get_singleton()->print("  %-10s insert %7.2f ns  hit %7.2f ns  miss %7.2f ns  erase %7.2f ns\n", p_map,
+			ns_per_op(p_result.insert, p_count), ns_per_op(p_result.hit, lookups),
+			ns_per_op(p_result.miss, lookups), ns_per_op(p_result.erase, p_count));
+}
+
+template <class K>
+static bool compare(const char *p_name, const Vector<K> &p_keys, const Vector<K> &p_missing, int p_rounds) {
+	OS::get_singleton()->print("%s, %d keys\n", p_name, p_keys.size());
+
+	Result chained = run<HashMap<K, int>, K>(p_keys, p_missing, p_rounds);
+	Result open = run<OAHashMap<K, int>, K>(p_keys, p_missing, p_rounds);
+
+	print_result("HashMap", chained, p_keys.size(), p_rounds);
+	print_result("OAHashMap", open, p_keys.size(), p_rounds);
+
+	return TestBenchmark::check_checksums(open.checksum, chained.checksum);
+}
+
+static void make_int_keys(int p_count, Vector<int> &r_keys, Vector<int> &r_missing) {
+	r_keys.resize(p_count);
+	r_missing.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		// Even keys are stored, odd keys are never present.
+		r_keys.write[i] = (Math::rand() & 0x3fffffff) << 1;
+		r_missing.write[i] = r_keys[i] | 1;
+	}
+}
+
+template <class K>
+static void make_string_keys(int p_count, const String &p_prefix, Vector<K> &r_keys, Vector<K> &r_missing) {
+	r_keys.resize(p_count);
+	r_missing.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		r_keys.write[i] = K(p_prefix + itos(i));
+		r_missing.write[i] = K(p_prefix + itos(i) + "_missing");
+	}
+}
+
+MainLoop *test() {
+	TestBenchmark::begin("HashMap / OAHashMap benchmark");
+
+	bool ok = true;
+
+	{
+		Vector<int> keys, missing;
+		make_int_keys(64, keys, missing);
+		ok = compare("int, small", keys, missing, 20000) && ok;
+		make_int_keys(1 << 17, keys, missing);
+		ok = compare("int, large", keys, missing, 10) && ok;
+	}
+
+	{
+		// Method and property tables, as in ClassDB.
+		Vector<StringName> keys, missing;
+		make_string_keys(48, "get_property_", keys, missing);
+		ok = compare("StringName, small", keys, missing, 20000) && ok;
+		make_string_keys(1 << 14, "method_", keys, missing);
+		ok = compare("StringName, large", keys, missing, 50) && ok;
+	}
+
+	{
+		// Resource paths, as in ResourceCache.
+		Vector<String> keys, missing;
+		make_string_keys(1 << 13, "res://assets/textures/texture_", keys, missing);
+		ok = compare("String paths", keys, missing, 20) && ok;
+	}
+
+	return TestBenchmark::end(ok, "All maps agreed.", "Some maps disagreed.");
+}
+
+} // namespace TestHashMapBenchmark
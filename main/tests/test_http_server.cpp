@@ -0,0 +1,317 @@
+/*************************************************************************/
+/*  test_http_server.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_http_server.h"
+
+#include "core/callable_method_pointer.h"
+#include "core/io/http_server.h"
+#include "core/io/stream_peer_tcp.h"
+#include "core/os/os.h"
+
+namespace TestHTTPServer {
+
+enum {
+	TEST_PORT = 47654,
+	TEST_TIMEOUT_MSEC = 2000,
+};
+
+// Answers every request with its path as the body, unless told to stop the server instead.
+class RequestHandler : public Object {
+public:
+	Vector<Ref<HTTPServerRequest>> requests;
+	HTTPServer *stop_server = nullptr;
+
+	void _on_request(Ref<HTTPServerRequest> p_request) {
+		requests.push_back(p_request);
+		if (stop_server) {
+			stop_server->stop();
+			return;
+		}
+		CharString path = p_request->get_path().utf8();
+		PackedByteArray body;
+		body.resize(path.length());
+		copymem(body.ptrw(), path.get_data(), path.length());
+		p_request->respond(200, body);
+	}
+};
+
+static OS *os = nullptr;
+
+static Ref<StreamPeerTCP> _connect(Ref<HTTPServer> p_server) {
+	Ref<StreamPeerTCP> tcp;
+	tcp.instance();
+	tcp->connect_to_host(IP_Address("127.0.0.1"), TEST_PORT);
+	uint64_t start = os->get_ticks_msec();
+	while (tcp->get_status() == StreamPeerTCP::STATUS_CONNECTING && os->get_ticks_msec() - start < TEST_TIMEOUT_MSEC) {
+		p_server->poll();
+		os->delay_usec(1000);
+	}
+	// Let the server accept it.
+	for (int i = 0; i < 10; i++) {
+		p_server->poll();
+		os->delay_usec(1000);
+	}
+	return tcp;
+}
+
+static void _send(Ref<StreamPeerTCP> p_tcp, const String &p_data) {
+	CharString cs = p_data.utf8();
+	p_tcp->put_data((const uint8_t *)cs.get_data(), cs.length());
+}
+
+// Polls the server and reads from the client until p_until was received, or the connection closed.
+static String _receive(Ref<HTTPServer> p_server, Ref<StreamPeerTCP> p_tcp, const String &p_until) {
+	String received;
+	uint64_t start = os->get_ticks_msec();
+	while (os->get_ticks_msec() - start < TEST_TIMEOUT_MSEC) {
+		p_server->poll();
+		int available = p_tcp->get_available_bytes();
+		if (available > 0) {
+			Vector<uint8_t> data;
+			data.resize(available);
+			int read = 0;
+			p_tcp->get_partial_data(data.ptrw(), available, read);
+			String chunk;
+			chunk.parse_utf8((const char *)data.ptr(), read);
+			received += chunk;
+		}
+		if (received.find(p_until) >= 0 || p_tcp->get_status() != StreamPeerTCP::STATUS_CONNECTED) {
+			break;
+		}
+		os->delay_usec(1000);
+	}
+	return received;
+}
+
+static void _wait_closed(Ref<HTTPServer> p_server) {
+	uint64_t start = os->get_ticks_msec();
+	while (p_server->get_connection_count() && os->get_ticks_msec() - start < TEST_TIMEOUT_MSEC) {
+		p_server->poll();
+		os->delay_usec(1000);
+	}
+}
+
+static bool _check(bool p_condition, const char *p_what) {
+	if (!p_condition) {
+		os->print("\t%s: FAILED\n", p_what);
+	}
+	return p_condition;
+}
+
+static bool test_request_parsing(Ref<HTTPServer> p_server, RequestHandler *p_handler) {
+	bool ok = true;
+
+	Ref<StreamPeerTCP> tcp = _connect(p_server);
+	_send(tcp, "GET /some/path?x=1&y=2 HTTP/1.1\r\nHost: localhost\r\nX-Test: a\r\nx-test:  b \r\n\r\n");
+	String response = _receive(p_server, tcp, "/some/path");
+	ok = _check(response.begins_with("HTTP/1.1 200 OK\r\n"), "Status line") && ok;
+	ok = _check(response.ends_with("\r\n\r\n/some/path"), "Response body") && ok;
+	if (_check(p_handler->requests.size() == 1, "One request received")) {
+		Ref<HTTPServerRequest> req = p_handler->requests[0];
+		ok = _check(req->get_method() == HTTPClient::METHOD_GET, "Method") && ok;
+		ok = _check(req->get_path() == "/some/path", "Path") && ok;
+		ok = _check(req->get_query_string() == "x=1&y=2", "Query string") && ok;
+		ok = _check(req->get_header("HOST") == "localhost", "Case insensitive header") && ok;
+		ok = _check(req->get_header("X-Test") == "a, b", "Repeated header") && ok;
+	} else {
+		ok = false;
+	}
+
+	// A body split across writes is only delivered once complete.
+	p_handler->requests.clear();
+	_send(tcp, "POST /upload HTTP/1.1\r\nContent-Length: 11\r\n\r\nhello");
+	_receive(p_server, tcp, "/upload");
+	ok = _check(p_handler->requests.empty(), "Partial body not delivered") && ok;
+	_send(tcp, " world");
+	response = _receive(p_server, tcp, "/upload");
+	ok = _check(response.ends_with("/upload"), "Split body response") && ok;
+	if (_check(p_handler->requests.size() == 1, "Split body request")) {
+		PackedByteArray body = p_handler->requests[0]->get_body();
+		String text;
+		text.parse_utf8((const char *)body.ptr(), body.size());
+		ok = _check(text == "hello world", "Split body") && ok;
+	} else {
+		ok = false;
+	}
+
+	tcp->disconnect_from_host();
+	p_handler->requests.clear();
+	return ok;
+}
+
+static bool test_keep_alive(Ref<HTTPServer> p_server, RequestHandler *p_handler) {
+	bool ok = true;
+
+	// HTTP/1.1 keeps the connection, and pipelined requests are answered in order.
+	Ref<StreamPeerTCP> tcp = _connect(p_server);
+	_send(tcp, "GET /one HTTP/1.1\r\n\r\nGET /two HTTP/1.1\r\n\r\n");
+	String response = _receive(p_server, tcp, "/two");
+	int one = response.find("/one");
+	int two = response.find("/two");
+	ok = _check(one >= 0 && two > one, "Pipelined responses in order") && ok;
+	ok = _check(response.find("Connection: close") < 0, "HTTP/1.1 keep-alive") && ok;
+	_send(tcp, "GET /three HTTP/1.1\r\n\r\n");
+	response = _receive(p_server, tcp, "/three");
+	ok = _check(response.ends_with("/three"), "Request on a reused connection") && ok;
+	ok = _check(p_server->get_connection_count() == 1, "Connection kept") && ok;
+
+	// "Connection: close" on HTTP/1.1, and plain HTTP/1.0, close after the response.
+	_send(tcp, "GET /close HTTP/1.1\r\nConnection: close\r\n\r\n");
+	response = _receive(p_server, tcp, "/close");
+	ok = _check(response.find("Connection: close\r\n") >= 0, "Connection close header") && ok;
+	_wait_closed(p_server);
+	ok = _check(p_server->get_connection_count() == 0, "Connection closed") && ok;
+
+	tcp = _connect(p_server);
+	_send(tcp, "GET /old HTTP/1.0\r\n\r\n");
+	response = _receive(p_server, tcp, "/old");
+	ok = _check(response.begins_with("HTTP/1.0 200 OK\r\n"), "HTTP/1.0 status line") && ok;
+	_wait_closed(p_server);
+	ok = _check(p_server->get_connection_count() == 0, "HTTP/1.0 connection closed") && ok;
+
+	tcp = _connect(p_server);
+	_send(tcp, "GET /old HTTP/1.0\r\nConnection: keep-alive\r\n\r\n");
+	response = _receive(p_server, tcp, "/old");
+	ok = _check(response.find("Connection: keep-alive\r\n") >= 0, "HTTP/1.0 keep-alive header") && ok;
+	ok = _check(p_server->get_connection_count() == 1, "HTTP/1.0 keep-alive connection kept") && ok;
+	tcp->disconnect_from_host();
+
+	p_handler->requests.clear();
+	return ok;
+}
+
+static bool _expect_failure(Ref<HTTPServer> p_server, RequestHandler *p_handler, const String &p_request, int p_code, const char *p_what) {
+	Ref<StreamPeerTCP> tcp = _connect(p_server);
+	_send(tcp, p_request);
+	String status = "HTTP/1.1 " + itos(p_code) + " " + HTTPServerRequest::get_status_text(p_code);
+	String response = _receive(p_server, tcp, "\r\n\r\n" + HTTPServerRequest::get_status_text(p_code));
+	bool ok = _check(response.begins_with(status) && response.find("Connection: close\r\n") >= 0, p_what);
+	ok = _check(p_handler->requests.empty(), p_what) && ok;
+	tcp->disconnect_from_host();
+	p_handler->requests.clear();
+	return ok;
+}
+
+static bool test_limits(Ref<HTTPServer> p_server, RequestHandler *p_handler) {
+	bool ok = true;
+
+	ok = _expect_failure(p_server, p_handler, "GET /\r\n\r\n", 400, "Malformed request line") && ok;
+	ok = _expect_failure(p_server, p_handler, "GET / HTTP/1.1\r\nno separator\r\n\r\n", 400, "Malformed header") && ok;
+	ok = _expect_failure(p_server, p_handler, "BREW / HTTP/1.1\r\n\r\n", 501, "Unknown method") && ok;
+	ok = _expect_failure(p_server, p_handler, "GET / HTTP/2.0\r\n\r\n", 505, "Unsupported version") && ok;
+	ok = _expect_failure(p_server, p_handler, "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n", 501, "Chunked request body") && ok;
+	ok = _expect_failure(p_server, p_handler, "POST / HTTP/1.1\r\nContent-Length: -1\r\n\r\n", 400, "Negative content length") && ok;
+
+	int max_size = p_server->get_max_request_size();
+	p_server->set_max_request_size(16);
+	ok = _expect_failure(p_server, p_handler, "POST / HTTP/1.1\r\nContent-Length: 17\r\n\r\n", 413, "Body over max_request_size") && ok;
+	p_server->set_max_request_size(max_size);
+
+	String huge = "GET / HTTP/1.1\r\nX-Padding: ";
+	for (int i = 0; i < 1024; i++) {
+		huge += "0123456789";
+	}
+	ok = _expect_failure(p_server, p_handler, huge, 431, "Headers over the size limit") && ok;
+
+	return ok;
+}
+
+static bool test_stop_in_handler(Ref<HTTPServer> p_server, RequestHandler *p_handler) {
+	// Two connections with requests in the same poll, the first handler stops the server.
+	Ref<StreamPeerTCP> a = _connect(p_server);
+	Ref<StreamPeerTCP> b = _connect(p_server);
+	p_handler->stop_server = p_server.ptr();
+	_send(a, "GET /a HTTP/1.1\r\n\r\n");
+	_send(b, "GET /b HTTP/1.1\r\n\r\n");
+	os->delay_usec(50000);
+	while (p_server->is_listening()) {
+		p_server->poll();
+		os->delay_usec(1000);
+	}
+	p_handler->stop_server = nullptr;
+
+	bool ok = _check(p_handler->requests.size() == 1, "No request handled after stop");
+	ok = _check(p_server->get_connection_count() == 0, "Connections closed on stop") && ok;
+	p_handler->requests.clear();
+	return ok;
+}
+
+typedef bool (*TestFunc)(Ref<HTTPServer> p_server, RequestHandler *p_handler);
+
+TestFunc test_funcs[] = {
+	test_request_parsing,
+	test_keep_alive,
+	test_limits,
+	test_stop_in_handler,
+	nullptr
+};
+
+MainLoop *test() {
+	os = OS::get_singleton();
+
+	Ref<HTTPServer> server;
+	server.instance();
+	RequestHandler handler;
+	server->connect("request_received", callable_mp(&handler, &RequestHandler::_on_request));
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		if (!server->is_listening() && server->listen(TEST_PORT, IP_Address("127.0.0.1")) != OK) {
+			os->print("Unable to listen on port %d.\n", TEST_PORT);
+			break;
+		}
+		_wait_closed(server); // From the previous test.
+		bool pass = test_funcs[count](server, &handler);
+		if (pass) {
+			passed++;
+		}
+		os->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	server->stop();
+
+	os->print("\n\n\n");
+	os->print("*************\n");
+	os->print("***TOTALS!***\n");
+	os->print("*************\n");
+
+	os->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+
+} // namespace TestHTTPServer
@@ -0,0 +1,422 @@
+/*************************************************************************/
+/*  test_json.cpp                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_json.h"
+
+#include "core/io/json.h"
+#include "core/os/os.h"
+
+namespace TestJSON {
+
+static OS *os = nullptr;
+
+// Compact, sorted output, used to compare parse results deeply.
+static String _canonical(const Variant &p_var) {
+	return JSON::print(p_var, "", true);
+}
+
+static Variant _sample() {
+	Dictionary inner;
+	inner["quote\"and\\backslash"] = "line\nbreak\ttab\rreturn\bback\fform";
+	inner["unicode"] = String::utf8("caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80");
+	inner["empty"] = "";
+	inner["empty_array"] = Array();
+	inner["empty_object"] = Dictionary();
+
+	Array numbers;
+	numbers.push_back(0);
+	numbers.push_back(-1);
+	numbers.push_back(123456789);
+	numbers.push_back(-0.5);
+	numbers.push_back(3.25e10);
+	numbers.push_back(1e-5);
+
+	Array mixed;
+	mixed.push_back(true);
+	mixed.push_back(false);
+	mixed.push_back(Variant());
+	mixed.push_back(inner);
+	mixed.push_back(numbers);
+
+	Dictionary root;
+	root["mixed"] = mixed;
+	root["numbers"] = numbers;
+	root["object"] = inner;
+	root["text"] = "plain";
+	return root;
+}
+
+static Error _feed_split(JSONReader &p_reader, const CharString &p_text, int p_split) {
+	const uint8_t *data = (const uint8_t *)p_text.get_data();
+	Error err = p_reader.feed(data, p_split);
+	if (err == OK) {
+		err = p_reader.feed(data + p_split, p_text.length() - p_split);
+	}
+	if (err == OK) {
+		err = p_reader.finish();
+	}
+	return err;
+}
+
+static Error _parse_chunked(const CharString &p_text, int p_split, Variant &r_ret) {
+	JSONVariantBuilder builder;
+	JSONReader reader(&builder);
+	Error err = _feed_split(reader, p_text, p_split);
+	if (err == OK) {
+		r_ret = builder.get_result();
+	}
+	return err;
+}
+
+static bool test_round_trip() {
+	bool ok = true;
+	const Variant sample = _sample();
+	const String indents[] = { "", "\t", "    " };
+
+	for (int i = 0; i < 3; i++) {
+		// JSON::print output read back by the streaming reader.
+		String text = JSON::print(sample, indents[i]);
+		Variant expected;
+		String err_str;
+		int err_line = 0;
+		if (JSON::parse(text, expected, err_str, err_line) != OK) {
+			os->print("\tJSON::parse failed on its own output: %s\n", err_str.utf8().get_data());
+			return false;
+		}
+
+		CharString cs = text.utf8();
+		Variant streamed;
+		if (JSON::parse_utf8((const uint8_t *)cs.get_data(), cs.length(), streamed, err_str, err_line) != OK || _canonical(streamed) != _canonical(expected)) {
+			os->print("\tStreaming parse of JSON::print output differs (indent %d).\n", i);
+			ok = false;
+		}
+
+		// JSONWriter output read back by JSON::parse.
+		JSONWriter writer(nullptr, indents[i]);
+		writer.write_variant(sample);
+		Variant written;
+		if (JSON::parse(writer.get_string(), written, err_str, err_line) != OK || _canonical(written) != _canonical(expected)) {
+			os->print("\tJSON::parse of JSONWriter output differs (indent %d).\n", i);
+			ok = false;
+		}
+	}
+
+	// The same values written with the event API.
+	JSONWriter writer;
+	writer.begin_object();
+	writer.write_key("a");
+	writer.begin_array();
+	writer.write_int(-42);
+	writer.write_number(0.5);
+	writer.write_bool(true);
+	writer.write_null();
+	writer.write_string("x\"y");
+	writer.end_array();
+	writer.write_key("b");
+	writer.begin_object();
+	writer.end_object();
+	writer.end_object();
+	if (writer.get_string() != "{\"a\":[-42,0.5,true,null,\"x\\\"y\"],\"b\":{}}") {
+		os->print("\tUnexpected JSONWriter output: %s\n", writer.get_string().utf8().get_data());
+		ok = false;
+	}
+
+	return ok;
+}
+
+static bool test_chunk_splits() {
+	bool ok = true;
+
+	// Escapes, a surrogate pair, raw multibyte UTF-8, numbers and literals that
+	// every split below cuts at every possible position.
+	const char *documents[] = {
+		"{\"k\\\"ey\": [\"a\\\\b\\n\\u00e9\\ud83d\\ude00\", -12.5e-3, 7, true, false, null],\n \"caf\xc3\xa9\": \"\xf0\x9f\x98\x80\", \"\": {}}",
+		"[1234567890, -0.25, \"\\uD83D\\uDE00\\u0041\", [[[]]], {\"a\": {\"b\": null}}]",
+		"\"\\ud83d\"",
+		"-1.5E+10",
+		"null",
+		nullptr
+	};
+	const String expected_strings[] = {
+		String::utf8("a\\b\n\xc3\xa9\xf0\x9f\x98\x80"),
+		String::utf8("\xf0\x9f\x98\x80" "A"),
+		String::utf8("\xef\xbf\xbd"), // Unpaired surrogate.
+	};
+
+	for (int d = 0; documents[d]; d++) {
+		CharString text = documents[d];
+		Variant whole;
+		if (_parse_chunked(text, 0, whole) != OK) {
+			os->print("\tDocument %d failed to parse.\n", d);
+			ok = false;
+			continue;
+		}
+		const String canonical = _canonical(whole);
+
+		for (int split = 1; split <= text.length(); split++) {
+			Variant split_result;
+			if (_parse_chunked(text, split, split_result) != OK || _canonical(split_result) != canonical) {
+				os->print("\tDocument %d differs when split at byte %d.\n", d, split);
+				ok = false;
+				break;
+			}
+		}
+
+		// One byte at a time.
+		JSONVariantBuilder builder;
+		JSONReader reader(&builder);
+		Error err = OK;
+		for (int i = 0; i < text.length() && err == OK; i++) {
+			err = reader.feed((const uint8_t *)text.get_data() + i, 1);
+		}
+		if (err != OK || reader.finish() != OK || _canonical(builder.get_result()) != canonical) {
+			os->print("\tDocument %d differs when fed byte by byte.\n", d);
+			ok = false;
+		}
+
+		// The decoded escapes themselves.
+		String decoded;
+		if (d == 0) {
+			decoded = Array(Dictionary(whole)["k\"ey"])[0];
+		} else if (d == 1) {
+			decoded = Array(whole)[2];
+		} else if (d == 2) {
+			decoded = whole;
+		}
+		if (d <= 2 && decoded != expected_strings[d]) {
+			os->print("\tDocument %d decoded to the wrong string.\n", d);
+			ok = false;
+		}
+	}
+
+	return ok;
+}
+
+static bool test_invalid_input() {
+	struct Invalid {
+		const char *text;
+		int line;
+	};
+	const Invalid invalid[] = {
+		{ "{\n\"a\": 1,\n\"b\" 2\n}", 3 }, // Missing colon.
+		{ "[1,\n2,\n]", 3 }, // Trailing comma.
+		{ "[\n\"abc", 2 }, // Unterminated string.
+		{ "{\"a\":\n\n tru }", 3 }, // Bad literal.
+		{ "[1] 2", 1 }, // Trailing value.
+		{ "\n\"\\uZZ00\"", 2 }, // Bad escape.
+		{ "[\"a\nb\" }", 2 }, // Mismatched end, after a raw newline in a string.
+		{ "{1: 2}", 1 }, // Non-string key.
+		{ "", 1 }, // Empty.
+		{ "[\n[\n[", 3 }, // Unexpected EOF.
+		{ nullptr, 0 }
+	};
+
+	bool ok = true;
+	for (int i = 0; invalid[i].text; i++) {
+		CharString text = invalid[i].text;
+		for (int split = 0; split <= text.length(); split++) {
+			JSONVariantBuilder builder;
+			JSONReader reader(&builder);
+			Error err = _feed_split(reader, text, split);
+			if (err != ERR_PARSE_ERROR || reader.get_error_message().empty() || reader.get_error_line() != invalid[i].line) {
+				os->print("\tInvalid document %d (split at %d): expected an error on line %d, got '%s' on line %d.\n", i, split, invalid[i].line, reader.get_error_message().utf8().get_data(), reader.get_error_line());
+				ok = false;
+				break;
+			}
+
+			// A failed reader refuses input until reset, then parses again.
+			if (reader.feed((const uint8_t *)"[]", 2) == OK) {
+				os->print("\tFailed reader accepted more input.\n");
+				ok = false;
+				break;
+			}
+			reader.reset();
+			if (reader.feed((const uint8_t *)"[]", 2) != OK || reader.finish() != OK) {
+				os->print("\tReader unusable after reset.\n");
+				ok = false;
+				break;
+			}
+		}
+	}
+	return ok;
+}
+
+// Only counts the nesting, so very deep documents don't build huge Variants.
+class DepthCounter : public JSONHandler {
+public:
+	int depth = 0;
+	int max_depth = 0;
+	int values = 0;
+
+	virtual Error begin_object() { return _push(); }
+	virtual Error end_object() { return _pop(); }
+	virtual Error begin_array() { return _push(); }
+	virtual Error end_array() { return _pop(); }
+	virtual Error key(const char *p_utf8, int p_len) { return OK; }
+	virtual Error string_value(const char *p_utf8, int p_len) { return _value(); }
+	virtual Error number_value(double p_value) { return _value(); }
+	virtual Error bool_value(bool p_value) { return _value(); }
+	virtual Error null_value() { return _value(); }
+
+	Error _push() {
+		depth++;
+		max_depth = MAX(depth, max_depth);
+		return OK;
+	}
+	Error _pop() {
+		depth--;
+		return OK;
+	}
+	Error _value() {
+		values++;
+		return OK;
+	}
+};
+
+static bool test_deep_nesting() {
+	bool ok = true;
+
+	// Far deeper than a recursive parser could handle. Objects need a key before
+	// each nested value, so levels alternate between '{"k":' and '['.
+	const int depth = 1000000;
+	const int levels_per_chunk = 1000;
+	{
+		String open;
+		String close;
+		for (int i = 0; i < levels_per_chunk; i++) {
+			open += (i & 1) ? "[" : "{\"k\":";
+		}
+		for (int i = levels_per_chunk - 1; i >= 0; i--) {
+			close += (i & 1) ? "]" : "}";
+		}
+		CharString open_utf8 = open.utf8();
+		CharString close_utf8 = close.utf8();
+
+		DepthCounter counter;
+		JSONReader reader(&counter);
+		Error err = OK;
+		for (int i = 0; i < depth / levels_per_chunk && err == OK; i++) {
+			err = reader.feed((const uint8_t *)open_utf8.get_data(), open_utf8.length());
+		}
+		if (err == OK) {
+			err = reader.feed((const uint8_t *)"1", 1);
+		}
+		for (int i = 0; i < depth / levels_per_chunk && err == OK; i++) {
+			err = reader.feed((const uint8_t *)close_utf8.get_data(), close_utf8.length());
+		}
+		if (err == OK) {
+			err = reader.finish();
+		}
+		if (err != OK || counter.max_depth != depth || counter.depth != 0 || counter.values != 1) {
+			os->print("\tDeep document failed: %s (depth %d).\n", reader.get_error_message().utf8().get_data(), counter.max_depth);
+			ok = false;
+		}
+	}
+
+	// Mismatched closing bracket at the bottom of a deep stack.
+	{
+		DepthCounter counter;
+		JSONReader reader(&counter);
+		LocalVector<uint8_t> text;
+		text.resize(depth + 1);
+		for (int i = 0; i < depth; i++) {
+			text[i] = '[';
+		}
+		text[depth] = '}';
+		if (reader.feed(&text[0], depth + 1) == OK) {
+			os->print("\tMismatched deep document was accepted.\n");
+			ok = false;
+		}
+	}
+
+	// Moderately deep documents build the same Variant as JSON::parse.
+	{
+		String nested;
+		for (int i = 0; i < 500; i++) {
+			nested += "[{\"a\":";
+		}
+		nested += "\"bottom\"";
+		for (int i = 0; i < 500; i++) {
+			nested += "}]";
+		}
+		Variant expected;
+		Variant streamed;
+		String err_str;
+		int err_line = 0;
+		CharString cs = nested.utf8();
+		if (JSON::parse(nested, expected, err_str, err_line) != OK || _parse_chunked(cs, cs.length() / 2, streamed) != OK || _canonical(streamed) != _canonical(expected)) {
+			os->print("\tNested document differs from JSON::parse.\n");
+			ok = false;
+		}
+	}
+
+	return ok;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_round_trip,
+	test_chunk_splits,
+	test_invalid_input,
+	test_deep_nesting,
+	nullptr
+};
+
+MainLoop *test() {
+	os = OS::get_singleton();
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		os->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	os->print("\n\n\n");
+	os->print("*************\n");
+	os->print("***TOTALS!***\n");
+	os->print("*************\n");
+
+	os->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+
+} // namespace TestJSON
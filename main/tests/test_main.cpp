@@ -36,16 +36,28 @@
 
 #include "test_astar.h"
 #include "test_class_db.h"
+#include "test_dictionary.h"
+#include "test_dictionary_benchmark.h"
+#include "test_enet.h"
 #include "test_gdscript.h"
 #include "test_gui.h"
+#include "test_hash_map_benchmark.h"
+#include "test_http_server.h"
+#include "test_json.h"
+#include "test_marshalls.h"
 #include "test_math.h"
 #include "test_oa_hash_map.h"
+#include "test_object_db.h"
 #include "test_ordered_hash_map.h"
 #include "test_physics_2d.h"
 #include "test_physics_3d.h"
 #include "test_render.h"
 #include "test_shader_lang.h"
+#include "test_signals.h"
 #include "test_string.h"
+#include "test_utf8_benchmark.h"
+#include "test_variant_benchmark.h"
+#include "test_websocket.h"
 
 const char **tests_get_names() {
 	static const char *test_names[] = {
@@ -64,6 +76,18 @@ const char **tests_get_names() {
 		"gd_bytecode",
 		"ordered_hash_map",
 		"astar",
+		"marshalls",
+		"object_db",
+		"signals",
+		"enet",
+		"http_server",
+		"websocket",
+		"json",
+		"dictionary",
+		"hash_map_benchmark",
+		"dictionary_benchmark",
+		"utf8_benchmark",
+		"variant_benchmark",
 		nullptr
 	};
 
@@ -133,6 +157,54 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestAStar::test();
 	}
 
+	if (p_test == "marshalls") {
+		return TestMarshalls::test();
+	}
+
+	if (p_test == "object_db") {
+		return TestObjectDB::test();
+	}
+
+	if (p_test == "signals") {
+		return TestSignals::test();
+	}
+
+	if (p_test == "enet") {
+		return TestENet::test();
+	}
+
+	if (p_test == "http_server") {
+		return TestHTTPServer::test();
+	}
+
+	if (p_test == "websocket") {
+		return TestWebSocket::test();
+	}
+
+	if (p_test == "json") {
+		return TestJSON::test();
+	}
+
+	if (p_test == "dictionary") {
+		return TestDictionary::test();
+	}
+
+	if (p_test == "hash_map_benchmark") {
+		return TestHashMapBenchmark::test();
+	}
+
+	if (p_test == "dictionary_benchmark") {
+		return TestDictionaryBenchmark::test();
+	}
+
+	if (p_test == "utf8_benchmark") {
+		return TestUTF8Benchmark::test();
+	}
+
+	if (p_test == "variant_benchmark") {
+		return TestVariantBenchmark::test();
+	}
+
 	print_line("Unknown test: " + p_test);
 	return nullptr;
 }
@@ -0,0 +1,187 @@
+/*************************************************************************/
+/*  test_marshalls.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_marshalls.h"
+
+#include "core/io/marshalls.h"
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+
+namespace TestMarshalls {
+
+// Typical payloads: small RPC argument lists, save game style nested
+// dictionaries, and large packed arrays.
+static Variant make_rpc_args() {
+	Array args;
+	args.push_back(42);
+	args.push_back(3.5);
+	args.push_back("player_moved");
+	args.push_back(Vector3(1, 2, 3));
+	args.push_back(Transform(Basis(), Vector3(4, 5, 6)));
+	return args;
+}
+
+static Variant make_save_game() {
+	Dictionary save;
+	Array entities;
+	for (int i = 0; i < 1000; i++) {
+		Dictionary e;
+		e["name"] = "entity_" + itos(i);
+		e["health"] = i % 100;
+		e["position"] = Vector2(i, -i);
+		e["speed"] = Math::randf();
+		e["flags"] = i % 3 == 0;
+		e["inventory"] = varray(i, i + 1, "sword");
+		entities.push_back(e);
+	}
+	save["entities"] = entities;
+	save["version"] = 4;
+	save["level"] = "res://levels/level_01.tscn";
+	return save;
+}
+
+static Variant make_float_array() {
+	Vector<float> data;
+	data.resize(1 << 20);
+	float *w = data.ptrw();
+	for (int i = 0; i < data.size(); i++) {
+		w[i] = i * 0.5f;
+	}
+	return data;
+}
+
+static Variant make_vector3_array() {
+	Vector<Vector3> data;
+	data.resize(1 << 17);
+	Vector3 *w = data.ptrw();
+	for (int i = 0; i < data.size(); i++) {
+		w[i] = Vector3(i, i * 2, i * 3);
+	}
+	return data;
+}
+
+static Variant make_int64_array() {
+	Vector<int64_t> data;
+	data.resize(1 << 18);
+	int64_t *w = data.ptrw();
+	for (int i = 0; i < data.size(); i++) {
+		w[i] = (int64_t)i << 33;
+	}
+	return data;
+}
+
+static bool run_payload(const String &p_name, const Variant &p_value, int p_iterations) {
+	OS *os = OS::get_singleton();
+
+	// Reference encoding, and check that both entry points agree.
+	int len = 0;
+	encode_variant(p_value, nullptr, len);
+	Vector<uint8_t> reference;
+	reference.resize(len);
+	encode_variant(p_value, reference.ptrw(), len);
+
+	Vector<uint8_t> buffer;
+	int buffer_len = 0;
+	encode_variant(p_value, buffer, buffer_len);
+	if (buffer_len != len || memcmp(buffer.ptr(), reference.ptr(), len) != 0) {
+		os->print("%s: single pass encoding differs from the sized encoding.\n", p_name.utf8().get_data());
+		return false;
+	}
+
+	// A size limit below the encoded size must fail without growing the buffer past it.
+	if (len > 1) {
+		Vector<uint8_t> capped;
+		int capped_len = 0;
+		Error err = encode_variant(p_value, capped, capped_len, false, len - 1);
+		if (err != ERR_OUT_OF_MEMORY || capped_len != len || capped.size() > len - 1) {
+			os->print("%s: size limited encoding was not capped.\n", p_name.utf8().get_data());
+			return false;
+		}
+	}
+
+	// Round trip must be byte exact.
+	Variant decoded;
+	int used = 0;
+	if (decode_variant(decoded, reference.ptr(), len, &used) != OK || used != len) {
+		os->print("%s: decoding failed.\n", p_name.utf8().get_data());
+		return false;
+	}
+	Vector<uint8_t> again;
+	int again_len = 0;
+	encode_variant(decoded, again, again_len);
+	if (again_len != len || memcmp(again.ptr(), reference.ptr(), len) != 0) {
+		os->print("%s: round trip mismatch.\n", p_name.utf8().get_data());
+		return false;
+	}
+
+	uint64_t t = os->get_ticks_usec();
+	for (int i = 0; i < p_iterations; i++) {
+		encode_variant(p_value, nullptr, len);
+		Vector<uint8_t> out;
+		out.resize(len);
+		encode_variant(p_value, out.ptrw(), len);
+	}
+	uint64_t two_pass = os->get_ticks_usec() - t;
+
+	t = os->get_ticks_usec();
+	for (int i = 0; i < p_iterations; i++) {
+		encode_variant(p_value, buffer, buffer_len);
+	}
+	uint64_t single_pass = os->get_ticks_usec() - t;
+
+	t = os->get_ticks_usec();
+	for (int i = 0; i < p_iterations; i++) {
+		decode_variant(decoded, reference.ptr(), len);
+	}
+	uint64_t decode = os->get_ticks_usec() - t;
+
+	os->print("%-14s %9d bytes  encode two-pass %8.2f us  single-pass %8.2f us  decode %8.2f us\n",
+			p_name.utf8().get_data(), len,
+			double(two_pass) / p_iterations, double(single_pass) / p_iterations, double(decode) / p_iterations);
+	return true;
+}
+
+MainLoop *test() {
+	OS::get_singleton()->print("\n\nMarshalls encode/decode benchmark\n\n");
+
+	Math::seed(0);
+
+	bool ok = true;
+	ok = run_payload("rpc_args", make_rpc_args(), 100000) && ok;
+	ok = run_payload("save_game", make_save_game(), 100) && ok;
+	ok = run_payload("float32_array", make_float_array(), 100) && ok;
+	ok = run_payload("vector3_array", make_vector3_array(), 100) && ok;
+	ok = run_payload("int64_array", make_int64_array(), 100) && ok;
+
+	OS::get_singleton()->print(ok ? "\nAll payloads round-tripped.\n" : "\nSome payloads failed.\n");
+	return nullptr;
+}
+
+} // namespace TestMarshalls
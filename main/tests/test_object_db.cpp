@@ -0,0 +1,207 @@
+/*************************************************************************/
+/*  test_object_db.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_object_db.h"
+
+#include "core/object.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/spin_lock.h"
+
+#include <atomic>
+
+namespace TestObjectDB {
+
+enum {
+	OBJECT_COUNT = 4096,
+	LOOKUPS_PER_THREAD = 4000000,
+	MAX_THREADS = 16,
+};
+
+// Emulates the former lookup, which held a global spinlock around the slot read.
+static SpinLock locked_lookup_lock;
+
+static Object *locked_get_instance(ObjectID p_id) {
+	locked_lookup_lock.lock();
+	Object *obj = ObjectDB::get_instance(p_id);
+	locked_lookup_lock.unlock();
+	return obj;
+}
+
+struct LookupData {
+	const ObjectID *ids = nullptr;
+	Object *const *objects = nullptr;
+	bool locked = false;
+	std::atomic<bool> *start = nullptr;
+	std::atomic<bool> *stop = nullptr; // When set, run until stopped instead.
+	std::atomic<uint32_t> *errors = nullptr;
+	uint32_t seed = 0;
+};
+
+static void lookup_thread(void *p_userdata) {
+	LookupData *ld = (LookupData *)p_userdata;
+	while (!ld->start->load()) {
+		;
+	}
+
+	uint32_t r = ld->seed;
+	uint32_t errors = 0;
+	for (int i = 0; ld->stop ? !ld->stop->load(std::memory_order_relaxed) : i < LOOKUPS_PER_THREAD; i++) {
+		r = r * 1664525 + 1013904223;
+		uint32_t idx = (r >> 8) % OBJECT_COUNT;
+		Object *obj = ld->locked ? locked_get_instance(ld->ids[idx]) : ObjectDB::get_instance(ld->ids[idx]);
+		if (obj != ld->objects[idx]) {
+			errors++;
+		}
+	}
+	ld->errors->fetch_add(errors);
+}
+
+struct ChurnData {
+	std::atomic<bool> *stop = nullptr;
+	std::atomic<uint32_t> *errors = nullptr;
+};
+
+static void churn_thread(void *p_userdata) {
+	ChurnData *cd = (ChurnData *)p_userdata;
+	Object *churn[256];
+	while (!cd->stop->load()) {
+		// Grows the slot blocks and reuses freed slots under the readers.
+		for (int i = 0; i < 256; i++) {
+			churn[i] = memnew(Object);
+		}
+		for (int i = 0; i < 256; i++) {
+			ObjectID id = churn[i]->get_instance_id();
+			memdelete(churn[i]);
+			if (ObjectDB::get_instance(id) != nullptr) {
+				OS::get_singleton()->print("Freed object still resolves!\n");
+				cd->errors->fetch_add(1);
+			}
+		}
+	}
+}
+
+static uint64_t run_lookups(const ObjectID *p_ids, Object *const *p_objects, int p_threads, bool p_locked, uint32_t &r_errors) {
+	std::atomic<bool> start(false);
+	std::atomic<uint32_t> errors(0);
+	LookupData data[MAX_THREADS];
+	Thread *threads[MAX_THREADS];
+
+	for (int i = 0; i < p_threads; i++) {
+		data[i].ids = p_ids;
+		data[i].objects = p_objects;
+		data[i].locked = p_locked;
+		data[i].start = &start;
+		data[i].errors = &errors;
+		data[i].seed = i * 7919 + 1;
+		threads[i] = Thread::create(lookup_thread, &data[i]);
+	}
+
+	uint64_t t = OS::get_singleton()->get_ticks_usec();
+	start.store(true);
+	for (int i = 0; i < p_threads; i++) {
+		Thread::wait_to_finish(threads[i]);
+		memdelete(threads[i]);
+	}
+	t = OS::get_singleton()->get_ticks_usec() - t;
+
+	r_errors = errors.load();
+	return t;
+}
+
+MainLoop *test() {
+	OS *os = OS::get_singleton();
+	os->print("\n\nObjectDB lookup contention benchmark\n\n");
+
+	Object *objects[OBJECT_COUNT];
+	ObjectID ids[OBJECT_COUNT];
+	for (int i = 0; i < OBJECT_COUNT; i++) {
+		objects[i] = memnew(Object);
+		ids[i] = objects[i]->get_instance_id();
+	}
+
+	bool ok = true;
+	const int max_threads = MIN(int(MAX_THREADS), MAX(2, os->get_processor_count()));
+
+	for (int threads = 1; threads <= max_threads; threads *= 2) {
+		uint32_t errors_locked = 0;
+		uint32_t errors_free = 0;
+		uint64_t locked = run_lookups(ids, objects, threads, true, errors_locked);
+		uint64_t lock_free = run_lookups(ids, objects, threads, false, errors_free);
+		ok = ok && !errors_locked && !errors_free;
+
+		double total = double(threads) * LOOKUPS_PER_THREAD;
+		os->print("%2d threads: spinlock %7.2f Mlookups/s  lock-free %7.2f Mlookups/s\n",
+				threads, total / locked, total / lock_free);
+	}
+
+	// Lookups of live objects must keep working while other objects are
+	// created and freed concurrently.
+	{
+		std::atomic<bool> start(true);
+		std::atomic<bool> stop(false);
+		std::atomic<uint32_t> errors(0);
+		LookupData data[2];
+		Thread *readers[2];
+		for (int i = 0; i < 2; i++) {
+			data[i].ids = ids;
+			data[i].objects = objects;
+			data[i].start = &start;
+			data[i].stop = &stop;
+			data[i].errors = &errors;
+			data[i].seed = i + 1;
+			readers[i] = Thread::create(lookup_thread, &data[i]);
+		}
+		ChurnData churn_data;
+		churn_data.stop = &stop;
+		churn_data.errors = &errors;
+		Thread *churn = Thread::create(churn_thread, &churn_data);
+
+		OS::get_singleton()->delay_usec(500000);
+		stop.store(true);
+		Thread::wait_to_finish(churn);
+		memdelete(churn);
+		for (int i = 0; i < 2; i++) {
+			Thread::wait_to_finish(readers[i]);
+			memdelete(readers[i]);
+		}
+		ok = ok && !errors.load();
+	}
+
+	for (int i = 0; i < OBJECT_COUNT; i++) {
+		memdelete(objects[i]);
+	}
+
+	os->print(ok ? "\nAll lookups resolved correctly.\n" : "\nSome lookups returned the wrong object!\n");
+	os->set_exit_code(ok ? 0 : 1);
+	return nullptr;
+}
+
+} // namespace TestObjectDB
@@ -0,0 +1,159 @@
+/*************************************************************************/
+/*  test_signals.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_signals.h"
+
+#include "core/object.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+
+namespace TestSignals {
+
+enum {
+	EMIT_COUNT = 1000000,
+};
+
+// Counts calls without allocating, so only the cost of emitting is measured.
+class CountingCallable : public CallableCustom {
+	ObjectID object;
+	int index;
+
+public:
+	mutable int calls = 0;
+	mutable int last_argc = 0;
+
+	static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
+		return p_a == p_b;
+	}
+
+	static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b) {
+		return p_a < p_b;
+	}
+
+	virtual uint32_t hash() const { return index; }
+	virtual String get_as_text() const { return "CountingCallable"; }
+	virtual CompareEqualFunc get_compare_equal_func() const { return compare_equal; }
+	virtual CompareLessFunc get_compare_less_func() const { return compare_less; }
+	virtual ObjectID get_object() const { return object; }
+
+	virtual void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const {
+		calls++;
+		last_argc = p_argcount;
+		r_call_error.error = Callable::CallError::CALL_OK;
+	}
+
+	CountingCallable(ObjectID p_object, int p_index) {
+		object = p_object;
+		index = p_index;
+	}
+};
+
+static bool run(const String &p_name, Object *p_emitter, const StringName &p_signal, int p_expected_calls) {
+	OS *os = OS::get_singleton();
+
+	p_emitter->emit_signal(p_signal); // Warm up.
+
+	// Memory usage is only tracked in debug builds, and this only checks that
+	// nothing is kept per emission.
+	uint64_t usage = Memory::get_mem_usage();
+	uint64_t t = os->get_ticks_usec();
+	for (int i = 0; i < EMIT_COUNT; i++) {
+		p_emitter->emit_signal(p_signal);
+	}
+	t = os->get_ticks_usec() - t;
+	int64_t retained = int64_t(Memory::get_mem_usage() - usage);
+
+	os->print("%-28s %8.1f ns/emit  %d calls/emit  %d bytes retained\n", p_name.utf8().get_data(), double(t) * 1000.0 / EMIT_COUNT, p_expected_calls, int(retained));
+#ifdef DEBUG_ENABLED
+	return retained == 0;
+#else
+	return true;
+#endif
+}
+
+MainLoop *test() {
+	OS *os = OS::get_singleton();
+	os->print("\n\nSignal emission benchmark (%d emissions each)\n\n", int(EMIT_COUNT));
+
+	const StringName signal = "script_changed";
+	Object *emitter = memnew(Object);
+	Object *target = memnew(Object);
+	bool ok = true;
+
+	CountingCallable *plain = memnew(CountingCallable(target->get_instance_id(), 0));
+	Callable plain_callable(plain);
+	emitter->connect(signal, plain_callable);
+	ok = run("one connection", emitter, signal, 1) && ok;
+
+	CountingCallable *bound = memnew(CountingCallable(target->get_instance_id(), 1));
+	Callable bound_callable(bound);
+	emitter->connect(signal, bound_callable, varray(42, "bound"));
+	ok = run("plus one with two binds", emitter, signal, 2) && ok;
+	if (bound->last_argc != 2) {
+		os->print("Bound connection got %d arguments instead of 2.\n", bound->last_argc);
+		ok = false;
+	}
+
+	Vector<Callable> many;
+	for (int i = 0; i < 30; i++) {
+		Callable c(memnew(CountingCallable(target->get_instance_id(), 2 + i)));
+		emitter->connect(signal, c);
+		many.push_back(c);
+	}
+	ok = run("plus thirty connections", emitter, signal, 32) && ok;
+
+	if (plain->calls != 3 * (EMIT_COUNT + 1)) {
+		os->print("Unexpected call count: %d.\n", plain->calls);
+		ok = false;
+	}
+
+	// One-shot connections are dropped after their first call.
+	CountingCallable *oneshot = memnew(CountingCallable(target->get_instance_id(), 100));
+	Callable oneshot_callable(oneshot);
+	emitter->connect(signal, oneshot_callable, Vector<Variant>(), Object::CONNECT_ONESHOT);
+	emitter->emit_signal(signal);
+	emitter->emit_signal(signal);
+	if (oneshot->calls != 1 || emitter->is_connected(signal, oneshot_callable)) {
+		os->print("One-shot connection was not disconnected.\n");
+		ok = false;
+	}
+
+	memdelete(target); // Disconnects everything.
+	memdelete(emitter);
+
+#ifdef DEBUG_ENABLED
+	os->print(ok ? "\nEmission keeps no memory.\n" : "\nEmission kept memory or misbehaved!\n");
+#else
+	os->print(ok ? "\nEmission works. Memory usage is only tracked in debug builds.\n" : "\nEmission misbehaved!\n");
+#endif
+	return nullptr;
+}
+
+} // namespace TestSignals
@@ -30,9 +30,11 @@
 
 #include "test_string.h"
 
+#include "core/io/file_access_memory.h"
 #include "core/io/ip_address.h"
 #include "core/os/os.h"
 #include "core/ustring.h"
+#include "core/variant_parser.h"
 
 #include "modules/modules_enabled.gen.h"
 #ifdef MODULE_REGEX_ENABLED
@@ -1127,6 +1129,143 @@ bool test_35() {
 	return state;
 }
 
+bool test_36() {
+	OS::get_singleton()->print("\n\nTest 36: Move construction and assignment\n");
+
+	bool state = true;
+
+	String a = "Godot Engine";
+	const CharType *data = a.ptr();
+
+	String b = std::move(a);
+	// The buffer is stolen, not shared or copied.
+	state = state && b.ptr() == data && a.empty() && b == "Godot Engine";
+
+	String c = "Other";
+	c = std::move(b);
+	state = state && c.ptr() == data && b.empty() && c == "Godot Engine";
+
+	Vector<String> v;
+	v.push_back(c);
+	v.push_back("Front");
+	v.insert(0, "First");
+	v.remove(2);
+	state = state && v.size() == 2 && v[0] == "First" && v[1] == "Godot Engine";
+	// Shifting elements around moves them, the copy still shares c's buffer.
+	state = state && v[1].ptr() == data;
+
+	Vector<String> w = std::move(v);
+	state = state && v.empty() && w.size() == 2;
+
+	return state;
+}
+
+// Parses p_len bytes of p_utf8, which must fail when p_error is set, or give p_expected.
+static bool check_utf8(const char *p_utf8, int p_len, bool p_error, const String &p_expected) {
+	String s;
+	bool error = s.parse_utf8(p_utf8, p_len);
+	return error == p_error && (p_error || s == p_expected);
+}
+
+bool test_37() {
+	OS::get_singleton()->print("\n\nTest 37: parse_utf8 on invalid and truncated input, at every alignment\n");
+	OS::get_singleton()->print("\t(Unicode parsing errors below are expected)\n");
+
+	// Runs of ASCII are decoded a word at a time, so each case is tried with
+	// an ASCII prefix of every length up to two words.
+	bool state = true;
+	const String e_acute = String::chr(0xE9);
+	for (int n = 0; n <= 16 && state; n++) {
+		char buf[64];
+		memset(buf, 'a', n);
+		const String prefix = String("aaaaaaaaaaaaaaaa").substr(0, n);
+
+		// Valid sequence between two runs.
+		memcpy(buf + n, "\xc3\xa9", 2);
+		memset(buf + n + 2, 'a', n);
+		state = state && check_utf8(buf, 2 * n + 2, false, prefix + e_acute + prefix);
+
+		// Invalid lead byte.
+		buf[n] = '\xff';
+		state = state && check_utf8(buf, n + 1, true, String());
+
+		// Truncated two and three byte sequences.
+		memcpy(buf + n, "\xc3", 1);
+		state = state && check_utf8(buf, n + 1, true, String());
+		memcpy(buf + n, "\xe6\x97", 2);
+		state = state && check_utf8(buf, n + 2, true, String());
+
+		// Missing continuation byte, followed by more ASCII.
+		memcpy(buf + n, "\xc3", 1);
+		memset(buf + n + 1, 'a', 9);
+		state = state && check_utf8(buf, n + 10, true, String());
+
+		// Overlong encoding.
+		memcpy(buf + n, "\xc0\x80", 2);
+		state = state && check_utf8(buf, n + 2, true, String());
+
+		// The terminator or the length ends the input, even inside a run.
+		memset(buf + n, 'b', 16);
+		buf[n] = 0;
+		state = state && check_utf8(buf, n + 16, false, prefix);
+		buf[n] = 'b';
+		state = state && check_utf8(buf, n + 3, false, prefix + "bbb");
+		buf[n + 16] = 0;
+		state = state && check_utf8(buf, -1, false, prefix + "bbbbbbbbbbbbbbbb");
+
+		if (!state) {
+			OS::get_singleton()->print("\tfailed with a prefix of %d bytes\n", n);
+		}
+	}
+
+	return state;
+}
+
+// Parses p_text as a single string token, from a UTF-8 file stream or from a String stream.
+static String parse_string_token(const char *p_text, bool p_utf8) {
+	Variant ret;
+	String err_str;
+	int err_line = 0;
+	if (p_utf8) {
+		FileAccessMemory file;
+		file.open_custom((const uint8_t *)p_text, strlen(p_text));
+		VariantParser::StreamFile stream;
+		stream.f = &file;
+		VariantParser::parse(&stream, ret, err_str, err_line);
+	} else {
+		VariantParser::StreamString stream;
+		stream.s = String::utf8(p_text);
+		VariantParser::parse(&stream, ret, err_str, err_line);
+	}
+	return ret;
+}
+
+bool test_38() {
+	OS::get_singleton()->print("\n\nTest 38: VariantParser string tokens\n");
+
+	bool state = true;
+	const String e_acute = String::chr(0xE9);
+
+	// ASCII only, used as is.
+	state = state && parse_string_token("\"res://assets/player.png\"", true) == "res://assets/player.png";
+	state = state && parse_string_token("\"tab\\tand\\nnewline\"", true) == "tab\tand\nnewline";
+
+	// Raw UTF-8 bytes are decoded when reading a file.
+	state = state && parse_string_token("\"caf\xc3\xa9 au lait\"", true) == "caf" + e_acute + " au lait";
+	state = state && parse_string_token("\"caf\xc3\xa9\"", false) == "caf" + e_acute;
+
+	// \u escapes, in the ASCII range or not.
+	state = state && parse_string_token("\"\\u0041BC\"", true) == "ABC";
+	state = state && parse_string_token("\"\\u0041\xc3\xa9\"", true) == "A" + e_acute;
+	state = state && parse_string_token("\"caf\\u00e9\"", false) == "caf" + e_acute;
+	state = state && parse_string_token("\"\\u65e5\\u672c\"", false) == String::chr(0x65E5) + String::chr(0x672C);
+
+	// StringName tokens go through the same path.
+	state = state && parse_string_token("&\"caf\xc3\xa9\"", true) == "caf" + e_acute;
+
+	return state;
+}
+
 typedef bool (*TestFunc)();
 
 TestFunc test_funcs[] = {
@@ -1166,6 +1305,9 @@ TestFunc test_funcs[] = {
 	test_33,
 	test_34,
 	test_35,
+	test_36,
+	test_37,
+	test_38,
 	nullptr
 
 };
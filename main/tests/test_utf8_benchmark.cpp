@@ -0,0 +1,98 @@
+/*************************************************************************/
+/*  test_utf8_benchmark.cpp                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_utf8_benchmark.h"
+
+#include "test_benchmark.h"
+
+#include "core/os/os.h"
+#include "core/ustring.h"
+
+namespace TestUTF8Benchmark {
+
+// Builds roughly p_bytes of UTF-8 text out of p_words, the way scene files,
+// node names and translations mix plain ASCII with the occasional accented
+// or wide character.
+static CharString make_text(const char *const *p_words, int p_word_count, int p_bytes) {
+	String text;
+	int i = 0;
+	while (text.length() < p_bytes) {
+		text += String::utf8(p_words[i % p_word_count]);
+		text += " ";
+		i++;
+	}
+	return text.utf8();
+}
+
+static bool run(const char *p_name, const CharString &p_utf8, int p_rounds) {
+	int bytes = p_utf8.length();
+
+	String decoded;
+	TestBenchmark::Timer timer;
+	for (int i = 0; i < p_rounds; i++) {
+		decoded.parse_utf8(p_utf8.get_data(), bytes);
+	}
+	uint64_t decode = timer.lap();
+
+	CharString encoded;
+	for (int i = 0; i < p_rounds; i++) {
+		encoded = decoded.utf8();
+	}
+	uint64_t encode = timer.lap();
+
+	double total = double(bytes) * p_rounds;
+	OS::get_singleton()->print("  %-8s %8d bytes  parse_utf8 %8.1f MB/s  utf8 %8.1f MB/s\n", p_name, bytes,
+			TestBenchmark::mb_per_sec(decode, total), TestBenchmark::mb_per_sec(encode, total));
+
+	// The round-trip must give back the exact same bytes.
+	if (encoded.length() != bytes || memcmp(encoded.get_data(), p_utf8.get_data(), bytes) != 0) {
+		OS::get_singleton()->print("  Round-trip mismatch\n");
+		return false;
+	}
+	return true;
+}
+
+MainLoop *test() {
+	TestBenchmark::begin("UTF-8 conversion benchmark");
+
+	static const char *ascii[] = { "Node2D", "position", "Vector2(", "res://assets/player.png", "transform", "=", "[node", "name=\"Sprite\"", "parent=\".\"]" };
+	static const char *latin[] = { "caf\xc3\xa9", "na\xc3\xafve", "text", "stra\xc3\x9f" "e", "label", "r\xc3\xa9sum\xc3\xa9", "value" };
+	static const char *wide[] = { "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e", "\xed\x95\x9c\xea\xb5\xad\xec\x96\xb4", "\xf0\x9f\x98\x80", "Godot" };
+
+	bool ok = true;
+	ok = run("ascii", make_text(ascii, sizeof(ascii) / sizeof(*ascii), 1 << 20), 20) && ok;
+	ok = run("latin", make_text(latin, sizeof(latin) / sizeof(*latin), 1 << 20), 20) && ok;
+	ok = run("wide", make_text(wide, sizeof(wide) / sizeof(*wide), 1 << 20), 20) && ok;
+	ok = run("short", make_text(ascii, 3, 24), 200000) && ok;
+
+	return TestBenchmark::end(ok, "All round-trips matched.", "Some round-trips failed.");
+}
+
+} // namespace TestUTF8Benchmark
@@ -0,0 +1,127 @@
+/*************************************************************************/
+/*  test_variant_benchmark.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_variant_benchmark.h"
+
+#include "test_benchmark.h"
+
+#include "core/array.h"
+#include "core/os/os.h"
+#include "core/variant.h"
+
+namespace TestVariantBenchmark {
+
+static const int COUNT = 1 << 16;
+static const int ROUNDS = 50;
+
+static void print_result(const char *p_name, uint64_t p_usec, int p_ops) {
+	OS::get_singleton()->print("  %-28s %8.2f ns/op\n", p_name, TestBenchmark::ns_per_op(p_usec, p_ops));
+}
+
+// Copies every element of an Array into the next one, the way scripts
+// shuffle values around, then checks the values made it through.
+static bool bench_copy(const char *p_name, const Variant &p_value) {
+	Array array;
+	array.resize(COUNT);
+	array[0] = p_value;
+
+	TestBenchmark::Timer timer;
+	for (int round = 0; round < ROUNDS; round++) {
+		for (int i = 1; i < COUNT; i++) {
+			array[i] = array[i - 1];
+		}
+	}
+	print_result(p_name, timer.lap(), ROUNDS * (COUNT - 1));
+
+	return array[COUNT - 1] == p_value;
+}
+
+// Constructs and destroys temporaries, which for the boxed math types
+// means allocating and freeing their storage.
+template <class T>
+static bool bench_temporaries(const char *p_name, const T &p_value) {
+	int checksum = 0;
+
+	TestBenchmark::Timer timer;
+	for (int i = 0; i < ROUNDS * COUNT; i++) {
+		Variant v = p_value;
+		Variant w = v;
+		checksum += w.get_type();
+	}
+	print_result(p_name, timer.lap(), ROUNDS * COUNT);
+
+	return checksum == ROUNDS * COUNT * Variant(p_value).get_type();
+}
+
+// Accumulates through Variant::evaluate, as the GDScript VM does for
+// `sum += value` in a loop.
+static bool bench_evaluate(const char *p_name, const Variant &p_zero, const Variant &p_value, const Variant &p_expected) {
+	Variant sum = p_zero;
+	bool valid = true;
+
+	TestBenchmark::Timer timer;
+	for (int i = 0; i < ROUNDS * COUNT && valid; i++) {
+		Variant::evaluate(Variant::OP_ADD, sum, p_value, sum, valid);
+	}
+	print_result(p_name, timer.lap(), ROUNDS * COUNT);
+
+	return valid && sum == p_expected;
+}
+
+MainLoop *test() {
+	TestBenchmark::begin("Variant benchmark");
+
+	bool ok = true;
+
+	OS::get_singleton()->print("Array element copies\n");
+	ok = bench_copy("int", 42) && ok;
+	ok = bench_copy("float", 4.2) && ok;
+	ok = bench_copy("Vector2", Vector2(1, 2)) && ok;
+	ok = bench_copy("Color", Color(1, 0.5, 0.25)) && ok;
+	ok = bench_copy("Transform", Transform(Basis(), Vector3(1, 2, 3))) && ok;
+	ok = bench_copy("String", "text") && ok;
+
+	OS::get_singleton()->print("Temporaries\n");
+	ok = bench_temporaries("int", 42) && ok;
+	ok = bench_temporaries("Vector3", Vector3(1, 2, 3)) && ok;
+	ok = bench_temporaries("Transform2D", Transform2D()) && ok;
+	ok = bench_temporaries("AABB", AABB(Vector3(), Vector3(1, 1, 1))) && ok;
+	ok = bench_temporaries("Basis", Basis()) && ok;
+	ok = bench_temporaries("Transform", Transform()) && ok;
+
+	OS::get_singleton()->print("Script arithmetic\n");
+	ok = bench_evaluate("int += int", 0, 3, 3 * ROUNDS * COUNT) && ok;
+	ok = bench_evaluate("float += float", 0.0, 0.5, 0.5 * ROUNDS * COUNT) && ok;
+	ok = bench_evaluate("Vector2 += Vector2", Vector2(), Vector2(1, 2), Vector2(1, 2) * (ROUNDS * COUNT)) && ok;
+
+	return TestBenchmark::end(ok, "All results matched.", "Some results did not match.");
+}
+
+} // namespace TestVariantBenchmark
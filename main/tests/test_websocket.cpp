@@ -0,0 +1,186 @@
+/*************************************************************************/
+/*  test_websocket.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_websocket.h"
+
+#include "core/callable_method_pointer.h"
+#include "core/io/stream_peer_tcp.h"
+#include "core/os/os.h"
+
+#include "modules/modules_enabled.gen.h"
+#ifdef MODULE_WEBSOCKET_ENABLED
+#include "modules/websocket/websocket_server.h"
+#endif
+
+namespace TestWebSocket {
+
+#ifdef MODULE_WEBSOCKET_ENABLED
+
+enum {
+	TEST_PORT = 47655,
+	TEST_PACKET_SIZE = 1024,
+	TEST_TIMEOUT_MSEC = 5000,
+};
+
+class Listener : public Object {
+public:
+	int connected_id = 0;
+	int disconnected_id = 0;
+
+	void _on_connected(int p_id, String p_protocol) {
+		connected_id = p_id;
+	}
+
+	void _on_disconnected(int p_id, bool p_was_clean) {
+		disconnected_id = p_id;
+	}
+};
+
+static const char *handshake_request =
+		"GET / HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"Upgrade: websocket\r\n"
+		"Connection: Upgrade\r\n"
+		"Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+		"Sec-WebSocket-Version: 13\r\n"
+		"\r\n";
+
+static bool test_client_killed_mid_send() {
+	OS *os = OS::get_singleton();
+
+	Ref<WebSocketServer> server = WebSocketServer::create_ref();
+	if (server.is_null() || server->listen(TEST_PORT) != OK) {
+		os->print("Unable to start the WebSocket server.\n");
+		return false;
+	}
+
+	Listener listener;
+	server->connect("client_connected", callable_mp(&listener, &Listener::_on_connected));
+	server->connect("client_disconnected", callable_mp(&listener, &Listener::_on_disconnected));
+
+	// A raw TCP client, so it can go away without sending a close frame.
+	Ref<StreamPeerTCP> tcp;
+	tcp.instance();
+	tcp->connect_to_host(IP_Address("127.0.0.1"), TEST_PORT);
+
+	bool request_sent = false;
+	uint64_t start = os->get_ticks_msec();
+	while (!listener.connected_id && os->get_ticks_msec() - start < TEST_TIMEOUT_MSEC) {
+		if (!request_sent && tcp->get_status() == StreamPeerTCP::STATUS_CONNECTED) {
+			tcp->put_data((const uint8_t *)handshake_request, strlen(handshake_request));
+			request_sent = true;
+		}
+		server->poll();
+		os->delay_usec(1000);
+	}
+
+	bool ok = listener.connected_id != 0;
+	if (!ok) {
+		os->print("Client did not connect.\n");
+	}
+
+	if (ok) {
+		int id = listener.connected_id;
+
+		// The handshake response is still unread, so closing resets the
+		// connection and the next sends on the server side fail.
+		tcp->disconnect_from_host();
+
+		uint8_t data[TEST_PACKET_SIZE] = {};
+		start = os->get_ticks_msec();
+		while (!listener.disconnected_id && os->get_ticks_msec() - start < TEST_TIMEOUT_MSEC) {
+			if (server->has_peer(id)) {
+				Ref<WebSocketPeer> peer = server->get_peer(id);
+				if (peer->is_connected_to_host()) {
+					peer->put_packet(data, TEST_PACKET_SIZE);
+				}
+			}
+			server->poll();
+			os->delay_usec(1000);
+		}
+
+		if (listener.disconnected_id != id) {
+			os->print("The server did not report the peer as disconnected.\n");
+			ok = false;
+		}
+		if (server->has_peer(id)) {
+			os->print("The server still holds the disconnected peer.\n");
+			ok = false;
+		}
+	}
+
+	server->stop();
+	return ok;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_client_killed_mid_send,
+	nullptr
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return nullptr;
+}
+
+#else
+
+MainLoop *test() {
+	ERR_PRINT("The WebSocket module is disabled, nothing to test.");
+	return nullptr;
+}
+
+#endif
+
+} // namespace TestWebSocket
@@ -34,6 +34,7 @@
 #include "core/os/os.h"
 
 void NetworkedMultiplayerENet::set_transfer_mode(TransferMode p_mode) {
+	MutexLock lock(peer_mutex);
 	transfer_mode = p_mode;
 }
 
@@ -42,24 +43,32 @@ NetworkedMultiplayerPeer::TransferMode NetworkedMultiplayerENet::get_transfer_mo
 }
 
 void NetworkedMultiplayerENet::set_target_peer(int p_peer) {
+	MutexLock lock(peer_mutex);
 	target_peer = p_peer;
 }
 
 int NetworkedMultiplayerENet::get_packet_peer() const {
+	MutexLock lock(peer_mutex);
 	ERR_FAIL_COND_V_MSG(!active, 1, "The multiplayer instance isn't currently active.");
-	ERR_FAIL_COND_V(incoming_packets.size() == 0, 1);
+	ERR_FAIL_COND_V(incoming_packets.data_left() == 0, 1);
 
-	return incoming_packets.front()->get().from;
+	Packet packet;
+	incoming_packets.copy(&packet, 0, 1);
+	return packet.from;
 }
 
 int NetworkedMultiplayerENet::get_packet_channel() const {
+	MutexLock lock(peer_mutex);
 	ERR_FAIL_COND_V_MSG(!active, -1, "The multiplayer instance isn't currently active.");
-	ERR_FAIL_COND_V(incoming_packets.size() == 0, -1);
+	ERR_FAIL_COND_V(incoming_packets.data_left() == 0, -1);
 
-	return incoming_packets.front()->get().channel;
+	Packet packet;
+	incoming_packets.copy(&packet, 0, 1);
+	return packet.channel;
 }
 
 int NetworkedMultiplayerENet::get_last_packet_channel() const {
+	MutexLock lock(peer_mutex);
 	ERR_FAIL_COND_V_MSG(!active, -1, "The multiplayer instance isn't currently active.");
 	ERR_FAIL_COND_V(!current_packet.packet, -1);
 
@@ -67,6 +76,7 @@ int NetworkedMultiplayerENet::get_last_packet_channel() const {
 }
 
 Error NetworkedMultiplayerENet::create_server(int p_port, int p_max_clients, int p_in_bandwidth, int p_out_bandwidth) {
+	MutexLock lock(peer_mutex);
 	ERR_FAIL_COND_V_MSG(active, ERR_ALREADY_IN_USE, "The multiplayer instance is already active.");
 	ERR_FAIL_COND_V_MSG(p_port < 0 || p_port > 65535, ERR_INVALID_PARAMETER, "The port number must be set between 0 and 65535 (inclusive).");
 	ERR_FAIL_COND_V_MSG(p_max_clients < 1 || p_max_clients > 4095, ERR_INVALID_PARAMETER, "The number of clients must be set between 1 and 4095 (inclusive).");
@@ -116,6 +126,7 @@ Error NetworkedMultiplayerENet::create_server(int p_port, int p_max_clients, int
 }
 
 Error NetworkedMultiplayerENet::create_client(const String &p_address, int p_port, int p_in_bandwidth, int p_out_bandwidth, int p_client_port) {
+	MutexLock lock(peer_mutex);
 	ERR_FAIL_COND_V_MSG(active, ERR_ALREADY_IN_USE, "The multiplayer instance is already active.");
 	ERR_FAIL_COND_V_MSG(p_port < 0 || p_port > 65535, ERR_INVALID_PARAMETER, "The server port number must be set between 0 and 65535 (inclusive).");
 	ERR_FAIL_COND_V_MSG(p_client_port < 0 || p_client_port > 65535, ERR_INVALID_PARAMETER, "The client port number must be set between 0 and 65535 (inclusive).");
@@ -207,10 +218,14 @@ Error NetworkedMultiplayerENet::create_client(const String &p_address, int p_por
 }
 
 void NetworkedMultiplayerENet::poll() {
+	MutexLock lock(peer_mutex);
 	ERR_FAIL_COND_MSG(!active, "The multiplayer instance isn't currently active.");
 
 	_pop_current_packet();
 
+	// Messages coalesced since the last poll go out with this service.
+	_flush_coalesced_packets();
+
 	ENetEvent event;
 	/* Keep servicing until there are no available events left in queue. */
 	while (true) {
@@ -256,7 +271,7 @@ void NetworkedMultiplayerENet::poll() {
 
 				connection_status = CONNECTION_CONNECTED; // If connecting, this means it connected to something!
 
-				emit_signal("peer_connected", *new_id);
+				_emit_peer_signal("peer_connected", *new_id);
 
 				if (server) {
 					// Do not notify other peers when server_relay is disabled.
@@ -281,7 +296,7 @@ void NetworkedMultiplayerENet::poll() {
 						enet_peer_send(E->get(), SYSCH_CONFIG, packet);
 					}
 				} else {
-					emit_signal("connection_succeeded");
+					_emit_peer_signal("connection_succeeded");
 				}
 
 			} break;
@@ -292,7 +307,7 @@ void NetworkedMultiplayerENet::poll() {
 
 				if (!id) {
 					if (!server) {
-						emit_signal("connection_failed");
+						_emit_peer_signal("connection_failed");
 					}
 					// Never fully connected.
 					break;
@@ -300,7 +315,7 @@ void NetworkedMultiplayerENet::poll() {
 
 				if (!server) {
 					// Client just disconnected from server.
-					emit_signal("server_disconnected");
+					_emit_peer_signal("server_disconnected");
 					close_connection();
 					return;
 				} else if (server_relay) {
@@ -317,7 +332,7 @@ void NetworkedMultiplayerENet::poll() {
 					}
 				}
 
-				emit_signal("peer_disconnected", *id);
+				_emit_peer_signal("peer_disconnected", *id);
 				peer_map.erase(*id);
 				memdelete(id);
 			} break;
@@ -335,17 +350,22 @@ void NetworkedMultiplayerENet::poll() {
 					switch (msg) {
 						case SYSMSG_ADD_PEER: {
 							peer_map[id] = nullptr;
-							emit_signal("peer_connected", id);
+							_emit_peer_signal("peer_connected", id);
 
 						} break;
 						case SYSMSG_REMOVE_PEER: {
 							peer_map.erase(id);
-							emit_signal("peer_disconnected", id);
+							_emit_peer_signal("peer_disconnected", id);
 						} break;
 					}
 
 					enet_packet_destroy(event.packet);
 				} else if (event.channelID < channel_count) {
+					if (event.packet->dataLength >= COALESCE_HEADER_SIZE && decode_uint32(&event.packet->data[0]) == 0) {
+						_process_coalesced_packet(event.peer, event.channelID, event.packet);
+						break;
+					}
+
 					Packet packet;
 					packet.packet = event.packet;
 
@@ -353,6 +373,8 @@ void NetworkedMultiplayerENet::poll() {
 
 					ERR_CONTINUE(event.packet->dataLength < 8);
 
+					packet.size = event.packet->dataLength - 8;
+
 					uint32_t source = decode_uint32(&event.packet->data[0]);
 					int target = decode_uint32(&event.packet->data[4]);
 
@@ -367,23 +389,21 @@ void NetworkedMultiplayerENet::poll() {
 
 						if (target == 1) {
 							// To myself and only myself
-							incoming_packets.push_back(packet);
+							_push_incoming_packet(packet);
 						} else if (!server_relay) {
 							// No other destination is allowed when server is not relaying
 							continue;
 						} else if (target == 0) {
 							// Re-send to everyone but sender :|
 
-							incoming_packets.push_back(packet);
+							_push_incoming_packet(packet);
 							// And make copies for sending
 							for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
 								if (uint32_t(E->key()) == source) { // Do not resend to self
 									continue;
 								}
 
-								ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
-
-								enet_peer_send(E->get(), event.channelID, packet2);
+								_relay_packet(E->key(), event.channelID, packet.packet);
 							}
 
 						} else if (target < 0) {
@@ -395,14 +415,12 @@ void NetworkedMultiplayerENet::poll() {
 									continue;
 								}
 
-								ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
-
-								enet_peer_send(E->get(), event.channelID, packet2);
+								_relay_packet(E->key(), event.channelID, packet.packet);
 							}
 
 							if (-target != 1) {
 								// Server is not excluded
-								incoming_packets.push_back(packet);
+								_push_incoming_packet(packet);
 							} else {
 								// Server is excluded, erase packet
 								enet_packet_destroy(packet.packet);
@@ -411,10 +429,15 @@ void NetworkedMultiplayerENet::poll() {
 						} else {
 							// To someone else, specifically
 							ERR_CONTINUE(!peer_map.has(target));
-							enet_peer_send(peer_map[target], event.channelID, packet.packet);
+							if (coalesce_packets) {
+								_relay_packet(target, event.channelID, packet.packet);
+								enet_packet_destroy(packet.packet);
+							} else {
+								enet_peer_send(peer_map[target], event.channelID, packet.packet);
+							}
 						}
 					} else {
-						incoming_packets.push_back(packet);
+						_push_incoming_packet(packet);
 					}
 
 					// Destroy packet later
@@ -428,15 +451,24 @@ void NetworkedMultiplayerENet::poll() {
 			} break;
 		}
 	}
+
+	// Relayed messages coalesced while polling go out now, not with the next poll.
+	if (!coalesced_packets.empty()) {
+		_flush_coalesced_packets();
+		enet_host_flush(host);
+	}
 }
 
 bool NetworkedMultiplayerENet::is_server() const {
+	MutexLock lock(peer_mutex);
 	ERR_FAIL_COND_V_MSG(!active, false, "The multiplayer instance isn't currently active.");
 
 	return server;
 }
 
 void NetworkedMultiplayerENet::close_connection(uint32_t wait_usec) {
+	MutexLock wait_lock(wait_mutex);
+	MutexLock lock(peer_mutex);
 	ERR_FAIL_COND_MSG(!active, "The multiplayer instance isn't currently active.");
 
 	_pop_current_packet();
@@ -462,12 +494,14 @@ void NetworkedMultiplayerENet::close_connection(uint32_t wait_usec) {
 	enet_host_destroy(host);
 	active = false;
 	incoming_packets.clear();
+	coalesced_packets.clear();
 	peer_map.clear();
 	unique_id = 1; // Server is 1
 	connection_status = CONNECTION_DISCONNECTED;
 }
 
 void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
+	MutexLock lock(peer_mutex);
 	ERR_FAIL_COND_MSG(!active, "The multiplayer instance isn't currently active.");
 	ERR_FAIL_COND_MSG(!is_server(), "Can't disconnect a peer when not acting as a server.");
 	ERR_FAIL_COND_MSG(!peer_map.has(p_peer), vformat("Peer ID %d not found in the list of peers.", p_peer));
@@ -495,7 +529,7 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
 			memdelete(id);
 		}
 
-		emit_signal("peer_disconnected", p_peer);
+		_emit_peer_signal("peer_disconnected", p_peer);
 		peer_map.erase(p_peer);
 	} else {
 		enet_peer_disconnect_later(peer_map[p_peer], 0);
@@ -503,24 +537,27 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
 }
 
 int NetworkedMultiplayerENet::get_available_packet_count() const {
-	return incoming_packets.size();
+	MutexLock lock(peer_mutex);
+	return incoming_packets.data_left();
 }
 
 Error NetworkedMultiplayerENet::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
-	ERR_FAIL_COND_V_MSG(incoming_packets.size() == 0, ERR_UNAVAILABLE, "No incoming packets available.");
+	MutexLock lock(peer_mutex);
+	ERR_FAIL_COND_V_MSG(incoming_packets.data_left() == 0, ERR_UNAVAILABLE, "No incoming packets available.");
 
 	_pop_current_packet();
 
-	current_packet = incoming_packets.front()->get();
-	incoming_packets.pop_front();
+	int read = incoming_packets.read(&current_packet, 1);
+	ERR_FAIL_COND_V(read != 1 || !current_packet.packet, ERR_BUG);
 
-	*r_buffer = (const uint8_t *)(&current_packet.packet->data[8]);
-	r_buffer_size = current_packet.packet->dataLength - 8;
+	*r_buffer = (const uint8_t *)(&current_packet.packet->data[current_packet.offset]);
+	r_buffer_size = current_packet.size;
 
 	return OK;
 }
 
 Error NetworkedMultiplayerENet::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
+	MutexLock lock(peer_mutex);
 	ERR_FAIL_COND_V_MSG(!active, ERR_UNCONFIGURED, "The multiplayer instance isn't currently active.");
 	ERR_FAIL_COND_V_MSG(connection_status != CONNECTION_CONNECTED, ERR_UNCONFIGURED, "The multiplayer instance isn't currently connected to any server or client.");
 
@@ -557,6 +594,23 @@ Error NetworkedMultiplayerENet::put_packet(const uint8_t *p_buffer, int p_buffer
 		ERR_FAIL_COND_V_MSG(!E, ERR_INVALID_PARAMETER, vformat("Invalid target peer: %d", target_peer));
 	}
 
+	if (coalesce_packets) {
+		// Queued per destination peer, sent on the next poll.
+		if (!server) {
+			_send_message(1, channel, packet_flags, unique_id, target_peer, p_buffer, p_buffer_size); // Send to server for broadcast
+		} else if (target_peer > 0) {
+			_send_message(target_peer, channel, packet_flags, unique_id, target_peer, p_buffer, p_buffer_size);
+		} else {
+			for (Map<int, ENetPeer *>::Element *F = peer_map.front(); F; F = F->next()) {
+				if (F->key() == -target_peer) { // Exclude packet
+					continue;
+				}
+				_send_message(F->key(), channel, packet_flags, unique_id, target_peer, p_buffer, p_buffer_size);
+			}
+		}
+		return OK;
+	}
+
 	ENetPacket *packet = enet_packet_create(nullptr, p_buffer_size + 8, packet_flags);
 	encode_uint32(unique_id, &packet->data[0]); // Source ID
 	encode_uint32(target_peer, &packet->data[4]); // Dest ID
@@ -599,19 +653,203 @@ int NetworkedMultiplayerENet::get_max_packet_size() const {
 	return 1 << 24; // Anything is good
 }
 
+void NetworkedMultiplayerENet::_push_incoming_packet(const Packet &p_packet) {
+	// Never let the ring fill up completely, RingBuffer can't read back from a full ring.
+	if (incoming_packets.space_left() <= 1) {
+		incoming_packets.resize(get_shift_from_power_of_2(incoming_packets.size()) + 1); // Grow, no allocation per packet.
+	}
+	incoming_packets.write(p_packet);
+}
+
 void NetworkedMultiplayerENet::_pop_current_packet() {
 	if (current_packet.packet) {
-		enet_packet_destroy(current_packet.packet);
+		// Messages split from a coalesced packet share it, the last one destroys it.
+		if (!current_packet.views) {
+			enet_packet_destroy(current_packet.packet);
+		} else if (--(*current_packet.views) == 0) {
+			enet_packet_destroy(current_packet.packet);
+			memdelete(current_packet.views);
+		}
 		current_packet.packet = nullptr;
+		current_packet.views = nullptr;
 		current_packet.from = 0;
 		current_packet.channel = -1;
 	}
 }
 
+void NetworkedMultiplayerENet::_send_message(int p_peer, int p_channel, int p_flags, uint32_t p_source, int p_target, const uint8_t *p_data, int p_size) {
+	Map<int, ENetPeer *>::Element *E = peer_map.find(p_peer);
+	ERR_FAIL_COND(!E || !E->get());
+
+	const int message_size = COALESCE_MESSAGE_HEADER_SIZE + p_size;
+	const uint64_t key = (uint64_t(uint32_t(p_peer)) << 32) | uint32_t(p_channel);
+	Map<uint64_t, CoalescedPacket>::Element *C = coalesced_packets.find(key);
+
+	if (C && (C->get().flags != p_flags || C->get().data.size() + message_size > COALESCE_MAX_SIZE)) {
+		_flush_coalesced_packet(C->get()); // Other flags, or full.
+	}
+
+	if (!coalesce_packets || COALESCE_HEADER_SIZE + message_size > COALESCE_MAX_SIZE) {
+		// Send on its own, after what was already queued to keep the order.
+		if (C) {
+			_flush_coalesced_packet(C->get());
+		}
+		ENetPacket *packet = enet_packet_create(nullptr, p_size + 8, p_flags);
+		encode_uint32(p_source, &packet->data[0]);
+		encode_uint32(p_target, &packet->data[4]);
+		copymem(&packet->data[8], p_data, p_size);
+		enet_peer_send(E->get(), p_channel, packet);
+		return;
+	}
+
+	if (!C) {
+		C = coalesced_packets.insert(key, CoalescedPacket());
+		C->get().peer = p_peer;
+		C->get().channel = p_channel;
+	}
+	C->get().flags = p_flags;
+
+	Vector<uint8_t> &data = C->get().data;
+	if (data.empty()) {
+		data.resize(COALESCE_HEADER_SIZE);
+		encode_uint32(0, data.ptrw());
+	}
+	int ofs = data.size();
+	data.resize(ofs + message_size);
+	uint8_t *w = data.ptrw();
+	encode_uint32(p_source, &w[ofs]);
+	encode_uint32(p_target, &w[ofs + 4]);
+	encode_uint16(p_size, &w[ofs + 8]);
+	copymem(&w[ofs + COALESCE_MESSAGE_HEADER_SIZE], p_data, p_size);
+}
+
+void NetworkedMultiplayerENet::_flush_coalesced_packet(CoalescedPacket &p_packet) {
+	if (p_packet.data.empty()) {
+		return;
+	}
+
+	Map<int, ENetPeer *>::Element *E = peer_map.find(p_packet.peer);
+	if (E && E->get()) {
+		ENetPacket *packet = enet_packet_create(p_packet.data.ptr(), p_packet.data.size(), p_packet.flags);
+		enet_peer_send(E->get(), p_packet.channel, packet);
+	}
+	p_packet.data.clear();
+}
+
+void NetworkedMultiplayerENet::_flush_coalesced_packets() {
+	Map<uint64_t, CoalescedPacket>::Element *C = coalesced_packets.front();
+	while (C) {
+		Map<uint64_t, CoalescedPacket>::Element *N = C->next();
+		if (C->get().data.empty()) {
+			coalesced_packets.erase(C); // Nothing sent to this peer and channel since the last flush.
+		} else {
+			_flush_coalesced_packet(C->get());
+		}
+		C = N;
+	}
+}
+
+void NetworkedMultiplayerENet::_relay_packet(int p_peer, int p_channel, const ENetPacket *p_packet) {
+	if (coalesce_packets) {
+		// Goes through the same queue as the coalesced messages, so it stays in order with them.
+		const int flags = p_packet->flags & (ENET_PACKET_FLAG_RELIABLE | ENET_PACKET_FLAG_UNSEQUENCED);
+		_send_message(p_peer, p_channel, flags, decode_uint32(&p_packet->data[0]), decode_uint32(&p_packet->data[4]), &p_packet->data[8], p_packet->dataLength - 8);
+		return;
+	}
+
+	ENetPacket *packet = enet_packet_create(p_packet->data, p_packet->dataLength, p_packet->flags);
+	enet_peer_send(peer_map[p_peer], p_channel, packet);
+}
+
+void NetworkedMultiplayerENet::_process_coalesced_packet(ENetPeer *p_peer, int p_channel, ENetPacket *p_packet) {
+	uint32_t *id = (uint32_t *)p_peer->data;
+	const int flags = p_packet->flags & (ENET_PACKET_FLAG_RELIABLE | ENET_PACKET_FLAG_UNSEQUENCED);
+	const int len = p_packet->dataLength;
+	int ofs = COALESCE_HEADER_SIZE;
+	int *views = memnew(int);
+	*views = 0;
+
+	while (ofs + COALESCE_MESSAGE_HEADER_SIZE <= len) {
+		uint32_t source = decode_uint32(&p_packet->data[ofs]);
+		int target = decode_uint32(&p_packet->data[ofs + 4]);
+		int size = decode_uint16(&p_packet->data[ofs + 8]);
+		ofs += COALESCE_MESSAGE_HEADER_SIZE;
+		ERR_BREAK_MSG(ofs + size > len, "Invalid coalesced packet received.");
+
+		const uint8_t *data = &p_packet->data[ofs];
+		ofs += size;
+
+		Packet packet;
+		packet.packet = p_packet;
+		packet.from = source;
+		packet.channel = p_channel;
+		packet.offset = data - p_packet->data;
+		packet.size = size;
+		packet.views = views;
+
+		if (!server) {
+			_push_incoming_packet(packet);
+			(*views)++;
+			continue;
+		}
+
+		// Someone is cheating and trying to fake the source!
+		ERR_CONTINUE(source != *id);
+
+		// Same routing as whole packets, relayed messages are sent (or coalesced) one by one.
+		if (target == 1) {
+			_push_incoming_packet(packet);
+			(*views)++;
+		} else if (!server_relay) {
+			continue;
+		} else if (target <= 0) {
+			for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
+				if (uint32_t(E->key()) == source || E->key() == -target) {
+					continue;
+				}
+				_send_message(E->key(), p_channel, flags, source, target, data, size);
+			}
+			if (target == 0 || -target != 1) {
+				_push_incoming_packet(packet);
+				(*views)++;
+			}
+		} else {
+			ERR_CONTINUE(!peer_map.has(target));
+			_send_message(target, p_channel, flags, source, target, data, size);
+		}
+	}
+
+	if (*views == 0) {
+		enet_packet_destroy(p_packet);
+		memdelete(views);
+	}
+}
+
 NetworkedMultiplayerPeer::ConnectionStatus NetworkedMultiplayerENet::get_connection_status() const {
+	MutexLock lock(peer_mutex);
 	return connection_status;
 }
 
+void NetworkedMultiplayerENet::wait_for_packets(int p_timeout_msec) {
+	// Keeps the host alive while waiting on its socket, without blocking
+	// the other calls into the peer. Only closing the connection waits.
+	MutexLock wait_lock(wait_mutex);
+
+	peer_mutex.lock();
+	ENetSocket socket = active ? host->socket : nullptr;
+	peer_mutex.unlock();
+
+	if (socket) {
+		enet_uint32 condition = ENET_SOCKET_WAIT_RECEIVE;
+		if (enet_socket_wait(socket, &condition, p_timeout_msec) == 0) {
+			return;
+		}
+	}
+
+	// DTLS sockets can't be waited on.
+	NetworkedMultiplayerPeer::wait_for_packets(p_timeout_msec);
+}
+
 uint32_t NetworkedMultiplayerENet::_gen_unique_id() const {
 	uint32_t hash = 0;
 
@@ -634,11 +872,13 @@ uint32_t NetworkedMultiplayerENet::_gen_unique_id() const {
 }
 
 int NetworkedMultiplayerENet::get_unique_id() const {
+	MutexLock lock(peer_mutex);
 	ERR_FAIL_COND_V_MSG(!active, 0, "The multiplayer instance isn't currently active.");
 	return unique_id;
 }
 
 void NetworkedMultiplayerENet::set_refuse_new_connections(bool p_enable) {
+	MutexLock lock(peer_mutex);
 	refuse_connections = p_enable;
 }
 
@@ -752,6 +992,7 @@ void NetworkedMultiplayerENet::enet_compressor_destroy(void *context) {
 }
 
 IP_Address NetworkedMultiplayerENet::get_peer_address(int p_peer_id) const {
+	MutexLock lock(peer_mutex);
 	ERR_FAIL_COND_V_MSG(!peer_map.has(p_peer_id), IP_Address(), vformat("Peer ID %d not found in the list of peers.", p_peer_id));
 	ERR_FAIL_COND_V_MSG(!is_server() && p_peer_id != 1, IP_Address(), "Can't get the address of peers other than the server (ID -1) when acting as a client.");
 	ERR_FAIL_COND_V_MSG(peer_map[p_peer_id] == nullptr, IP_Address(), vformat("Peer ID %d found in the list of peers, but is null.", p_peer_id));
@@ -767,6 +1008,7 @@ IP_Address NetworkedMultiplayerENet::get_peer_address(int p_peer_id) const {
 }
 
 int NetworkedMultiplayerENet::get_peer_port(int p_peer_id) const {
+	MutexLock lock(peer_mutex);
 	ERR_FAIL_COND_V_MSG(!peer_map.has(p_peer_id), 0, vformat("Peer ID %d not found in the list of peers.", p_peer_id));
 	ERR_FAIL_COND_V_MSG(!is_server() && p_peer_id != 1, 0, "Can't get the address of peers other than the server (ID -1) when acting as a client.");
 	ERR_FAIL_COND_V_MSG(peer_map[p_peer_id] == nullptr, 0, vformat("Peer ID %d found in the list of peers, but is null.", p_peer_id));
@@ -778,6 +1020,7 @@ int NetworkedMultiplayerENet::get_peer_port(int p_peer_id) const {
 }
 
 void NetworkedMultiplayerENet::set_transfer_channel(int p_channel) {
+	MutexLock lock(peer_mutex);
 	ERR_FAIL_COND_MSG(p_channel < -1 || p_channel >= channel_count, vformat("The transfer channel must be set between 0 and %d, inclusive (got %d).", channel_count - 1, p_channel));
 	ERR_FAIL_COND_MSG(p_channel == SYSCH_CONFIG, vformat("The channel %d is reserved.", SYSCH_CONFIG));
 	transfer_channel = p_channel;
@@ -815,6 +1058,18 @@ bool NetworkedMultiplayerENet::is_server_relay_enabled() const {
 	return server_relay;
 }
 
+void NetworkedMultiplayerENet::set_coalesce_packets(bool p_enabled) {
+	MutexLock lock(peer_mutex);
+	if (coalesce_packets && !p_enabled && active) {
+		_flush_coalesced_packets();
+	}
+	coalesce_packets = p_enabled;
+}
+
+bool NetworkedMultiplayerENet::is_coalescing_packets() const {
+	return coalesce_packets;
+}
+
 void NetworkedMultiplayerENet::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("create_server", "port", "max_clients", "in_bandwidth", "out_bandwidth"), &NetworkedMultiplayerENet::create_server, DEFVAL(32), DEFVAL(0), DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("create_client", "address", "port", "in_bandwidth", "out_bandwidth", "client_port"), &NetworkedMultiplayerENet::create_client, DEFVAL(0), DEFVAL(0), DEFVAL(0));
@@ -842,12 +1097,15 @@ void NetworkedMultiplayerENet::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_always_ordered"), &NetworkedMultiplayerENet::is_always_ordered);
 	ClassDB::bind_method(D_METHOD("set_server_relay_enabled", "enabled"), &NetworkedMultiplayerENet::set_server_relay_enabled);
 	ClassDB::bind_method(D_METHOD("is_server_relay_enabled"), &NetworkedMultiplayerENet::is_server_relay_enabled);
+	ClassDB::bind_method(D_METHOD("set_coalesce_packets", "enabled"), &NetworkedMultiplayerENet::set_coalesce_packets);
+	ClassDB::bind_method(D_METHOD("is_coalescing_packets"), &NetworkedMultiplayerENet::is_coalescing_packets);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_mode", PROPERTY_HINT_ENUM, "None,Range Coder,FastLZ,ZLib,ZStd"), "set_compression_mode", "get_compression_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "transfer_channel"), "set_transfer_channel", "get_transfer_channel");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "channel_count"), "set_channel_count", "get_channel_count");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "always_ordered"), "set_always_ordered", "is_always_ordered");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "coalesce_packets"), "set_coalesce_packets", "is_coalescing_packets");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "dtls_verify"), "set_dtls_verify_enabled", "is_dtls_verify_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_dtls"), "set_dtls_enabled", "is_dtls_enabled");
 
@@ -866,10 +1124,12 @@ NetworkedMultiplayerENet::NetworkedMultiplayerENet() {
 	unique_id = 0;
 	target_peer = 0;
 	current_packet.packet = nullptr;
+	incoming_packets.resize(INCOMING_PACKETS_QUEUE_SHIFT);
 	transfer_mode = TRANSFER_MODE_RELIABLE;
 	channel_count = SYSCH_MAX;
 	transfer_channel = -1;
 	always_ordered = false;
+	coalesce_packets = false;
 	connection_status = CONNECTION_DISCONNECTED;
 	compression_mode = COMPRESS_NONE;
 	enet_compressor.context = this;
@@ -34,6 +34,7 @@
 #include "core/crypto/crypto.h"
 #include "core/io/compression.h"
 #include "core/io/networked_multiplayer_peer.h"
+#include "core/ring_buffer.h"
 
 #include <enet/enet.h>
 
@@ -62,9 +63,20 @@ private:
 		SYSCH_MAX
 	};
 
+	// Coalesced packets start with a zero source ID, followed by messages with
+	// their own source, target and 16-bit size. They are kept below the MTU.
+	enum {
+		COALESCE_HEADER_SIZE = 4,
+		COALESCE_MESSAGE_HEADER_SIZE = 10,
+		COALESCE_MAX_SIZE = 1200,
+	};
+
 	bool active;
 	bool server;
 
+	// Held while waiting on the host socket, so it is not destroyed meanwhile.
+	Mutex wait_mutex;
+
 	uint32_t unique_id;
 
 	int target_peer;
@@ -85,18 +97,45 @@ private:
 	Map<int, ENetPeer *> peer_map;
 
 	struct Packet {
-		ENetPacket *packet;
+		ENetPacket *packet = nullptr;
 		int from;
 		int channel;
+		int offset = 8; // Payload position, past the source and target IDs.
+		int size = 0;
+		int *views = nullptr; // Shared by the messages split from one coalesced packet.
+	};
+
+	// Messages waiting to be sent to a peer on a channel, flushed on poll. A
+	// message with other flags flushes the pending ones first, to keep the order.
+	struct CoalescedPacket {
+		int peer = 0;
+		int channel = 0;
+		int flags = 0;
+		Vector<uint8_t> data;
 	};
 
+	bool coalesce_packets;
+	Map<uint64_t, CoalescedPacket> coalesced_packets;
+
+	void _send_message(int p_peer, int p_channel, int p_flags, uint32_t p_source, int p_target, const uint8_t *p_data, int p_size);
+	void _flush_coalesced_packet(CoalescedPacket &p_packet);
+	void _flush_coalesced_packets();
+	void _relay_packet(int p_peer, int p_channel, const ENetPacket *p_packet);
+	void _process_coalesced_packet(ENetPeer *p_peer, int p_channel, ENetPacket *p_packet);
+
 	CompressionMode compression_mode;
 
-	List<Packet> incoming_packets;
+	// Queue of received packets (or views into coalesced ones), grown as needed.
+	enum {
+		INCOMING_PACKETS_QUEUE_SHIFT = 6,
+	};
+
+	RingBuffer<Packet> incoming_packets;
 
 	Packet current_packet;
 
 	uint32_t _gen_unique_id() const;
+	void _push_incoming_packet(const Packet &p_packet);
 	void _pop_current_packet();
 
 	Vector<uint8_t> src_compressor_mem;
@@ -147,6 +186,9 @@ public:
 
 	virtual ConnectionStatus get_connection_status() const;
 
+	virtual bool is_threaded_poll_supported() const { return true; }
+	virtual void wait_for_packets(int p_timeout_msec);
+
 	virtual void set_refuse_new_connections(bool p_enable);
 	virtual bool is_refusing_new_connections() const;
 
@@ -165,6 +207,8 @@ public:
 	bool is_always_ordered() const;
 	void set_server_relay_enabled(bool p_enabled);
 	bool is_server_relay_enabled() const;
+	void set_coalesce_packets(bool p_enabled);
+	bool is_coalescing_packets() const;
 
 	NetworkedMultiplayerENet();
 	~NetworkedMultiplayerENet();
@@ -243,6 +243,8 @@ private:
 	int _argument_count;
 	int _stack_size;
 	int _call_size;
+	VariantCallCache *_call_caches = nullptr;
+	int _call_cache_count = 0;
 	int _initial_line;
 	bool _static;
 	MultiplayerAPI::RPCMode rpc_mode;
@@ -829,7 +829,7 @@ void GDScriptFunctions::call(Function p_func, const Variant **p_args, int p_arg_
 
 			PackedByteArray barr;
 			int len;
-			Error err = encode_variant(*p_args[0], nullptr, len, full_objects);
+			Error err = encode_variant(*p_args[0], barr, len, full_objects);
 			if (err) {
 				r_error.error = Callable::CallError::CALL_ERROR_INVALID_ARGUMENT;
 				r_error.argument = 0;
@@ -839,10 +839,6 @@ void GDScriptFunctions::call(Function p_func, const Variant **p_args, int p_arg_
 			}
 
 			barr.resize(len);
-			{
-				uint8_t *w = barr.ptrw();
-				encode_variant(*p_args[0], w, len, full_objects);
-			}
 			r_ret = barr;
 		} break;
 		case BYTES_TO_VAR: {
@@ -50,13 +50,13 @@ bool GridMap::_set(const StringName &p_name, const Variant &p_value) {
 			int amount = cells.size();
 			const int *r = cells.ptr();
 			ERR_FAIL_COND_V(amount % 3, false); // not even
-			cell_map.clear();
+			_clear_cells();
 			for (int i = 0; i < amount / 3; i++) {
 				IndexKey ik;
 				ik.key = decode_uint64((const uint8_t *)&r[i * 3]);
 				Cell cell;
 				cell.cell = decode_uint32((const uint8_t *)&r[i * 3 + 2]);
-				cell_map[ik] = cell;
+				*_insert_cell(ik) = cell;
 			}
 		}
 
@@ -96,14 +96,14 @@ bool GridMap::_get(const StringName &p_name, Variant &r_ret) const {
 	if (name == "data") {
 		Dictionary d;
 
+		Vector<IndexKey> keys = _get_used_cell_keys();
 		Vector<int> cells;
-		cells.resize(cell_map.size() * 3);
+		cells.resize(keys.size() * 3);
 		{
 			int *w = cells.ptrw();
-			int i = 0;
-			for (Map<IndexKey, Cell>::Element *E = cell_map.front(); E; E = E->next(), i++) {
-				encode_uint64(E->key().key, (uint8_t *)&w[i * 3]);
-				encode_uint32(E->get().cell, (uint8_t *)&w[i * 3 + 2]);
+			for (int i = 0; i < keys.size(); i++) {
+				encode_uint64(keys[i].key, (uint8_t *)&w[i * 3]);
+				encode_uint32(_get_cell(keys[i])->cell, (uint8_t *)&w[i * 3 + 2]);
 			}
 		}
 
@@ -267,14 +267,15 @@ void GridMap::set_cell_item(int p_x, int p_y, int p_z, int p_item, int p_rot) {
 
 	if (p_item < 0) {
 		//erase
-		if (cell_map.has(key)) {
+		if (_get_cell(key)) {
 			OctantKey octantkey = ok;
 
-			ERR_FAIL_COND(!octant_map.has(octantkey));
-			Octant &g = *octant_map[octantkey];
+			Octant **octant = octant_map.lookup_ptr(octantkey);
+			ERR_FAIL_COND(!octant);
+			Octant &g = **octant;
 			g.cells.erase(key);
 			g.dirty = true;
-			cell_map.erase(key);
+			_erase_cell(key);
 			_queue_octants_dirty();
 		}
 		return;
@@ -282,40 +283,96 @@ void GridMap::set_cell_item(int p_x, int p_y, int p_z, int p_item, int p_rot) {
 
 	OctantKey octantkey = ok;
 
-	if (!octant_map.has(octantkey)) {
-		//create octant because it does not exist
-		Octant *g = memnew(Octant);
-		g->dirty = true;
-		g->static_body = PhysicsServer3D::get_singleton()->body_create(PhysicsServer3D::BODY_MODE_STATIC);
-		PhysicsServer3D::get_singleton()->body_attach_object_instance_id(g->static_body, get_instance_id());
-		PhysicsServer3D::get_singleton()->body_set_collision_layer(g->static_body, collision_layer);
-		PhysicsServer3D::get_singleton()->body_set_collision_mask(g->static_body, collision_mask);
-		SceneTree *st = SceneTree::get_singleton();
+	Octant **octant = octant_map.lookup_ptr(octantkey);
+	Octant &g = octant ? **octant : *_create_octant(octantkey);
+	g.cells.insert(key);
+	g.dirty = true;
+	_queue_octants_dirty();
 
-		if (st && st->is_debugging_collisions_hint()) {
-			g->collision_debug = RenderingServer::get_singleton()->mesh_create();
-			g->collision_debug_instance = RenderingServer::get_singleton()->instance_create();
-			RenderingServer::get_singleton()->instance_set_base(g->collision_debug_instance, g->collision_debug);
-		}
+	Cell c;
+	c.item = p_item;
+	c.rot = p_rot;
 
-		octant_map[octantkey] = g;
+	*_insert_cell(key) = c;
+}
 
-		if (is_inside_world()) {
-			_octant_enter_world(octantkey);
-			_octant_transform(octantkey);
+void GridMap::set_cell_items(const Array &p_cells, int p_item, int p_rot) {
+	if (p_item < 0) {
+		for (int i = 0; i < p_cells.size(); i++) {
+			Vector3 pos = p_cells[i];
+			set_cell_item(pos.x, pos.y, pos.z, p_item, p_rot);
 		}
+		return;
 	}
 
-	Octant &g = *octant_map[octantkey];
-	g.cells.insert(key);
-	g.dirty = true;
-	_queue_octants_dirty();
+	if (baked_meshes.size() && !recreating_octants) {
+		//if you set a cell item, baked meshes go good bye
+		clear_baked_meshes();
+		_recreate_octant_data();
+	}
 
 	Cell c;
 	c.item = p_item;
 	c.rot = p_rot;
 
-	cell_map[key] = c;
+	// Neighbouring cells usually share an octant, so it is only looked up
+	// again when the octant changes.
+	Octant *g = nullptr;
+	OctantKey last_ok;
+
+	for (int i = 0; i < p_cells.size(); i++) {
+		Vector3 pos = p_cells[i];
+		int x = pos.x;
+		int y = pos.y;
+		int z = pos.z;
+		ERR_CONTINUE(ABS(x) >= 1 << 20 || ABS(y) >= 1 << 20 || ABS(z) >= 1 << 20);
+
+		IndexKey key;
+		key.x = x;
+		key.y = y;
+		key.z = z;
+
+		OctantKey ok;
+		ok.x = x / octant_size;
+		ok.y = y / octant_size;
+		ok.z = z / octant_size;
+
+		if (!g || !(ok == last_ok)) {
+			Octant **octant = octant_map.lookup_ptr(ok);
+			g = octant ? *octant : _create_octant(ok);
+			last_ok = ok;
+		}
+
+		g->cells.insert(key);
+		g->dirty = true;
+		*_insert_cell(key) = c;
+	}
+
+	_queue_octants_dirty();
+}
+
+GridMap::Octant *GridMap::_create_octant(const OctantKey &p_key) {
+	Octant *g = memnew(Octant);
+	g->dirty = true;
+	g->static_body = PhysicsServer3D::get_singleton()->body_create(PhysicsServer3D::BODY_MODE_STATIC);
+	PhysicsServer3D::get_singleton()->body_attach_object_instance_id(g->static_body, get_instance_id());
+	PhysicsServer3D::get_singleton()->body_set_collision_layer(g->static_body, collision_layer);
+	PhysicsServer3D::get_singleton()->body_set_collision_mask(g->static_body, collision_mask);
+	SceneTree *st = SceneTree::get_singleton();
+
+	if (st && st->is_debugging_collisions_hint()) {
+		g->collision_debug = RenderingServer::get_singleton()->mesh_create();
+		g->collision_debug_instance = RenderingServer::get_singleton()->instance_create();
+		RenderingServer::get_singleton()->instance_set_base(g->collision_debug_instance, g->collision_debug);
+	}
+
+	octant_map.insert(p_key, g);
+
+	if (is_inside_world()) {
+		_octant_enter_world(p_key);
+		_octant_transform(p_key);
+	}
+	return g;
 }
 
 int GridMap::get_cell_item(int p_x, int p_y, int p_z) const {
@@ -328,10 +385,11 @@ int GridMap::get_cell_item(int p_x, int p_y, int p_z) const {
 	key.y = p_y;
 	key.z = p_z;
 
-	if (!cell_map.has(key)) {
+	const Cell *c = _get_cell(key);
+	if (!c) {
 		return INVALID_CELL_ITEM;
 	}
-	return cell_map[key].item;
+	return c->item;
 }
 
 int GridMap::get_cell_item_orientation(int p_x, int p_y, int p_z) const {
@@ -344,10 +402,11 @@ int GridMap::get_cell_item_orientation(int p_x, int p_y, int p_z) const {
 	key.y = p_y;
 	key.z = p_z;
 
-	if (!cell_map.has(key)) {
+	const Cell *c = _get_cell(key);
+	if (!c) {
 		return -1;
 	}
-	return cell_map[key].rot;
+	return c->rot;
 }
 
 Vector3 GridMap::world_to_map(const Vector3 &p_world_pos) const {
@@ -368,8 +427,9 @@ Vector3 GridMap::map_to_world(int p_x, int p_y, int p_z) const {
 }
 
 void GridMap::_octant_transform(const OctantKey &p_key) {
-	ERR_FAIL_COND(!octant_map.has(p_key));
-	Octant &g = *octant_map[p_key];
+	Octant **octant = octant_map.lookup_ptr(p_key);
+	ERR_FAIL_COND(!octant);
+	Octant &g = **octant;
 	PhysicsServer3D::get_singleton()->body_set_state(g.static_body, PhysicsServer3D::BODY_STATE_TRANSFORM, get_global_transform());
 
 	if (g.collision_debug_instance.is_valid()) {
@@ -382,8 +442,9 @@ void GridMap::_octant_transform(const OctantKey &p_key) {
 }
 
 bool GridMap::_octant_update(const OctantKey &p_key) {
-	ERR_FAIL_COND_V(!octant_map.has(p_key), false);
-	Octant &g = *octant_map[p_key];
+	Octant **octant = octant_map.lookup_ptr(p_key);
+	ERR_FAIL_COND_V(!octant, false);
+	Octant &g = **octant;
 	if (!g.dirty) {
 		return false;
 	}
@@ -426,15 +487,17 @@ bool GridMap::_octant_update(const OctantKey &p_key) {
 
 	Map<int, List<Pair<Transform, IndexKey>>> multimesh_items;
 
-	for (Set<IndexKey>::Element *E = g.cells.front(); E; E = E->next()) {
-		ERR_CONTINUE(!cell_map.has(E->get()));
-		const Cell &c = cell_map[E->get()];
+	for (int k = 0; k < g.cells.size(); k++) {
+		const IndexKey &key = g.cells[k];
+		const Cell *cell = _get_cell(key);
+		ERR_CONTINUE(!cell);
+		const Cell &c = *cell;
 
 		if (!mesh_library.is_valid() || !mesh_library->has_item(c.item)) {
 			continue;
 		}
 
-		Vector3 cellpos = Vector3(E->get().x, E->get().y, E->get().z);
+		Vector3 cellpos = Vector3(key.x, key.y, key.z);
 		Vector3 ofs = _get_offset();
 
 		Transform xform;
@@ -450,7 +513,7 @@ bool GridMap::_octant_update(const OctantKey &p_key) {
 
 				Pair<Transform, IndexKey> p;
 				p.first = xform;
-				p.second = E->get();
+				p.second = key;
 				multimesh_items[c.item].push_back(p);
 			}
 		}
@@ -481,7 +544,7 @@ bool GridMap::_octant_update(const OctantKey &p_key) {
 				NavigationServer3D::get_singleton()->region_set_map(region, navigation->get_rid());
 				nm.region = region;
 			}
-			g.navmesh_ids[E->get()] = nm;
+			g.navmesh_ids[key] = nm;
 		}
 	}
 
@@ -542,15 +605,16 @@ bool GridMap::_octant_update(const OctantKey &p_key) {
 }
 
 void GridMap::_reset_physic_bodies_collision_filters() {
-	for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
-		PhysicsServer3D::get_singleton()->body_set_collision_layer(E->get()->static_body, collision_layer);
-		PhysicsServer3D::get_singleton()->body_set_collision_mask(E->get()->static_body, collision_mask);
+	for (OAHashMap<OctantKey, Octant *, OctantKeyHasher>::Iterator E = octant_map.iter(); E.valid; E = octant_map.next_iter(E)) {
+		PhysicsServer3D::get_singleton()->body_set_collision_layer((*E.value)->static_body, collision_layer);
+		PhysicsServer3D::get_singleton()->body_set_collision_mask((*E.value)->static_body, collision_mask);
 	}
 }
 
 void GridMap::_octant_enter_world(const OctantKey &p_key) {
-	ERR_FAIL_COND(!octant_map.has(p_key));
-	Octant &g = *octant_map[p_key];
+	Octant **octant = octant_map.lookup_ptr(p_key);
+	ERR_FAIL_COND(!octant);
+	Octant &g = **octant;
 	PhysicsServer3D::get_singleton()->body_set_state(g.static_body, PhysicsServer3D::BODY_STATE_TRANSFORM, get_global_transform());
 	PhysicsServer3D::get_singleton()->body_set_space(g.static_body, get_world_3d()->get_space());
 
@@ -566,8 +630,9 @@ void GridMap::_octant_enter_world(const OctantKey &p_key) {
 
 	if (navigation && mesh_library.is_valid()) {
 		for (Map<IndexKey, Octant::NavMesh>::Element *F = g.navmesh_ids.front(); F; F = F->next()) {
-			if (cell_map.has(F->key()) && F->get().region.is_valid() == false) {
-				Ref<NavigationMesh> nm = mesh_library->get_item_navmesh(cell_map[F->key()].item);
+			const Cell *c = _get_cell(F->key());
+			if (c && F->get().region.is_valid() == false) {
+				Ref<NavigationMesh> nm = mesh_library->get_item_navmesh(c->item);
 				if (nm.is_valid()) {
 					RID region = NavigationServer3D::get_singleton()->region_create();
 					NavigationServer3D::get_singleton()->region_set_navmesh(region, nm);
@@ -581,8 +646,9 @@ void GridMap::_octant_enter_world(const OctantKey &p_key) {
 }
 
 void GridMap::_octant_exit_world(const OctantKey &p_key) {
-	ERR_FAIL_COND(!octant_map.has(p_key));
-	Octant &g = *octant_map[p_key];
+	Octant **octant = octant_map.lookup_ptr(p_key);
+	ERR_FAIL_COND(!octant);
+	Octant &g = **octant;
 	PhysicsServer3D::get_singleton()->body_set_state(g.static_body, PhysicsServer3D::BODY_STATE_TRANSFORM, get_global_transform());
 	PhysicsServer3D::get_singleton()->body_set_space(g.static_body, RID());
 
@@ -605,8 +671,9 @@ void GridMap::_octant_exit_world(const OctantKey &p_key) {
 }
 
 void GridMap::_octant_clean_up(const OctantKey &p_key) {
-	ERR_FAIL_COND(!octant_map.has(p_key));
-	Octant &g = *octant_map[p_key];
+	Octant **octant = octant_map.lookup_ptr(p_key);
+	ERR_FAIL_COND(!octant);
+	Octant &g = **octant;
 
 	if (g.collision_debug.is_valid()) {
 		RS::get_singleton()->free(g.collision_debug);
@@ -647,8 +714,8 @@ void GridMap::_notification(int p_what) {
 
 			last_transform = get_global_transform();
 
-			for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
-				_octant_enter_world(E->key());
+			for (OAHashMap<OctantKey, Octant *, OctantKeyHasher>::Iterator E = octant_map.iter(); E.valid; E = octant_map.next_iter(E)) {
+				_octant_enter_world(*E.key);
 			}
 
 			for (int i = 0; i < baked_meshes.size(); i++) {
@@ -663,8 +730,8 @@ void GridMap::_notification(int p_what) {
 				break;
 			}
 			//update run
-			for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
-				_octant_transform(E->key());
+			for (OAHashMap<OctantKey, Octant *, OctantKeyHasher>::Iterator E = octant_map.iter(); E.valid; E = octant_map.next_iter(E)) {
+				_octant_transform(*E.key);
 			}
 
 			last_transform = new_xform;
@@ -675,8 +742,8 @@ void GridMap::_notification(int p_what) {
 
 		} break;
 		case NOTIFICATION_EXIT_WORLD: {
-			for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
-				_octant_exit_world(E->key());
+			for (OAHashMap<OctantKey, Octant *, OctantKeyHasher>::Iterator E = octant_map.iter(); E.valid; E = octant_map.next_iter(E)) {
+				_octant_exit_world(*E.key);
 			}
 
 			navigation = nullptr;
@@ -702,8 +769,8 @@ void GridMap::_update_visibility() {
 
 	_change_notify("visible");
 
-	for (Map<OctantKey, Octant *>::Element *e = octant_map.front(); e; e = e->next()) {
-		Octant *octant = e->value();
+	for (OAHashMap<OctantKey, Octant *, OctantKeyHasher>::Iterator E = octant_map.iter(); E.valid; E = octant_map.next_iter(E)) {
+		Octant *octant = *E.value;
 		for (int i = 0; i < octant->multimesh_instances.size(); i++) {
 			const Octant::MultimeshInstance &mi = octant->multimesh_instances[i];
 			RS::get_singleton()->instance_set_visible(mi.instance, is_visible());
@@ -720,28 +787,128 @@ void GridMap::_queue_octants_dirty() {
 	awaiting_update = true;
 }
 
+GridMap::Cell *GridMap::_get_cell(const IndexKey &p_key) const {
+	CellChunk **chunk = cell_chunks.lookup_ptr(_get_cell_chunk_key(p_key));
+	if (!chunk) {
+		return nullptr;
+	}
+
+	int index = _get_cell_chunk_index(p_key);
+	if (!(*chunk)->is_used(index)) {
+		return nullptr;
+	}
+	return &(*chunk)->cells[index];
+}
+
+GridMap::Cell *GridMap::_insert_cell(const IndexKey &p_key) {
+	IndexKey ck = _get_cell_chunk_key(p_key);
+	CellChunk **chunk_ptr = cell_chunks.lookup_ptr(ck);
+	CellChunk *chunk;
+	if (chunk_ptr) {
+		chunk = *chunk_ptr;
+	} else {
+		chunk = memnew(CellChunk);
+		cell_chunks.insert(ck, chunk);
+	}
+
+	int index = _get_cell_chunk_index(p_key);
+	if (!chunk->is_used(index)) {
+		chunk->used[index >> 6] |= uint64_t(1) << (index & 63);
+		chunk->used_count++;
+		chunk->cells[index] = Cell();
+		cell_count++;
+	}
+	return &chunk->cells[index];
+}
+
+void GridMap::_erase_cell(const IndexKey &p_key) {
+	IndexKey ck = _get_cell_chunk_key(p_key);
+	CellChunk **chunk_ptr = cell_chunks.lookup_ptr(ck);
+	if (!chunk_ptr) {
+		return;
+	}
+
+	CellChunk *chunk = *chunk_ptr;
+	int index = _get_cell_chunk_index(p_key);
+	if (!chunk->is_used(index)) {
+		return;
+	}
+
+	chunk->used[index >> 6] &= ~(uint64_t(1) << (index & 63));
+	chunk->used_count--;
+	cell_count--;
+
+	if (chunk->used_count == 0) {
+		cell_chunks.remove(ck);
+		memdelete(chunk);
+	}
+}
+
+void GridMap::_clear_cells() {
+	for (OAHashMap<IndexKey, CellChunk *, IndexKeyHasher>::Iterator it = cell_chunks.iter(); it.valid; it = cell_chunks.next_iter(it)) {
+		memdelete(*it.value);
+	}
+	cell_chunks.clear();
+	cell_count = 0;
+}
+
+Vector<GridMap::IndexKey> GridMap::_get_used_cell_keys() const {
+	// Chunks are visited in sorted order, so the result does not depend on the
+	// hash map layout (keeps saved cell data stable).
+	Vector<IndexKey> chunk_keys;
+	chunk_keys.resize(cell_chunks.get_num_elements());
+	int chunk_count = 0;
+	for (OAHashMap<IndexKey, CellChunk *, IndexKeyHasher>::Iterator it = cell_chunks.iter(); it.valid; it = cell_chunks.next_iter(it)) {
+		chunk_keys.write[chunk_count++] = *it.key;
+	}
+	chunk_keys.sort();
+
+	Vector<IndexKey> cells;
+	cells.resize(cell_count);
+	IndexKey *w = cells.ptrw();
+	int idx = 0;
+	for (int i = 0; i < chunk_count; i++) {
+		const CellChunk *chunk = *cell_chunks.lookup_ptr(chunk_keys[i]);
+		for (int j = 0; j < CELL_CHUNK_CELLS; j++) {
+			if (chunk->is_used(j)) {
+				IndexKey &k = w[idx++];
+				k.x = chunk_keys[i].x * CELL_CHUNK_SIZE + (j & CELL_CHUNK_MASK);
+				k.y = chunk_keys[i].y * CELL_CHUNK_SIZE + ((j >> CELL_CHUNK_SHIFT) & CELL_CHUNK_MASK);
+				k.z = chunk_keys[i].z * CELL_CHUNK_SIZE + (j >> (CELL_CHUNK_SHIFT * 2));
+			}
+		}
+	}
+
+	return cells;
+}
+
 void GridMap::_recreate_octant_data() {
 	recreating_octants = true;
-	Map<IndexKey, Cell> cell_copy = cell_map;
+	Vector<IndexKey> keys = _get_used_cell_keys();
+	Vector<Cell> cells;
+	cells.resize(keys.size());
+	for (int i = 0; i < keys.size(); i++) {
+		cells.write[i] = *_get_cell(keys[i]);
+	}
 	_clear_internal();
-	for (Map<IndexKey, Cell>::Element *E = cell_copy.front(); E; E = E->next()) {
-		set_cell_item(E->key().x, E->key().y, E->key().z, E->get().item, E->get().rot);
+	for (int i = 0; i < keys.size(); i++) {
+		set_cell_item(keys[i].x, keys[i].y, keys[i].z, cells[i].item, cells[i].rot);
 	}
 	recreating_octants = false;
 }
 
 void GridMap::_clear_internal() {
-	for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
+	for (OAHashMap<OctantKey, Octant *, OctantKeyHasher>::Iterator E = octant_map.iter(); E.valid; E = octant_map.next_iter(E)) {
 		if (is_inside_world()) {
-			_octant_exit_world(E->key());
+			_octant_exit_world(*E.key);
 		}
 
-		_octant_clean_up(E->key());
-		memdelete(E->get());
+		_octant_clean_up(*E.key);
+		memdelete(*E.value);
 	}
 
 	octant_map.clear();
-	cell_map.clear();
+	_clear_cells();
 }
 
 void GridMap::clear() {
@@ -759,15 +926,15 @@ void GridMap::_update_octants_callback() {
 	}
 
 	List<OctantKey> to_delete;
-	for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
-		if (_octant_update(E->key())) {
-			to_delete.push_back(E->key());
+	for (OAHashMap<OctantKey, Octant *, OctantKeyHasher>::Iterator E = octant_map.iter(); E.valid; E = octant_map.next_iter(E)) {
+		if (_octant_update(*E.key)) {
+			to_delete.push_back(*E.key);
 		}
 	}
 
-	while (to_delete.front()) {
-		octant_map.erase(to_delete.front()->get());
-		to_delete.pop_back();
+	for (List<OctantKey>::Element *E = to_delete.front(); E; E = E->next()) {
+		memdelete(*octant_map.lookup_ptr(E->get()));
+		octant_map.remove(E->get());
 	}
 
 	_update_visibility();
@@ -800,6 +967,7 @@ void GridMap::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_octant_size"), &GridMap::get_octant_size);
 
 	ClassDB::bind_method(D_METHOD("set_cell_item", "x", "y", "z", "item", "orientation"), &GridMap::set_cell_item, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("set_cell_items", "cells", "item", "orientation"), &GridMap::set_cell_items, DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("get_cell_item", "x", "y", "z"), &GridMap::get_cell_item);
 	ClassDB::bind_method(D_METHOD("get_cell_item_orientation", "x", "y", "z"), &GridMap::get_cell_item_orientation);
 
@@ -860,9 +1028,8 @@ void GridMap::set_clip(bool p_enabled, bool p_clip_above, int p_floor, Vector3::
 	clip_above = p_clip_above;
 
 	//make it all update
-	for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
-		Octant *g = E->get();
-		g->dirty = true;
+	for (OAHashMap<OctantKey, Octant *, OctantKeyHasher>::Iterator E = octant_map.iter(); E.valid; E = octant_map.next_iter(E)) {
+		(*E.value)->dirty = true;
 	}
 	awaiting_update = true;
 	_update_octants_callback();
@@ -878,12 +1045,11 @@ float GridMap::get_cell_scale() const {
 }
 
 Array GridMap::get_used_cells() const {
+	Vector<IndexKey> keys = _get_used_cell_keys();
 	Array a;
-	a.resize(cell_map.size());
-	int i = 0;
-	for (Map<IndexKey, Cell>::Element *E = cell_map.front(); E; E = E->next()) {
-		Vector3 p(E->key().x, E->key().y, E->key().z);
-		a[i++] = p;
+	a.resize(keys.size());
+	for (int i = 0; i < keys.size(); i++) {
+		a[i] = Vector3(keys[i].x, keys[i].y, keys[i].z);
 	}
 
 	return a;
@@ -897,8 +1063,10 @@ Array GridMap::get_meshes() {
 	Vector3 ofs = _get_offset();
 	Array meshes;
 
-	for (Map<IndexKey, Cell>::Element *E = cell_map.front(); E; E = E->next()) {
-		int id = E->get().item;
+	Vector<IndexKey> keys = _get_used_cell_keys();
+	for (int i = 0; i < keys.size(); i++) {
+		const Cell &c = *_get_cell(keys[i]);
+		int id = c.item;
 		if (!mesh_library->has_item(id)) {
 			continue;
 		}
@@ -907,13 +1075,13 @@ Array GridMap::get_meshes() {
 			continue;
 		}
 
-		IndexKey ik = E->key();
+		IndexKey ik = keys[i];
 
 		Vector3 cellpos = Vector3(ik.x, ik.y, ik.z);
 
 		Transform xform;
 
-		xform.basis.set_orthogonal_index(E->get().rot);
+		xform.basis.set_orthogonal_index(c.rot);
 
 		xform.set_origin(cellpos * cell_size + ofs);
 		xform.basis.scale(Vector3(cell_scale, cell_scale, cell_scale));
@@ -949,10 +1117,12 @@ void GridMap::make_baked_meshes(bool p_gen_lightmap_uv, float p_lightmap_uv_texe
 	//generate
 	Map<OctantKey, Map<Ref<Material>, Ref<SurfaceTool>>> surface_map;
 
-	for (Map<IndexKey, Cell>::Element *E = cell_map.front(); E; E = E->next()) {
-		IndexKey key = E->key();
+	Vector<IndexKey> keys = _get_used_cell_keys();
+	for (int k = 0; k < keys.size(); k++) {
+		IndexKey key = keys[k];
+		const Cell &c = *_get_cell(key);
 
-		int item = E->get().item;
+		int item = c.item;
 		if (!mesh_library->has_item(item)) {
 			continue;
 		}
@@ -967,7 +1137,7 @@ void GridMap::make_baked_meshes(bool p_gen_lightmap_uv, float p_lightmap_uv_texe
 
 		Transform xform;
 
-		xform.basis.set_orthogonal_index(E->get().rot);
+		xform.basis.set_orthogonal_index(c.rot);
 		xform.set_origin(cellpos * cell_size + ofs);
 		xform.basis.scale(Vector3(cell_scale, cell_scale, cell_scale));
 
@@ -1066,6 +1236,7 @@ GridMap::GridMap() {
 	navigation = nullptr;
 	set_notify_transform(true);
 	recreating_octants = false;
+	cell_count = 0;
 }
 
 GridMap::~GridMap() {
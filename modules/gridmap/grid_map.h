@@ -31,6 +31,8 @@
 #ifndef GRID_MAP_H
 #define GRID_MAP_H
 
+#include "core/oa_hash_map.h"
+#include "core/vset.h"
 #include "scene/3d/navigation_3d.h"
 #include "scene/3d/node_3d.h"
 #include "scene/resources/mesh_library.h"
@@ -59,9 +61,17 @@ class GridMap : public Node3D {
 			return key < p_key.key;
 		}
 
+		_FORCE_INLINE_ bool operator==(const IndexKey &p_key) const {
+			return key == p_key.key;
+		}
+
 		IndexKey() { key = 0; }
 	};
 
+	struct IndexKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const IndexKey &p_key) { return hash_one_uint64(p_key.key); }
+	};
+
 	/**
 	 * @brief A Cell is a single cell in the cube map space; it is defined by its coordinates and the populating Item, identified by int id.
 	 */
@@ -103,7 +113,7 @@ class GridMap : public Node3D {
 		};
 
 		Vector<MultimeshInstance> multimesh_instances;
-		Set<IndexKey> cells;
+		VSet<IndexKey> cells;
 		RID collision_debug;
 		RID collision_debug_instance;
 
@@ -126,10 +136,18 @@ class GridMap : public Node3D {
 			return key < p_key.key;
 		}
 
+		_FORCE_INLINE_ bool operator==(const OctantKey &p_key) const {
+			return key == p_key.key;
+		}
+
 		//OctantKey(const IndexKey& p_k, int p_item) { indexkey=p_k.key; item=p_item; }
 		OctantKey() { key = 0; }
 	};
 
+	struct OctantKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const OctantKey &p_key) { return hash_one_uint64(p_key.key); }
+	};
+
 	uint32_t collision_layer;
 	uint32_t collision_mask;
 
@@ -152,8 +170,46 @@ class GridMap : public Node3D {
 
 	Ref<MeshLibrary> mesh_library;
 
-	Map<OctantKey, Octant *> octant_map;
-	Map<IndexKey, Cell> cell_map;
+	OAHashMap<OctantKey, Octant *, OctantKeyHasher> octant_map;
+
+	enum {
+		CELL_CHUNK_SHIFT = 3,
+		CELL_CHUNK_SIZE = 1 << CELL_CHUNK_SHIFT,
+		CELL_CHUNK_MASK = CELL_CHUNK_SIZE - 1,
+		CELL_CHUNK_CELLS = CELL_CHUNK_SIZE * CELL_CHUNK_SIZE * CELL_CHUNK_SIZE,
+	};
+
+	// Cells are stored in dense cubic chunks, looked up by chunk position,
+	// instead of one tree node per cell.
+	struct CellChunk {
+		Cell cells[CELL_CHUNK_CELLS];
+		uint64_t used[CELL_CHUNK_CELLS / 64] = {};
+		int used_count = 0;
+
+		_FORCE_INLINE_ bool is_used(int p_index) const { return used[p_index >> 6] & (uint64_t(1) << (p_index & 63)); }
+	};
+
+	OAHashMap<IndexKey, CellChunk *, IndexKeyHasher> cell_chunks;
+	int cell_count;
+
+	_FORCE_INLINE_ static IndexKey _get_cell_chunk_key(const IndexKey &p_key) {
+		IndexKey ck;
+		ck.x = p_key.x >> CELL_CHUNK_SHIFT;
+		ck.y = p_key.y >> CELL_CHUNK_SHIFT;
+		ck.z = p_key.z >> CELL_CHUNK_SHIFT;
+		return ck;
+	}
+	_FORCE_INLINE_ static int _get_cell_chunk_index(const IndexKey &p_key) {
+		return ((p_key.z & CELL_CHUNK_MASK) << (CELL_CHUNK_SHIFT * 2)) | ((p_key.y & CELL_CHUNK_MASK) << CELL_CHUNK_SHIFT) | (p_key.x & CELL_CHUNK_MASK);
+	}
+
+	Octant *_create_octant(const OctantKey &p_key);
+
+	Cell *_get_cell(const IndexKey &p_key) const;
+	Cell *_insert_cell(const IndexKey &p_key);
+	void _erase_cell(const IndexKey &p_key);
+	void _clear_cells();
+	Vector<IndexKey> _get_used_cell_keys() const;
 
 	void _recreate_octant_data();
 
@@ -235,6 +291,7 @@ public:
 	bool get_center_z() const;
 
 	void set_cell_item(int p_x, int p_y, int p_z, int p_item, int p_rot = 0);
+	void set_cell_items(const Array &p_cells, int p_item, int p_rot = 0);
 	int get_cell_item(int p_x, int p_y, int p_z) const;
 	int get_cell_item_orientation(int p_x, int p_y, int p_z) const;
 
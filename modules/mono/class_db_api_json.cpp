@@ -65,17 +65,15 @@ void class_db_api_to_json(const String &p_output_file, ClassDB::APIType p_api) {
 
 			List<StringName> snames;
 
-			k = nullptr;
-
-			while ((k = t->method_map.next(k))) {
-				String name = k->operator String();
+			for (OAHashMap<StringName, MethodBind *>::Iterator it = t->method_map.iter(); it.valid; it = t->method_map.next_iter(it)) {
+				String name = it.key->operator String();
 
 				ERR_CONTINUE(name.empty());
 
 				if (name[0] == '_')
 					continue; // Ignore non-virtual methods that start with an underscore
 
-				snames.push_back(*k);
+				snames.push_back(*it.key);
 			}
 
 			snames.sort_custom<StringName::AlphCompare>();
@@ -86,7 +84,7 @@ void class_db_api_to_json(const String &p_output_file, ClassDB::APIType p_api) {
 				Dictionary method_dict;
 				methods.push_back(method_dict);
 
-				MethodBind *mb = t->method_map[F->get()];
+				MethodBind *mb = *t->method_map.lookup_ptr(F->get());
 				method_dict["name"] = mb->get_name();
 				method_dict["argument_count"] = mb->get_argument_count();
 				method_dict["return_type"] = mb->get_argument_type(-1);
@@ -191,10 +189,8 @@ void class_db_api_to_json(const String &p_output_file, ClassDB::APIType p_api) {
 
 			List<StringName> snames;
 
-			k = nullptr;
-
-			while ((k = t->property_setget.next(k))) {
-				snames.push_back(*k);
+			for (OAHashMap<StringName, ClassDB::PropertySetGet>::Iterator it = t->property_setget.iter(); it.valid; it = t->property_setget.next_iter(it)) {
+				snames.push_back(*it.key);
 			}
 
 			snames.sort_custom<StringName::AlphCompare>();
@@ -205,7 +201,7 @@ void class_db_api_to_json(const String &p_output_file, ClassDB::APIType p_api) {
 				Dictionary property_dict;
 				properties.push_back(property_dict);
 
-				ClassDB::PropertySetGet *psg = t->property_setget.getptr(F->get());
+				ClassDB::PropertySetGet *psg = t->property_setget.lookup_ptr(F->get());
 
 				property_dict["name"] = F->get();
 				property_dict["setter"] = psg->setter;
@@ -1150,7 +1150,7 @@ void VisualScriptBuiltinFunc::exec_func(BuiltinFunc p_func, const Variant **p_in
 			PackedByteArray barr;
 			int len;
 			bool full_objects = *p_inputs[1];
-			Error err = encode_variant(*p_inputs[0], nullptr, len, full_objects);
+			Error err = encode_variant(*p_inputs[0], barr, len, full_objects);
 			if (err) {
 				r_error.error = Callable::CallError::CALL_ERROR_INVALID_ARGUMENT;
 				r_error.argument = 0;
@@ -1160,10 +1160,6 @@ void VisualScriptBuiltinFunc::exec_func(BuiltinFunc p_func, const Variant **p_in
 			}
 
 			barr.resize(len);
-			{
-				uint8_t *w = barr.ptrw();
-				encode_variant(*p_inputs[0], w, len, full_objects);
-			}
 			*r_return = barr;
 		} break;
 		case VisualScriptBuiltinFunc::BYTES_TO_VAR: {
@@ -723,6 +723,8 @@ public:
 	VisualScriptFunctionCall *node;
 	VisualScriptInstance *instance;
 
+	VariantCallCache call_cache;
+
 	//virtual int get_working_memory_size() const { return 0; }
 	//virtual bool is_output_port_unsequenced(int p_idx) const { return false; }
 	//virtual bool get_output_port_unsequenced(int p_idx,Variant* r_value,Variant* p_working_mem,String &r_error) const { return true; }
@@ -764,9 +766,9 @@ public:
 				if (rpc_mode) {
 					call_rpc(object, p_inputs, input_args);
 				} else if (returns) {
-					*p_outputs[0] = object->call(function, p_inputs, input_args, r_error);
+					*p_outputs[0] = object->call_cached(function, p_inputs, input_args, r_error, call_cache);
 				} else {
-					object->call(function, p_inputs, input_args, r_error);
+					object->call_cached(function, p_inputs, input_args, r_error, call_cache);
 				}
 			} break;
 			case VisualScriptFunctionCall::CALL_MODE_NODE_PATH: {
@@ -787,9 +789,9 @@ public:
 				if (rpc_mode) {
 					call_rpc(node, p_inputs, input_args);
 				} else if (returns) {
-					*p_outputs[0] = another->call(function, p_inputs, input_args, r_error);
+					*p_outputs[0] = another->call_cached(function, p_inputs, input_args, r_error, call_cache);
 				} else {
-					another->call(function, p_inputs, input_args, r_error);
+					another->call_cached(function, p_inputs, input_args, r_error, call_cache);
 				}
 
 			} break;
@@ -805,19 +807,19 @@ public:
 				} else if (returns) {
 					if (call_mode == VisualScriptFunctionCall::CALL_MODE_INSTANCE) {
 						if (returns >= 2) {
-							*p_outputs[1] = v.call(function, p_inputs + 1, input_args, r_error);
+							v.call_ptr(function, p_inputs + 1, input_args, p_outputs[1], r_error, &call_cache);
 						} else if (returns == 1) {
-							v.call(function, p_inputs + 1, input_args, r_error);
+							v.call_ptr(function, p_inputs + 1, input_args, nullptr, r_error, &call_cache);
 						} else {
 							r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
 							r_error_str = "Invalid returns count for call_mode == CALL_MODE_INSTANCE";
 							return 0;
 						}
 					} else {
-						*p_outputs[0] = v.call(function, p_inputs + 1, input_args, r_error);
+						v.call_ptr(function, p_inputs + 1, input_args, p_outputs[0], r_error, &call_cache);
 					}
 				} else {
-					v.call(function, p_inputs + 1, input_args, r_error);
+					v.call_ptr(function, p_inputs + 1, input_args, nullptr, r_error, &call_cache);
 				}
 
 				if (call_mode == VisualScriptFunctionCall::CALL_MODE_INSTANCE) {
@@ -836,9 +838,9 @@ public:
 				if (rpc_mode) {
 					call_rpc(object, p_inputs, input_args);
 				} else if (returns) {
-					*p_outputs[0] = object->call(function, p_inputs, input_args, r_error);
+					*p_outputs[0] = object->call_cached(function, p_inputs, input_args, r_error, call_cache);
 				} else {
-					object->call(function, p_inputs, input_args, r_error);
+					object->call_cached(function, p_inputs, input_args, r_error, call_cache);
 				}
 			} break;
 		}
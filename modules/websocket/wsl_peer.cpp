@@ -68,11 +68,26 @@ void WSLPeer::_wsl_destroy(struct PeerData **p_data) {
 		data->destroy = true;
 		return;
 	}
+	if (data->is_server) {
+		// A failed send disables writing, so the peer would never be polled
+		// again once its socket is closed. Let the server remove it.
+		WSLServer *helper = (WSLServer *)data->obj;
+		helper->_on_peer_destroyed(data->id);
+	}
 	wslay_event_context_free(data->ctx);
 	memdelete(data);
 	*p_data = nullptr;
 }
 
+void WSLPeer::_wsl_notify_write_pending(struct PeerData *p_data) {
+	// The server only polls peers with socket activity, so it must be told
+	// about output that could not be flushed right away.
+	if (p_data->is_server && wslay_event_want_write(p_data->ctx)) {
+		WSLServer *helper = (WSLServer *)p_data->obj;
+		helper->_on_peer_write_pending(p_data->id);
+	}
+}
+
 bool WSLPeer::_wsl_poll(struct PeerData *p_data) {
 	p_data->polling = true;
 	int err = 0;
@@ -250,6 +265,7 @@ Error WSLPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
 		close_now();
 		return FAILED;
 	}
+	_wsl_notify_write_pending(_data);
 	return OK;
 }
 
@@ -288,6 +304,10 @@ bool WSLPeer::is_connected_to_host() const {
 	return _data != nullptr;
 }
 
+bool WSLPeer::wants_write() const {
+	return _data && wslay_event_want_write(_data->ctx);
+}
+
 void WSLPeer::close_now() {
 	close(1000, "");
 	_wsl_destroy(&_data);
@@ -299,6 +319,7 @@ void WSLPeer::close(int p_code, String p_reason) {
 		wslay_event_queue_close(_data->ctx, p_code, (uint8_t *)cs.ptr(), cs.size());
 		wslay_event_send(_data->ctx);
 		_data->closing = true;
+		_wsl_notify_write_pending(_data);
 	}
 
 	_in_buffer.clear();
@@ -79,6 +79,7 @@ public:
 private:
 	static bool _wsl_poll(struct PeerData *p_data);
 	static void _wsl_destroy(struct PeerData **p_data);
+	static void _wsl_notify_write_pending(struct PeerData *p_data);
 
 	struct PeerData *_data;
 	uint8_t _is_string;
@@ -100,6 +101,7 @@ public:
 	virtual int get_max_packet_size() const { return _packet_buffer.size(); };
 
 	virtual void close_now();
+	bool wants_write() const;
 	virtual void close(int p_code = 1000, String p_reason = "");
 	virtual bool is_connected_to_host() const;
 	virtual IP_Address get_connected_host() const;
@@ -179,18 +179,85 @@ Error WSLServer::listen(int p_port, const Vector<String> p_protocols, bool gd_mp
 	return _server->listen(p_port, bind_ip);
 }
 
+void WSLServer::_add_polled_peer(int p_id, const Ref<StreamPeerTCP> &p_tcp, bool p_use_ssl) {
+	if (_poller.is_null()) {
+		return;
+	}
+	// SSL can buffer decrypted data the socket does not report as readable.
+	if (p_use_ssl || _poller->add_socket(p_id, p_tcp->get_socket(), NetSocket::POLL_TYPE_IN) != OK) {
+		_poll_always.insert(p_id);
+	}
+}
+
+void WSLServer::_poll_peer(int p_id, List<int> &r_remove_ids) {
+	Map<int, Ref<WebSocketPeer>>::Element *E = _peer_map.find(p_id);
+	if (!E) {
+		_poll_always.erase(p_id);
+		return;
+	}
+
+	Ref<WSLPeer> peer = (WSLPeer *)E->get().ptr();
+	peer->poll();
+	if (!peer->is_connected_to_host()) {
+		_on_disconnect(p_id, peer->close_code != -1);
+		r_remove_ids.push_back(p_id);
+		return;
+	}
+
+	if (_poller.is_valid() && _poller->has_socket(p_id)) {
+		// Polling itself can queue output (pong and close replies) without
+		// going through _on_peer_write_pending(), so check again.
+		if (peer->wants_write()) {
+			_poll_always.insert(p_id);
+		} else {
+			_poll_always.erase(p_id);
+		}
+	}
+}
+
+void WSLServer::_on_peer_write_pending(int32_t p_peer_id) {
+	if (_poller.is_valid()) {
+		_poll_always.insert(p_peer_id);
+	}
+}
+
+void WSLServer::_on_peer_destroyed(int32_t p_peer_id) {
+	if (_poller.is_valid()) {
+		// Unregister before the socket is closed, then poll the peer once more
+		// so it is removed and reported as disconnected.
+		_poller->remove_socket(p_peer_id);
+		_poll_always.insert(p_peer_id);
+	}
+}
+
 void WSLServer::poll() {
 	List<int> remove_ids;
-	for (Map<int, Ref<WebSocketPeer>>::Element *E = _peer_map.front(); E; E = E->next()) {
-		Ref<WSLPeer> peer = (WSLPeer *)E->get().ptr();
-		peer->poll();
-		if (!peer->is_connected_to_host()) {
-			_on_disconnect(E->key(), peer->close_code != -1);
-			remove_ids.push_back(E->key());
+	if (_poller.is_valid()) {
+		_poller->wait(_poll_events, 0);
+		for (uint32_t i = 0; i < _poll_events.size(); i++) {
+			int id = _poll_events[i].id;
+			if (!_poll_always.has(id)) {
+				_poll_peer(id, remove_ids);
+			}
+		}
+		Set<int>::Element *E = _poll_always.front();
+		while (E) {
+			// Polling may erase the current element.
+			Set<int>::Element *N = E->next();
+			_poll_peer(E->get(), remove_ids);
+			E = N;
+		}
+	} else {
+		for (Map<int, Ref<WebSocketPeer>>::Element *E = _peer_map.front(); E; E = E->next()) {
+			_poll_peer(E->key(), remove_ids);
 		}
 	}
 	for (List<int>::Element *E = remove_ids.front(); E; E = E->next()) {
 		_peer_map.erase(E->get());
+		if (_poller.is_valid()) {
+			_poller->remove_socket(E->get());
+			_poll_always.erase(E->get());
+		}
 	}
 	remove_ids.clear();
 
@@ -219,6 +286,7 @@ void WSLServer::poll() {
 		ws_peer->set_no_delay(true);
 
 		_peer_map[id] = ws_peer;
+		_add_polled_peer(id, ppeer->tcp, ppeer->use_ssl);
 		remove_peers.push_back(ppeer);
 		_on_connect(id, ppeer->protocol);
 	}
@@ -270,6 +338,10 @@ void WSLServer::stop() {
 	_pending.clear();
 	_peer_map.clear();
 	_protocols.clear();
+	_poll_always.clear();
+	if (_poller.is_valid()) {
+		_poller->clear();
+	}
 }
 
 bool WSLServer::has_peer(int p_id) const {
@@ -315,6 +387,7 @@ WSLServer::WSLServer() {
 	_out_buf_size = DEF_BUF_SHIFT;
 	_out_pkt_size = DEF_PKT_SHIFT;
 	_server.instance();
+	_poller = Ref<NetSocketPoller>(NetSocketPoller::create());
 }
 
 WSLServer::~WSLServer() {
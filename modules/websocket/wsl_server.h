@@ -78,6 +78,16 @@ private:
 	Ref<TCP_Server> _server;
 	Vector<String> _protocols;
 
+	// Established peers are registered with the poller, so each tick only
+	// touches the ones with pending I/O. Peers that cannot rely on socket
+	// readiness (SSL, unflushed output) are kept in _poll_always.
+	Ref<NetSocketPoller> _poller;
+	LocalVector<NetSocketPoller::Event> _poll_events;
+	Set<int> _poll_always;
+
+	void _add_polled_peer(int p_id, const Ref<StreamPeerTCP> &p_tcp, bool p_use_ssl);
+	void _poll_peer(int p_id, List<int> &r_remove_ids);
+
 public:
 	Error set_buffers(int p_in_buffer, int p_in_packets, int p_out_buffer, int p_out_packets);
 	Error listen(int p_port, const Vector<String> p_protocols = Vector<String>(), bool gd_mp_api = false);
@@ -91,6 +101,9 @@ public:
 	void disconnect_peer(int p_peer_id, int p_code = 1000, String p_reason = "");
 	virtual void poll();
 
+	void _on_peer_write_pending(int32_t p_peer_id);
+	void _on_peer_destroyed(int32_t p_peer_id);
+
 	WSLServer();
 	~WSLServer();
 };
@@ -69,6 +69,7 @@ Variant JavaClass::call(const StringName &, const Variant **, int, Callable::Cal
 }
 
 JavaClass::JavaClass() {
+	_overrides_call = true;
 }
 
 Variant JavaObject::call(const StringName &, const Variant **, int, Callable::CallError &) {
@@ -214,6 +214,7 @@ public:
 #endif
 
 	JNISingleton() {
+		_overrides_call = true;
 #ifdef ANDROID_ENABLED
 		instance = nullptr;
 #endif
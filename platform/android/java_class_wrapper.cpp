@@ -491,6 +491,7 @@ Variant JavaClass::call(const StringName &p_method, const Variant **p_args, int
 }
 
 JavaClass::JavaClass() {
+	_overrides_call = true;
 }
 
 /////////////////////
@@ -500,6 +501,7 @@ Variant JavaObject::call(const StringName &p_method, const Variant **p_args, int
 }
 
 JavaObject::JavaObject(const Ref<JavaClass> &p_base, jobject *p_instance) {
+	_overrides_call = true;
 }
 
 JavaObject::~JavaObject() {
@@ -76,8 +76,8 @@ void TileMap::_notification(int p_what) {
 
 		case NOTIFICATION_EXIT_TREE: {
 			_update_quadrant_space(RID());
-			for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
-				Quadrant &q = E->get();
+			for (OAHashMap<PosKey, Quadrant *, PosKeyHasher>::Iterator it = quadrant_map.iter(); it.valid; it = quadrant_map.next_iter(it)) {
+				Quadrant &q = **it.value;
 				if (navigation) {
 					for (Map<PosKey, Quadrant::NavPoly>::Element *F = q.navpoly_ids.front(); F; F = F->next()) {
 						NavigationServer2D::get_singleton()->region_set_map(F->get().region, RID());
@@ -117,8 +117,8 @@ void TileMap::_notification(int p_what) {
 
 void TileMap::_update_quadrant_space(const RID &p_space) {
 	if (!use_parent) {
-		for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
-			Quadrant &q = E->get();
+		for (OAHashMap<PosKey, Quadrant *, PosKeyHasher>::Iterator it = quadrant_map.iter(); it.valid; it = quadrant_map.next_iter(it)) {
+			Quadrant &q = **it.value;
 			PhysicsServer2D::get_singleton()->body_set_space(q.body, p_space);
 		}
 	}
@@ -141,8 +141,8 @@ void TileMap::_update_quadrant_transform() {
 		nav_rel = get_relative_transform_to_parent(navigation);
 	}
 
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
-		Quadrant &q = E->get();
+	for (OAHashMap<PosKey, Quadrant *, PosKeyHasher>::Iterator it = quadrant_map.iter(); it.valid; it = quadrant_map.next_iter(it)) {
+		Quadrant &q = **it.value;
 		Transform2D xform;
 		xform.set_origin(q.pos);
 
@@ -372,8 +372,10 @@ void TileMap::update_dirty_quadrants() {
 		RID prev_debug_canvas_item;
 
 		for (int i = 0; i < q.cells.size(); i++) {
-			Map<PosKey, Cell>::Element *E = tile_map.find(q.cells[i]);
-			Cell &c = E->get();
+			const PosKey &pk = q.cells[i];
+			Cell *cell = _get_cell(pk);
+			ERR_CONTINUE(!cell);
+			Cell &c = *cell;
 			//moment of truth
 			if (!tile_set->has_tile(c.id)) {
 				continue;
@@ -381,7 +383,7 @@ void TileMap::update_dirty_quadrants() {
 			Ref<Texture2D> tex = tile_set->tile_get_texture(c.id);
 			Vector2 tile_ofs = tile_set->tile_get_texture_offset(c.id);
 
-			Vector2 wofs = _map_to_world(E->key().x, E->key().y);
+			Vector2 wofs = _map_to_world(pk.x, pk.y);
 			Vector2 offset = wofs - q.pos + tofs;
 
 			if (!tex.is_valid()) {
@@ -562,7 +564,7 @@ void TileMap::update_dirty_quadrants() {
 							for (int k = 0; k < _shapes.size(); k++) {
 								Ref<ConvexPolygonShape2D> convex = _shapes[k];
 								if (convex.is_valid()) {
-									_add_shape(shape_idx, q, convex, shapes[j], xform, Vector2(E->key().x, E->key().y));
+									_add_shape(shape_idx, q, convex, shapes[j], xform, Vector2(pk.x, pk.y));
 #ifdef DEBUG_ENABLED
 								} else {
 									print_error("The TileSet assigned to the TileMap " + get_name() + " has an invalid convex shape.");
@@ -570,7 +572,7 @@ void TileMap::update_dirty_quadrants() {
 								}
 							}
 						} else {
-							_add_shape(shape_idx, q, shape, shapes[j], xform, Vector2(E->key().x, E->key().y));
+							_add_shape(shape_idx, q, shape, shapes[j], xform, Vector2(pk.x, pk.y));
 						}
 					}
 				}
@@ -604,7 +606,7 @@ void TileMap::update_dirty_quadrants() {
 					Quadrant::NavPoly np;
 					np.region = region;
 					np.xform = xform;
-					q.navpoly_ids[E->key()] = np;
+					q.navpoly_ids[pk] = np;
 
 					if (debug_navigation) {
 						RID debug_navigation_item = vs->canvas_item_create();
@@ -675,7 +677,7 @@ void TileMap::update_dirty_quadrants() {
 				Quadrant::Occluder oc;
 				oc.xform = xform;
 				oc.id = orid;
-				q.occluder_instances[E->key()] = oc;
+				q.occluder_instances[pk] = oc;
 			}
 		}
 
@@ -686,9 +688,18 @@ void TileMap::update_dirty_quadrants() {
 	pending_update = false;
 
 	if (quadrant_order_dirty) {
+		// Draw the quadrants in key order, regardless of the hash map layout.
+		Vector<Quadrant *> quadrants;
+		quadrants.resize(quadrant_map.get_num_elements());
+		int quadrant_count = 0;
+		for (OAHashMap<PosKey, Quadrant *, PosKeyHasher>::Iterator it = quadrant_map.iter(); it.valid; it = quadrant_map.next_iter(it)) {
+			quadrants.write[quadrant_count++] = *it.value;
+		}
+		quadrants.sort_custom<QuadrantKeySort>();
+
 		int index = -(int64_t)0x80000000; //always must be drawn below children
-		for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
-			Quadrant &q = E->get();
+		for (int i = 0; i < quadrant_count; i++) {
+			Quadrant &q = *quadrants[i];
 			for (List<RID>::Element *F = q.canvas_items.front(); F; F = F->next()) {
 				RS::get_singleton()->canvas_item_set_draw_index(F->get(), index++);
 			}
@@ -708,14 +719,17 @@ void TileMap::_recompute_rect_cache() {
 	}
 
 	Rect2 r_total;
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+	bool first = true;
+	for (OAHashMap<PosKey, Quadrant *, PosKeyHasher>::Iterator it = quadrant_map.iter(); it.valid; it = quadrant_map.next_iter(it)) {
+		const PosKey &qk = *it.key;
 		Rect2 r;
-		r.position = _map_to_world(E->key().x * _get_quadrant_size(), E->key().y * _get_quadrant_size());
-		r.expand_to(_map_to_world(E->key().x * _get_quadrant_size() + _get_quadrant_size(), E->key().y * _get_quadrant_size()));
-		r.expand_to(_map_to_world(E->key().x * _get_quadrant_size() + _get_quadrant_size(), E->key().y * _get_quadrant_size() + _get_quadrant_size()));
-		r.expand_to(_map_to_world(E->key().x * _get_quadrant_size(), E->key().y * _get_quadrant_size() + _get_quadrant_size()));
-		if (E == quadrant_map.front()) {
+		r.position = _map_to_world(qk.x * _get_quadrant_size(), qk.y * _get_quadrant_size());
+		r.expand_to(_map_to_world(qk.x * _get_quadrant_size() + _get_quadrant_size(), qk.y * _get_quadrant_size()));
+		r.expand_to(_map_to_world(qk.x * _get_quadrant_size() + _get_quadrant_size(), qk.y * _get_quadrant_size() + _get_quadrant_size()));
+		r.expand_to(_map_to_world(qk.x * _get_quadrant_size(), qk.y * _get_quadrant_size() + _get_quadrant_size()));
+		if (first) {
 			r_total = r;
+			first = false;
 		} else {
 			r_total = r_total.merge(r);
 		}
@@ -729,10 +743,104 @@ void TileMap::_recompute_rect_cache() {
 #endif
 }
 
-Map<TileMap::PosKey, TileMap::Quadrant>::Element *TileMap::_create_quadrant(const PosKey &p_qk) {
+TileMap::Cell *TileMap::_get_cell(const PosKey &p_pos) const {
+	CellChunk **chunk = cell_chunks.lookup_ptr(_get_cell_chunk_key(p_pos));
+	if (!chunk) {
+		return nullptr;
+	}
+
+	int index = _get_cell_chunk_index(p_pos);
+	if (!(*chunk)->is_used(index)) {
+		return nullptr;
+	}
+	return &(*chunk)->cells[index];
+}
+
+TileMap::Cell *TileMap::_insert_cell(const PosKey &p_pos) {
+	PosKey ck = _get_cell_chunk_key(p_pos);
+	CellChunk **chunk_ptr = cell_chunks.lookup_ptr(ck);
+	CellChunk *chunk;
+	if (chunk_ptr) {
+		chunk = *chunk_ptr;
+	} else {
+		chunk = memnew(CellChunk);
+		cell_chunks.insert(ck, chunk);
+	}
+
+	int index = _get_cell_chunk_index(p_pos);
+	if (!chunk->is_used(index)) {
+		chunk->used[index >> 6] |= uint64_t(1) << (index & 63);
+		chunk->used_count++;
+		chunk->cells[index] = Cell();
+		cell_count++;
+	}
+	return &chunk->cells[index];
+}
+
+void TileMap::_erase_cell(const PosKey &p_pos) {
+	PosKey ck = _get_cell_chunk_key(p_pos);
+	CellChunk **chunk_ptr = cell_chunks.lookup_ptr(ck);
+	if (!chunk_ptr) {
+		return;
+	}
+
+	CellChunk *chunk = *chunk_ptr;
+	int index = _get_cell_chunk_index(p_pos);
+	if (!chunk->is_used(index)) {
+		return;
+	}
+
+	chunk->used[index >> 6] &= ~(uint64_t(1) << (index & 63));
+	chunk->used_count--;
+	cell_count--;
+
+	if (chunk->used_count == 0) {
+		cell_chunks.remove(ck);
+		memdelete(chunk);
+	}
+}
+
+void TileMap::_clear_cells() {
+	for (OAHashMap<PosKey, CellChunk *, PosKeyHasher>::Iterator it = cell_chunks.iter(); it.valid; it = cell_chunks.next_iter(it)) {
+		memdelete(*it.value);
+	}
+	cell_chunks.clear();
+	cell_count = 0;
+}
+
+Vector<TileMap::PosKey> TileMap::_get_used_cell_keys() const {
+	// Chunks are visited in sorted order, so the result does not depend on the
+	// hash map layout (keeps saved tile data stable).
+	Vector<PosKey> chunk_keys;
+	chunk_keys.resize(cell_chunks.get_num_elements());
+	int chunk_count = 0;
+	for (OAHashMap<PosKey, CellChunk *, PosKeyHasher>::Iterator it = cell_chunks.iter(); it.valid; it = cell_chunks.next_iter(it)) {
+		chunk_keys.write[chunk_count++] = *it.key;
+	}
+	chunk_keys.sort();
+
+	Vector<PosKey> cells;
+	cells.resize(cell_count);
+	PosKey *w = cells.ptrw();
+	int idx = 0;
+	for (int i = 0; i < chunk_count; i++) {
+		const CellChunk *chunk = *cell_chunks.lookup_ptr(chunk_keys[i]);
+		for (int j = 0; j < CELL_CHUNK_CELLS; j++) {
+			if (chunk->is_used(j)) {
+				w[idx++] = PosKey(chunk_keys[i].x * CELL_CHUNK_SIZE + (j & CELL_CHUNK_MASK), chunk_keys[i].y * CELL_CHUNK_SIZE + (j >> CELL_CHUNK_SHIFT));
+			}
+		}
+	}
+
+	return cells;
+}
+
+TileMap::Quadrant *TileMap::_create_quadrant(const PosKey &p_qk) {
 	Transform2D xform;
 	//xform.set_origin(Point2(p_qk.x,p_qk.y)*cell_size*quadrant_size);
-	Quadrant q;
+	Quadrant *Q = memnew(Quadrant);
+	Quadrant &q = *Q;
+	q.key = p_qk;
 	q.pos = _map_to_world(p_qk.x * _get_quadrant_size(), p_qk.y * _get_quadrant_size());
 	q.pos += get_cell_draw_offset();
 	if (tile_origin == TILE_ORIGIN_CENTER) {
@@ -769,11 +877,12 @@ Map<TileMap::PosKey, TileMap::Quadrant>::Element *TileMap::_create_quadrant(cons
 
 	rect_cache_dirty = true;
 	quadrant_order_dirty = true;
-	return quadrant_map.insert(p_qk, q);
+	quadrant_map.insert(p_qk, Q);
+	return Q;
 }
 
-void TileMap::_erase_quadrant(Map<PosKey, Quadrant>::Element *Q) {
-	Quadrant &q = Q->get();
+void TileMap::_erase_quadrant(Quadrant *Q) {
+	Quadrant &q = *Q;
 	if (!use_parent) {
 		PhysicsServer2D::get_singleton()->free(q.body);
 	} else if (collision_parent) {
@@ -800,12 +909,13 @@ void TileMap::_erase_quadrant(Map<PosKey, Quadrant>::Element *Q) {
 	}
 	q.occluder_instances.clear();
 
-	quadrant_map.erase(Q);
+	quadrant_map.remove(q.key);
+	memdelete(Q);
 	rect_cache_dirty = true;
 }
 
-void TileMap::_make_quadrant_dirty(Map<PosKey, Quadrant>::Element *Q, bool update) {
-	Quadrant &q = Q->get();
+void TileMap::_make_quadrant_dirty(Quadrant *Q, bool update) {
+	Quadrant &q = *Q;
 	if (!q.dirty_list.in_list()) {
 		dirty_quadrant_list.add(&q.dirty_list);
 	}
@@ -837,7 +947,7 @@ void TileMap::_set_celld(const Vector2 &p_pos, const Dictionary &p_data) {
 void TileMap::set_cell(int p_x, int p_y, int p_tile, bool p_flip_x, bool p_flip_y, bool p_transpose, Vector2 p_autotile_coord) {
 	PosKey pk(p_x, p_y);
 
-	Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	Cell *E = _get_cell(pk);
 	if (!E && p_tile == INVALID_CELL) {
 		return; //nothing to do
 	}
@@ -845,10 +955,10 @@ void TileMap::set_cell(int p_x, int p_y, int p_tile, bool p_flip_x, bool p_flip_
 	PosKey qk = pk.to_quadrant(_get_quadrant_size());
 	if (p_tile == INVALID_CELL) {
 		//erase existing
-		tile_map.erase(pk);
-		Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
+		_erase_cell(pk);
+		Quadrant *Q = _get_quadrant(qk);
 		ERR_FAIL_COND(!Q);
-		Quadrant &q = Q->get();
+		Quadrant &q = *Q;
 		q.cells.erase(pk);
 		if (q.cells.size() == 0) {
 			_erase_quadrant(Q);
@@ -860,24 +970,23 @@ void TileMap::set_cell(int p_x, int p_y, int p_tile, bool p_flip_x, bool p_flip_
 		return;
 	}
 
-	Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
+	Quadrant *Q = _get_quadrant(qk);
 
 	if (!E) {
-		E = tile_map.insert(pk, Cell());
+		E = _insert_cell(pk);
 		if (!Q) {
 			Q = _create_quadrant(qk);
 		}
-		Quadrant &q = Q->get();
-		q.cells.insert(pk);
+		Q->cells.insert(pk);
 	} else {
 		ERR_FAIL_COND(!Q); // quadrant should exist...
 
-		if (E->get().id == p_tile && E->get().flip_h == p_flip_x && E->get().flip_v == p_flip_y && E->get().transpose == p_transpose && E->get().autotile_coord_x == (uint16_t)p_autotile_coord.x && E->get().autotile_coord_y == (uint16_t)p_autotile_coord.y) {
+		if (E->id == p_tile && E->flip_h == p_flip_x && E->flip_v == p_flip_y && E->transpose == p_transpose && E->autotile_coord_x == (uint16_t)p_autotile_coord.x && E->autotile_coord_y == (uint16_t)p_autotile_coord.y) {
 			return; //nothing changed
 		}
 	}
 
-	Cell &c = E->get();
+	Cell &c = *E;
 
 	c.id = p_tile;
 	c.flip_h = p_flip_x;
@@ -890,6 +999,63 @@ void TileMap::set_cell(int p_x, int p_y, int p_tile, bool p_flip_x, bool p_flip_
 	used_size_cache_dirty = true;
 }
 
+void TileMap::set_cells(const TypedArray<Vector2i> &p_cells, int p_tile, bool p_flip_x, bool p_flip_y, bool p_transpose, Vector2 p_autotile_coord) {
+	if (p_tile == INVALID_CELL) {
+		// Erasing may free quadrants, so it goes through set_cell().
+		for (int i = 0; i < p_cells.size(); i++) {
+			Vector2i pos = p_cells[i];
+			set_cell(pos.x, pos.y, p_tile, p_flip_x, p_flip_y, p_transpose, p_autotile_coord);
+		}
+		return;
+	}
+
+	int quadrant_size = _get_quadrant_size();
+	uint16_t autotile_coord_x = (uint16_t)p_autotile_coord.x;
+	uint16_t autotile_coord_y = (uint16_t)p_autotile_coord.y;
+
+	// Neighbouring cells usually share a quadrant, so it is only looked up
+	// again when the quadrant changes.
+	Quadrant *Q = nullptr;
+	PosKey last_qk;
+	bool has_last_qk = false;
+
+	for (int i = 0; i < p_cells.size(); i++) {
+		Vector2i pos = p_cells[i];
+		PosKey pk(pos.x, pos.y);
+		PosKey qk = pk.to_quadrant(quadrant_size);
+		if (!has_last_qk || !(qk == last_qk)) {
+			Q = _get_quadrant(qk);
+			last_qk = qk;
+			has_last_qk = true;
+		}
+
+		Cell *E = _get_cell(pk);
+		if (!E) {
+			E = _insert_cell(pk);
+			if (!Q) {
+				Q = _create_quadrant(qk);
+			}
+			Q->cells.insert(pk);
+		} else {
+			ERR_CONTINUE(!Q); // quadrant should exist...
+
+			if (E->id == p_tile && E->flip_h == p_flip_x && E->flip_v == p_flip_y && E->transpose == p_transpose && E->autotile_coord_x == autotile_coord_x && E->autotile_coord_y == autotile_coord_y) {
+				continue; //nothing changed
+			}
+		}
+
+		E->id = p_tile;
+		E->flip_h = p_flip_x;
+		E->flip_v = p_flip_y;
+		E->transpose = p_transpose;
+		E->autotile_coord_x = autotile_coord_x;
+		E->autotile_coord_y = autotile_coord_y;
+
+		_make_quadrant_dirty(Q);
+		used_size_cache_dirty = true;
+	}
+}
+
 int TileMap::get_cellv(const Vector2 &p_pos) const {
 	return get_cell(p_pos.x, p_pos.y);
 }
@@ -932,7 +1098,7 @@ void TileMap::update_bitmask_region(const Vector2 &p_start, const Vector2 &p_end
 void TileMap::update_cell_bitmask(int p_x, int p_y) {
 	ERR_FAIL_COND_MSG(tile_set.is_null(), "Cannot update cell bitmask if Tileset is not open.");
 	PosKey p(p_x, p_y);
-	Map<PosKey, Cell>::Element *E = tile_map.find(p);
+	Cell *E = _get_cell(p);
 	if (E != nullptr) {
 		int id = get_cell(p_x, p_y);
 		if (tile_set->tile_get_tile_mode(id) == TileSet::AUTO_TILE) {
@@ -993,22 +1159,22 @@ void TileMap::update_cell_bitmask(int p_x, int p_y) {
 				}
 			}
 			Vector2 coord = tile_set->autotile_get_subtile_for_bitmask(id, mask, this, Vector2(p_x, p_y));
-			E->get().autotile_coord_x = (int)coord.x;
-			E->get().autotile_coord_y = (int)coord.y;
+			E->autotile_coord_x = (int)coord.x;
+			E->autotile_coord_y = (int)coord.y;
 
 			PosKey qk = p.to_quadrant(_get_quadrant_size());
-			Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
+			Quadrant *Q = _get_quadrant(qk);
 			_make_quadrant_dirty(Q);
 
 		} else if (tile_set->tile_get_tile_mode(id) == TileSet::SINGLE_TILE) {
-			E->get().autotile_coord_x = 0;
-			E->get().autotile_coord_y = 0;
+			E->autotile_coord_x = 0;
+			E->autotile_coord_y = 0;
 		} else if (tile_set->tile_get_tile_mode(id) == TileSet::ATLAS_TILE) {
 			if (tile_set->autotile_get_bitmask(id, Vector2(p_x, p_y)) == TileSet::BIND_CENTER) {
 				Vector2 coord = tile_set->atlastile_get_subtile_by_priority(id, this, Vector2(p_x, p_y));
 
-				E->get().autotile_coord_x = (int)coord.x;
-				E->get().autotile_coord_y = (int)coord.y;
+				E->autotile_coord_x = (int)coord.x;
+				E->autotile_coord_y = (int)coord.y;
 			}
 		}
 	}
@@ -1023,9 +1189,10 @@ void TileMap::update_dirty_bitmask() {
 
 void TileMap::fix_invalid_tiles() {
 	ERR_FAIL_COND_MSG(tile_set.is_null(), "Cannot fix invalid tiles if Tileset is not open.");
-	for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
-		if (!tile_set->has_tile(get_cell(E->key().x, E->key().y))) {
-			set_cell(E->key().x, E->key().y, INVALID_CELL);
+	Vector<PosKey> cells = _get_used_cell_keys();
+	for (int i = 0; i < cells.size(); i++) {
+		if (!tile_set->has_tile(get_cell(cells[i].x, cells[i].y))) {
+			set_cell(cells[i].x, cells[i].y, INVALID_CELL);
 		}
 	}
 }
@@ -1033,67 +1200,65 @@ void TileMap::fix_invalid_tiles() {
 int TileMap::get_cell(int p_x, int p_y) const {
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *E = _get_cell(pk);
 
 	if (!E) {
 		return INVALID_CELL;
 	}
 
-	return E->get().id;
+	return E->id;
 }
 
 bool TileMap::is_cell_x_flipped(int p_x, int p_y) const {
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *E = _get_cell(pk);
 
 	if (!E) {
 		return false;
 	}
 
-	return E->get().flip_h;
+	return E->flip_h;
 }
 
 bool TileMap::is_cell_y_flipped(int p_x, int p_y) const {
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *E = _get_cell(pk);
 
 	if (!E) {
 		return false;
 	}
 
-	return E->get().flip_v;
+	return E->flip_v;
 }
 
 bool TileMap::is_cell_transposed(int p_x, int p_y) const {
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *E = _get_cell(pk);
 
 	if (!E) {
 		return false;
 	}
 
-	return E->get().transpose;
+	return E->transpose;
 }
 
 void TileMap::set_cell_autotile_coord(int p_x, int p_y, const Vector2 &p_coord) {
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	Cell *E = _get_cell(pk);
 
 	if (!E) {
 		return;
 	}
 
-	Cell c = E->get();
-	c.autotile_coord_x = p_coord.x;
-	c.autotile_coord_y = p_coord.y;
-	tile_map[pk] = c;
+	E->autotile_coord_x = p_coord.x;
+	E->autotile_coord_y = p_coord.y;
 
 	PosKey qk = pk.to_quadrant(_get_quadrant_size());
-	Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
+	Quadrant *Q = _get_quadrant(qk);
 
 	if (!Q) {
 		return;
@@ -1105,36 +1270,44 @@ void TileMap::set_cell_autotile_coord(int p_x, int p_y, const Vector2 &p_coord)
 Vector2 TileMap::get_cell_autotile_coord(int p_x, int p_y) const {
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *E = _get_cell(pk);
 
 	if (!E) {
 		return Vector2();
 	}
 
-	return Vector2(E->get().autotile_coord_x, E->get().autotile_coord_y);
+	return Vector2(E->autotile_coord_x, E->autotile_coord_y);
 }
 
 void TileMap::_recreate_quadrants() {
 	_clear_quadrants();
 
-	for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
-		PosKey qk = PosKey(E->key().x, E->key().y).to_quadrant(_get_quadrant_size());
+	Vector<PosKey> cells = _get_used_cell_keys();
+	for (int i = 0; i < cells.size(); i++) {
+		PosKey qk = cells[i].to_quadrant(_get_quadrant_size());
 
-		Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
+		Quadrant *Q = _get_quadrant(qk);
 		if (!Q) {
 			Q = _create_quadrant(qk);
-			dirty_quadrant_list.add(&Q->get().dirty_list);
+			dirty_quadrant_list.add(&Q->dirty_list);
 		}
 
-		Q->get().cells.insert(E->key());
+		Q->cells.insert(cells[i]);
 		_make_quadrant_dirty(Q, false);
 	}
 	update_dirty_quadrants();
 }
 
 void TileMap::_clear_quadrants() {
-	while (quadrant_map.size()) {
-		_erase_quadrant(quadrant_map.front());
+	// Erasing removes the quadrants from the hash map, so collect them first.
+	Vector<Quadrant *> quadrants;
+	quadrants.resize(quadrant_map.get_num_elements());
+	int quadrant_count = 0;
+	for (OAHashMap<PosKey, Quadrant *, PosKeyHasher>::Iterator it = quadrant_map.iter(); it.valid; it = quadrant_map.next_iter(it)) {
+		quadrants.write[quadrant_count++] = *it.value;
+	}
+	for (int i = 0; i < quadrant_count; i++) {
+		_erase_quadrant(quadrants[i]);
 	}
 }
 
@@ -1149,8 +1322,8 @@ void TileMap::set_use_parent_material(bool p_use_parent_material) {
 }
 
 void TileMap::_update_all_items_material_state() {
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
-		Quadrant &q = E->get();
+	for (OAHashMap<PosKey, Quadrant *, PosKeyHasher>::Iterator it = quadrant_map.iter(); it.valid; it = quadrant_map.next_iter(it)) {
+		Quadrant &q = **it.value;
 		for (List<RID>::Element *F = q.canvas_items.front(); F; F = F->next()) {
 			_update_item_material_state(F->get());
 		}
@@ -1163,7 +1336,7 @@ void TileMap::_update_item_material_state(const RID &p_canvas_item) {
 
 void TileMap::clear() {
 	_clear_quadrants();
-	tile_map.clear();
+	_clear_cells();
 	used_size_cache_dirty = true;
 }
 
@@ -1216,29 +1389,31 @@ void TileMap::_set_tile_data(const Vector<int> &p_data) {
 
 Vector<int> TileMap::_get_tile_data() const {
 	Vector<int> data;
-	data.resize(tile_map.size() * 3);
+	data.resize(cell_count * 3);
 	int *w = data.ptrw();
 
-	// Save in highest format
+	// Save in highest format, one chunk after another
 
+	Vector<PosKey> cells = _get_used_cell_keys();
 	int idx = 0;
-	for (const Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
+	for (int i = 0; i < cells.size(); i++) {
+		const Cell *E = _get_cell(cells[i]);
 		uint8_t *ptr = (uint8_t *)&w[idx];
-		encode_uint16(E->key().x, &ptr[0]);
-		encode_uint16(E->key().y, &ptr[2]);
-		uint32_t val = E->get().id;
-		if (E->get().flip_h) {
+		encode_uint16(cells[i].x, &ptr[0]);
+		encode_uint16(cells[i].y, &ptr[2]);
+		uint32_t val = E->id;
+		if (E->flip_h) {
 			val |= (1 << 29);
 		}
-		if (E->get().flip_v) {
+		if (E->flip_v) {
 			val |= (1 << 30);
 		}
-		if (E->get().transpose) {
+		if (E->transpose) {
 			val |= (1 << 31);
 		}
 		encode_uint32(val, &ptr[4]);
-		encode_uint16(E->get().autotile_coord_x, &ptr[8]);
-		encode_uint16(E->get().autotile_coord_y, &ptr[10]);
+		encode_uint16(E->autotile_coord_x, &ptr[8]);
+		encode_uint16(E->autotile_coord_y, &ptr[10]);
 		idx += 3;
 	}
 
@@ -1259,8 +1434,8 @@ Rect2 TileMap::_edit_get_rect() const {
 void TileMap::set_collision_layer(uint32_t p_layer) {
 	collision_layer = p_layer;
 	if (!use_parent) {
-		for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
-			Quadrant &q = E->get();
+		for (OAHashMap<PosKey, Quadrant *, PosKeyHasher>::Iterator it = quadrant_map.iter(); it.valid; it = quadrant_map.next_iter(it)) {
+			Quadrant &q = **it.value;
 			PhysicsServer2D::get_singleton()->body_set_collision_layer(q.body, collision_layer);
 		}
 	}
@@ -1269,8 +1444,8 @@ void TileMap::set_collision_layer(uint32_t p_layer) {
 void TileMap::set_collision_mask(uint32_t p_mask) {
 	collision_mask = p_mask;
 	if (!use_parent) {
-		for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
-			Quadrant &q = E->get();
+		for (OAHashMap<PosKey, Quadrant *, PosKeyHasher>::Iterator it = quadrant_map.iter(); it.valid; it = quadrant_map.next_iter(it)) {
+			Quadrant &q = **it.value;
 			PhysicsServer2D::get_singleton()->body_set_collision_mask(q.body, collision_mask);
 		}
 	}
@@ -1334,8 +1509,8 @@ void TileMap::set_collision_use_parent(bool p_use_parent) {
 void TileMap::set_collision_friction(float p_friction) {
 	friction = p_friction;
 	if (!use_parent) {
-		for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
-			Quadrant &q = E->get();
+		for (OAHashMap<PosKey, Quadrant *, PosKeyHasher>::Iterator it = quadrant_map.iter(); it.valid; it = quadrant_map.next_iter(it)) {
+			Quadrant &q = **it.value;
 			PhysicsServer2D::get_singleton()->body_set_param(q.body, PhysicsServer2D::BODY_PARAM_FRICTION, p_friction);
 		}
 	}
@@ -1348,8 +1523,8 @@ float TileMap::get_collision_friction() const {
 void TileMap::set_collision_bounce(float p_bounce) {
 	bounce = p_bounce;
 	if (!use_parent) {
-		for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
-			Quadrant &q = E->get();
+		for (OAHashMap<PosKey, Quadrant *, PosKeyHasher>::Iterator it = quadrant_map.iter(); it.valid; it = quadrant_map.next_iter(it)) {
+			Quadrant &q = **it.value;
 			PhysicsServer2D::get_singleton()->body_set_param(q.body, PhysicsServer2D::BODY_PARAM_BOUNCE, p_bounce);
 		}
 	}
@@ -1608,11 +1783,10 @@ bool TileMap::is_centered_textures_enabled() const {
 
 TypedArray<Vector2i> TileMap::get_used_cells() const {
 	TypedArray<Vector2i> a;
-	a.resize(tile_map.size());
-	int i = 0;
-	for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
-		Vector2i p(E->key().x, E->key().y);
-		a[i++] = p;
+	Vector<PosKey> cells = _get_used_cell_keys();
+	a.resize(cells.size());
+	for (int i = 0; i < cells.size(); i++) {
+		a[i] = Vector2i(cells[i].x, cells[i].y);
 	}
 
 	return a;
@@ -1620,10 +1794,10 @@ TypedArray<Vector2i> TileMap::get_used_cells() const {
 
 TypedArray<Vector2i> TileMap::get_used_cells_by_index(int p_id) const {
 	TypedArray<Vector2i> a;
-	for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
-		if (E->value().id == p_id) {
-			Vector2i p(E->key().x, E->key().y);
-			a.push_back(p);
+	Vector<PosKey> cells = _get_used_cell_keys();
+	for (int i = 0; i < cells.size(); i++) {
+		if (_get_cell(cells[i])->id == p_id) {
+			a.push_back(Vector2i(cells[i].x, cells[i].y));
 		}
 	}
 
@@ -1633,11 +1807,12 @@ TypedArray<Vector2i> TileMap::get_used_cells_by_index(int p_id) const {
 Rect2 TileMap::get_used_rect() { // Not const because of cache
 
 	if (used_size_cache_dirty) {
-		if (tile_map.size() > 0) {
-			used_size_cache = Rect2(tile_map.front()->key().x, tile_map.front()->key().y, 0, 0);
+		if (cell_count > 0) {
+			Vector<PosKey> cells = _get_used_cell_keys();
+			used_size_cache = Rect2(cells[0].x, cells[0].y, 0, 0);
 
-			for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
-				used_size_cache.expand_to(Vector2(E->key().x, E->key().y));
+			for (int i = 1; i < cells.size(); i++) {
+				used_size_cache.expand_to(Vector2(cells[i].x, cells[i].y));
 			}
 
 			used_size_cache.size += Vector2(1, 1);
@@ -1653,8 +1828,8 @@ Rect2 TileMap::get_used_rect() { // Not const because of cache
 
 void TileMap::set_occluder_light_mask(int p_mask) {
 	occluder_light_mask = p_mask;
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
-		for (Map<PosKey, Quadrant::Occluder>::Element *F = E->get().occluder_instances.front(); F; F = F->next()) {
+	for (OAHashMap<PosKey, Quadrant *, PosKeyHasher>::Iterator it = quadrant_map.iter(); it.valid; it = quadrant_map.next_iter(it)) {
+		for (Map<PosKey, Quadrant::Occluder>::Element *F = (*it.value)->occluder_instances.front(); F; F = F->next()) {
 			RenderingServer::get_singleton()->canvas_light_occluder_set_light_mask(F->get().id, occluder_light_mask);
 		}
 	}
@@ -1666,8 +1841,8 @@ int TileMap::get_occluder_light_mask() const {
 
 void TileMap::set_light_mask(int p_light_mask) {
 	CanvasItem::set_light_mask(p_light_mask);
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
-		for (List<RID>::Element *F = E->get().canvas_items.front(); F; F = F->next()) {
+	for (OAHashMap<PosKey, Quadrant *, PosKeyHasher>::Iterator it = quadrant_map.iter(); it.valid; it = quadrant_map.next_iter(it)) {
+		for (List<RID>::Element *F = (*it.value)->canvas_items.front(); F; F = F->next()) {
 			RenderingServer::get_singleton()->canvas_item_set_light_mask(F->get(), get_light_mask());
 		}
 	}
@@ -1765,6 +1940,7 @@ void TileMap::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_occluder_light_mask"), &TileMap::get_occluder_light_mask);
 
 	ClassDB::bind_method(D_METHOD("set_cell", "x", "y", "tile", "flip_x", "flip_y", "transpose", "autotile_coord"), &TileMap::set_cell, DEFVAL(false), DEFVAL(false), DEFVAL(false), DEFVAL(Vector2()));
+	ClassDB::bind_method(D_METHOD("set_cells", "cells", "tile", "flip_x", "flip_y", "transpose", "autotile_coord"), &TileMap::set_cells, DEFVAL(false), DEFVAL(false), DEFVAL(false), DEFVAL(Vector2()));
 	ClassDB::bind_method(D_METHOD("set_cellv", "position", "tile", "flip_x", "flip_y", "transpose"), &TileMap::set_cellv, DEFVAL(false), DEFVAL(false), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("_set_celld", "position", "data"), &TileMap::_set_celld);
 	ClassDB::bind_method(D_METHOD("get_cell", "x", "y"), &TileMap::get_cell);
@@ -1873,6 +2049,7 @@ TileMap::TileMap() {
 
 	fp_adjust = 0.00001;
 	tile_origin = TILE_ORIGIN_TOP_LEFT;
+	cell_count = 0;
 	set_notify_transform(true);
 	set_notify_local_transform(false);
 }
@@ -31,6 +31,7 @@
 #ifndef TILE_MAP_H
 #define TILE_MAP_H
 
+#include "core/oa_hash_map.h"
 #include "core/self_list.h"
 #include "core/vset.h"
 #include "scene/2d/navigation_2d.h"
@@ -123,10 +124,42 @@ private:
 		Cell() { _u64t = 0; }
 	};
 
-	Map<PosKey, Cell> tile_map;
+	struct PosKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const PosKey &p_key) { return hash_one_uint64(p_key.key); }
+	};
+
+	enum {
+		CELL_CHUNK_SHIFT = 4,
+		CELL_CHUNK_SIZE = 1 << CELL_CHUNK_SHIFT,
+		CELL_CHUNK_MASK = CELL_CHUNK_SIZE - 1,
+		CELL_CHUNK_CELLS = CELL_CHUNK_SIZE * CELL_CHUNK_SIZE,
+	};
+
+	// Cells are stored in dense square chunks, looked up by chunk position,
+	// instead of one tree node per cell.
+	struct CellChunk {
+		Cell cells[CELL_CHUNK_CELLS];
+		uint64_t used[CELL_CHUNK_CELLS / 64] = {};
+		int used_count = 0;
+
+		_FORCE_INLINE_ bool is_used(int p_index) const { return used[p_index >> 6] & (uint64_t(1) << (p_index & 63)); }
+	};
+
+	OAHashMap<PosKey, CellChunk *, PosKeyHasher> cell_chunks;
+	int cell_count;
+
+	_FORCE_INLINE_ static PosKey _get_cell_chunk_key(const PosKey &p_pos) { return PosKey(p_pos.x >> CELL_CHUNK_SHIFT, p_pos.y >> CELL_CHUNK_SHIFT); }
+	_FORCE_INLINE_ static int _get_cell_chunk_index(const PosKey &p_pos) { return ((p_pos.y & CELL_CHUNK_MASK) << CELL_CHUNK_SHIFT) | (p_pos.x & CELL_CHUNK_MASK); }
+
+	Cell *_get_cell(const PosKey &p_pos) const;
+	Cell *_insert_cell(const PosKey &p_pos);
+	void _erase_cell(const PosKey &p_pos);
+	void _clear_cells();
+	Vector<PosKey> _get_used_cell_keys() const;
 	List<PosKey> dirty_bitmask;
 
 	struct Quadrant {
+		PosKey key;
 		Vector2 pos;
 		List<RID> canvas_items;
 		RID body;
@@ -149,30 +182,16 @@ private:
 
 		VSet<PosKey> cells;
 
-		void operator=(const Quadrant &q) {
-			pos = q.pos;
-			canvas_items = q.canvas_items;
-			body = q.body;
-			shape_owner_id = q.shape_owner_id;
-			cells = q.cells;
-			navpoly_ids = q.navpoly_ids;
-			occluder_instances = q.occluder_instances;
-		}
-		Quadrant(const Quadrant &q) :
-				dirty_list(this) {
-			pos = q.pos;
-			canvas_items = q.canvas_items;
-			body = q.body;
-			shape_owner_id = q.shape_owner_id;
-			cells = q.cells;
-			occluder_instances = q.occluder_instances;
-			navpoly_ids = q.navpoly_ids;
-		}
 		Quadrant() :
 				dirty_list(this) {}
 	};
 
-	Map<PosKey, Quadrant> quadrant_map;
+	struct QuadrantKeySort {
+		_FORCE_INLINE_ bool operator()(const Quadrant *p_a, const Quadrant *p_b) const { return p_a->key < p_b->key; }
+	};
+
+	// Quadrants are allocated separately, as the dirty list points into them.
+	OAHashMap<PosKey, Quadrant *, PosKeyHasher> quadrant_map;
 
 	SelfList<Quadrant>::List dirty_quadrant_list;
 
@@ -202,9 +221,13 @@ private:
 
 	void _add_shape(int &shape_idx, const Quadrant &p_q, const Ref<Shape2D> &p_shape, const TileSet::ShapeData &p_shape_data, const Transform2D &p_xform, const Vector2 &p_metadata);
 
-	Map<PosKey, Quadrant>::Element *_create_quadrant(const PosKey &p_qk);
-	void _erase_quadrant(Map<PosKey, Quadrant>::Element *Q);
-	void _make_quadrant_dirty(Map<PosKey, Quadrant>::Element *Q, bool update = true);
+	_FORCE_INLINE_ Quadrant *_get_quadrant(const PosKey &p_qk) const {
+		Quadrant **q = quadrant_map.lookup_ptr(p_qk);
+		return q ? *q : nullptr;
+	}
+	Quadrant *_create_quadrant(const PosKey &p_qk);
+	void _erase_quadrant(Quadrant *Q);
+	void _make_quadrant_dirty(Quadrant *Q, bool update = true);
 	void _recreate_quadrants();
 	void _clear_quadrants();
 	void _update_quadrant_space(const RID &p_space);
@@ -254,6 +277,7 @@ public:
 	int get_quadrant_size() const;
 
 	void set_cell(int p_x, int p_y, int p_tile, bool p_flip_x = false, bool p_flip_y = false, bool p_transpose = false, Vector2 p_autotile_coord = Vector2());
+	void set_cells(const TypedArray<Vector2i> &p_cells, int p_tile, bool p_flip_x = false, bool p_flip_y = false, bool p_transpose = false, Vector2 p_autotile_coord = Vector2());
 	int get_cell(int p_x, int p_y) const;
 	bool is_cell_x_flipped(int p_x, int p_y) const;
 	bool is_cell_y_flipped(int p_x, int p_y) const;
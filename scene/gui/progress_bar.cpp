@@ -54,21 +54,77 @@ void ProgressBar::_notification(int p_what) {
 		Ref<Font> font = get_theme_font("font");
 		Color font_color = get_theme_color("font_color");
 
+		fg_command = -1;
+
 		draw_style_box(bg, Rect2(Point2(), get_size()));
 		float r = get_as_ratio();
 		int mp = fg->get_minimum_size().width;
 		int p = r * (get_size().width - mp);
 		if (p > 0) {
+			// The fill can only be patched in place when it is the single
+			// nine-patch command recorded right after the background.
+			int bg_commands = _get_nine_patch_command_count(bg);
+			if (bg_commands >= 0 && _get_nine_patch_command_count(fg) == 1) {
+				fg_command = bg_commands;
+			}
 			draw_style_box(fg, Rect2(Point2(), Size2(p + fg->get_minimum_size().width, get_size().height)));
 		}
 
+		drawn_percent = _get_percent();
 		if (percent_visible) {
-			String txt = itos(int(get_as_ratio() * 100)) + "%";
+			String txt = itos(drawn_percent) + "%";
 			font->draw_halign(get_canvas_item(), Point2(0, font->get_ascent() + (get_size().height - font->get_height()) / 2), HALIGN_CENTER, get_size().width, txt, font_color);
 		}
 	}
 }
 
+int ProgressBar::_get_percent() const {
+	return int(get_as_ratio() * 100);
+}
+
+int ProgressBar::_get_nine_patch_command_count(const Ref<StyleBox> &p_style) {
+	// Returns how many commands the style box records when drawn, or -1 if
+	// it may record anything other than nine-patches.
+	if (Object::cast_to<StyleBoxEmpty>(*p_style)) {
+		return 0;
+	}
+	const StyleBoxTexture *style_texture = Object::cast_to<StyleBoxTexture>(*p_style);
+	if (!style_texture) {
+		return -1;
+	}
+	return style_texture->get_texture().is_valid() ? 1 : 0;
+}
+
+bool ProgressBar::_patch_value_draw() {
+	// Only the fill rect depends on the value, unless the percentage text
+	// changes too.
+	if (fg_command < 0 || !_can_patch_value_draw()) {
+		return false;
+	}
+
+	if (percent_visible && _get_percent() != drawn_percent) {
+		return false;
+	}
+
+	Ref<StyleBoxTexture> fg = get_theme_stylebox("fg");
+	if (fg.is_null() || fg->get_texture().is_null()) {
+		return false;
+	}
+
+	int mp = fg->get_minimum_size().width;
+	int p = get_as_ratio() * (get_size().width - mp);
+	if (p <= 0) {
+		return false;
+	}
+
+	Rect2 rect;
+	Rect2 src_rect;
+	fg->get_nine_patch_rects(Rect2(Point2(), Size2(p + mp, get_size().height)), rect, src_rect);
+
+	RS::get_singleton()->canvas_item_command_set_rect(get_canvas_item(), fg_command, rect, src_rect);
+	return true;
+}
+
 void ProgressBar::set_percent_visible(bool p_visible) {
 	percent_visible = p_visible;
 	update();
@@ -89,4 +145,6 @@ ProgressBar::ProgressBar() {
 	set_v_size_flags(0);
 	set_step(0.01);
 	percent_visible = true;
+	fg_command = -1;
+	drawn_percent = 0;
 }
@@ -37,9 +37,15 @@ class ProgressBar : public Range {
 	GDCLASS(ProgressBar, Range);
 
 	bool percent_visible;
+	int fg_command;
+	int drawn_percent;
+
+	int _get_percent() const;
+	static int _get_nine_patch_command_count(const Ref<StyleBox> &p_style);
 
 protected:
 	void _notification(int p_what);
+	virtual bool _patch_value_draw();
 	static void _bind_methods();
 
 public:
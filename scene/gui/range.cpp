@@ -30,6 +30,8 @@
 
 #include "range.h"
 
+#include "scene/scene_string_names.h"
+
 String Range::get_configuration_warning() const {
 	String warning = Control::get_configuration_warning();
 
@@ -46,10 +48,24 @@ String Range::get_configuration_warning() const {
 void Range::_value_changed_notify() {
 	_value_changed(shared->val);
 	emit_signal("value_changed", shared->val);
-	update();
+	if (!_patch_value_draw()) {
+		update();
+	}
 	_change_notify("value");
 }
 
+bool Range::_can_patch_value_draw() const {
+	// A script or a draw signal connection may draw something that depends
+	// on the value, so only the built-in drawing can be patched.
+	if (!is_visible_in_tree() || get_script_instance()) {
+		return false;
+	}
+
+	List<Connection> draw_connections;
+	get_signal_connection_list(SceneStringNames::get_singleton()->draw, &draw_connections);
+	return draw_connections.empty();
+}
+
 void Range::Shared::emit_value_changed() {
 	for (Set<Range *>::Element *E = owners.front(); E; E = E->next()) {
 		Range *r = E->get();
@@ -59,6 +59,10 @@ class Range : public Control {
 
 protected:
 	virtual void _value_changed(double) {}
+	// Return true if the value change was applied to the already recorded
+	// draw commands, so the control does not have to be redrawn.
+	virtual bool _patch_value_draw() { return false; }
+	bool _can_patch_value_draw() const;
 
 	static void _bind_methods();
 
@@ -34,6 +34,7 @@
 
 void TextureProgress::set_under_texture(const Ref<Texture2D> &p_texture) {
 	under = p_texture;
+	progress_command = -1;
 	update();
 	minimum_size_changed();
 }
@@ -68,6 +69,7 @@ int TextureProgress::get_stretch_margin(Margin p_margin) const {
 
 void TextureProgress::set_nine_patch_stretch(bool p_stretch) {
 	nine_patch_stretch = p_stretch;
+	progress_command = -1;
 	update();
 	minimum_size_changed();
 }
@@ -92,6 +94,7 @@ Size2 TextureProgress::get_minimum_size() const {
 
 void TextureProgress::set_progress_texture(const Ref<Texture2D> &p_texture) {
 	progress = p_texture;
+	progress_command = -1;
 	update();
 	minimum_size_changed();
 }
@@ -204,6 +207,59 @@ Point2 TextureProgress::get_relative_center() {
 	return p;
 }
 
+Rect2 TextureProgress::_get_progress_region() const {
+	Size2 s = progress->get_size();
+	float ratio = get_as_ratio();
+	switch (mode) {
+		case FILL_RIGHT_TO_LEFT:
+			return Rect2(Point2(s.x - s.x * ratio, 0), Size2(s.x * ratio, s.y));
+		case FILL_TOP_TO_BOTTOM:
+			return Rect2(Point2(), Size2(s.x, s.y * ratio));
+		case FILL_BOTTOM_TO_TOP:
+			return Rect2(Point2(0, s.y - s.y * ratio), Size2(s.x, s.y * ratio));
+		case FILL_BILINEAR_LEFT_AND_RIGHT:
+			return Rect2(Point2(s.x / 2 - s.x * ratio / 2, 0), Size2(s.x * ratio, s.y));
+		case FILL_BILINEAR_TOP_AND_BOTTOM:
+			return Rect2(Point2(0, s.y / 2 - s.y * ratio / 2), Size2(s.x, s.y * ratio));
+		default:
+			return Rect2(Point2(), Size2(s.x * ratio, s.y));
+	}
+}
+
+bool TextureProgress::_is_single_rect_texture(const Ref<Texture2D> &p_texture, bool p_allow_null) {
+	// Only textures known to record exactly one rect command when drawn can be
+	// addressed by index later on.
+	if (p_texture.is_null()) {
+		return p_allow_null;
+	}
+	if (p_texture->get_width() == 0 || p_texture->get_height() == 0) {
+		return false;
+	}
+	if (Object::cast_to<ImageTexture>(*p_texture) || Object::cast_to<StreamTexture2D>(*p_texture)) {
+		return true;
+	}
+	const AtlasTexture *atlas = Object::cast_to<AtlasTexture>(*p_texture);
+	return atlas && atlas->get_atlas().is_valid();
+}
+
+bool TextureProgress::_patch_value_draw() {
+	// The linear fill modes only change the rect of the progress texture when
+	// the value changes, so patch the recorded command instead of redrawing.
+	if (progress_command < 0 || progress.is_null() || !_can_patch_value_draw()) {
+		return false;
+	}
+
+	Rect2 region = _get_progress_region();
+	Rect2 rect;
+	Rect2 src_rect;
+	if (!progress->get_rect_region(region, region, rect, src_rect)) {
+		return false;
+	}
+
+	RS::get_singleton()->canvas_item_command_set_rect(get_canvas_item(), progress_command, rect, src_rect);
+	return true;
+}
+
 void TextureProgress::draw_nine_patch_stretched(const Ref<Texture2D> &p_texture, FillMode p_mode, double p_ratio, const Color &p_modulate) {
 	Vector2 texture_size = p_texture->get_size();
 	Vector2 topleft = Vector2(stretch_margin[MARGIN_LEFT], stretch_margin[MARGIN_TOP]);
@@ -310,6 +366,8 @@ void TextureProgress::_notification(int p_what) {
 	const float corners[12] = { -0.125, -0.375, -0.625, -0.875, 0.125, 0.375, 0.625, 0.875, 1.125, 1.375, 1.625, 1.875 };
 	switch (p_what) {
 		case NOTIFICATION_DRAW: {
+			progress_command = -1;
+
 			if (nine_patch_stretch && (mode == FILL_LEFT_TO_RIGHT || mode == FILL_RIGHT_TO_LEFT || mode == FILL_TOP_TO_BOTTOM || mode == FILL_BOTTOM_TO_TOP)) {
 				if (under.is_valid()) {
 					draw_nine_patch_stretched(under, FILL_LEFT_TO_RIGHT, 1.0, tint_under);
@@ -327,20 +385,16 @@ void TextureProgress::_notification(int p_what) {
 				if (progress.is_valid()) {
 					Size2 s = progress->get_size();
 					switch (mode) {
-						case FILL_LEFT_TO_RIGHT: {
-							Rect2 region = Rect2(Point2(), Size2(s.x * get_as_ratio(), s.y));
-							draw_texture_rect_region(progress, region, region, tint_progress);
-						} break;
-						case FILL_RIGHT_TO_LEFT: {
-							Rect2 region = Rect2(Point2(s.x - s.x * get_as_ratio(), 0), Size2(s.x * get_as_ratio(), s.y));
-							draw_texture_rect_region(progress, region, region, tint_progress);
-						} break;
-						case FILL_TOP_TO_BOTTOM: {
-							Rect2 region = Rect2(Point2(), Size2(s.x, s.y * get_as_ratio()));
-							draw_texture_rect_region(progress, region, region, tint_progress);
-						} break;
-						case FILL_BOTTOM_TO_TOP: {
-							Rect2 region = Rect2(Point2(0, s.y - s.y * get_as_ratio()), Size2(s.x, s.y * get_as_ratio()));
+						case FILL_LEFT_TO_RIGHT:
+						case FILL_RIGHT_TO_LEFT:
+						case FILL_TOP_TO_BOTTOM:
+						case FILL_BOTTOM_TO_TOP:
+						case FILL_BILINEAR_LEFT_AND_RIGHT:
+						case FILL_BILINEAR_TOP_AND_BOTTOM: {
+							if (_is_single_rect_texture(under, true) && _is_single_rect_texture(progress)) {
+								progress_command = under.is_valid() ? 1 : 0;
+							}
+							Rect2 region = _get_progress_region();
 							draw_texture_rect_region(progress, region, region, tint_progress);
 						} break;
 						case FILL_CLOCKWISE:
@@ -408,16 +462,6 @@ void TextureProgress::_notification(int p_what) {
 								draw_line(p - Point2(0, 8), p + Point2(0, 8), Color(0.9, 0.5, 0.5), 2);
 							}
 						} break;
-						case FILL_BILINEAR_LEFT_AND_RIGHT: {
-							Rect2 region = Rect2(Point2(s.x / 2 - s.x * get_as_ratio() / 2, 0), Size2(s.x * get_as_ratio(), s.y));
-							draw_texture_rect_region(progress, region, region, tint_progress);
-						} break;
-						case FILL_BILINEAR_TOP_AND_BOTTOM: {
-							Rect2 region = Rect2(Point2(0, s.y / 2 - s.y * get_as_ratio() / 2), Size2(s.x, s.y * get_as_ratio()));
-							draw_texture_rect_region(progress, region, region, tint_progress);
-						} break;
-						default:
-							draw_texture_rect_region(progress, Rect2(Point2(), Size2(s.x * get_as_ratio(), s.y)), Rect2(Point2(), Size2(s.x * get_as_ratio(), s.y)), tint_progress);
 					}
 				}
 				if (over.is_valid()) {
@@ -431,6 +475,7 @@ void TextureProgress::_notification(int p_what) {
 void TextureProgress::set_fill_mode(int p_fill) {
 	ERR_FAIL_INDEX(p_fill, 9);
 	mode = (FillMode)p_fill;
+	progress_command = -1;
 	update();
 }
 
@@ -553,4 +598,6 @@ TextureProgress::TextureProgress() {
 	stretch_margin[MARGIN_TOP] = 0;
 
 	tint_under = tint_progress = tint_over = Color(1, 1, 1);
+
+	progress_command = -1;
 }
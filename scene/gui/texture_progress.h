@@ -43,6 +43,7 @@ class TextureProgress : public Range {
 protected:
 	static void _bind_methods();
 	void _notification(int p_what);
+	virtual bool _patch_value_draw();
 
 public:
 	enum FillMode {
@@ -105,6 +106,10 @@ private:
 	bool nine_patch_stretch;
 	int stretch_margin[4];
 	Color tint_under, tint_progress, tint_over;
+	int progress_command;
+
+	Rect2 _get_progress_region() const;
+	static bool _is_single_rect_texture(const Ref<Texture2D> &p_texture, bool p_allow_null = false);
 
 	Point2 unit_val_to_uv(float val);
 	Point2 get_relative_center();
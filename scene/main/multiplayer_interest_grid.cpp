@@ -0,0 +1,210 @@
+/*************************************************************************/
+/*  multiplayer_interest_grid.cpp                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "multiplayer_interest_grid.h"
+
+#include "scene/2d/node_2d.h"
+#include "scene/3d/node_3d.h"
+
+bool MultiplayerInterestGrid::_get_node_cell(Node *p_node, Vector3i &r_cell) const {
+	if (!p_node->is_inside_tree()) {
+		return false;
+	}
+
+	// Use the closest spatial node, so e.g. a plain Node child of a character follows it.
+	for (Node *n = p_node; n; n = n->get_parent()) {
+		Vector3 pos;
+		if (Node3D *n3d = Object::cast_to<Node3D>(n)) {
+			pos = n3d->get_global_transform().origin;
+		} else if (Node2D *n2d = Object::cast_to<Node2D>(n)) {
+			Vector2 pos2d = n2d->get_global_position();
+			pos = Vector3(pos2d.x, pos2d.y, 0);
+		} else {
+			continue;
+		}
+
+		r_cell = Vector3i(Math::floor(pos.x / cell_size), Math::floor(pos.y / cell_size), Math::floor(pos.z / cell_size));
+		return true;
+	}
+
+	return false;
+}
+
+void MultiplayerInterestGrid::update() {
+	viewer_cells.clear();
+	cell_viewers.clear();
+	cached_peers = Vector<int>();
+
+	Map<int, ObjectID>::Element *E = viewers.front();
+	while (E) {
+		Map<int, ObjectID>::Element *N = E->next();
+		Node *viewer = Object::cast_to<Node>(ObjectDB::get_instance(E->get()));
+		if (!viewer) {
+			viewers.erase(E); // Freed.
+		} else {
+			Vector3i cell;
+			if (_get_node_cell(viewer, cell)) {
+				viewer_cells[E->key()] = cell;
+				cell_viewers[cell].push_back(E->key());
+			}
+		}
+		E = N;
+	}
+}
+
+void MultiplayerInterestGrid::_update_peer_cache(const Vector<int> &p_peers) {
+	if (p_peers.ptr() == cached_peers.ptr() && p_peers.size() == cached_peers.size()) {
+		return; // Same shared buffer, so same peers.
+	}
+
+	cached_peers = p_peers;
+	cached_peer_set.clear();
+	cached_unviewed_peers.clear();
+	for (int i = 0; i < p_peers.size(); i++) {
+		cached_peer_set.insert(p_peers[i]);
+		if (!viewer_cells.has(p_peers[i])) {
+			cached_unviewed_peers.push_back(p_peers[i]);
+		}
+	}
+}
+
+void MultiplayerInterestGrid::get_relevant_peers(Node *p_node, const Vector<int> &p_peers, Vector<int> &r_peers) {
+	Vector3i cell;
+	if (!_get_node_cell(p_node, cell)) {
+		r_peers.append_array(p_peers); // Not spatial, relevant to everyone.
+		return;
+	}
+
+	_update_peer_cache(p_peers);
+
+	// Peers without a viewer, e.g. still loading, get everything.
+	r_peers.append_array(cached_unviewed_peers);
+
+	int master = p_node->get_network_master();
+	bool master_added = !cached_peer_set.has(master) || !viewer_cells.has(master);
+
+	// Visit the cells in view distance, or the occupied cells if there are fewer of them.
+	int64_t side = 2 * int64_t(view_distance) + 1;
+	if (side * side * side <= cell_viewers.size()) {
+		for (int x = -view_distance; x <= view_distance; x++) {
+			for (int y = -view_distance; y <= view_distance; y++) {
+				for (int z = -view_distance; z <= view_distance; z++) {
+					const Vector<int> *peers = cell_viewers.getptr(cell + Vector3i(x, y, z));
+					if (!peers) {
+						continue;
+					}
+					for (int i = 0; i < peers->size(); i++) {
+						if (cached_peer_set.has((*peers)[i])) {
+							r_peers.push_back((*peers)[i]);
+							master_added = master_added || (*peers)[i] == master;
+						}
+					}
+				}
+			}
+		}
+	} else {
+		const Vector3i *K = nullptr;
+		while ((K = cell_viewers.next(K))) {
+			Vector3i d = *K - cell;
+			if (ABS(d.x) > view_distance || ABS(d.y) > view_distance || ABS(d.z) > view_distance) {
+				continue;
+			}
+			const Vector<int> &peers = cell_viewers[*K];
+			for (int i = 0; i < peers.size(); i++) {
+				if (cached_peer_set.has(peers[i])) {
+					r_peers.push_back(peers[i]);
+					master_added = master_added || peers[i] == master;
+				}
+			}
+		}
+	}
+
+	if (!master_added) {
+		r_peers.push_back(master);
+	}
+}
+
+void MultiplayerInterestGrid::set_cell_size(float p_size) {
+	ERR_FAIL_COND(p_size <= 0);
+	cell_size = p_size;
+}
+
+float MultiplayerInterestGrid::get_cell_size() const {
+	return cell_size;
+}
+
+void MultiplayerInterestGrid::set_view_distance(int p_cells) {
+	ERR_FAIL_COND(p_cells < 0);
+	view_distance = p_cells;
+}
+
+int MultiplayerInterestGrid::get_view_distance() const {
+	return view_distance;
+}
+
+void MultiplayerInterestGrid::set_peer_viewer(int p_peer, Node *p_viewer) {
+	ERR_FAIL_NULL(p_viewer);
+	viewers[p_peer] = p_viewer->get_instance_id();
+}
+
+Node *MultiplayerInterestGrid::get_peer_viewer(int p_peer) const {
+	const Map<int, ObjectID>::Element *E = viewers.find(p_peer);
+	if (!E) {
+		return nullptr;
+	}
+	return Object::cast_to<Node>(ObjectDB::get_instance(E->get()));
+}
+
+void MultiplayerInterestGrid::remove_peer_viewer(int p_peer) {
+	viewers.erase(p_peer);
+	const Vector3i *cell = viewer_cells.getptr(p_peer);
+	if (cell) {
+		Vector<int> &peers = cell_viewers[*cell];
+		peers.erase(p_peer);
+		if (peers.empty()) {
+			cell_viewers.erase(*cell);
+		}
+		viewer_cells.erase(p_peer);
+	}
+	cached_peers = Vector<int>();
+}
+
+void MultiplayerInterestGrid::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_cell_size", "size"), &MultiplayerInterestGrid::set_cell_size);
+	ClassDB::bind_method(D_METHOD("get_cell_size"), &MultiplayerInterestGrid::get_cell_size);
+	ClassDB::bind_method(D_METHOD("set_view_distance", "cells"), &MultiplayerInterestGrid::set_view_distance);
+	ClassDB::bind_method(D_METHOD("get_view_distance"), &MultiplayerInterestGrid::get_view_distance);
+	ClassDB::bind_method(D_METHOD("set_peer_viewer", "peer", "viewer"), &MultiplayerInterestGrid::set_peer_viewer);
+	ClassDB::bind_method(D_METHOD("get_peer_viewer", "peer"), &MultiplayerInterestGrid::get_peer_viewer);
+	ClassDB::bind_method(D_METHOD("remove_peer_viewer", "peer"), &MultiplayerInterestGrid::remove_peer_viewer);
+
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size", PROPERTY_HINT_RANGE, "0.01,4096,0.01,or_greater"), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "view_distance", PROPERTY_HINT_RANGE, "0,64,1,or_greater"), "set_view_distance", "get_view_distance");
+}
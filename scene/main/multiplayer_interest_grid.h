@@ -0,0 +1,87 @@
+/*************************************************************************/
+/*  multiplayer_interest_grid.h                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef MULTIPLAYER_INTEREST_GRID_H
+#define MULTIPLAYER_INTEREST_GRID_H
+
+#include "core/io/multiplayer_interest.h"
+#include "core/math/vector3i.h"
+
+// Spatial interest: peer viewers are bucketed in a uniform grid on update(), and a
+// peer is interested in the nodes within view_distance cells of its viewer, so a
+// query only visits the viewers in the cells around the node.
+class MultiplayerInterestGrid : public MultiplayerInterest {
+	GDCLASS(MultiplayerInterestGrid, MultiplayerInterest);
+
+	float cell_size = 64.0;
+	int view_distance = 2;
+
+	struct CellHasher {
+		static _FORCE_INLINE_ uint32_t hash(const Vector3i &p_cell) {
+			uint32_t h = hash_djb2_one_32(p_cell.x);
+			h = hash_djb2_one_32(p_cell.y, h);
+			return hash_djb2_one_32(p_cell.z, h);
+		}
+	};
+
+	Map<int, ObjectID> viewers;
+	// Rebuilt on update().
+	HashMap<int, Vector3i> viewer_cells;
+	HashMap<Vector3i, Vector<int>, CellHasher> cell_viewers;
+
+	// Derived from the peer list of the last query, which is the same for all the
+	// nodes of a snapshot. Holding a reference keeps the check a pointer compare.
+	Vector<int> cached_peers;
+	Set<int> cached_peer_set;
+	Vector<int> cached_unviewed_peers;
+
+	bool _get_node_cell(Node *p_node, Vector3i &r_cell) const;
+	void _update_peer_cache(const Vector<int> &p_peers);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_cell_size(float p_size);
+	float get_cell_size() const;
+	void set_view_distance(int p_cells);
+	int get_view_distance() const;
+
+	void set_peer_viewer(int p_peer, Node *p_viewer);
+	Node *get_peer_viewer(int p_peer) const;
+	void remove_peer_viewer(int p_peer);
+
+	virtual void update();
+	virtual void get_relevant_peers(Node *p_node, const Vector<int> &p_peers, Vector<int> &r_peers);
+
+	MultiplayerInterestGrid() {}
+};
+
+#endif // MULTIPLAYER_INTEREST_GRID_H
@@ -460,18 +460,24 @@ bool Node::is_network_master() const {
 
 /***** RPC CONFIG ********/
 
-uint16_t Node::rpc_config(const StringName &p_method, MultiplayerAPI::RPCMode p_mode) {
+uint16_t Node::rpc_config(const StringName &p_method, MultiplayerAPI::RPCMode p_mode, const Vector<int> &p_arg_formats) {
+	for (int i = 0; i < p_arg_formats.size(); i++) {
+		ERR_FAIL_INDEX_V_MSG(p_arg_formats[i], MultiplayerAPI::RPC_ARG_MAX, UINT16_MAX, "Invalid RPC argument format for method '" + String(p_method) + "'.");
+	}
+
 	uint16_t mid = get_node_rpc_method_id(p_method);
 	if (mid == UINT16_MAX) {
 		// It's new
 		NetData nd;
 		nd.name = p_method;
 		nd.mode = p_mode;
+		nd.arg_formats = p_arg_formats;
 		data.rpc_methods.push_back(nd);
 		return ((uint16_t)data.rpc_properties.size() - 1) | (1 << 15);
 	} else {
 		int c_mid = (~(1 << 15)) & mid;
 		data.rpc_methods.write[c_mid].mode = p_mode;
+		data.rpc_methods.write[c_mid].arg_formats = p_arg_formats;
 		return mid;
 	}
 }
@@ -733,6 +739,17 @@ MultiplayerAPI::RPCMode Node::get_node_rpc_mode_by_id(const uint16_t p_rpc_metho
 	return MultiplayerAPI::RPC_MODE_DISABLED;
 }
 
+Vector<int> Node::get_node_rpc_arg_formats_by_id(const uint16_t p_rpc_method_id) const {
+	// Make sure this is a node generated ID.
+	if (((1 << 15) & p_rpc_method_id) > 0) {
+		int mid = (~(1 << 15)) & p_rpc_method_id;
+		if (mid < data.rpc_methods.size()) {
+			return data.rpc_methods[mid].arg_formats;
+		}
+	}
+	return Vector<int>();
+}
+
 MultiplayerAPI::RPCMode Node::get_node_rpc_mode(const StringName &p_method) const {
 	return get_node_rpc_mode_by_id(get_node_rpc_method_id(p_method));
 }
@@ -777,6 +794,11 @@ String Node::get_rpc_md5() const {
 	String rpc_list;
 	for (int i = 0; i < data.rpc_methods.size(); i += 1) {
 		rpc_list += String(data.rpc_methods[i].name);
+		// Signatures must match too, typed arguments carry no type information.
+		const Vector<int> &formats = data.rpc_methods[i].arg_formats;
+		for (int j = 0; j < formats.size(); j++) {
+			rpc_list += itos(formats[j]);
+		}
 	}
 	for (int i = 0; i < data.rpc_properties.size(); i += 1) {
 		rpc_list += String(data.rpc_properties[i].name);
@@ -2802,7 +2824,7 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_multiplayer"), &Node::get_multiplayer);
 	ClassDB::bind_method(D_METHOD("get_custom_multiplayer"), &Node::get_custom_multiplayer);
 	ClassDB::bind_method(D_METHOD("set_custom_multiplayer", "api"), &Node::set_custom_multiplayer);
-	ClassDB::bind_method(D_METHOD("rpc_config", "method", "mode"), &Node::rpc_config);
+	ClassDB::bind_method(D_METHOD("rpc_config", "method", "mode", "arg_formats"), &Node::rpc_config, DEFVAL(Vector<int>()));
 	ClassDB::bind_method(D_METHOD("rset_config", "property", "mode"), &Node::rset_config);
 
 	ClassDB::bind_method(D_METHOD("_set_editor_description", "editor_description"), &Node::set_editor_description);
@@ -85,6 +85,7 @@ private:
 	struct NetData {
 		StringName name;
 		MultiplayerAPI::RPCMode mode;
+		Vector<int> arg_formats; // MultiplayerAPI::RPCArgFormat for each argument, empty if untyped.
 	};
 
 	struct Data {
@@ -428,7 +429,7 @@ public:
 	int get_network_master() const;
 	bool is_network_master() const;
 
-	uint16_t rpc_config(const StringName &p_method, MultiplayerAPI::RPCMode p_mode); // config a local method for RPC
+	uint16_t rpc_config(const StringName &p_method, MultiplayerAPI::RPCMode p_mode, const Vector<int> &p_arg_formats = Vector<int>()); // config a local method for RPC
 	uint16_t rset_config(const StringName &p_property, MultiplayerAPI::RPCMode p_mode); // config a local property for RPC
 
 	void rpc(const StringName &p_method, VARIANT_ARG_LIST); //rpc call, honors RPCMode
@@ -452,6 +453,7 @@ public:
 	uint16_t get_node_rpc_method_id(const StringName &p_method) const;
 	StringName get_node_rpc_method(const uint16_t p_rpc_method_id) const;
 	MultiplayerAPI::RPCMode get_node_rpc_mode_by_id(const uint16_t p_rpc_method_id) const;
+	Vector<int> get_node_rpc_arg_formats_by_id(const uint16_t p_rpc_method_id) const;
 	MultiplayerAPI::RPCMode get_node_rpc_mode(const StringName &p_method) const;
 
 	/// Returns the rpc property ID, otherwise UINT32_MAX
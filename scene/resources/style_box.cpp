@@ -172,20 +172,28 @@ Rect2 StyleBoxTexture::get_draw_rect(const Rect2 &p_rect) const {
 	return p_rect.grow_individual(expand_margin[MARGIN_LEFT], expand_margin[MARGIN_TOP], expand_margin[MARGIN_RIGHT], expand_margin[MARGIN_BOTTOM]);
 }
 
+void StyleBoxTexture::get_nine_patch_rects(const Rect2 &p_rect, Rect2 &r_rect, Rect2 &r_src_rect) const {
+	ERR_FAIL_COND(texture.is_null());
+
+	r_rect = p_rect;
+	r_src_rect = region_rect;
+
+	texture->get_rect_region(r_rect, r_src_rect, r_rect, r_src_rect);
+
+	r_rect.position.x -= expand_margin[MARGIN_LEFT];
+	r_rect.position.y -= expand_margin[MARGIN_TOP];
+	r_rect.size.x += expand_margin[MARGIN_LEFT] + expand_margin[MARGIN_RIGHT];
+	r_rect.size.y += expand_margin[MARGIN_TOP] + expand_margin[MARGIN_BOTTOM];
+}
+
 void StyleBoxTexture::draw(RID p_canvas_item, const Rect2 &p_rect) const {
 	if (texture.is_null()) {
 		return;
 	}
 
-	Rect2 rect = p_rect;
-	Rect2 src_rect = region_rect;
-
-	texture->get_rect_region(rect, src_rect, rect, src_rect);
-
-	rect.position.x -= expand_margin[MARGIN_LEFT];
-	rect.position.y -= expand_margin[MARGIN_TOP];
-	rect.size.x += expand_margin[MARGIN_LEFT] + expand_margin[MARGIN_RIGHT];
-	rect.size.y += expand_margin[MARGIN_TOP] + expand_margin[MARGIN_BOTTOM];
+	Rect2 rect;
+	Rect2 src_rect;
+	get_nine_patch_rects(p_rect, rect, src_rect);
 
 	RID normal_rid;
 	if (normal_map.is_valid()) {
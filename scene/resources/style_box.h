@@ -133,6 +133,7 @@ public:
 
 	virtual Rect2 get_draw_rect(const Rect2 &p_rect) const;
 	virtual void draw(RID p_canvas_item, const Rect2 &p_rect) const;
+	void get_nine_patch_rects(const Rect2 &p_rect, Rect2 &r_rect, Rect2 &r_src_rect) const;
 
 	StyleBoxTexture();
 	~StyleBoxTexture();
@@ -1206,6 +1206,17 @@ public:
 			return command;
 		}
 
+		// Commands are kept in recording order, so a client that recorded an
+		// item can address its commands by index and patch them in place.
+		Command *get_command(int p_index) const {
+			Command *c = commands;
+			while (c && p_index > 0) {
+				c = c->next;
+				p_index--;
+			}
+			return p_index == 0 ? c : nullptr;
+		}
+
 		struct CustomData {
 			virtual ~CustomData() {}
 		};
@@ -1312,6 +1323,8 @@ public:
 
 	virtual void draw_window_margins(int *p_margins, RID *p_margin_textures) = 0;
 
+	virtual int get_render_info(RS::RenderInfo p_info) = 0;
+
 	virtual bool free(RID p_rid) = 0;
 	virtual void update() = 0;
 
@@ -483,6 +483,157 @@ Size2i RasterizerCanvasRD::_bind_texture_binding(TextureBindingID p_binding, RD:
 	}
 }
 
+Size2i RasterizerCanvasRD::_get_texture_binding_size(TextureBindingID p_binding) const {
+	TextureBinding *const *texture_binding_ptr = bindings.texture_bindings.getptr(p_binding);
+	ERR_FAIL_COND_V(!texture_binding_ptr, Size2i());
+	const TextureBinding *texture_binding = *texture_binding_ptr;
+
+	if (texture_binding->key.texture.is_valid()) {
+		return storage->texture_2d_get_size(texture_binding->key.texture);
+	} else {
+		return Size2i(1, 1);
+	}
+}
+
+void RasterizerCanvasRD::_get_rect_data(const Item::CommandRect *p_rect, Vector2 &r_texpixel_size, Rect2 &r_src_rect, Rect2 &r_dst_rect) const {
+	r_dst_rect = Rect2(p_rect->rect.position, p_rect->rect.size);
+
+	if (r_dst_rect.size.width < 0) {
+		r_dst_rect.position.x += r_dst_rect.size.width;
+		r_dst_rect.size.width *= -1;
+	}
+	if (r_dst_rect.size.height < 0) {
+		r_dst_rect.position.y += r_dst_rect.size.height;
+		r_dst_rect.size.height *= -1;
+	}
+
+	if (r_texpixel_size == Vector2()) {
+		r_src_rect = Rect2(0, 0, 1, 1);
+		r_texpixel_size = Vector2(1, 1);
+		return;
+	}
+
+	r_src_rect = (p_rect->flags & CANVAS_RECT_REGION) ? Rect2(p_rect->source.position * r_texpixel_size, p_rect->source.size * r_texpixel_size) : Rect2(0, 0, 1, 1);
+
+	if (p_rect->flags & CANVAS_RECT_FLIP_H) {
+		r_src_rect.size.x *= -1;
+	}
+
+	if (p_rect->flags & CANVAS_RECT_FLIP_V) {
+		r_src_rect.size.y *= -1;
+	}
+
+	if (p_rect->flags & CANVAS_RECT_TRANSPOSE) {
+		r_dst_rect.size.x *= -1; // Encoding in the dst_rect.z uniform
+	}
+}
+
+bool RasterizerCanvasRD::_rect_batch_can_merge(const Item::Command *p_command, const Item::CommandRect *p_first) const {
+	if (!p_command || p_command->type != Item::Command::TYPE_RECT) {
+		return false;
+	}
+
+	const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(p_command);
+
+	// UV clipping is toggled for the whole draw call, so it must match across the run.
+	if ((rect->flags & CANVAS_RECT_CLIP_UV) != (p_first->flags & CANVAS_RECT_CLIP_UV)) {
+		return false;
+	}
+
+	return rect->texture_binding.binding_id == p_first->texture_binding.binding_id && rect->specular_shininess == p_first->specular_shininess;
+}
+
+uint32_t RasterizerCanvasRD::_get_rect_batch_size(const Item::CommandRect *p_first) const {
+	uint32_t count = 1;
+	const Item::Command *c = p_first->next;
+	while (_rect_batch_can_merge(c, p_first)) {
+		count++;
+		c = c->next;
+	}
+	return count;
+}
+
+void RasterizerCanvasRD::_prepare_rect_batches(int p_item_count) {
+	rect_batch.batches.clear();
+	rect_batch.current_batch = 0;
+
+	if (!rect_batch.enabled) {
+		return;
+	}
+
+	// Draw lists recorded earlier in the frame still read the instances they
+	// were given, so each call appends after them instead of starting over.
+	// The offset is reset once per frame in update().
+	uint32_t first_instance = rect_batch.instance_count;
+
+	for (int i = 0; i < p_item_count; i++) {
+		const Item *ci = items[i];
+		Color base_color = ci->final_modulate;
+
+		const Item::Command *c = ci->commands;
+		while (c) {
+			if (c->type != Item::Command::TYPE_RECT || !_rect_batch_can_merge(c->next, static_cast<const Item::CommandRect *>(c))) {
+				c = c->next;
+				continue;
+			}
+
+			const Item::CommandRect *first = static_cast<const Item::CommandRect *>(c);
+			uint32_t count = _get_rect_batch_size(first);
+
+			RectBatch batch;
+			batch.offset = rect_batch.instance_count;
+			batch.count = 0;
+
+			if (rect_batch.instance_count + count <= rect_batch.max_instances) {
+				Vector2 texpixel_size = _get_texture_binding_size(first->texture_binding.binding_id);
+				texpixel_size.x = 1.0 / texpixel_size.x;
+				texpixel_size.y = 1.0 / texpixel_size.y;
+
+				for (uint32_t j = 0; j < count; j++) {
+					const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+					RectBatchInstance &instance = rect_batch.instances[rect_batch.instance_count++];
+
+					Vector2 pixel_size = texpixel_size;
+					Rect2 src_rect;
+					Rect2 dst_rect;
+					_get_rect_data(rect, pixel_size, src_rect, dst_rect);
+
+					instance.modulation[0] = rect->modulate.r * base_color.r;
+					instance.modulation[1] = rect->modulate.g * base_color.g;
+					instance.modulation[2] = rect->modulate.b * base_color.b;
+					instance.modulation[3] = rect->modulate.a * base_color.a;
+
+					instance.src_rect[0] = src_rect.position.x;
+					instance.src_rect[1] = src_rect.position.y;
+					instance.src_rect[2] = src_rect.size.width;
+					instance.src_rect[3] = src_rect.size.height;
+
+					instance.dst_rect[0] = dst_rect.position.x;
+					instance.dst_rect[1] = dst_rect.position.y;
+					instance.dst_rect[2] = dst_rect.size.width;
+					instance.dst_rect[3] = dst_rect.size.height;
+
+					c = c->next;
+				}
+
+				batch.count = count;
+			} else {
+				//out of space, these will be drawn one by one
+				for (uint32_t j = 0; j < count; j++) {
+					c = c->next;
+				}
+			}
+
+			rect_batch.batches.push_back(batch);
+		}
+	}
+
+	if (rect_batch.instance_count > first_instance) {
+		uint32_t count = rect_batch.instance_count - first_instance;
+		RD::get_singleton()->buffer_update(rect_batch.buffer, sizeof(RectBatchInstance) * first_instance, sizeof(RectBatchInstance) * count, &rect_batch.instances[first_instance], true);
+	}
+}
+
 ////////////////////
 void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_item, RD::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants) {
 	//create an empty push constant
@@ -503,8 +654,8 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 	push_constant.color_texture_pixel_size[0] = 0;
 	push_constant.color_texture_pixel_size[1] = 0;
 
-	push_constant.pad[0] = 0;
-	push_constant.pad[1] = 0;
+	push_constant.batch_offset = 0;
+	push_constant.pad = 0;
 
 	push_constant.lights[0] = 0;
 	push_constant.lights[1] = 0;
@@ -608,6 +759,14 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 				uniforms.push_back(u);
 			}
 
+			{
+				RD::Uniform u;
+				u.type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+				u.binding = 8;
+				u.ids.push_back(rect_batch.buffer);
+				uniforms.push_back(u);
+			}
+
 			//validate and update lighs if they are being used
 
 			if (light_count > 0) {
@@ -684,6 +843,8 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 
 	bool reclip = false;
 
+	uint32_t unbatched_rects = 0;
+
 	const Item::Command *c = p_item->commands;
 	while (c) {
 		push_constant.flags = base_flags; //reset on each command for sanity
@@ -714,55 +875,49 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 
 				_update_specular_shininess(rect->specular_shininess, &push_constant.specular_shininess);
 
-				Rect2 src_rect;
-				Rect2 dst_rect;
+				if (unbatched_rects > 0) {
+					unbatched_rects--; //part of a run that did not fit in the batch buffer
+				} else if (rect_batch.enabled && _rect_batch_can_merge(c->next, rect)) {
+					//this rect starts a run that was gathered in _prepare_rect_batches()
+					uint32_t count = _get_rect_batch_size(rect);
 
-				if (texpixel_size != Vector2()) {
-					push_constant.color_texture_pixel_size[0] = texpixel_size.x;
-					push_constant.color_texture_pixel_size[1] = texpixel_size.y;
+					const RectBatch *batch = rect_batch.current_batch < rect_batch.batches.size() ? &rect_batch.batches[rect_batch.current_batch++] : nullptr;
 
-					src_rect = (rect->flags & CANVAS_RECT_REGION) ? Rect2(rect->source.position * texpixel_size, rect->source.size * texpixel_size) : Rect2(0, 0, 1, 1);
-					dst_rect = Rect2(rect->rect.position, rect->rect.size);
+					if (batch && batch->count == count) {
+						push_constant.flags |= FLAGS_RECT_BATCH;
+						if (rect->flags & CANVAS_RECT_CLIP_UV) {
+							push_constant.flags |= FLAGS_CLIP_RECT_UV;
+						}
+						push_constant.batch_offset = batch->offset;
+						push_constant.color_texture_pixel_size[0] = texpixel_size.x;
+						push_constant.color_texture_pixel_size[1] = texpixel_size.y;
 
-					if (dst_rect.size.width < 0) {
-						dst_rect.position.x += dst_rect.size.width;
-						dst_rect.size.width *= -1;
-					}
-					if (dst_rect.size.height < 0) {
-						dst_rect.position.y += dst_rect.size.height;
-						dst_rect.size.height *= -1;
-					}
+						RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
+						RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
+						RD::get_singleton()->draw_list_draw(p_draw_list, true, count);
 
-					if (rect->flags & CANVAS_RECT_FLIP_H) {
-						src_rect.size.x *= -1;
-					}
+						info.commands += count;
+						info.draw_calls++;
 
-					if (rect->flags & CANVAS_RECT_FLIP_V) {
-						src_rect.size.y *= -1;
-					}
+						push_constant.batch_offset = 0;
 
-					if (rect->flags & CANVAS_RECT_TRANSPOSE) {
-						dst_rect.size.x *= -1; // Encoding in the dst_rect.z uniform
+						//skip the rest of the run, it was drawn with this call
+						for (uint32_t j = 1; j < count; j++) {
+							c = c->next;
+						}
+						break;
 					}
 
-					if (rect->flags & CANVAS_RECT_CLIP_UV) {
-						push_constant.flags |= FLAGS_CLIP_RECT_UV;
-					}
+					unbatched_rects = count - 1;
+				}
 
-				} else {
-					dst_rect = Rect2(rect->rect.position, rect->rect.size);
+				Rect2 src_rect;
+				Rect2 dst_rect;
 
-					if (dst_rect.size.width < 0) {
-						dst_rect.position.x += dst_rect.size.width;
-						dst_rect.size.width *= -1;
-					}
-					if (dst_rect.size.height < 0) {
-						dst_rect.position.y += dst_rect.size.height;
-						dst_rect.size.height *= -1;
-					}
+				_get_rect_data(rect, texpixel_size, src_rect, dst_rect);
 
-					src_rect = Rect2(0, 0, 1, 1);
-					texpixel_size = Vector2(1, 1);
+				if (rect->flags & CANVAS_RECT_CLIP_UV) {
+					push_constant.flags |= FLAGS_CLIP_RECT_UV;
 				}
 
 				push_constant.modulation[0] = rect->modulate.r * base_color.r;
@@ -787,6 +942,9 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
 
+				info.commands++;
+				info.draw_calls++;
+
 			} break;
 
 			case Item::Command::TYPE_NINEPATCH: {
@@ -863,6 +1021,9 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
 
+				info.commands++;
+				info.draw_calls++;
+
 			} break;
 			case Item::Command::TYPE_POLYGON: {
 				const Item::CommandPolygon *polygon = static_cast<const Item::CommandPolygon *>(c);
@@ -918,6 +1079,9 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 				}
 				RD::get_singleton()->draw_list_draw(p_draw_list, pb->indices.is_valid());
 
+				info.commands++;
+				info.draw_calls++;
+
 			} break;
 			case Item::Command::TYPE_PRIMITIVE: {
 				const Item::CommandPrimitive *primitive = static_cast<const Item::CommandPrimitive *>(c);
@@ -956,6 +1120,9 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
 
+				info.commands++;
+				info.draw_calls++;
+
 				if (primitive->point_count == 4) {
 					for (uint32_t j = 1; j < 3; j++) {
 						//second half of triangle
@@ -970,6 +1137,8 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 
 					RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 					RD::get_singleton()->draw_list_draw(p_draw_list, true);
+
+					info.draw_calls++;
 				}
 
 			} break;
@@ -1315,6 +1484,9 @@ void RasterizerCanvasRD::_render_items(RID p_to_render_target, int p_item_count,
 
 	RD::FramebufferFormatID fb_format = RD::get_singleton()->framebuffer_get_format(framebuffer);
 
+	//instance data must be uploaded before the draw list begins
+	_prepare_rect_batches(p_item_count);
+
 	RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(framebuffer, clear ? RD::INITIAL_ACTION_CLEAR : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_DISCARD, clear_colors);
 
 	if (p_screen_uniform_set.is_valid()) {
@@ -2163,8 +2335,28 @@ void RasterizerCanvasRD::set_time(double p_time) {
 	state.time = p_time;
 }
 
+int RasterizerCanvasRD::get_render_info(RS::RenderInfo p_info) {
+	switch (p_info) {
+		case RS::INFO_2D_COMMANDS_IN_FRAME: {
+			return last_frame_info.commands;
+		} break;
+		case RS::INFO_2D_DRAW_CALLS_IN_FRAME: {
+			return last_frame_info.draw_calls;
+		} break;
+		default: {
+			return 0;
+		}
+	}
+}
+
 void RasterizerCanvasRD::update() {
 	_dispose_bindings();
+
+	last_frame_info = info;
+	info.commands = 0;
+	info.draw_calls = 0;
+
+	rect_batch.instance_count = 0;
 }
 
 RasterizerCanvasRD::RasterizerCanvasRD(RasterizerStorageRD *p_storage) {
@@ -2403,6 +2595,20 @@ RasterizerCanvasRD::RasterizerCanvasRD(RasterizerStorageRD *p_storage) {
 		}
 	}
 
+	{ //rect batching
+		rect_batch.enabled = GLOBAL_DEF("rendering/2d/batching/use_batching", true);
+		rect_batch.max_instances = GLOBAL_DEF_RST("rendering/2d/batching/max_rect_instances", (int)DEFAULT_MAX_RECT_BATCH_INSTANCES);
+		ProjectSettings::get_singleton()->set_custom_property_info("rendering/2d/batching/max_rect_instances", PropertyInfo(Variant::INT, "rendering/2d/batching/max_rect_instances", PROPERTY_HINT_RANGE, "256,1048576,1"));
+		rect_batch.instances = memnew_arr(RectBatchInstance, rect_batch.max_instances);
+		rect_batch.buffer = RD::get_singleton()->storage_buffer_create(sizeof(RectBatchInstance) * rect_batch.max_instances);
+		rect_batch.instance_count = 0;
+		rect_batch.current_batch = 0;
+
+		info.commands = 0;
+		info.draw_calls = 0;
+		last_frame_info = info;
+	}
+
 	{
 		//polygon buffers
 		polygon_buffers.last_id = 1;
@@ -2481,6 +2687,9 @@ RasterizerCanvasRD::~RasterizerCanvasRD() {
 		RD::get_singleton()->free(state.lights_uniform_buffer);
 		RD::get_singleton()->free(shader.default_skeleton_uniform_buffer);
 		RD::get_singleton()->free(shader.default_skeleton_texture_buffer);
+
+		RD::get_singleton()->free(rect_batch.buffer);
+		memdelete_arr(rect_batch.instances);
 	}
 
 	//shadow rendering
@@ -31,6 +31,7 @@
 #ifndef RASTERIZER_CANVAS_RD_H
 #define RASTERIZER_CANVAS_RD_H
 
+#include "core/local_vector.h"
 #include "servers/rendering/rasterizer.h"
 #include "servers/rendering/rasterizer_rd/rasterizer_storage_rd.h"
 #include "servers/rendering/rasterizer_rd/render_pipeline_vertex_format_cache_rd.h"
@@ -80,7 +81,9 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 		FLAGS_LIGHT_COUNT_SHIFT = 20,
 
 		FLAGS_DEFAULT_NORMAL_MAP_USED = (1 << 26),
-		FLAGS_DEFAULT_SPECULAR_MAP_USED = (1 << 27)
+		FLAGS_DEFAULT_SPECULAR_MAP_USED = (1 << 27),
+
+		FLAGS_RECT_BATCH = (1 << 28)
 
 	};
 
@@ -101,7 +104,8 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 		MAX_RENDER_ITEMS = 256 * 1024,
 		MAX_LIGHT_TEXTURES = 1024,
 		DEFAULT_MAX_LIGHTS_PER_ITEM = 16,
-		DEFAULT_MAX_LIGHTS_PER_RENDER = 256
+		DEFAULT_MAX_LIGHTS_PER_RENDER = 256,
+		DEFAULT_MAX_RECT_BATCH_INSTANCES = 16384
 	};
 
 	/****************/
@@ -432,7 +436,8 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 				float ninepatch_margins[4];
 				float dst_rect[4];
 				float src_rect[4];
-				float pad[2];
+				uint32_t batch_offset; //first instance in the rect batch buffer, if FLAGS_RECT_BATCH is set
+				uint32_t pad;
 			};
 			//primitive
 			struct {
@@ -450,8 +455,52 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 		float skeleton_inverse[16];
 	};
 
+	/******************/
+	/**** BATCHING ****/
+	/******************/
+
+	// Runs of consecutive rect commands within an item that share texture,
+	// flags and pipeline are merged into a single instanced draw. Per-rect data
+	// is gathered before the draw list begins and read from a storage buffer.
+
+	struct RectBatchInstance {
+		float modulation[4];
+		float dst_rect[4];
+		float src_rect[4];
+	};
+
+	struct RectBatch {
+		uint32_t offset;
+		uint32_t count; //zero if it did not fit in the buffer, rects are drawn one by one
+	};
+
+	struct {
+		bool enabled;
+		uint32_t max_instances;
+		uint32_t instance_count; //used so far this frame, batches store their offset into the buffer
+		RectBatchInstance *instances;
+		RID buffer;
+
+		LocalVector<RectBatch> batches;
+		uint32_t current_batch;
+	} rect_batch;
+
+	struct Info {
+		uint32_t commands;
+		uint32_t draw_calls;
+	};
+
+	Info info; //accumulated during the frame
+	Info last_frame_info;
+
 	Item *items[MAX_RENDER_ITEMS];
 
+	_FORCE_INLINE_ bool _rect_batch_can_merge(const Item::Command *p_command, const Item::CommandRect *p_first) const;
+	uint32_t _get_rect_batch_size(const Item::CommandRect *p_first) const;
+	void _get_rect_data(const Item::CommandRect *p_rect, Vector2 &r_texpixel_size, Rect2 &r_src_rect, Rect2 &r_dst_rect) const;
+	void _prepare_rect_batches(int p_item_count);
+	Size2i _get_texture_binding_size(TextureBindingID p_binding) const;
+
 	Size2i _bind_texture_binding(TextureBindingID p_binding, RenderingDevice::DrawListID p_draw_list, uint32_t &flags);
 	void _render_item(RenderingDevice::DrawListID p_draw_list, const Item *p_item, RenderingDevice::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants);
 	void _render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, RID p_screen_uniform_set);
@@ -486,6 +535,8 @@ public:
 
 	void draw_window_margins(int *p_margins, RID *p_margin_textures) {}
 
+	int get_render_info(RS::RenderInfo p_info);
+
 	void set_time(double p_time);
 	void update();
 	bool free(RID p_rid);
@@ -23,6 +23,10 @@ layout(location = 2) out vec2 vertex_interp;
 
 layout(location = 3) out vec2 pixel_size_interp;
 
+#elif !defined(USE_ATTRIBUTES) && !defined(USE_PRIMITIVE)
+
+layout(location = 3) flat out vec4 src_rect_interp;
+
 #endif
 
 #ifdef USE_MATERIAL_UNIFORMS
@@ -74,11 +78,28 @@ void main() {
 	vec2 vertex_base_arr[4] = vec2[](vec2(0.0, 0.0), vec2(0.0, 1.0), vec2(1.0, 1.0), vec2(1.0, 0.0));
 	vec2 vertex_base = vertex_base_arr[gl_VertexIndex];
 
-	vec2 uv = draw_data.src_rect.xy + abs(draw_data.src_rect.zw) * ((draw_data.flags & FLAGS_TRANSPOSE_RECT) != 0 ? vertex_base.yx : vertex_base.xy);
+	vec4 src_rect = draw_data.src_rect;
+	vec4 dst_rect = draw_data.dst_rect;
 	vec4 color = draw_data.modulation;
-	vec2 vertex = draw_data.dst_rect.xy + abs(draw_data.dst_rect.zw) * mix(vertex_base, vec2(1.0, 1.0) - vertex_base, lessThan(draw_data.src_rect.zw, vec2(0.0, 0.0)));
+
+#ifndef USE_NINEPATCH
+	if (bool(draw_data.flags & FLAGS_RECT_BATCH)) {
+		//rect data comes from the batch buffer, one instance per rect
+		uint instance_index = draw_data.batch_offset + gl_InstanceIndex;
+		src_rect = rect_batch.data[instance_index].src_rect;
+		dst_rect = rect_batch.data[instance_index].dst_rect;
+		color = rect_batch.data[instance_index].modulation;
+	}
+#endif
+
+	vec2 uv = src_rect.xy + abs(src_rect.zw) * ((draw_data.flags & FLAGS_TRANSPOSE_RECT) != 0 ? vertex_base.yx : vertex_base.xy);
+	vec2 vertex = dst_rect.xy + abs(dst_rect.zw) * mix(vertex_base, vec2(1.0, 1.0) - vertex_base, lessThan(src_rect.zw, vec2(0.0, 0.0)));
 	uvec4 bones = uvec4(0, 0, 0, 0);
 
+#ifndef USE_NINEPATCH
+	src_rect_interp = src_rect;
+#endif
+
 #endif
 
 	mat4 world_matrix = mat4(vec4(draw_data.world_x, 0.0, 0.0), vec4(draw_data.world_y, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(draw_data.world_ofs, 0.0, 1.0));
@@ -221,6 +242,10 @@ layout(location = 2) in vec2 vertex_interp;
 
 layout(location = 3) in vec2 pixel_size_interp;
 
+#elif !defined(USE_ATTRIBUTES) && !defined(USE_PRIMITIVE)
+
+layout(location = 3) flat in vec4 src_rect_interp;
+
 #endif
 
 layout(location = 0) out vec4 frag_color;
@@ -324,7 +349,12 @@ void main() {
 
 #endif
 	if (bool(draw_data.flags & FLAGS_CLIP_RECT_UV)) {
+#ifdef USE_NINEPATCH
 		uv = clamp(uv, draw_data.src_rect.xy, draw_data.src_rect.xy + abs(draw_data.src_rect.zw));
+#else
+		//per rect when batched, so it is passed from the vertex shader
+		uv = clamp(uv, src_rect_interp.xy, src_rect_interp.xy + abs(src_rect_interp.zw));
+#endif
 	}
 
 #endif
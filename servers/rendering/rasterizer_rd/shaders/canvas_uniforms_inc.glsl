@@ -22,6 +22,8 @@
 #define FLAGS_DEFAULT_NORMAL_MAP_USED (1 << 26)
 #define FLAGS_DEFAULT_SPECULAR_MAP_USED (1 << 27)
 
+#define FLAGS_RECT_BATCH (1 << 28)
+
 // In vulkan, sets should always be ordered using the following logic:
 // Lower Sets: Sets that change format and layout less often
 // Higher sets: Sets that change format and layout very often
@@ -45,7 +47,8 @@ layout(push_constant, binding = 0, std430) uniform DrawData {
 	vec4 ninepatch_margins;
 	vec4 dst_rect; //for built-in rect and UV
 	vec4 src_rect;
-	vec2 pad;
+	uint batch_offset;
+	uint pad;
 
 #endif
 	vec2 color_texture_pixel_size;
@@ -137,6 +140,17 @@ layout(set = 2, binding = 7, std430) restrict readonly buffer GlobalVariableData
 }
 global_variables;
 
+struct RectBatchInstance {
+	vec4 modulation;
+	vec4 dst_rect;
+	vec4 src_rect;
+};
+
+layout(set = 2, binding = 8, std430) restrict readonly buffer RectBatchData {
+	RectBatchInstance data[];
+}
+rect_batch;
+
 /* SET3: Render Target Data */
 
 #ifdef SCREEN_TEXTURE_USED
@@ -31,6 +31,8 @@
 #include "rendering_server_canvas.h"
 
 #include "core/math/geometry_2d.h"
+#include "core/os/os.h"
+#include "core/project_settings.h"
 #include "rendering_server_globals.h"
 #include "rendering_server_raster.h"
 #include "rendering_server_viewport.h"
@@ -43,11 +45,74 @@ void RenderingServerCanvas::_render_canvas_item_tree(RID p_to_render_target, Can
 	memset(z_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
 	memset(z_last_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
 
-	for (int i = 0; i < p_child_item_count; i++) {
-		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr);
+	bool threaded = false;
+
+	if (cull_use_threads) {
+		// Split the tree into independent subtrees. Only worth it for large trees,
+		// otherwise waking up the worker threads costs more than the walk itself.
+		cull_jobs.clear();
+		for (int i = 0; i < p_child_item_count; i++) {
+			_collect_cull_jobs(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, nullptr, nullptr);
+		}
+		if (p_canvas_item) {
+			_collect_cull_jobs(p_canvas_item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, nullptr, nullptr);
+		}
+		threaded = cull_jobs.size() >= CULL_THREADED_MIN_JOBS;
 	}
-	if (p_canvas_item) {
-		_cull_canvas_item(p_canvas_item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr);
+
+	if (threaded) {
+		CullWorkData work_data;
+		work_data.clip_rect = p_clip_rect;
+		work_data.jobs_per_chunk = MAX(1u, cull_jobs.size() / (cull_work_pool.get_thread_count() * CULL_CHUNKS_PER_THREAD));
+
+		uint32_t chunk_count = (cull_jobs.size() + work_data.jobs_per_chunk - 1) / work_data.jobs_per_chunk;
+		if (cull_results.size() < chunk_count) {
+			cull_results.resize(chunk_count);
+		}
+
+		// Update the dirty item rects first. Rects that come from mesh, multimesh
+		// and particles AABBs may update the storage, so those are left to this thread.
+		cull_work_pool.do_work(chunk_count, this, &RenderingServerCanvas::_update_cull_rects_chunk, &work_data);
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			LocalVector<Item *> &storage_rect_items = cull_results[i].storage_rect_items;
+			for (uint32_t j = 0; j < storage_rect_items.size(); j++) {
+				storage_rect_items[j]->get_rect();
+			}
+		}
+
+		cull_rects_updated = true;
+		cull_work_pool.do_work(chunk_count, this, &RenderingServerCanvas::_cull_canvas_item_chunk, &work_data);
+		cull_rects_updated = false;
+
+		// Merge in job order, so items keep the same draw order within each z layer
+		// as with the recursive walk.
+		bool redraw = false;
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			CullResult &result = cull_results[i];
+			for (uint32_t j = 0; j < result.items.size(); j++) {
+				Item *ci = result.items[j];
+				int zidx = ci->z_final - RS::CANVAS_ITEM_Z_MIN;
+				if (z_last_list[zidx]) {
+					z_last_list[zidx]->next = ci;
+					z_last_list[zidx] = ci;
+				} else {
+					z_list[zidx] = ci;
+					z_last_list[zidx] = ci;
+				}
+			}
+			redraw = redraw || result.redraw_requested;
+		}
+
+		if (redraw) {
+			RenderingServerRaster::redraw_request();
+		}
+	} else {
+		for (int i = 0; i < p_child_item_count; i++) {
+			_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr);
+		}
+		if (p_canvas_item) {
+			_cull_canvas_item(p_canvas_item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr);
+		}
 	}
 
 	RasterizerCanvas::Item *list = nullptr;
@@ -99,11 +164,9 @@ void _mark_ysort_dirty(RenderingServerCanvas::Item *ysort_owner, RID_PtrOwner<Re
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
-void RenderingServerCanvas::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RasterizerCanvas::Item **z_list, RasterizerCanvas::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner) {
-	Item *ci = p_canvas_item;
-
+bool RenderingServerCanvas::_cull_canvas_item_prepare(Item *ci, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int &r_z, Item *p_canvas_clip, Item *&r_material_owner, Transform2D &r_xform, Rect2 &r_global_rect, Color &r_modulate) {
 	if (!ci->visible) {
-		return;
+		return false;
 	}
 
 	if (ci->children_order_dirty) {
@@ -111,32 +174,29 @@ void RenderingServerCanvas::_cull_canvas_item(Item *p_canvas_item, const Transfo
 		ci->children_order_dirty = false;
 	}
 
-	Rect2 rect = ci->get_rect();
-	Transform2D xform = p_transform * ci->xform;
-	Rect2 global_rect = xform.xform(rect);
-	global_rect.position += p_clip_rect.position;
+	Rect2 rect = cull_rects_updated ? ci->rect : ci->get_rect();
+	r_xform = p_transform * ci->xform;
+	r_global_rect = r_xform.xform(rect);
+	r_global_rect.position += p_clip_rect.position;
 
-	if (ci->use_parent_material && p_material_owner) {
-		ci->material_owner = p_material_owner;
+	if (ci->use_parent_material && r_material_owner) {
+		ci->material_owner = r_material_owner;
 	} else {
-		p_material_owner = ci;
+		r_material_owner = ci;
 		ci->material_owner = nullptr;
 	}
 
-	Color modulate(ci->modulate.r * p_modulate.r, ci->modulate.g * p_modulate.g, ci->modulate.b * p_modulate.b, ci->modulate.a * p_modulate.a);
+	r_modulate = Color(ci->modulate.r * p_modulate.r, ci->modulate.g * p_modulate.g, ci->modulate.b * p_modulate.b, ci->modulate.a * p_modulate.a);
 
-	if (modulate.a < 0.007) {
-		return;
+	if (r_modulate.a < 0.007) {
+		return false;
 	}
 
-	int child_item_count = ci->child_items.size();
-	Item **child_items = ci->child_items.ptrw();
-
 	if (ci->clip) {
 		if (p_canvas_clip != nullptr) {
-			ci->final_clip_rect = p_canvas_clip->final_clip_rect.clip(global_rect);
+			ci->final_clip_rect = p_canvas_clip->final_clip_rect.clip(r_global_rect);
 		} else {
-			ci->final_clip_rect = global_rect;
+			ci->final_clip_rect = r_global_rect;
 		}
 		ci->final_clip_owner = ci;
 
@@ -144,6 +204,72 @@ void RenderingServerCanvas::_cull_canvas_item(Item *p_canvas_item, const Transfo
 		ci->final_clip_owner = p_canvas_clip;
 	}
 
+	if (ci->z_relative) {
+		r_z = CLAMP(r_z + ci->z_index, RS::CANVAS_ITEM_Z_MIN, RS::CANVAS_ITEM_Z_MAX);
+	} else {
+		r_z = ci->z_index;
+	}
+
+	return true;
+}
+
+void RenderingServerCanvas::_cull_canvas_item_self(Item *ci, const Transform2D &p_xform, const Rect2 &p_global_rect, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RasterizerCanvas::Item **z_list, RasterizerCanvas::Item **z_last_list, CullResult *r_result) {
+	if (ci->copy_back_buffer) {
+		ci->copy_back_buffer->screen_rect = p_xform.xform(ci->copy_back_buffer->rect).clip(p_clip_rect);
+	}
+
+	if (ci->update_when_visible) {
+		if (r_result) {
+			r_result->redraw_requested = true;
+		} else {
+			RenderingServerRaster::redraw_request();
+		}
+	}
+
+	if ((ci->commands != nullptr && p_clip_rect.intersects(p_global_rect, true)) || ci->vp_render || ci->copy_back_buffer) {
+		//something to draw?
+		ci->final_transform = p_xform;
+		ci->final_modulate = Color(p_modulate.r * ci->self_modulate.r, p_modulate.g * ci->self_modulate.g, p_modulate.b * ci->self_modulate.b, p_modulate.a * ci->self_modulate.a);
+		ci->global_rect_cache = p_global_rect;
+		ci->global_rect_cache.position -= p_clip_rect.position;
+		ci->light_masked = false;
+
+		ci->z_final = p_z;
+
+		ci->next = nullptr;
+
+		if (r_result) {
+			// Linked into the z lists when the results of all jobs are merged.
+			r_result->items.push_back(ci);
+			return;
+		}
+
+		int zidx = p_z - RS::CANVAS_ITEM_Z_MIN;
+
+		if (z_last_list[zidx]) {
+			z_last_list[zidx]->next = ci;
+			z_last_list[zidx] = ci;
+
+		} else {
+			z_list[zidx] = ci;
+			z_last_list[zidx] = ci;
+		}
+	}
+}
+
+void RenderingServerCanvas::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RasterizerCanvas::Item **z_list, RasterizerCanvas::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner, CullResult *r_result) {
+	Item *ci = p_canvas_item;
+
+	Transform2D xform;
+	Rect2 global_rect;
+	Color modulate;
+	if (!_cull_canvas_item_prepare(ci, p_transform, p_clip_rect, p_modulate, p_z, p_canvas_clip, p_material_owner, xform, global_rect, modulate)) {
+		return;
+	}
+
+	int child_item_count = ci->child_items.size();
+	Item **child_items = ci->child_items.ptrw();
+
 	if (ci->sort_y) {
 		if (ci->ysort_children_count == -1) {
 			ci->ysort_children_count = 0;
@@ -160,63 +286,151 @@ void RenderingServerCanvas::_cull_canvas_item(Item *p_canvas_item, const Transfo
 		sorter.sort(child_items, child_item_count);
 	}
 
-	if (ci->z_relative) {
-		p_z = CLAMP(p_z + ci->z_index, RS::CANVAS_ITEM_Z_MIN, RS::CANVAS_ITEM_Z_MAX);
-	} else {
-		p_z = ci->z_index;
+	for (int i = 0; i < child_item_count; i++) {
+		if (!child_items[i]->behind || (ci->sort_y && child_items[i]->sort_y)) {
+			continue;
+		}
+		if (ci->sort_y) {
+			_cull_canvas_item(child_items[i], xform * child_items[i]->ysort_xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, r_result);
+		} else {
+			_cull_canvas_item(child_items[i], xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, p_material_owner, r_result);
+		}
 	}
 
+	_cull_canvas_item_self(ci, xform, global_rect, p_clip_rect, modulate, p_z, z_list, z_last_list, r_result);
+
 	for (int i = 0; i < child_item_count; i++) {
-		if (!child_items[i]->behind || (ci->sort_y && child_items[i]->sort_y)) {
+		if (child_items[i]->behind || (ci->sort_y && child_items[i]->sort_y)) {
 			continue;
 		}
 		if (ci->sort_y) {
-			_cull_canvas_item(child_items[i], xform * child_items[i]->ysort_xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner);
+			_cull_canvas_item(child_items[i], xform * child_items[i]->ysort_xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, r_result);
 		} else {
-			_cull_canvas_item(child_items[i], xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, p_material_owner);
+			_cull_canvas_item(child_items[i], xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, p_material_owner, r_result);
 		}
 	}
+}
+
+void RenderingServerCanvas::_collect_cull_jobs(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, Item *p_canvas_clip, Item *p_material_owner) {
+	Item *ci = p_canvas_item;
+
+	if (!ci->visible) {
+		return;
+	}
 
-	if (ci->copy_back_buffer) {
-		ci->copy_back_buffer->screen_rect = xform.xform(ci->copy_back_buffer->rect).clip(p_clip_rect);
+	if (ci->sort_y || ci->child_items.size() < CULL_SPLIT_MIN_CHILDREN) {
+		// Small subtrees are culled recursively by a single job.
+		CullJob job;
+		job.item = ci;
+		job.transform = p_transform;
+		job.modulate = p_modulate;
+		job.z = p_z;
+		job.canvas_clip = p_canvas_clip;
+		job.material_owner = p_material_owner;
+		cull_jobs.push_back(job);
+		return;
 	}
 
-	if (ci->update_when_visible) {
-		RenderingServerRaster::redraw_request();
+	// Items with many children are split: the item itself becomes a job drawn
+	// between its behind and regular children, and each child gets its own job.
+	Transform2D xform;
+	Rect2 global_rect;
+	Color modulate;
+	if (!_cull_canvas_item_prepare(ci, p_transform, p_clip_rect, p_modulate, p_z, p_canvas_clip, p_material_owner, xform, global_rect, modulate)) {
+		return;
 	}
 
-	if ((ci->commands != nullptr && p_clip_rect.intersects(global_rect, true)) || ci->vp_render || ci->copy_back_buffer) {
-		//something to draw?
-		ci->final_transform = xform;
-		ci->final_modulate = Color(modulate.r * ci->self_modulate.r, modulate.g * ci->self_modulate.g, modulate.b * ci->self_modulate.b, modulate.a * ci->self_modulate.a);
-		ci->global_rect_cache = global_rect;
-		ci->global_rect_cache.position -= p_clip_rect.position;
-		ci->light_masked = false;
+	int child_item_count = ci->child_items.size();
+	Item **child_items = ci->child_items.ptrw();
 
-		int zidx = p_z - RS::CANVAS_ITEM_Z_MIN;
+	for (int i = 0; i < child_item_count; i++) {
+		if (child_items[i]->behind) {
+			_collect_cull_jobs(child_items[i], xform, p_clip_rect, modulate, p_z, (Item *)ci->final_clip_owner, p_material_owner);
+		}
+	}
 
-		if (z_last_list[zidx]) {
-			z_last_list[zidx]->next = ci;
-			z_last_list[zidx] = ci;
+	CullJob job;
+	job.item = ci;
+	job.self_only = true;
+	job.transform = xform;
+	job.global_rect = global_rect;
+	job.modulate = modulate;
+	job.z = p_z;
+	cull_jobs.push_back(job);
 
-		} else {
-			z_list[zidx] = ci;
-			z_last_list[zidx] = ci;
+	for (int i = 0; i < child_item_count; i++) {
+		if (!child_items[i]->behind) {
+			_collect_cull_jobs(child_items[i], xform, p_clip_rect, modulate, p_z, (Item *)ci->final_clip_owner, p_material_owner);
 		}
+	}
+}
 
-		ci->z_final = p_z;
+static bool _item_rect_uses_storage(const RenderingServerCanvas::Item *p_canvas_item) {
+	const RenderingServerCanvas::Item::Command *c = p_canvas_item->commands;
+	while (c) {
+		switch (c->type) {
+			case RenderingServerCanvas::Item::Command::TYPE_MESH:
+			case RenderingServerCanvas::Item::Command::TYPE_MULTIMESH:
+			case RenderingServerCanvas::Item::Command::TYPE_PARTICLES:
+				return true;
+			default:
+				break;
+		}
+		c = c->next;
+	}
+	return false;
+}
 
-		ci->next = nullptr;
+void RenderingServerCanvas::_update_cull_rects(Item *p_canvas_item, LocalVector<Item *> &r_storage_rect_items) {
+	if (!p_canvas_item->visible) {
+		return;
+	}
+
+	if (!p_canvas_item->custom_rect && (p_canvas_item->rect_dirty || p_canvas_item->update_when_visible)) {
+		if (_item_rect_uses_storage(p_canvas_item)) {
+			r_storage_rect_items.push_back(p_canvas_item);
+		} else {
+			p_canvas_item->get_rect();
+		}
 	}
 
+	int child_item_count = p_canvas_item->child_items.size();
+	Item **child_items = p_canvas_item->child_items.ptrw();
 	for (int i = 0; i < child_item_count; i++) {
-		if (child_items[i]->behind || (ci->sort_y && child_items[i]->sort_y)) {
-			continue;
+		_update_cull_rects(child_items[i], r_storage_rect_items);
+	}
+}
+
+void RenderingServerCanvas::_update_cull_rects_chunk(uint32_t p_chunk, CullWorkData *p_work_data) {
+	LocalVector<Item *> &storage_rect_items = cull_results[p_chunk].storage_rect_items;
+	storage_rect_items.clear();
+
+	uint32_t from = p_chunk * p_work_data->jobs_per_chunk;
+	uint32_t to = MIN(from + p_work_data->jobs_per_chunk, cull_jobs.size());
+
+	for (uint32_t i = from; i < to; i++) {
+		// Self only jobs had their rect computed while collecting the jobs,
+		// and their children are jobs of their own.
+		if (!cull_jobs[i].self_only) {
+			_update_cull_rects(cull_jobs[i].item, storage_rect_items);
 		}
-		if (ci->sort_y) {
-			_cull_canvas_item(child_items[i], xform * child_items[i]->ysort_xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner);
+	}
+}
+
+void RenderingServerCanvas::_cull_canvas_item_chunk(uint32_t p_chunk, CullWorkData *p_work_data) {
+	CullResult &result = cull_results[p_chunk];
+	result.items.clear();
+	result.redraw_requested = false;
+
+	uint32_t from = p_chunk * p_work_data->jobs_per_chunk;
+	uint32_t to = MIN(from + p_work_data->jobs_per_chunk, cull_jobs.size());
+
+	for (uint32_t i = from; i < to; i++) {
+		const CullJob &job = cull_jobs[i];
+		if (job.self_only) {
+			_cull_canvas_item_self(job.item, job.transform, job.global_rect, p_work_data->clip_rect, job.modulate, job.z, nullptr, nullptr, &result);
 		} else {
-			_cull_canvas_item(child_items[i], xform, p_clip_rect, modulate, p_z, z_list, z_last_list, (Item *)ci->final_clip_owner, p_material_owner);
+			_cull_canvas_item(job.item, job.transform, p_work_data->clip_rect, job.modulate, job.z, nullptr, nullptr, job.canvas_clip, job.material_owner, &result);
 		}
 	}
 }
@@ -922,6 +1136,99 @@ void RenderingServerCanvas::canvas_item_clear(RID p_item) {
 	canvas_item->clear();
 }
 
+void RenderingServerCanvas::canvas_item_command_set_rect(RID p_item, int p_command, const Rect2 &p_rect, const Rect2 &p_src_rect) {
+	Item *canvas_item = canvas_item_owner.getornull(p_item);
+	ERR_FAIL_COND(!canvas_item);
+
+	Item::Command *c = canvas_item->get_command(p_command);
+	ERR_FAIL_COND_MSG(!c, "Command index out of range: " + itos(p_command) + ".");
+
+	if (c->type == Item::Command::TYPE_RECT) {
+		Item::CommandRect *rect = static_cast<Item::CommandRect *>(c);
+		// Same normalization as canvas_item_add_texture_rect_region(), keeping the
+		// flags that were not derived from the sign of the rects.
+		rect->flags &= ~(RasterizerCanvas::CANVAS_RECT_FLIP_H | RasterizerCanvas::CANVAS_RECT_FLIP_V);
+		rect->rect = p_rect;
+		if (rect->flags & RasterizerCanvas::CANVAS_RECT_REGION) {
+			rect->source = p_src_rect;
+		}
+
+		if (rect->rect.size.x < 0) {
+			rect->flags |= RasterizerCanvas::CANVAS_RECT_FLIP_H;
+			rect->rect.size.x = -rect->rect.size.x;
+		}
+		if (rect->source.size.x < 0) {
+			rect->flags ^= RasterizerCanvas::CANVAS_RECT_FLIP_H;
+			rect->source.size.x = -rect->source.size.x;
+		}
+		if (rect->rect.size.y < 0) {
+			rect->flags |= RasterizerCanvas::CANVAS_RECT_FLIP_V;
+			rect->rect.size.y = -rect->rect.size.y;
+		}
+		if (rect->source.size.y < 0) {
+			rect->flags ^= RasterizerCanvas::CANVAS_RECT_FLIP_V;
+			rect->source.size.y = -rect->source.size.y;
+		}
+
+		if (rect->flags & RasterizerCanvas::CANVAS_RECT_TRANSPOSE) {
+			SWAP(rect->rect.size.x, rect->rect.size.y);
+		}
+	} else if (c->type == Item::Command::TYPE_NINEPATCH) {
+		Item::CommandNinePatch *style = static_cast<Item::CommandNinePatch *>(c);
+		style->rect = p_rect;
+		style->source = p_src_rect;
+	} else {
+		ERR_FAIL_MSG("Command is not a rect or nine-patch command.");
+	}
+
+	canvas_item->rect_dirty = true;
+}
+
+void RenderingServerCanvas::canvas_item_command_set_modulate(RID p_item, int p_command, const Color &p_modulate) {
+	Item *canvas_item = canvas_item_owner.getornull(p_item);
+	ERR_FAIL_COND(!canvas_item);
+
+	Item::Command *c = canvas_item->get_command(p_command);
+	ERR_FAIL_COND_MSG(!c, "Command index out of range: " + itos(p_command) + ".");
+
+	switch (c->type) {
+		case Item::Command::TYPE_RECT: {
+			static_cast<Item::CommandRect *>(c)->modulate = p_modulate;
+		} break;
+		case Item::Command::TYPE_NINEPATCH: {
+			static_cast<Item::CommandNinePatch *>(c)->color = p_modulate;
+		} break;
+		case Item::Command::TYPE_MESH: {
+			static_cast<Item::CommandMesh *>(c)->modulate = p_modulate;
+		} break;
+		default: {
+			ERR_FAIL_MSG("Command does not have a modulate color.");
+		}
+	}
+}
+
+void RenderingServerCanvas::canvas_item_command_set_transform(RID p_item, int p_command, const Transform2D &p_transform) {
+	Item *canvas_item = canvas_item_owner.getornull(p_item);
+	ERR_FAIL_COND(!canvas_item);
+
+	Item::Command *c = canvas_item->get_command(p_command);
+	ERR_FAIL_COND_MSG(!c, "Command index out of range: " + itos(p_command) + ".");
+
+	switch (c->type) {
+		case Item::Command::TYPE_TRANSFORM: {
+			static_cast<Item::CommandTransform *>(c)->xform = p_transform;
+		} break;
+		case Item::Command::TYPE_MESH: {
+			static_cast<Item::CommandMesh *>(c)->transform = p_transform;
+		} break;
+		default: {
+			ERR_FAIL_MSG("Command does not have a transform.");
+		}
+	}
+
+	canvas_item->rect_dirty = true;
+}
+
 void RenderingServerCanvas::canvas_item_set_draw_index(RID p_item, int p_index) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
@@ -1394,9 +1701,16 @@ RenderingServerCanvas::RenderingServerCanvas() {
 	z_last_list = (RasterizerCanvas::Item **)memalloc(z_range * sizeof(RasterizerCanvas::Item *));
 
 	disable_scale = false;
+
+	cull_use_threads = GLOBAL_DEF("rendering/2d/culling/use_threads", true) && OS::get_singleton()->get_processor_count() > 1;
+	if (cull_use_threads) {
+		cull_work_pool.init();
+	}
 }
 
 RenderingServerCanvas::~RenderingServerCanvas() {
 	memfree(z_list);
 	memfree(z_last_list);
+
+	cull_work_pool.finish();
 }
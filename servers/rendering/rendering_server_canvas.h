@@ -31,6 +31,8 @@
 #ifndef VISUALSERVERCANVAS_H
 #define VISUALSERVERCANVAS_H
 
+#include "core/local_vector.h"
+#include "core/thread_work_pool.h"
 #include "rasterizer.h"
 #include "rendering_server_viewport.h"
 
@@ -157,7 +159,56 @@ public:
 
 private:
 	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RasterizerCanvas::Light *p_lights);
-	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RasterizerCanvas::Item **z_list, RasterizerCanvas::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner);
+
+	/* THREADED CULLING */
+
+	enum {
+		// Items with at least this many children are split into one job per child.
+		CULL_SPLIT_MIN_CHILDREN = 64,
+		// Below this many jobs, the tree is culled on the calling thread.
+		CULL_THREADED_MIN_JOBS = 256,
+		CULL_CHUNKS_PER_THREAD = 4,
+	};
+
+	struct CullJob {
+		Item *item = nullptr;
+		Transform2D transform;
+		Color modulate;
+		int z = 0;
+		Item *canvas_clip = nullptr;
+		Item *material_owner = nullptr;
+		// Draw only the item itself; its children are separate jobs.
+		bool self_only = false;
+		Rect2 global_rect;
+	};
+
+	struct CullResult {
+		LocalVector<Item *> items;
+		bool redraw_requested = false;
+		// Dirty items whose rect has to be computed on the rendering thread.
+		LocalVector<Item *> storage_rect_items;
+	};
+
+	struct CullWorkData {
+		Rect2 clip_rect;
+		uint32_t jobs_per_chunk;
+	};
+
+	bool cull_use_threads;
+	ThreadWorkPool cull_work_pool;
+	// Set while worker threads cull, so they use the rects computed beforehand.
+	bool cull_rects_updated = false;
+	LocalVector<CullJob> cull_jobs;
+	LocalVector<CullResult> cull_results;
+
+	bool _cull_canvas_item_prepare(Item *ci, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int &r_z, Item *p_canvas_clip, Item *&r_material_owner, Transform2D &r_xform, Rect2 &r_global_rect, Color &r_modulate);
+	void _cull_canvas_item_self(Item *ci, const Transform2D &p_xform, const Rect2 &p_global_rect, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RasterizerCanvas::Item **z_list, RasterizerCanvas::Item **z_last_list, CullResult *r_result);
+	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RasterizerCanvas::Item **z_list, RasterizerCanvas::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner, CullResult *r_result = nullptr);
+	void _collect_cull_jobs(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, Item *p_canvas_clip, Item *p_material_owner);
+	void _update_cull_rects(Item *p_canvas_item, LocalVector<Item *> &r_storage_rect_items);
+	void _update_cull_rects_chunk(uint32_t p_chunk, CullWorkData *p_work_data);
+	void _cull_canvas_item_chunk(uint32_t p_chunk, CullWorkData *p_work_data);
+
 	void _light_mask_canvas_items(int p_z, RasterizerCanvas::Item *p_canvas_item, RasterizerCanvas::Light *p_masked_lights);
 
 	RasterizerCanvas::Item **z_list;
@@ -215,6 +266,11 @@ public:
 	void canvas_item_attach_skeleton(RID p_item, RID p_skeleton);
 
 	void canvas_item_clear(RID p_item);
+
+	void canvas_item_command_set_rect(RID p_item, int p_command, const Rect2 &p_rect, const Rect2 &p_src_rect);
+	void canvas_item_command_set_modulate(RID p_item, int p_command, const Color &p_modulate);
+	void canvas_item_command_set_transform(RID p_item, int p_command, const Transform2D &p_transform);
+
 	void canvas_item_set_draw_index(RID p_item, int p_index);
 
 	void canvas_item_set_material(RID p_item, RID p_material);
@@ -689,6 +689,11 @@ public:
 	BIND2(canvas_item_attach_skeleton, RID, RID)
 
 	BIND1(canvas_item_clear, RID)
+
+	BIND4(canvas_item_command_set_rect, RID, int, const Rect2 &, const Rect2 &)
+	BIND3(canvas_item_command_set_modulate, RID, int, const Color &)
+	BIND3(canvas_item_command_set_transform, RID, int, const Transform2D &)
+
 	BIND2(canvas_item_set_draw_index, RID, int)
 
 	BIND2(canvas_item_set_material, RID, RID)
@@ -45,6 +45,9 @@ void RenderingServerWrapMT::thread_draw(bool p_swap_buffers, double frame_step)
 
 void RenderingServerWrapMT::thread_flush() {
 	atomic_decrement(&draw_pending);
+
+	sync_changed.store(rendering_server->has_changed(), std::memory_order_relaxed);
+	sync_flushed_count.store(command_queue.get_flushed_count(), std::memory_order_release);
 }
 
 void RenderingServerWrapMT::_thread_callback(void *_instance) {
@@ -63,8 +66,8 @@ void RenderingServerWrapMT::thread_loop() {
 	exit = false;
 	draw_thread_up = true;
 	while (!exit) {
-		// flush commands one by one, until exit is requested
-		command_queue.wait_and_flush_one();
+		// flush commands in batches, until exit is requested
+		command_queue.wait_and_flush();
 	}
 
 	command_queue.flush_all(); // flush all
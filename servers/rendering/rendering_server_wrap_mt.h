@@ -51,6 +51,10 @@ class RenderingServerWrapMT : public RenderingServer {
 	bool create_thread;
 
 	uint64_t draw_pending;
+	// Server state captured by the last sync(), so the main thread can query
+	// it without waiting for the server thread.
+	std::atomic<bool> sync_changed = { true };
+	std::atomic<uint32_t> sync_flushed_count = { 0 };
 	void thread_draw(bool p_swap_buffers, double frame_step);
 	void thread_flush();
 
@@ -592,6 +596,11 @@ public:
 	FUNC2(canvas_item_attach_skeleton, RID, RID)
 
 	FUNC1(canvas_item_clear, RID)
+
+	FUNC4(canvas_item_command_set_rect, RID, int, const Rect2 &, const Rect2 &)
+	FUNC3(canvas_item_command_set_modulate, RID, int, const Color &)
+	FUNC3(canvas_item_command_set_transform, RID, int, const Transform2D &)
+
 	FUNC2(canvas_item_set_draw_index, RID, int)
 
 	FUNC2(canvas_item_set_material, RID, RID)
@@ -663,7 +672,22 @@ public:
 	virtual void finish();
 	virtual void draw(bool p_swap_buffers, double frame_step);
 	virtual void sync();
-	FUNC0RC(bool, has_changed)
+
+	virtual bool has_changed() const {
+		if (Thread::get_caller_id() != server_thread) {
+			// Nothing was pushed since the last sync() got flushed, so what it
+			// captured is still current and the round-trip can be skipped.
+			if (command_queue.get_pushed_count() == sync_flushed_count.load(std::memory_order_acquire)) {
+				return sync_changed.load(std::memory_order_relaxed);
+			}
+			bool ret;
+			command_queue.push_and_ret(rendering_server, &RenderingServer::has_changed, &ret);
+			SYNC_DEBUG
+			return ret;
+		} else {
+			return rendering_server->has_changed();
+		}
+	}
 
 	/* RENDER INFO */
 
@@ -1040,6 +1040,11 @@ public:
 	virtual void canvas_item_attach_skeleton(RID p_item, RID p_skeleton) = 0;
 
 	virtual void canvas_item_clear(RID p_item) = 0;
+
+	virtual void canvas_item_command_set_rect(RID p_item, int p_command, const Rect2 &p_rect, const Rect2 &p_src_rect) = 0;
+	virtual void canvas_item_command_set_modulate(RID p_item, int p_command, const Color &p_modulate) = 0;
+	virtual void canvas_item_command_set_transform(RID p_item, int p_command, const Transform2D &p_transform) = 0;
+
 	virtual void canvas_item_set_draw_index(RID p_item, int p_index) = 0;
 
 	virtual void canvas_item_set_material(RID p_item, RID p_material) = 0;
@@ -1183,6 +1188,8 @@ public:
 		INFO_VIDEO_MEM_USED,
 		INFO_TEXTURE_MEM_USED,
 		INFO_VERTEX_MEM_USED,
+		INFO_2D_COMMANDS_IN_FRAME,
+		INFO_2D_DRAW_CALLS_IN_FRAME,
 	};
 
 	virtual int get_render_info(RenderInfo p_info) = 0;
@@ -51,6 +51,7 @@ public:
 	virtual Error recvfrom(uint8_t *p_buffer, int p_len, int &r_read, IP_Address &r_ip, uint16_t &r_port) = 0;
 	virtual int set_option(ENetSocketOption p_option, int p_value) = 0;
 	virtual void close() = 0;
+	virtual int wait(enet_uint32 *r_condition, enet_uint32 p_timeout) { return -1; }
 	virtual ~ENetGodotSocket(){};
 };
 
@@ -99,6 +100,21 @@ public:
 		return sock->recvfrom(p_buffer, p_len, r_read, r_ip, r_port);
 	}
 
+	int wait(enet_uint32 *r_condition, enet_uint32 p_timeout) {
+		if (!(*r_condition & ENET_SOCKET_WAIT_RECEIVE)) {
+			return -1;
+		}
+		Error err = sock->poll(NetSocket::POLL_TYPE_IN, p_timeout);
+		if (err == OK) {
+			*r_condition = ENET_SOCKET_WAIT_RECEIVE;
+		} else if (err == ERR_BUSY) {
+			*r_condition = ENET_SOCKET_WAIT_NONE;
+		} else {
+			return -1;
+		}
+		return 0;
+	}
+
 	int set_option(ENetSocketOption p_option, int p_value) {
 		switch (p_option) {
 			case ENET_SOCKOPT_NONBLOCK: {
@@ -494,10 +510,10 @@ int enet_socket_receive(ENetSocket socket, ENetAddress *address, ENetBuffer *buf
 	return read;
 }
 
-// Not implemented
 int enet_socket_wait(ENetSocket socket, enet_uint32 *condition, enet_uint32 timeout) {
 
-	return 0; // do we need this function?
+	ENetGodotSocket *sock = (ENetGodotSocket *)socket;
+	return sock->wait(condition, timeout);
 }
 
 int enet_socket_get_address(ENetSocket socket, ENetAddress *address) {